@@ -0,0 +1,50 @@
+import path from 'path';
+import llvm from '..';
+import measure from './measure';
+
+const Iterations = 2000;
+const ChainLength = 256;
+
+// Compares emitting a chain of dependent instructions one IRBuilder call at a
+// time against a single emitBatch call for the whole chain.
+export default function benchBatch(): void {
+    const filename = path.basename(__filename);
+    const context = new llvm.LLVMContext();
+    const module = new llvm.Module(filename, context);
+    const builder = new llvm.IRBuilder(context);
+
+    const i32Ty = builder.getInt32Ty();
+    const funcType = llvm.FunctionType.get(i32Ty, [i32Ty, i32Ty], false);
+    const func = llvm.Function.Create(funcType, llvm.Function.LinkageTypes.ExternalLinkage, 'bench', module);
+    builder.SetInsertPoint(llvm.BasicBlock.Create(context, 'entry', func));
+    const a = func.getArg(0);
+    const b = func.getArg(1);
+
+    // slot 0 is a, slot 1 is b, operation i defines slot 2 + i
+    const { Add, Mul, ICmp, Select } = llvm.IRBuilder.BatchOp;
+    const words: number[] = [];
+    let last = 0;
+    for (let i = 0; i < ChainLength; i += 4) {
+        const slot = 2 + i;
+        words.push(Add, last, 1);
+        words.push(Mul, slot, 0);
+        words.push(ICmp, llvm.ICmpInst.Predicate.ICMP_SLT, slot + 1, 1);
+        words.push(Select, slot + 2, slot + 1, 0);
+        last = slot + 3;
+    }
+    const program = new Int32Array(words);
+    const values = [a, b];
+    const results = [last];
+
+    console.log(`${filename}: emitting ${ChainLength} instructions per iteration`);
+    measure('IRBuilder calls', Iterations, () => {
+        let value: llvm.Value = a;
+        for (let i = 0; i < ChainLength; i += 4) {
+            const sum = builder.CreateAdd(value, b);
+            const product = builder.CreateMul(sum, a);
+            const less = builder.CreateICmpSLT(product, b);
+            value = builder.CreateSelect(less, product, a);
+        }
+    });
+    measure('IRBuilder.emitBatch', Iterations, () => builder.emitBatch(program, values, [], results));
+}
@@ -0,0 +1,57 @@
+import path from 'path';
+import llvm from '..';
+import measure from './measure';
+
+const Iterations = 50;
+const FunctionCount = 64;
+const ChainLength = 1024;
+
+// Compares counting the integer-typed instructions of a module through the bulk accessors, which
+// create a wrapper per instruction, against a single reused IRCursor.
+export default function benchCursor(): void {
+    const filename = path.basename(__filename);
+    const context = new llvm.LLVMContext();
+    const module = new llvm.Module(filename, context);
+    const builder = new llvm.IRBuilder(context);
+
+    const i32Ty = builder.getInt32Ty();
+    const funcType = llvm.FunctionType.get(i32Ty, [i32Ty], false);
+    const { Add, Ret } = llvm.IRBuilder.BatchOp;
+    const words: number[] = [];
+    for (let i = 0; i < ChainLength; ++i) {
+        words.push(Add, i, 0);
+    }
+    words.push(Ret, ChainLength);
+    const program = new Int32Array(words);
+    for (let i = 0; i < FunctionCount; ++i) {
+        const func = llvm.Function.Create(funcType, llvm.Function.LinkageTypes.ExternalLinkage, `func${i}`, module);
+        builder.SetInsertPoint(llvm.BasicBlock.Create(context, 'entry', func));
+        builder.emitBatch(program, [func.getArg(0)]);
+    }
+
+    console.log(`${filename}: scanning ${FunctionCount * (ChainLength + 1)} instructions per iteration`);
+    const { IntegerTyID } = llvm.Type.TypeID;
+    measure('bulk accessors', Iterations, () => {
+        let count = 0;
+        for (const func of module.getFunctions()) {
+            for (const block of func.getBasicBlocks()) {
+                for (const inst of block.getInstructions()) {
+                    if (inst.getType().getTypeID() === IntegerTyID) {
+                        ++count;
+                    }
+                }
+            }
+        }
+        return count;
+    });
+    measure('IRCursor', Iterations, () => {
+        let count = 0;
+        const cursor = module.cursor();
+        while (cursor.next()) {
+            if (cursor.getTypeID() === IntegerTyID) {
+                ++count;
+            }
+        }
+        return count;
+    });
+}
@@ -0,0 +1,15 @@
+import benchWrapper from './wrapper';
+import benchIRBuilder from './irbuilder';
+import benchBatch from './batch';
+import benchCursor from './cursor';
+import benchTrampoline from './trampoline';
+import benchLazy from './lazy';
+import benchTiered from './tiered';
+
+benchWrapper();
+benchIRBuilder();
+benchBatch();
+benchCursor();
+benchTrampoline();
+benchLazy();
+benchTiered();
@@ -0,0 +1,27 @@
+import path from 'path';
+import llvm from '..';
+import measure from './measure';
+
+const Iterations = 200000;
+
+// Measures the per-call overhead of IRBuilder factories, which is dominated by
+// the IsClassOf validation of their arguments.
+export default function benchIRBuilder(): void {
+    const filename = path.basename(__filename);
+    const context = new llvm.LLVMContext();
+    const module = new llvm.Module(filename, context);
+    const builder = new llvm.IRBuilder(context);
+
+    const i32Ty = builder.getInt32Ty();
+    const funcType = llvm.FunctionType.get(i32Ty, [i32Ty, i32Ty], false);
+    const func = llvm.Function.Create(funcType, llvm.Function.LinkageTypes.ExternalLinkage, 'bench', module);
+    builder.SetInsertPoint(llvm.BasicBlock.Create(context, 'entry', func));
+    const a = func.getArg(0);
+    const b = func.getArg(1);
+
+    console.log(`${filename}: emitting instructions through IRBuilder`);
+    measure('CreateAdd', Iterations, () => builder.CreateAdd(a, b));
+    measure('CreateICmpSLT', Iterations, () => builder.CreateICmpSLT(a, b));
+    measure('CreateSelect', Iterations, () => builder.CreateSelect(builder.getTrue(), a, b));
+    measure('CreateZExt', Iterations, () => builder.CreateZExt(a, builder.getInt64Ty()));
+}
@@ -0,0 +1,48 @@
+import path from 'path';
+import llvm from '..';
+import measure from './measure';
+
+const Iterations = 5;
+const FunctionCounts = [64, 256, 1024];
+const ChainLength = 64;
+
+function createModule(context: llvm.LLVMContext, jit: llvm.LLJIT, functionCount: number): llvm.Module {
+    const module = new llvm.Module('lazy', context);
+    module.setDataLayout(jit.getDataLayout());
+    module.setTargetTriple(jit.getTargetTriple());
+    const builder = new llvm.IRBuilder(context);
+    const i32Ty = builder.getInt32Ty();
+    const funcType = llvm.FunctionType.get(i32Ty, [i32Ty], false);
+    const { Add, Ret } = llvm.IRBuilder.BatchOp;
+    const words: number[] = [];
+    for (let i = 0; i < ChainLength; ++i) {
+        words.push(Add, i, 0);
+    }
+    words.push(Ret, ChainLength);
+    const program = new Int32Array(words);
+    for (let i = 0; i < functionCount; ++i) {
+        const func = llvm.Function.Create(funcType, llvm.Function.LinkageTypes.ExternalLinkage, `func${i}`, module);
+        builder.SetInsertPoint(llvm.BasicBlock.Create(context, 'entry', func));
+        builder.emitBatch(program, [func.getArg(0)]);
+    }
+    return module;
+}
+
+// Measures the time from adding a module to the result of calling one of its functions, for an
+// eager and a lazy JIT, as the module grows.
+export default function benchLazy(): void {
+    const filename = path.basename(__filename);
+    console.log(`${filename}: time to the first result of a module of ${FunctionCounts.join(', ')} functions`);
+    const modes: [string, llvm.LLJITOptions][] = [['eager', {}], ['lazy', { lazy: true }], ['speculative', { lazy: true, speculate: true }]];
+    for (const functionCount of FunctionCounts) {
+        for (const [mode, options] of modes) {
+            measure(`${mode} ${functionCount} functions`, Iterations, () => {
+                const jit = new llvm.LLJIT(options);
+                jit.addModule(createModule(new llvm.LLVMContext(), jit, functionCount));
+                const result = jit.getFunction('func0', { result: 'i32', params: ['i32'] })(1);
+                jit.dispose();
+                return result;
+            });
+        }
+    }
+}
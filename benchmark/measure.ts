@@ -0,0 +1,21 @@
+function pad(text: string, width: number): string {
+    while (text.length < width) {
+        text += ' ';
+    }
+    return text;
+}
+
+export default function measure(label: string, iterations: number, fn: () => void): number {
+    // warm up so that the JIT and the wrapper caches are in a steady state
+    for (let i = 0; i < Math.min(iterations, 10000); ++i) {
+        fn();
+    }
+    const start = process.hrtime();
+    for (let i = 0; i < iterations; ++i) {
+        fn();
+    }
+    const [seconds, nanoseconds] = process.hrtime(start);
+    const nsPerOp = (seconds * 1e9 + nanoseconds) / iterations;
+    console.log(`${pad(label, 40)} ${nsPerOp.toFixed(1)} ns/op`);
+    return nsPerOp;
+}
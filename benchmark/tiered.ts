@@ -0,0 +1,64 @@
+import path from 'path';
+import llvm from '..';
+import measure from './measure';
+
+const Iterations = 100000;
+const LoopCount = 1000;
+
+function createModule(context: llvm.LLVMContext, jit: llvm.LLJIT): llvm.Module {
+    const module = new llvm.Module('tiered', context);
+    module.setDataLayout(jit.getDataLayout());
+    module.setTargetTriple(jit.getTargetTriple());
+    const builder = new llvm.IRBuilder(context);
+    const i32Ty = builder.getInt32Ty();
+    // the sum of i * i for i below n
+    const funcType = llvm.FunctionType.get(i32Ty, [i32Ty], false);
+    const func = llvm.Function.Create(funcType, llvm.Function.LinkageTypes.ExternalLinkage, 'sumOfSquares', module);
+    const entry = llvm.BasicBlock.Create(context, 'entry', func);
+    const loop = llvm.BasicBlock.Create(context, 'loop', func);
+    const exit = llvm.BasicBlock.Create(context, 'exit', func);
+    builder.SetInsertPoint(entry);
+    builder.CreateBr(loop);
+    builder.SetInsertPoint(loop);
+    const i = builder.CreatePHI(i32Ty, 2);
+    const sum = builder.CreatePHI(i32Ty, 2);
+    const nextSum = builder.CreateAdd(sum, builder.CreateMul(i, i));
+    const next = builder.CreateAdd(i, builder.getInt32(1));
+    i.addIncoming(builder.getInt32(0), entry);
+    i.addIncoming(next, loop);
+    sum.addIncoming(builder.getInt32(0), entry);
+    sum.addIncoming(nextSum, loop);
+    builder.CreateCondBr(builder.CreateICmpSLT(next, func.getArg(0)), loop, exit);
+    builder.SetInsertPoint(exit);
+    builder.CreateRet(nextSum);
+    return module;
+}
+
+// Compares an eager JIT at CodeGenOpt.Aggressive with a tiered one, for the time to the first
+// result and for the calls once the tiered JIT has recompiled the function.
+export default function benchTiered(): void {
+    const filename = path.basename(__filename);
+    console.log(`${filename}: a loop of ${LoopCount} iterations, eager and tiered`);
+    const modes: [string, llvm.LLJITOptions][] = [['eager', { optLevel: llvm.CodeGenOpt.Aggressive }], ['tiered', { tiered: true }]];
+    for (const [mode, options] of modes) {
+        measure(`${mode} first result`, 5, () => {
+            const jit = new llvm.LLJIT(options);
+            jit.addModule(createModule(new llvm.LLVMContext(), jit));
+            const result = jit.getFunction('sumOfSquares', { result: 'i32', params: ['i32'] })(LoopCount);
+            jit.dispose();
+            return result;
+        });
+    }
+    for (const [mode, options] of modes) {
+        const jit = new llvm.LLJIT(options);
+        jit.addModule(createModule(new llvm.LLVMContext(), jit));
+        const sumOfSquares = jit.getFunction('sumOfSquares', { result: 'i32', params: ['i32'] });
+        // past the default threshold, then wait for the recompiled function to be swapped in
+        for (let n = 0; n < 1000; ++n) {
+            sumOfSquares(LoopCount);
+        }
+        jit.waitForTierUps();
+        measure(`${mode} steady state`, Iterations, () => sumOfSquares(LoopCount));
+        jit.dispose();
+    }
+}
@@ -0,0 +1,48 @@
+import path from 'path';
+import llvm from '..';
+import measure from './measure';
+
+const Iterations = 1000000;
+const MaxParams = 6;
+
+// Measures the cost of calling a JIT-compiled function from JS through its trampoline, for a
+// function summing 0 to MaxParams doubles.
+export default function benchTrampoline(): void {
+    const filename = path.basename(__filename);
+    const jit = new llvm.LLJIT();
+    const context = new llvm.LLVMContext();
+    const module = new llvm.Module(filename, context);
+    module.setDataLayout(jit.getDataLayout());
+    module.setTargetTriple(jit.getTargetTriple());
+    const builder = new llvm.IRBuilder(context);
+
+    const doubleTy = builder.getDoubleTy();
+    for (let count = 0; count <= MaxParams; ++count) {
+        const paramTypes: llvm.Type[] = [];
+        for (let i = 0; i < count; ++i) {
+            paramTypes.push(doubleTy);
+        }
+        const funcType = llvm.FunctionType.get(doubleTy, paramTypes, false);
+        const func = llvm.Function.Create(funcType, llvm.Function.LinkageTypes.ExternalLinkage, `sum${count}`, module);
+        builder.SetInsertPoint(llvm.BasicBlock.Create(context, 'entry', func));
+        let sum: llvm.Value = llvm.ConstantFP.get(doubleTy, 0);
+        for (let i = 0; i < count; ++i) {
+            sum = builder.CreateFAdd(sum, func.getArg(i));
+        }
+        builder.CreateRet(sum);
+    }
+    jit.addModule(module);
+
+    console.log(`${filename}: calling a native function with 0 to ${MaxParams} f64 arguments`);
+    const args = [1, 2, 3, 4, 5, 6];
+    for (let count = 0; count <= MaxParams; ++count) {
+        const params: llvm.NativeType[] = [];
+        for (let i = 0; i < count; ++i) {
+            params.push('f64');
+        }
+        const sum = jit.getFunction(`sum${count}`, { result: 'f64', params });
+        const callArgs = args.slice(0, count);
+        measure(`${count} arguments`, Iterations, () => sum(...callArgs));
+    }
+    jit.dispose();
+}
@@ -0,0 +1,120 @@
+import path from 'path';
+import llvm from '..';
+import measure from './measure';
+
+const Iterations = 200000;
+const Rounds = 10;
+const Copies = 20000;
+
+function pad(text: string, width: number): string {
+    while (text.length < width) {
+        text += ' ';
+    }
+    return text;
+}
+
+// Every round emits the instructions into a fresh context through emitBatch, which creates no wrappers, so that
+// wrapping them with BasicBlock.getInstructions always misses the wrapper cache and goes through Value::New.
+function measureFresh(label: string, prologue: number[], operation: number[]): void {
+    const words = prologue.slice();
+    for (let i = 0; i < Copies; ++i) {
+        words.push(...operation);
+    }
+    const program = new Int32Array(words);
+    const round = (): number => {
+        const context = new llvm.LLVMContext();
+        const module = new llvm.Module('fresh', context);
+        const builder = new llvm.IRBuilder(context);
+        const i32Ty = builder.getInt32Ty();
+        const doubleTy = builder.getDoubleTy();
+        const funcType = llvm.FunctionType.get(builder.getVoidTy(), [i32Ty, i32Ty, builder.getInt8PtrTy(), doubleTy], false);
+        const func = llvm.Function.Create(funcType, llvm.Function.LinkageTypes.ExternalLinkage, 'fresh', module);
+        const entryBB = llvm.BasicBlock.Create(context, 'entry', func);
+        builder.SetInsertPoint(entryBB);
+        builder.emitBatch(program, [func.getArg(0), func.getArg(1), func.getArg(2), func.getArg(3)],
+            [i32Ty, doubleTy, builder.getInt64Ty()]);
+        const start = process.hrtime();
+        const count = entryBB.getInstructions().length;
+        const [seconds, nanoseconds] = process.hrtime(start);
+        module.dispose();
+        return (seconds * 1e9 + nanoseconds) / count;
+    };
+    round();
+    let total = 0;
+    for (let i = 0; i < Rounds; ++i) {
+        total += round();
+    }
+    console.log(`${pad(label, 40)} ${(total / Rounds).toFixed(1)} ns/op`);
+}
+
+// Measures the cost of turning an llvm::Value into its JS wrapper, per opcode.
+// Every value is reached through User.getOperand, which goes through the
+// generic Value::New dispatch rather than a leaf constructor. Repeated calls
+// return the wrapper kept by the cache, so the Value::New dispatch itself is
+// measured on instructions that have never been wrapped.
+export default function benchWrapper(): void {
+    const filename = path.basename(__filename);
+    const context = new llvm.LLVMContext();
+    const module = new llvm.Module(filename, context);
+    const builder = new llvm.IRBuilder(context);
+
+    const i32Ty = builder.getInt32Ty();
+    const doubleTy = builder.getDoubleTy();
+    const ptrTy = builder.getInt8PtrTy();
+    const sinkType = llvm.FunctionType.get(builder.getVoidTy(), true);
+    const sink = llvm.Function.Create(sinkType, llvm.Function.LinkageTypes.ExternalLinkage, 'sink', module);
+    const funcType = llvm.FunctionType.get(builder.getVoidTy(), [i32Ty, i32Ty, ptrTy, doubleTy], false);
+    const func = llvm.Function.Create(funcType, llvm.Function.LinkageTypes.ExternalLinkage, 'bench', module);
+    const entryBB = llvm.BasicBlock.Create(context, 'entry', func);
+    builder.SetInsertPoint(entryBB);
+
+    const a = func.getArg(0);
+    const b = func.getArg(1);
+    const p = func.getArg(2);
+    const x = func.getArg(3);
+    const values: [string, llvm.Value][] = [
+        ['Argument', a],
+        ['ConstantInt', builder.getInt32(42)],
+        ['Function', sink],
+        ['alloca', builder.CreateAlloca(i32Ty)],
+        ['load', builder.CreateLoad(i32Ty, p)],
+        ['add', builder.CreateAdd(a, b)],
+        ['fneg', builder.CreateFNeg(x)],
+        ['icmp', builder.CreateICmpEQ(a, b)],
+        ['fcmp', builder.CreateFCmpOLT(x, x)],
+        ['getelementptr', builder.CreateGEP(i32Ty, p, [a])],
+        ['zext', builder.CreateZExt(a, builder.getInt64Ty())],
+        ['sitofp', builder.CreateSIToFP(a, doubleTy)],
+        ['ptrtoint', builder.CreatePtrToInt(p, builder.getInt64Ty())],
+        ['select', builder.CreateSelect(builder.CreateICmpSLT(a, b), a, b)]
+    ];
+    const users = values.map(([name, value]) => {
+        return [name, builder.CreateCall(sinkType, sink, [value])] as [string, llvm.CallInst];
+    });
+    builder.CreateRetVoid();
+
+    console.log(`${filename}: wrapping a value reached through User.getOperand, cache hits`);
+    for (const [name, user] of users) {
+        measure(name, Iterations, () => user.getOperand(0));
+    }
+    measure('ret (BasicBlock.getTerminator)', Iterations, () => entryBB.getTerminator());
+    measure('Type (Value.getType)', Iterations, () => a.getType());
+
+    // slots 0 to 3 are the arguments (i32, i32, ptr, double), types 0 to 2 are i32, double and i64
+    const { Alloca, Load, Add, FNeg, ICmp, FCmp, GEP, ZExt, SIToFP, PtrToInt, Select } = llvm.IRBuilder.BatchOp;
+    const { ICMP_EQ, ICMP_SLT } = llvm.ICmpInst.Predicate;
+    const { FCMP_OLT } = llvm.FCmpInst.Predicate;
+    console.log(`${filename}: wrapping ${Copies} instructions never wrapped before, in a fresh context per round`);
+    measureFresh('alloca', [], [Alloca, 0]);
+    measureFresh('load', [], [Load, 0, 2]);
+    measureFresh('add', [], [Add, 0, 1]);
+    measureFresh('fneg', [], [FNeg, 3]);
+    measureFresh('icmp', [], [ICmp, ICMP_EQ, 0, 1]);
+    measureFresh('fcmp', [], [FCmp, FCMP_OLT, 3, 3]);
+    measureFresh('getelementptr', [], [GEP, 0, 2, 1, 0]);
+    measureFresh('zext', [], [ZExt, 0, 2]);
+    measureFresh('sitofp', [], [SIToFP, 0, 1]);
+    measureFresh('ptrtoint', [], [PtrToInt, 2, 2]);
+    // slot 4 is the condition defined by the prologue
+    measureFresh('select', [ICmp, ICMP_SLT, 0, 1], [Select, 4, 0, 1]);
+}
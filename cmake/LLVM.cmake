@@ -13,4 +13,4 @@ include_directories(${LLVM_INCLUDE_DIRS})
 
 add_definitions(${LLVM_DEFINITIONS})
 
-llvm_map_components_to_libnames(LLVM_LIBS core codegen irreader linker support target ${LLVM_TARGETS_TO_BUILD})
+llvm_map_components_to_libnames(LLVM_LIBS core codegen irreader linker orcjit passes support target ${LLVM_TARGETS_TO_BUILD})
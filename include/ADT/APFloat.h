@@ -2,10 +2,11 @@
 
 #include <napi.h>
 #include <llvm/ADT/APFloat.h>
+#include "Util/AddonData.h"
 
 class APFloat : public Napi::ObjectWrap<APFloat> {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT;
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -2,10 +2,11 @@
 
 #include <napi.h>
 #include <llvm/ADT/APInt.h>
+#include "Util/AddonData.h"
 
 class APInt : public Napi::ObjectWrap<APInt> {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT;
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
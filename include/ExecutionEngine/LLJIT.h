@@ -0,0 +1,97 @@
+#pragma once
+
+#include <napi.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
+#include "ExecutionEngine/Speculation.h"
+#include "ExecutionEngine/TieredCompiler.h"
+#include "ExecutionEngine/Trampoline.h"
+#include "Util/ErrMsg.h"
+#include "Util/Dispose.h"
+#include "Util/AddonData.h"
+
+//===--------------------------------------------------------------------===//
+// In-process ORC JIT
+//
+// A module is added together with its LLVMContext, which becomes the
+// ThreadSafeContext of the module inside the JIT, so the context must not own
+// any other module. The Module and LLVMContext wrappers behave as disposed
+// afterwards, and the Value/Type wrappers of the context throw when used,
+// since the IR they point into now belongs to the JIT. Code is
+// compiled for the host when one of its symbols is first looked up, and
+// disposing the JIT frees it. The JS functions made by getFunction call the
+// code through a trampoline and throw once the JIT is disposed.
+//
+// A lazy JIT is an LLLazyJIT: every function of a module is compiled on its
+// first call through a stub, and with speculate the functions it calls are
+// compiled ahead on the compile threads. A tiered JIT compiles at
+// CodeGenOpt::None first and recompiles the hot functions in the background.
+//===--------------------------------------------------------------------===//
+
+class LLJIT : public Napi::ObjectWrap<LLJIT> {
+public:
+    static inline ConstructorReference constructor; // NOLINT
+
+    static void Init(Napi::Env env, Napi::Object &exports);
+
+    static bool IsClassOf(const Napi::Value &value);
+
+    static LLJIT *Extract(const Napi::Value &value);
+
+    explicit LLJIT(const Napi::CallbackInfo &info);
+
+    bool isDisposed();
+
+    llvm::orc::LLJIT *getLLVMPrimitive();
+
+    // the address of a symbol of the main JITDylib, compiling it if needed; throws a JS error if there is none
+    static uint64_t LookupAddress(Napi::Env env, llvm::orc::LLJIT &jit, const std::string &name);
+
+    // take a module and its context away from their wrappers, throws a JS error if the context owns other modules
+    static llvm::orc::ThreadSafeModule TakeModule(Napi::Env env, const Napi::Value &module);
+
+    // the ORC error as a JS error
+    static Napi::Error ToError(Napi::Env env, llvm::Error error);
+
+private:
+    // an LLLazyJIT when lazy
+    std::unique_ptr<llvm::orc::LLJIT> jit;
+
+    bool lazy = false;
+
+    std::shared_ptr<SpeculativeCompiler> speculator;
+
+    std::unique_ptr<TieredCompiler> tiered;
+
+    // one per name and signature, shared by the functions handed out for them and cleared on dispose
+    std::unordered_map<std::string, std::unique_ptr<Trampoline::CallTarget>> callTargets;
+
+    // the Trampoline::GetTypeKey of the functions defined by the modules added, which getFunction checks
+    // the signatures it is given against
+    std::unordered_map<std::string, std::string> typeKeys;
+
+    disposeGuardMacro(LLJIT)
+
+    void speculateBody(const std::string &name);
+
+    llvm::Error addIRModule(llvm::orc::ThreadSafeModule module);
+
+    void addModule(const Napi::CallbackInfo &info);
+
+    Napi::Value lookup(const Napi::CallbackInfo &info);
+
+    Napi::Value getFunction(const Napi::CallbackInfo &info);
+
+    Napi::Value getTier(const Napi::CallbackInfo &info);
+
+    void waitForTierUps(const Napi::CallbackInfo &info);
+
+    Napi::Value getTargetTriple(const Napi::CallbackInfo &info);
+
+    Napi::Value getDataLayout(const Napi::CallbackInfo &info);
+
+    void dispose(const Napi::CallbackInfo &info);
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+
+//===--------------------------------------------------------------------===//
+// Speculative compilation for the lazy LLJIT
+//
+// Every function a lazily added module defines is a candidate. When a
+// function is compiled, the candidates its body refers to are looked up in
+// the implementation JITDylib of the compile-on-demand layer, which compiles
+// them on the compile threads of the JIT before they are first called. Each
+// candidate is requested at most once.
+//===--------------------------------------------------------------------===//
+
+class SpeculativeCompiler {
+public:
+    explicit SpeculativeCompiler(llvm::orc::LLLazyJIT &jit);
+
+    // route the modules the JIT compiles through speculate()
+    static void Install(llvm::orc::LLLazyJIT &jit, std::shared_ptr<SpeculativeCompiler> speculator);
+
+    void addCandidates(const llvm::Module &module);
+
+    // request the candidates declared by a module being compiled
+    void speculate(const llvm::Module &module);
+
+    void request(const std::vector<std::string> &names);
+
+private:
+    llvm::orc::LLLazyJIT &jit;
+
+    std::mutex mutex;
+
+    std::unordered_set<std::string> candidates;
+};
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ExecutionEngine/Orc/IRCompileLayer.h>
+#include <llvm/ExecutionEngine/Orc/IndirectionUtils.h>
+#include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/Passes/OptimizationLevel.h>
+#include "Util/ThreadPool.h"
+
+//===--------------------------------------------------------------------===//
+// Tiered compilation for the LLJIT
+//
+// A module is compiled at once at CodeGenOpt::None, where instruction
+// selection goes through FastISel, after its local globals have been made
+// external and its bitcode kept aside. Every exported function is renamed
+// "<name>.tier0" and counts its calls, and "<name>" is an indirect stub
+// pointing at it, through which all the calls go. The call reaching the
+// threshold queues the function on a background thread, which rebuilds it
+// alone from the bitcode, with the rest of the module as declarations, runs
+// the default pipeline of the tier-up level on it, compiles it as
+// "<name>.tier1" and swaps the stub over. A function failing to tier up
+// keeps running its tier-0 code.
+//===--------------------------------------------------------------------===//
+
+class TieredCompiler {
+public:
+    struct Options {
+        uint64_t threshold = 1000;
+        llvm::OptimizationLevel level = llvm::OptimizationLevel::O3;
+    };
+
+    // optimizedBuilder is the machine builder of the tier-up code
+    TieredCompiler(llvm::orc::LLJIT &jit, llvm::orc::JITTargetMachineBuilder optimizedBuilder, const Options &options);
+
+    ~TieredCompiler();
+
+    TieredCompiler(const TieredCompiler &) = delete;
+
+    TieredCompiler &operator=(const TieredCompiler &) = delete;
+
+    // fails with a DuplicateDefinition, leaving the compiler untouched, if a function of the module is already tiered
+    llvm::Error addModule(llvm::orc::ThreadSafeModule module);
+
+    // 0 or 1, -1 for a name that is not a tiered function
+    int getTier(const std::string &name);
+
+    // block until no tier-up is queued or running
+    void wait();
+
+private:
+    struct FunctionTier {
+        TieredCompiler *compiler;
+        std::string name;
+        std::shared_ptr<const llvm::SmallVector<char, 0>> bitcode;
+        std::atomic<uint64_t> calls{0};
+        std::atomic<int> tier{0};
+    };
+
+    llvm::orc::LLJIT &jit;
+
+    llvm::orc::JITTargetMachineBuilder optimizedBuilder;
+
+    llvm::orc::IRCompileLayer optimizedLayer;
+
+    std::unique_ptr<llvm::orc::IndirectStubsManager> stubs;
+
+    Options options;
+
+    unsigned moduleCount = 0;
+
+    std::mutex mutex;
+
+    std::unordered_map<std::string, std::unique_ptr<FunctionTier>> functions;
+
+    std::condition_variable idle;
+
+    unsigned pending = 0;
+
+    // destroyed first, so that no tier-up outlives the rest
+    ThreadPool pool{1};
+
+    // called by the tier-0 code on the call reaching the threshold
+    static void OnHot(FunctionTier *function);
+
+    void instrument(llvm::Function &function, FunctionTier &tier);
+
+    llvm::Error tierUp(FunctionTier &function);
+};
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <napi.h>
+#include <string>
+#include <vector>
+
+namespace llvm {
+    class FunctionType;
+}
+
+//===--------------------------------------------------------------------===//
+// N-API entry points for calling native functions from JS
+//
+// A trampoline is a napi_callback generated as IR for one signature: it
+// unpacks the JS arguments with the N-API getters straight into the native
+// parameters, calls the function its data points at and boxes the result.
+// Trampolines are compiled once per signature by a JIT of their own, shared
+// by the process and never torn down, so they stay valid whatever happens to
+// the JIT holding the functions they call.
+//===--------------------------------------------------------------------===//
+
+namespace Trampoline {
+    enum class Kind {
+        Void,
+        Bool,
+        I32,
+        U32,
+        // from and to BigInt
+        I64,
+        U64,
+        F32,
+        F64,
+        // the data of a TypedArray or Buffer
+        Ptr
+    };
+
+    struct Signature {
+        Kind result = Kind::Void;
+        std::vector<Kind> params;
+        // the caller takes it upon itself that the symbol has the signature, which is not checked against its type
+        bool unchecked = false;
+
+        // false unless the value is { result?: NativeType, params?: NativeType[], unchecked?: boolean }
+        bool parse(const Napi::Value &value);
+
+        // like "f64(i32,ptr)"
+        std::string key() const;
+
+        // the IR types the function is called with, like "double(i32,ptr)", alike for i32 and u32
+        std::string typeKey() const;
+    };
+
+    // the typeKey of the signatures a function of the type can be called with, empty if it cannot be
+    std::string GetTypeKey(const llvm::FunctionType &type);
+
+    // what the data of a trampoline points at; the JIT owning the function clears the address when it is disposed,
+    // after which calls throw instead of jumping into freed code
+    struct CallTarget {
+        void *address;
+    };
+
+    // the trampoline for the signature, compiled on first use; throws a JS error if it cannot be compiled
+    napi_callback Get(Napi::Env env, const Signature &signature);
+}
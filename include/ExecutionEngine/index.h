@@ -0,0 +1,9 @@
+#pragma once
+
+#include <napi.h>
+#include "ExecutionEngine/LLJIT.h"
+#include "ExecutionEngine/Speculation.h"
+#include "ExecutionEngine/TieredCompiler.h"
+#include "ExecutionEngine/Trampoline.h"
+
+void InitExecutionEngine(Napi::Env env, Napi::Object &exports);
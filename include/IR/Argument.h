@@ -2,10 +2,12 @@
 
 #include <napi.h>
 #include <llvm/IR/Argument.h>
+#include "Util/AddonData.h"
+#include "Util/ContextOwned.h"
 
-class Argument : public Napi::ObjectWrap<Argument> {
+class Argument : public Napi::ObjectWrap<Argument>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -22,6 +24,8 @@ public:
 private:
     llvm::Argument *argument = nullptr;
 
+    ownedGuardMacro(Argument)
+
     Napi::Value getParent(const Napi::CallbackInfo &info);
 
     Napi::Value getArgNo(const Napi::CallbackInfo &info);
@@ -2,10 +2,11 @@
 
 #include <napi.h>
 #include <llvm/IR/Attributes.h>
+#include "Util/AddonData.h"
 
 class Attribute : public Napi::ObjectWrap<Attribute> {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
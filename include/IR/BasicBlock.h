@@ -2,10 +2,12 @@
 
 #include <napi.h>
 #include <llvm/IR/BasicBlock.h>
+#include "Util/AddonData.h"
+#include "Util/ContextOwned.h"
 
-class BasicBlock : public Napi::ObjectWrap<BasicBlock> {
+class BasicBlock : public Napi::ObjectWrap<BasicBlock>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -22,6 +24,8 @@ public:
 private:
     llvm::BasicBlock *basicBlock = nullptr;
 
+    ownedGuardMacro(BasicBlock)
+
     static Napi::Value Create(const Napi::CallbackInfo &info);
 
     Napi::Value getParent(const Napi::CallbackInfo &info);
@@ -32,6 +36,8 @@ private:
 
     Napi::Value getFirstNonPHI(const Napi::CallbackInfo &info);
 
+    Napi::Value getInstructions(const Napi::CallbackInfo &info);
+
     void insertInto(const Napi::CallbackInfo &info);
 
     void removeFromParent(const Napi::CallbackInfo &info);
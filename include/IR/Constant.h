@@ -2,10 +2,12 @@
 
 #include <napi.h>
 #include <llvm/IR/Constant.h>
+#include "Util/AddonData.h"
+#include "Util/ContextOwned.h"
 
-class Constant : public Napi::ObjectWrap<Constant> {
+class Constant : public Napi::ObjectWrap<Constant>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -22,6 +24,8 @@ public:
 private:
     llvm::Constant *constant = nullptr;
 
+    ownedGuardMacro(Constant)
+
     static Napi::Value getNullValue(const Napi::CallbackInfo &info);
 
     static Napi::Value getAllOnesValue(const Napi::CallbackInfo &info);
@@ -2,10 +2,12 @@
 
 #include <napi.h>
 #include <llvm/IR/Constants.h>
+#include "Util/AddonData.h"
+#include "Util/ContextOwned.h"
 
-class ConstantInt : public Napi::ObjectWrap<ConstantInt> {
+class ConstantInt : public Napi::ObjectWrap<ConstantInt>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -22,14 +24,16 @@ public:
 private:
     llvm::ConstantInt *constantInt = nullptr;
 
+    ownedGuardMacro(ConstantInt)
+
     static Napi::Value get(const Napi::CallbackInfo &info);
 
     Napi::Value getType(const Napi::CallbackInfo &info);
 };
 
-class ConstantFP : public Napi::ObjectWrap<ConstantFP> {
+class ConstantFP : public Napi::ObjectWrap<ConstantFP>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -46,6 +50,8 @@ public:
 private:
     llvm::ConstantFP *constantFP = nullptr;
 
+    ownedGuardMacro(ConstantFP)
+
     static Napi::Value get(const Napi::CallbackInfo &info);
 
     static Napi::Value getNaN(const Napi::CallbackInfo &info);
@@ -53,9 +59,9 @@ private:
     Napi::Value getType(const Napi::CallbackInfo &info);
 };
 
-class ConstantArray : public Napi::ObjectWrap<ConstantArray> {
+class ConstantArray : public Napi::ObjectWrap<ConstantArray>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -72,14 +78,16 @@ public:
 private:
     llvm::ConstantArray *constantArray = nullptr;
 
+    ownedGuardMacro(ConstantArray)
+
     static Napi::Value get(const Napi::CallbackInfo &info);
 
     Napi::Value getType(const Napi::CallbackInfo &info);
 };
 
-class ConstantStruct : public Napi::ObjectWrap<ConstantStruct> {
+class ConstantStruct : public Napi::ObjectWrap<ConstantStruct>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -96,14 +104,16 @@ public:
 private:
     llvm::ConstantStruct *constantStruct = nullptr;
 
+    ownedGuardMacro(ConstantStruct)
+
     static Napi::Value get(const Napi::CallbackInfo &info);
 
     Napi::Value getType(const Napi::CallbackInfo &info);
 };
 
-class ConstantPointerNull : public Napi::ObjectWrap<ConstantPointerNull> {
+class ConstantPointerNull : public Napi::ObjectWrap<ConstantPointerNull>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -120,14 +130,16 @@ public:
 private:
     llvm::ConstantPointerNull *constantPointerNull = nullptr;
 
+    ownedGuardMacro(ConstantPointerNull)
+
     static Napi::Value get(const Napi::CallbackInfo &info);
 
     Napi::Value getType(const Napi::CallbackInfo &info);
 };
 
-class ConstantDataArray : public Napi::ObjectWrap<ConstantDataArray> {
+class ConstantDataArray : public Napi::ObjectWrap<ConstantDataArray>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -144,6 +156,8 @@ public:
 private:
     llvm::ConstantDataArray *constantDataArray = nullptr;
 
+    ownedGuardMacro(ConstantDataArray)
+
     static Napi::Value get(const Napi::CallbackInfo &info);
 
     static Napi::Value getString(const Napi::CallbackInfo &info);
@@ -151,9 +165,35 @@ private:
     Napi::Value getType(const Napi::CallbackInfo &info);
 };
 
-class ConstantExpr : public Napi::ObjectWrap<ConstantExpr> {
+class ConstantDataVector : public Napi::ObjectWrap<ConstantDataVector>, public ContextOwned {
+public:
+    static inline ConstructorReference constructor; // NOLINT
+
+    static void Init(Napi::Env env, Napi::Object &exports);
+
+    static Napi::Object New(Napi::Env env, llvm::ConstantDataVector *constantDataVector);
+
+    static bool IsClassOf(const Napi::Value &value);
+
+    static llvm::ConstantDataVector *Extract(const Napi::Value &value);
+
+    explicit ConstantDataVector(const Napi::CallbackInfo &info);
+
+    llvm::ConstantDataVector *getLLVMPrimitive();
+
+private:
+    llvm::ConstantDataVector *constantDataVector = nullptr;
+
+    ownedGuardMacro(ConstantDataVector)
+
+    static Napi::Value get(const Napi::CallbackInfo &info);
+
+    Napi::Value getType(const Napi::CallbackInfo &info);
+};
+
+class ConstantExpr : public Napi::ObjectWrap<ConstantExpr>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -170,6 +210,8 @@ public:
 private:
     llvm::ConstantExpr *constantExpr = nullptr;
 
+    ownedGuardMacro(ConstantExpr)
+
     static Napi::Value getAlignOf(const Napi::CallbackInfo& info);
 
     static Napi::Value getSizeOf(const Napi::CallbackInfo& info);
@@ -225,9 +267,9 @@ private:
     Napi::Value getType(const Napi::CallbackInfo &info);
 };
 
-class UndefValue : public Napi::ObjectWrap<UndefValue> {
+class UndefValue : public Napi::ObjectWrap<UndefValue>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -244,6 +286,8 @@ public:
 private:
     llvm::UndefValue *undefValue = nullptr;
 
+    ownedGuardMacro(UndefValue)
+
     static Napi::Value get(const Napi::CallbackInfo &info);
 
     Napi::Value getType(const Napi::CallbackInfo &info);
@@ -2,10 +2,11 @@
 
 #include <napi.h>
 #include <llvm/IR/DIBuilder.h>
+#include "Util/AddonData.h"
 
 class DIBuilder : public Napi::ObjectWrap<DIBuilder> {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -2,10 +2,11 @@
 
 #include <napi.h>
 #include <llvm/IR/DataLayout.h>
+#include "Util/AddonData.h"
 
 class DataLayout : public Napi::ObjectWrap<DataLayout> {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -17,11 +18,16 @@ public:
 
     explicit DataLayout(const Napi::CallbackInfo &info);
 
+    ~DataLayout() override;
+
     llvm::DataLayout &getLLVMPrimitive();
 
 private:
     llvm::DataLayout *dataLayout = nullptr;
 
+    // false when borrowed from a module
+    bool owned = false;
+
     Napi::Value getStringRepresentation(const Napi::CallbackInfo &info);
 
     Napi::Value getTypeAllocSize(const Napi::CallbackInfo &info);
@@ -2,10 +2,12 @@
 
 #include <napi.h>
 #include <llvm/IR/DebugInfoMetadata.h>
+#include "Util/AddonData.h"
+#include "Util/HierarchyWrapper.h"
 
 class DITypeRefArray : public Napi::ObjectWrap<DITypeRefArray> {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -23,9 +25,9 @@ private:
     llvm::DITypeRefArray *array = nullptr;
 };
 
-class DINode : public Napi::ObjectWrap<DINode> {
+class DINode : public Napi::ObjectWrap<DINode>, public HierarchyWrapper {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -43,9 +45,9 @@ private:
     llvm::DINode *node = nullptr;
 };
 
-class DIScope : public Napi::ObjectWrap<DIScope> {
+class DIScope : public Napi::ObjectWrap<DIScope>, public HierarchyWrapper {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -63,9 +65,9 @@ private:
     llvm::DIScope *scope = nullptr;
 };
 
-class DIFile : public Napi::ObjectWrap<DIFile> {
+class DIFile : public Napi::ObjectWrap<DIFile>, public HierarchyWrapper {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -83,9 +85,9 @@ private:
     llvm::DIFile *file = nullptr;
 };
 
-class DIType : public Napi::ObjectWrap<DIType> {
+class DIType : public Napi::ObjectWrap<DIType>, public HierarchyWrapper {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -103,9 +105,9 @@ private:
     llvm::DIType *type = nullptr;
 };
 
-class DIBasicType : public Napi::ObjectWrap<DIBasicType> {
+class DIBasicType : public Napi::ObjectWrap<DIBasicType>, public HierarchyWrapper {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -123,9 +125,9 @@ private:
     llvm::DIBasicType *type = nullptr;
 };
 
-class DIDerivedType : public Napi::ObjectWrap<DIDerivedType> {
+class DIDerivedType : public Napi::ObjectWrap<DIDerivedType>, public HierarchyWrapper {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -143,9 +145,9 @@ private:
     llvm::DIDerivedType *type = nullptr;
 };
 
-class DICompositeType : public Napi::ObjectWrap<DICompositeType> {
+class DICompositeType : public Napi::ObjectWrap<DICompositeType>, public HierarchyWrapper {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -163,9 +165,9 @@ private:
     llvm::DICompositeType *type = nullptr;
 };
 
-class DISubroutineType : public Napi::ObjectWrap<DISubroutineType> {
+class DISubroutineType : public Napi::ObjectWrap<DISubroutineType>, public HierarchyWrapper {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -183,9 +185,9 @@ private:
     llvm::DISubroutineType *type = nullptr;
 };
 
-class DICompileUnit : public Napi::ObjectWrap<DICompileUnit> {
+class DICompileUnit : public Napi::ObjectWrap<DICompileUnit>, public HierarchyWrapper {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -205,9 +207,9 @@ private:
     Napi::Value getFile(const Napi::CallbackInfo &info);
 };
 
-class DILocalScope : public Napi::ObjectWrap<DILocalScope> {
+class DILocalScope : public Napi::ObjectWrap<DILocalScope>, public HierarchyWrapper {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -225,9 +227,9 @@ private:
     llvm::DILocalScope *scope = nullptr;
 };
 
-class DILocation : public Napi::ObjectWrap<DILocation> {
+class DILocation : public Napi::ObjectWrap<DILocation>, public HierarchyWrapper {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -247,9 +249,9 @@ private:
     static Napi::Value get(const Napi::CallbackInfo &info);
 };
 
-class DISubprogram : public Napi::ObjectWrap<DISubprogram> {
+class DISubprogram : public Napi::ObjectWrap<DISubprogram>, public HierarchyWrapper {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -267,9 +269,9 @@ private:
     llvm::DISubprogram *subprogram = nullptr;
 };
 
-class DILexicalBlock : public Napi::ObjectWrap<DILexicalBlock> {
+class DILexicalBlock : public Napi::ObjectWrap<DILexicalBlock>, public HierarchyWrapper {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -287,9 +289,9 @@ private:
     llvm::DILexicalBlock *block = nullptr;
 };
 
-class DINamespace : public Napi::ObjectWrap<DINamespace> {
+class DINamespace : public Napi::ObjectWrap<DINamespace>, public HierarchyWrapper {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -307,9 +309,9 @@ private:
     llvm::DINamespace *ns = nullptr;
 };
 
-class DIVariable : public Napi::ObjectWrap<DIVariable> {
+class DIVariable : public Napi::ObjectWrap<DIVariable>, public HierarchyWrapper {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -327,9 +329,9 @@ private:
     llvm::DIVariable *variable = nullptr;
 };
 
-class DIExpression : public Napi::ObjectWrap<DIExpression> {
+class DIExpression : public Napi::ObjectWrap<DIExpression>, public HierarchyWrapper {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -347,9 +349,9 @@ private:
     llvm::DIExpression *expression = nullptr;
 };
 
-class DIGlobalVariable : public Napi::ObjectWrap<DIGlobalVariable> {
+class DIGlobalVariable : public Napi::ObjectWrap<DIGlobalVariable>, public HierarchyWrapper {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -367,9 +369,9 @@ private:
     llvm::DIGlobalVariable *variable = nullptr;
 };
 
-class DILocalVariable : public Napi::ObjectWrap<DILocalVariable> {
+class DILocalVariable : public Napi::ObjectWrap<DILocalVariable>, public HierarchyWrapper {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -387,9 +389,9 @@ private:
     llvm::DILocalVariable *variable = nullptr;
 };
 
-class DIGlobalVariableExpression : public Napi::ObjectWrap<DIGlobalVariableExpression> {
+class DIGlobalVariableExpression : public Napi::ObjectWrap<DIGlobalVariableExpression>, public HierarchyWrapper {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -2,10 +2,12 @@
 
 #include <napi.h>
 #include <llvm/IR/DerivedTypes.h>
+#include "Util/AddonData.h"
+#include "Util/ContextOwned.h"
 
-class IntegerType : public Napi::ObjectWrap<IntegerType> {
+class IntegerType : public Napi::ObjectWrap<IntegerType>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT;
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -22,6 +24,8 @@ public:
 private:
     llvm::IntegerType *integerType = nullptr;
 
+    ownedGuardMacro(IntegerType)
+
     static Napi::Value get(const Napi::CallbackInfo &info);
 
     Napi::Value isStructTy(const Napi::CallbackInfo &info);
@@ -33,9 +37,9 @@ private:
     Napi::Value getTypeID(const Napi::CallbackInfo &info);
 };
 
-class FunctionType : public Napi::ObjectWrap<FunctionType> {
+class FunctionType : public Napi::ObjectWrap<FunctionType>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT;
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -52,6 +56,8 @@ public:
 private:
     llvm::FunctionType *functionType = nullptr;
 
+    ownedGuardMacro(FunctionType)
+
     static Napi::Value get(const Napi::CallbackInfo &info);
 
     Napi::Value isVoidTy(const Napi::CallbackInfo &info);
@@ -61,7 +67,7 @@ private:
 
 class FunctionCallee : public Napi::ObjectWrap<FunctionCallee> {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -76,8 +82,6 @@ public:
     llvm::FunctionCallee getLLVMPrimitive();
 
 private:
-    static inline llvm::FunctionCallee tmpCallee; // tmp in static-new
-
     llvm::FunctionCallee callee;
 
     Napi::Value getFunctionType(const Napi::CallbackInfo &info);
@@ -85,9 +89,9 @@ private:
     Napi::Value getCallee(const Napi::CallbackInfo &info);
 };
 
-class StructType : public Napi::ObjectWrap<StructType> {
+class StructType : public Napi::ObjectWrap<StructType>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT;
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -104,6 +108,8 @@ public:
 private:
     llvm::StructType *structType = nullptr;
 
+    ownedGuardMacro(StructType)
+
     static Napi::Value create(const Napi::CallbackInfo &info);
 
     static Napi::Value get(const Napi::CallbackInfo &info);
@@ -135,9 +141,9 @@ private:
     Napi::Value getTypeID(const Napi::CallbackInfo &info);
 };
 
-class ArrayType : public Napi::ObjectWrap<ArrayType> {
+class ArrayType : public Napi::ObjectWrap<ArrayType>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT;
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -154,6 +160,8 @@ public:
 private:
     llvm::ArrayType *arrayType = nullptr;
 
+    ownedGuardMacro(ArrayType)
+
     static Napi::Value get(const Napi::CallbackInfo &info);
 
     static Napi::Value isValidElementType(const Napi::CallbackInfo &info);
@@ -169,9 +177,9 @@ private:
     Napi::Value getTypeID(const Napi::CallbackInfo &info);
 };
 
-class VectorType : public Napi::ObjectWrap<VectorType> {
+class VectorType : public Napi::ObjectWrap<VectorType>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT;
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -188,6 +196,8 @@ public:
 private:
     llvm::VectorType *vectorType = nullptr;
 
+    ownedGuardMacro(VectorType)
+
     Napi::Value isStructTy(const Napi::CallbackInfo &info);
 
     Napi::Value isVoidTy(const Napi::CallbackInfo &info);
@@ -195,9 +205,9 @@ private:
     Napi::Value getTypeID(const Napi::CallbackInfo &info);
 };
 
-class PointerType : public Napi::ObjectWrap<PointerType> {
+class PointerType : public Napi::ObjectWrap<PointerType>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT;
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -214,6 +224,8 @@ public:
 private:
     llvm::PointerType *pointerType = nullptr;
 
+    ownedGuardMacro(PointerType)
+
     static Napi::Value get(const Napi::CallbackInfo &info);
 
     static Napi::Value getUnqual(const Napi::CallbackInfo &info);
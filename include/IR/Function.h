@@ -2,10 +2,12 @@
 
 #include <napi.h>
 #include <llvm/IR/Function.h>
+#include "Util/AddonData.h"
+#include "Util/ContextOwned.h"
 
-class Function : public Napi::ObjectWrap<Function> {
+class Function : public Napi::ObjectWrap<Function>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -38,18 +40,24 @@ public:
 private:
     llvm::Function *function = nullptr;
 
+    ownedGuardMacro(Function)
+
     static Napi::Value Create(const Napi::CallbackInfo &info);
 
     Napi::Value argSize(const Napi::CallbackInfo &info);
 
     Napi::Value getArg(const Napi::CallbackInfo &info);
 
+    Napi::Value getArguments(const Napi::CallbackInfo &info);
+
     Napi::Value getReturnType(const Napi::CallbackInfo &info);
 
     void addBasicBlock(const Napi::CallbackInfo &info);
 
     Napi::Value getEntryBlock(const Napi::CallbackInfo &info);
 
+    Napi::Value getBasicBlocks(const Napi::CallbackInfo &info);
+
     Napi::Value getExitBlock(const Napi::CallbackInfo &info);
 
     void insertAfter(const Napi::CallbackInfo &info);
@@ -2,10 +2,12 @@
 
 #include <napi.h>
 #include <llvm/IR/GlobalValue.h>
+#include "Util/AddonData.h"
+#include "Util/ContextOwned.h"
 
-class GlobalValue : public Napi::ObjectWrap<GlobalValue> {
+class GlobalValue : public Napi::ObjectWrap<GlobalValue>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -22,6 +24,8 @@ public:
 private:
     llvm::GlobalValue *globalValue = nullptr;
 
+    ownedGuardMacro(GlobalValue)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     Napi::Value getValueType(const Napi::CallbackInfo &info);
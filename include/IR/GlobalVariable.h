@@ -2,10 +2,12 @@
 
 #include <napi.h>
 #include <llvm/IR/GlobalVariable.h>
+#include "Util/AddonData.h"
+#include "Util/ContextOwned.h"
 
-class GlobalVariable : public Napi::ObjectWrap<GlobalVariable> {
+class GlobalVariable : public Napi::ObjectWrap<GlobalVariable>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -22,6 +24,8 @@ public:
 private:
     llvm::GlobalVariable *globalVariable = nullptr;
 
+    ownedGuardMacro(GlobalVariable)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     Napi::Value getValueType(const Napi::CallbackInfo &info);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <napi.h>
+#include <vector>
 #include <llvm/IR/IRBuilder.h>
 #include "IR/index.h"
 #include "Util/index.h"
@@ -47,7 +48,8 @@ Napi::Value unOpFactory(const Napi::CallbackInfo &info) { \
     throw Napi::TypeError::New(env, ErrMsg::Class::IRBuilder::CreateUnOpFactory); \
 }
 
-typedef llvm::IRBuilder<> LLVMIRBuilder;
+// instructions are reported to the wrapper as they are inserted, to account for the growth of their module
+typedef llvm::IRBuilder<llvm::ConstantFolder, llvm::IRBuilderCallbackInserter> LLVMIRBuilder;
 
 typedef llvm::Value *(llvm::IRBuilderBase::*UnaryOperation)(llvm::Value *, const llvm::Twine &);
 
@@ -79,9 +81,50 @@ typedef llvm::Type *(llvm::IRBuilderBase::*GetType)();
 
 typedef llvm::Value *(llvm::IRBuilderBase::*CreateCast)(llvm::Value *, llvm::Type *, const llvm::Twine &name);
 
+//===--------------------------------------------------------------------===//
+// Operations of IRBuilder.emitBatch
+//
+// An operation is its opcode followed by its operands, one int32 each:
+// "value"/"block" operands are slot indices, "type" operands index the type
+// table, "n" is the count of the operands which follow it. Every operation
+// defines the next slot, holding null when it does not produce a value.
+//===--------------------------------------------------------------------===//
+
+namespace BatchOp {
+    enum : int32_t {
+        SetInsertPoint = 0, // block
+        ConstInt,           // type, value (sign-extended)
+        // binary operators: lhs, rhs
+        Add, FAdd, Sub, FSub, Mul, FMul, UDiv, SDiv, FDiv, URem, SRem, FRem,
+        Shl, LShr, AShr, And, Or, Xor,
+        // unary operators: value
+        Neg, FNeg, Not,
+        ICmp,               // predicate, lhs, rhs
+        FCmp,               // predicate, lhs, rhs
+        // casts: value, type
+        Trunc, ZExt, SExt, FPToUI, FPToSI, UIToFP, SIToFP, FPTrunc, FPExt, PtrToInt, IntToPtr, BitCast,
+        Alloca,             // type
+        Load,               // type, ptr
+        Store,              // value, ptr
+        GEP,                // type, ptr, n, indices...
+        InBoundsGEP,        // type, ptr, n, indices...
+        Call,               // function type, callee, n, args...
+        Select,             // cond, trueValue, falseValue
+        PHI,                // type, n, (value, block)...
+        AddIncoming,        // phi, value, block
+        Ret,                // value
+        RetVoid,            //
+        Br,                 // block
+        CondBr,             // cond, trueBlock, falseBlock
+        Unreachable,        //
+        ConstInt64,         // type, low, high (the 32-bit halves of the value)
+        OpCount
+    };
+}
+
 class IRBuilder : public Napi::ObjectWrap<IRBuilder> {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -91,11 +134,41 @@ public:
 
     explicit IRBuilder(const Napi::CallbackInfo &info);
 
+    ~IRBuilder() override;
+
     LLVMIRBuilder *getLLVMPrimitive();
 
+    bool isDisposed();
+
 private:
     LLVMIRBuilder *builder = nullptr;
 
+    // the object the builder has been created from, which must outlive it
+    Napi::ObjectReference ownerRef;
+
+    // the context of the builder, checked for asynchronous operations before every call
+    LLVMContext *context = nullptr;
+    Napi::ObjectReference contextRef;
+
+    // bytes of IR inserted into growingModule that its wrapper has not been told about yet
+    const llvm::Module *growingModule = nullptr;
+    int64_t pendingGrowth = 0;
+
+    // the instructions inserted by the running emitBatch, erased if it fails
+    std::vector<llvm::Instruction *> *batchInserted = nullptr;
+
+    bool isLocked();
+
+    LLVMIRBuilder *createBuilder(llvm::LLVMContext &llvmContext);
+
+    void noteInserted(llvm::Instruction *inst);
+
+    void flushGrowth();
+
+    contextGuardMacro(IRBuilder)
+
+    void dispose(const Napi::CallbackInfo &info);
+
     //===--------------------------------------------------------------------===//
     // Builder configuration methods
     //===--------------------------------------------------------------------===//
@@ -110,7 +183,7 @@ private:
 
     class InsertPoint : public Napi::ObjectWrap<InsertPoint> {
     public:
-        static inline Napi::FunctionReference constructor; // NOLINT
+        static inline ConstructorReference constructor; // NOLINT
 
         static Napi::Function Init(Napi::Env env, Napi::Object &exports);
 
@@ -125,8 +198,6 @@ private:
         llvm::IRBuilderBase::InsertPoint getLLVMPrimitive();
 
     private:
-        static inline llvm::IRBuilderBase::InsertPoint tmpInsertPoint; // tmp in static-new
-
         llvm::IRBuilderBase::InsertPoint insertPoint;
     };
 
@@ -277,4 +348,10 @@ private:
     //===--------------------------------------------------------------------===//
 
     Napi::Value CreatePtrDiff(const Napi::CallbackInfo &info);
+
+    //===--------------------------------------------------------------------===//
+    // Batched emission
+    //===--------------------------------------------------------------------===//
+
+    Napi::Value emitBatch(const Napi::CallbackInfo &info);
 };
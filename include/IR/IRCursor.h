@@ -0,0 +1,84 @@
+#pragma once
+
+#include <napi.h>
+#include <llvm/IR/Module.h>
+#include "Util/ErrMsg.h"
+#include "Util/Dispose.h"
+#include "Util/AddonData.h"
+
+class Module;
+
+//===--------------------------------------------------------------------===//
+// A cursor walking the functions, basic blocks and instructions of a module
+//
+// The position is kept natively and the accessors describe the innermost
+// entity the cursor points at, so a scan does not create a wrapper per
+// element. The module must not be modified while it is being walked.
+//===--------------------------------------------------------------------===//
+
+class IRCursor : public Napi::ObjectWrap<IRCursor> {
+public:
+    static inline ConstructorReference constructor; // NOLINT
+
+    static void Init(Napi::Env env, Napi::Object &exports);
+
+    static Napi::Object New(Napi::Env env, const Napi::Object &module);
+
+    static bool IsClassOf(const Napi::Value &value);
+
+    explicit IRCursor(const Napi::CallbackInfo &info);
+
+private:
+    // keeps the module alive as long as the cursor
+    Napi::ObjectReference moduleRef;
+    Module *wrapper = nullptr;
+
+    llvm::Function *function = nullptr;
+    llvm::BasicBlock *basicBlock = nullptr;
+    llvm::Instruction *instruction = nullptr;
+
+    // set once a level has run past its last element, so that it does not start over
+    bool functionsDone = false;
+    bool basicBlocksDone = false;
+    bool instructionsDone = false;
+
+    bool isDisposed();
+
+    bool isLocked();
+
+    contextGuardMacro(IRCursor)
+
+    bool stepFunction();
+
+    bool stepBasicBlock();
+
+    bool stepInstruction();
+
+    llvm::Value *current(Napi::Env env);
+
+    Napi::Value next(const Napi::CallbackInfo &info);
+
+    Napi::Value nextFunction(const Napi::CallbackInfo &info);
+
+    Napi::Value nextBasicBlock(const Napi::CallbackInfo &info);
+
+    Napi::Value nextInstruction(const Napi::CallbackInfo &info);
+
+    void reset(const Napi::CallbackInfo &info);
+
+    Napi::Value getOpcode(const Napi::CallbackInfo &info);
+
+    Napi::Value getOpcodeName(const Napi::CallbackInfo &info);
+
+    Napi::Value getNumOperands(const Napi::CallbackInfo &info);
+
+    Napi::Value getTypeID(const Napi::CallbackInfo &info);
+
+    Napi::Value getName(const Napi::CallbackInfo &info);
+
+    Napi::Value getFunction(const Napi::CallbackInfo &info);
+
+    Napi::Value getBasicBlock(const Napi::CallbackInfo &info);
+
+    Napi::Value getInstruction(const Napi::CallbackInfo &info);
+};
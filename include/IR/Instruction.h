@@ -2,10 +2,12 @@
 
 #include <napi.h>
 #include <llvm/IR/Instruction.h>
+#include "Util/AddonData.h"
+#include "Util/ContextOwned.h"
 
-class Instruction : public Napi::ObjectWrap<Instruction> {
+class Instruction : public Napi::ObjectWrap<Instruction>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -22,6 +24,8 @@ public:
 private:
     llvm::Instruction *inst = nullptr;
 
+    ownedGuardMacro(Instruction)
+
     Napi::Value userBack(const Napi::CallbackInfo &info);
 
     Napi::Value getParent(const Napi::CallbackInfo &info);
@@ -2,10 +2,12 @@
 
 #include <napi.h>
 #include <llvm/IR/Instructions.h>
+#include "Util/AddonData.h"
+#include "Util/ContextOwned.h"
 
-class AllocaInst : public Napi::ObjectWrap<AllocaInst> {
+class AllocaInst : public Napi::ObjectWrap<AllocaInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -22,6 +24,8 @@ public:
 private:
     llvm::AllocaInst *allocaInst = nullptr;
 
+    ownedGuardMacro(AllocaInst)
+
     Napi::Value getAllocatedType(const Napi::CallbackInfo &info);
 
     Napi::Value getArraySize(const Napi::CallbackInfo &info);
@@ -31,9 +35,9 @@ private:
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class LoadInst : public Napi::ObjectWrap<LoadInst> {
+class LoadInst : public Napi::ObjectWrap<LoadInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -50,14 +54,16 @@ public:
 private:
     llvm::LoadInst *loadInst = nullptr;
 
+    ownedGuardMacro(LoadInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class StoreInst : public Napi::ObjectWrap<StoreInst> {
+class StoreInst : public Napi::ObjectWrap<StoreInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -74,6 +80,8 @@ public:
 private:
     llvm::StoreInst *storeInst = nullptr;
 
+    ownedGuardMacro(StoreInst)
+
     Napi::Value getValueOperand(const Napi::CallbackInfo &info);
 
     Napi::Value getPointerOperand(const Napi::CallbackInfo &info);
@@ -85,9 +93,9 @@ private:
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class FenceInst : public Napi::ObjectWrap<FenceInst> {
+class FenceInst : public Napi::ObjectWrap<FenceInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -104,14 +112,16 @@ public:
 private:
     llvm::FenceInst *fenceInst = nullptr;
 
+    ownedGuardMacro(FenceInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class AtomicCmpXchgInst : public Napi::ObjectWrap<AtomicCmpXchgInst> {
+class AtomicCmpXchgInst : public Napi::ObjectWrap<AtomicCmpXchgInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -128,14 +138,16 @@ public:
 private:
     llvm::AtomicCmpXchgInst *atomicCmpXchgInst = nullptr;
 
+    ownedGuardMacro(AtomicCmpXchgInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class AtomicRMWInst : public Napi::ObjectWrap<AtomicRMWInst> {
+class AtomicRMWInst : public Napi::ObjectWrap<AtomicRMWInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -152,14 +164,16 @@ public:
 private:
     llvm::AtomicRMWInst *atomicRMWInst = nullptr;
 
+    ownedGuardMacro(AtomicRMWInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class GetElementPtrInst : public Napi::ObjectWrap<GetElementPtrInst> {
+class GetElementPtrInst : public Napi::ObjectWrap<GetElementPtrInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -176,14 +190,16 @@ public:
 private:
     llvm::GetElementPtrInst *gepInst = nullptr;
 
+    ownedGuardMacro(GetElementPtrInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class ICmpInst : public Napi::ObjectWrap<ICmpInst> {
+class ICmpInst : public Napi::ObjectWrap<ICmpInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -200,14 +216,16 @@ public:
 private:
     llvm::ICmpInst *icmpInst = nullptr;
 
+    ownedGuardMacro(ICmpInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class FCmpInst : public Napi::ObjectWrap<FCmpInst> {
+class FCmpInst : public Napi::ObjectWrap<FCmpInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -224,14 +242,16 @@ public:
 private:
     llvm::FCmpInst *fcmpInst = nullptr;
 
+    ownedGuardMacro(FCmpInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class CallInst : public Napi::ObjectWrap<CallInst> {
+class CallInst : public Napi::ObjectWrap<CallInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -248,14 +268,16 @@ public:
 private:
     llvm::CallInst *callInst = nullptr;
 
+    ownedGuardMacro(CallInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class SelectInst : public Napi::ObjectWrap<SelectInst> {
+class SelectInst : public Napi::ObjectWrap<SelectInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -272,6 +294,8 @@ public:
 private:
     llvm::SelectInst *selectInst = nullptr;
 
+    ownedGuardMacro(SelectInst)
+
     Napi::Value getCondition(const Napi::CallbackInfo &info);
 
     Napi::Value getTrueValue(const Napi::CallbackInfo &info);
@@ -289,9 +313,9 @@ private:
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class VAArgInst : public Napi::ObjectWrap<VAArgInst> {
+class VAArgInst : public Napi::ObjectWrap<VAArgInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -308,14 +332,16 @@ public:
 private:
     llvm::VAArgInst *vaArgInst = nullptr;
 
+    ownedGuardMacro(VAArgInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class ExtractElementInst : public Napi::ObjectWrap<ExtractElementInst> {
+class ExtractElementInst : public Napi::ObjectWrap<ExtractElementInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -332,14 +358,16 @@ public:
 private:
     llvm::ExtractElementInst *extractElementInst = nullptr;
 
+    ownedGuardMacro(ExtractElementInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class InsertElementInst : public Napi::ObjectWrap<InsertElementInst> {
+class InsertElementInst : public Napi::ObjectWrap<InsertElementInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -356,14 +384,16 @@ public:
 private:
     llvm::InsertElementInst *insertElementInst = nullptr;
 
+    ownedGuardMacro(InsertElementInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class ShuffleVectorInst : public Napi::ObjectWrap<ShuffleVectorInst> {
+class ShuffleVectorInst : public Napi::ObjectWrap<ShuffleVectorInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -380,14 +410,16 @@ public:
 private:
     llvm::ShuffleVectorInst *shuffleVectorInst = nullptr;
 
+    ownedGuardMacro(ShuffleVectorInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class ExtractValueInst : public Napi::ObjectWrap<ExtractValueInst> {
+class ExtractValueInst : public Napi::ObjectWrap<ExtractValueInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -404,14 +436,16 @@ public:
 private:
     llvm::ExtractValueInst *extractValueInst = nullptr;
 
+    ownedGuardMacro(ExtractValueInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class InsertValueInst : public Napi::ObjectWrap<InsertValueInst> {
+class InsertValueInst : public Napi::ObjectWrap<InsertValueInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -428,14 +462,16 @@ public:
 private:
     llvm::InsertValueInst *insertValueInst = nullptr;
 
+    ownedGuardMacro(InsertValueInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class PHINode : public Napi::ObjectWrap<PHINode> {
+class PHINode : public Napi::ObjectWrap<PHINode>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -452,6 +488,8 @@ public:
 private:
     llvm::PHINode *phiNode = nullptr;
 
+    ownedGuardMacro(PHINode)
+
     void addIncoming(const Napi::CallbackInfo &info);
 
     Napi::Value getType(const Napi::CallbackInfo &info);
@@ -459,9 +497,9 @@ private:
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class LandingPadInst : public Napi::ObjectWrap<LandingPadInst> {
+class LandingPadInst : public Napi::ObjectWrap<LandingPadInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -478,6 +516,8 @@ public:
 private:
     llvm::LandingPadInst *lpInst = nullptr;
 
+    ownedGuardMacro(LandingPadInst)
+
     void setCleanup(const Napi::CallbackInfo &info);
 
     void addClause(const Napi::CallbackInfo &info);
@@ -487,9 +527,9 @@ private:
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class ReturnInst : public Napi::ObjectWrap<ReturnInst> {
+class ReturnInst : public Napi::ObjectWrap<ReturnInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -506,6 +546,8 @@ public:
 private:
     llvm::ReturnInst *returnInst = nullptr;
 
+    ownedGuardMacro(ReturnInst)
+
     Napi::Value getReturnValue(const Napi::CallbackInfo &info);
 
     Napi::Value getType(const Napi::CallbackInfo &info);
@@ -513,9 +555,9 @@ private:
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class BranchInst : public Napi::ObjectWrap<BranchInst> {
+class BranchInst : public Napi::ObjectWrap<BranchInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -532,6 +574,8 @@ public:
 private:
     llvm::BranchInst *branchInst = nullptr;
 
+    ownedGuardMacro(BranchInst)
+
     Napi::Value isUnconditional(const Napi::CallbackInfo &info);
 
     Napi::Value isConditional(const Napi::CallbackInfo &info);
@@ -547,9 +591,9 @@ private:
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class SwitchInst : public Napi::ObjectWrap<SwitchInst> {
+class SwitchInst : public Napi::ObjectWrap<SwitchInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -566,6 +610,8 @@ public:
 private:
     llvm::SwitchInst *switchInst = nullptr;
 
+    ownedGuardMacro(SwitchInst)
+
     void addCase(const Napi::CallbackInfo &info);
 
     Napi::Value getType(const Napi::CallbackInfo &info);
@@ -573,9 +619,9 @@ private:
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class IndirectBrInst : public Napi::ObjectWrap<IndirectBrInst> {
+class IndirectBrInst : public Napi::ObjectWrap<IndirectBrInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -592,14 +638,16 @@ public:
 private:
     llvm::IndirectBrInst *indirectBrInst = nullptr;
 
+    ownedGuardMacro(IndirectBrInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class InvokeInst : public Napi::ObjectWrap<InvokeInst> {
+class InvokeInst : public Napi::ObjectWrap<InvokeInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -616,14 +664,16 @@ public:
 private:
     llvm::InvokeInst *invokeInst = nullptr;
 
+    ownedGuardMacro(InvokeInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class CallBrInst : public Napi::ObjectWrap<CallBrInst> {
+class CallBrInst : public Napi::ObjectWrap<CallBrInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -640,14 +690,16 @@ public:
 private:
     llvm::CallBrInst *callBrInst = nullptr;
 
+    ownedGuardMacro(CallBrInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class ResumeInst : public Napi::ObjectWrap<ResumeInst> {
+class ResumeInst : public Napi::ObjectWrap<ResumeInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -664,14 +716,16 @@ public:
 private:
     llvm::ResumeInst *resumeInst = nullptr;
 
+    ownedGuardMacro(ResumeInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class CatchSwitchInst : public Napi::ObjectWrap<CatchSwitchInst> {
+class CatchSwitchInst : public Napi::ObjectWrap<CatchSwitchInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -688,14 +742,16 @@ public:
 private:
     llvm::CatchSwitchInst *catchSwitchInst = nullptr;
 
+    ownedGuardMacro(CatchSwitchInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class CleanupPadInst : public Napi::ObjectWrap<CleanupPadInst> {
+class CleanupPadInst : public Napi::ObjectWrap<CleanupPadInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -712,14 +768,16 @@ public:
 private:
     llvm::CleanupPadInst *cleanupPadInst = nullptr;
 
+    ownedGuardMacro(CleanupPadInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class CatchPadInst : public Napi::ObjectWrap<CatchPadInst> {
+class CatchPadInst : public Napi::ObjectWrap<CatchPadInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -736,14 +794,16 @@ public:
 private:
     llvm::CatchPadInst *catchPadInst = nullptr;
 
+    ownedGuardMacro(CatchPadInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class CatchReturnInst : public Napi::ObjectWrap<CatchReturnInst> {
+class CatchReturnInst : public Napi::ObjectWrap<CatchReturnInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -760,14 +820,16 @@ public:
 private:
     llvm::CatchReturnInst *catchReturnInst = nullptr;
 
+    ownedGuardMacro(CatchReturnInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class CleanupReturnInst : public Napi::ObjectWrap<CleanupReturnInst> {
+class CleanupReturnInst : public Napi::ObjectWrap<CleanupReturnInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -784,14 +846,16 @@ public:
 private:
     llvm::CleanupReturnInst *cleanupReturnInst = nullptr;
 
+    ownedGuardMacro(CleanupReturnInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class UnreachableInst : public Napi::ObjectWrap<UnreachableInst> {
+class UnreachableInst : public Napi::ObjectWrap<UnreachableInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -808,14 +872,16 @@ public:
 private:
     llvm::UnreachableInst *unreachableInst = nullptr;
 
+    ownedGuardMacro(UnreachableInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class TruncInst : public Napi::ObjectWrap<TruncInst> {
+class TruncInst : public Napi::ObjectWrap<TruncInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -832,14 +898,16 @@ public:
 private:
     llvm::TruncInst *truncInst = nullptr;
 
+    ownedGuardMacro(TruncInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class ZExtInst : public Napi::ObjectWrap<ZExtInst> {
+class ZExtInst : public Napi::ObjectWrap<ZExtInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -856,14 +924,16 @@ public:
 private:
     llvm::ZExtInst *zExtInst = nullptr;
 
+    ownedGuardMacro(ZExtInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class SExtInst : public Napi::ObjectWrap<SExtInst> {
+class SExtInst : public Napi::ObjectWrap<SExtInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -880,14 +950,16 @@ public:
 private:
     llvm::SExtInst *sExtInst = nullptr;
 
+    ownedGuardMacro(SExtInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class FPTruncInst : public Napi::ObjectWrap<FPTruncInst> {
+class FPTruncInst : public Napi::ObjectWrap<FPTruncInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -904,14 +976,16 @@ public:
 private:
     llvm::FPTruncInst *fpTruncInst = nullptr;
 
+    ownedGuardMacro(FPTruncInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class FPExtInst : public Napi::ObjectWrap<FPExtInst> {
+class FPExtInst : public Napi::ObjectWrap<FPExtInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -928,14 +1002,16 @@ public:
 private:
     llvm::FPExtInst *fpExtInst = nullptr;
 
+    ownedGuardMacro(FPExtInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class UIToFPInst : public Napi::ObjectWrap<UIToFPInst> {
+class UIToFPInst : public Napi::ObjectWrap<UIToFPInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -952,14 +1028,16 @@ public:
 private:
     llvm::UIToFPInst *uiToFPInst = nullptr;
 
+    ownedGuardMacro(UIToFPInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class SIToFPInst : public Napi::ObjectWrap<SIToFPInst> {
+class SIToFPInst : public Napi::ObjectWrap<SIToFPInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -976,14 +1054,16 @@ public:
 private:
     llvm::SIToFPInst *siToFPInst = nullptr;
 
+    ownedGuardMacro(SIToFPInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class FPToUIInst : public Napi::ObjectWrap<FPToUIInst> {
+class FPToUIInst : public Napi::ObjectWrap<FPToUIInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -1000,14 +1080,16 @@ public:
 private:
     llvm::FPToUIInst *fpToUIInst = nullptr;
 
+    ownedGuardMacro(FPToUIInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class FPToSIInst : public Napi::ObjectWrap<FPToSIInst> {
+class FPToSIInst : public Napi::ObjectWrap<FPToSIInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -1024,14 +1106,16 @@ public:
 private:
     llvm::FPToSIInst *fpToSIInst = nullptr;
 
+    ownedGuardMacro(FPToSIInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class IntToPtrInst : public Napi::ObjectWrap<IntToPtrInst> {
+class IntToPtrInst : public Napi::ObjectWrap<IntToPtrInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -1048,14 +1132,16 @@ public:
 private:
     llvm::IntToPtrInst *intToPtrInst = nullptr;
 
+    ownedGuardMacro(IntToPtrInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class PtrToIntInst : public Napi::ObjectWrap<PtrToIntInst> {
+class PtrToIntInst : public Napi::ObjectWrap<PtrToIntInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -1072,14 +1158,16 @@ public:
 private:
     llvm::PtrToIntInst *ptrToIntInst = nullptr;
 
+    ownedGuardMacro(PtrToIntInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class BitCastInst : public Napi::ObjectWrap<BitCastInst> {
+class BitCastInst : public Napi::ObjectWrap<BitCastInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -1096,14 +1184,16 @@ public:
 private:
     llvm::BitCastInst *bitCastInst = nullptr;
 
+    ownedGuardMacro(BitCastInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class AddrSpaceCastInst : public Napi::ObjectWrap<AddrSpaceCastInst> {
+class AddrSpaceCastInst : public Napi::ObjectWrap<AddrSpaceCastInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -1120,14 +1210,16 @@ public:
 private:
     llvm::AddrSpaceCastInst *addrSpaceCastInst = nullptr;
 
+    ownedGuardMacro(AddrSpaceCastInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
 };
 
-class FreezeInst : public Napi::ObjectWrap<FreezeInst> {
+class FreezeInst : public Napi::ObjectWrap<FreezeInst>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -1144,6 +1236,8 @@ public:
 private:
     llvm::FreezeInst *freezeInst = nullptr;
 
+    ownedGuardMacro(FreezeInst)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     void setDebugLoc(const Napi::CallbackInfo &info);
@@ -1,11 +1,17 @@
 #pragma once
 
 #include <napi.h>
+#include <memory>
+#include <unordered_set>
 #include <llvm/IR/LLVMContext.h>
+#include "Util/AddonData.h"
+#include "Util/ContextOwned.h"
+
+class Module;
 
 class LLVMContext : public Napi::ObjectWrap<LLVMContext> {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT;
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -13,10 +19,43 @@ public:
 
     static llvm::LLVMContext &Extract(const Napi::Value &value);
 
+    // the wrapper of a context, null if it has been collected
+    static LLVMContext *Lookup(Napi::Env env, llvm::LLVMContext &context);
+
     explicit LLVMContext(const Napi::CallbackInfo &info);
 
+    ~LLVMContext() override;
+
     llvm::LLVMContext &getLLVMPrimitive();
 
+    void addModule(Module *module);
+
+    void removeModule(Module *module);
+
+    // held by an asynchronous operation for as long as it uses the context on another thread,
+    // during which JS may neither use nor dispose the context and what lives in it
+    void lock();
+
+    void unlock();
+
+    bool isLocked() const;
+
+    unsigned getModuleCount() const;
+
+    // hand the context over once every module has been taken away from it, the wrapper behaves as disposed
+    // afterwards
+    std::unique_ptr<llvm::LLVMContext> release();
+
 private:
     llvm::LLVMContext *context = nullptr;
+
+    // shared with the wrappers of what lives in the context, which are locked and released along with it
+    std::shared_ptr<ContextState> state;
+
+    // wrappers owning a module of this context, freed before the context itself
+    std::unordered_set<Module *> modules;
+
+    void free();
+
+    void dispose(const Napi::CallbackInfo &info);
 };
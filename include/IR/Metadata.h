@@ -2,10 +2,12 @@
 
 #include <napi.h>
 #include <llvm/IR/Metadata.h>
+#include "Util/AddonData.h"
+#include "Util/HierarchyWrapper.h"
 
-class Metadata : public Napi::ObjectWrap<Metadata> {
+class Metadata : public Napi::ObjectWrap<Metadata>, public HierarchyWrapper {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -23,9 +25,9 @@ private:
     llvm::Metadata *metadata = nullptr;
 };
 
-class MDNode : public Napi::ObjectWrap<MDNode> {
+class MDNode : public Napi::ObjectWrap<MDNode>, public HierarchyWrapper {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
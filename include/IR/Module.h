@@ -2,26 +2,78 @@
 
 #include <napi.h>
 #include <llvm/IR/Module.h>
+#include "Util/ErrMsg.h"
+#include "Util/Dispose.h"
+#include "Util/AddonData.h"
+
+class LLVMContext;
 
 class Module : public Napi::ObjectWrap<Module> {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT;
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
+    // the wrapper owning the module if there is one, a non-owning wrapper otherwise
     static Napi::Object New(Napi::Env env, llvm::Module *module);
 
+    // a wrapper taking the ownership of the module
+    static Napi::Object New(Napi::Env env, std::unique_ptr<llvm::Module> module, const Napi::Object &context);
+
     static bool IsClassOf(const Napi::Value &value);
 
     static llvm::Module *Extract(const Napi::Value &value);
 
+    // take the module away from its wrapper, which behaves as disposed afterwards
+    static std::unique_ptr<llvm::Module> Release(const Napi::Value &value);
+
+    // re-estimate the native footprint of the module and report the change to V8
+    static void UpdateExternalMemory(const Napi::Value &value);
+
+    // account for IR added to a module by the builders, re-estimating once it has grown by a fraction of its size
+    static void NoteGrowth(Napi::Env env, const llvm::Module *module, int64_t bytes);
+
     explicit Module(const Napi::CallbackInfo &info);
 
+    ~Module() override;
+
     llvm::Module *getLLVMPrimitive();
 
+    bool isDisposed();
+
+    // the wrapper of the context the module lives in
+    LLVMContext *getContextWrapper();
+
+    // whether the context of the module is locked by an asynchronous operation
+    bool isLocked();
+
+    void free();
+
 private:
     llvm::Module *module = nullptr;
 
+    // set when this wrapper owns the module, the context is kept alive as long as the module
+    LLVMContext *owner = nullptr;
+    Napi::ObjectReference ownerRef;
+
+    // bytes currently reported to V8 as external memory
+    int64_t externalMemory = 0;
+
+    // bytes noted by NoteGrowth since the last estimate
+    int64_t pendingGrowth = 0;
+
+    void updateExternalMemory();
+
+    void noteGrowth(int64_t bytes);
+
+    void adopt(const Napi::Object &context);
+
+    void detach();
+
+    contextGuardMacro(Module)
+
+    void dispose(const Napi::CallbackInfo &info);
+
     Napi::Value getModuleIdentifier(const Napi::CallbackInfo &info);
 
     Napi::Value getSourceFileName(const Napi::CallbackInfo &info);
@@ -48,9 +100,19 @@ private:
 
     Napi::Value getGlobalVariable(const Napi::CallbackInfo &info);
 
+    Napi::Value getFunctions(const Napi::CallbackInfo &info);
+
+    Napi::Value getGlobalVariables(const Napi::CallbackInfo &info);
+
     void addModuleFlag(const Napi::CallbackInfo &info);
 
     Napi::Value empty(const Napi::CallbackInfo &info);
 
     Napi::Value print(const Napi::CallbackInfo &info);
+
+    Napi::Value printAsync(const Napi::CallbackInfo &info);
+
+    Napi::Value cursor(const Napi::CallbackInfo &info);
+
+    Napi::Value findInstructions(const Napi::CallbackInfo &info);
 };
\ No newline at end of file
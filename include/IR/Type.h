@@ -2,10 +2,12 @@
 
 #include <napi.h>
 #include <llvm/IR/Type.h>
+#include "Util/AddonData.h"
+#include "Util/ContextOwned.h"
 
-class Type : public Napi::ObjectWrap<Type> {
+class Type : public Napi::ObjectWrap<Type>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT;
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -22,6 +24,8 @@ public:
 private:
     llvm::Type *type = nullptr;
 
+    ownedGuardMacro(Type)
+
     static Napi::Value getIntNTy(const Napi::CallbackInfo &info);
 
     Napi::Value getPointerTo(const Napi::CallbackInfo &info);
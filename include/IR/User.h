@@ -2,10 +2,12 @@
 
 #include <napi.h>
 #include <llvm/IR/User.h>
+#include "Util/AddonData.h"
+#include "Util/ContextOwned.h"
 
-class User : public Napi::ObjectWrap<User> {
+class User : public Napi::ObjectWrap<User>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -22,11 +24,15 @@ public:
 private:
     llvm::User *user = nullptr;
 
+    ownedGuardMacro(User)
+
     Napi::Value getOperand(const Napi::CallbackInfo &info);
 
     void setOperand(const Napi::CallbackInfo &info);
 
     Napi::Value getNumOperands(const Napi::CallbackInfo &info);
 
+    Napi::Value getOperands(const Napi::CallbackInfo &info);
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 };
@@ -2,10 +2,12 @@
 
 #include <napi.h>
 #include <llvm/IR/Value.h>
+#include "Util/AddonData.h"
+#include "Util/ContextOwned.h"
 
-class Value : public Napi::ObjectWrap<Value> {
+class Value : public Napi::ObjectWrap<Value>, public ContextOwned {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -22,6 +24,8 @@ public:
 private:
     llvm::Value *value = nullptr;
 
+    ownedGuardMacro(Value)
+
     Napi::Value getType(const Napi::CallbackInfo &info);
 
     Napi::Value hasName(const Napi::CallbackInfo &info);
@@ -37,4 +41,6 @@ private:
     Napi::Value useEmpty(const Napi::CallbackInfo &info);
 
     Napi::Value userEmpty(const Napi::CallbackInfo &info);
+
+    Napi::Value getUsers(const Napi::CallbackInfo &info);
 };
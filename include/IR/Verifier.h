@@ -2,7 +2,15 @@
 
 #include <napi.h>
 #include <llvm/IR/Verifier.h>
+#include <llvm/Support/raw_ostream.h>
+#include "Util/CancellationToken.h"
 
 namespace Verifier {
     void Init(Napi::Env env, Napi::Object &exports);
+
+    // llvm::verifyModule, polling the token between functions; the module-level checks run once every function
+    // has passed, and check the function bodies again, so a valid module is verified about twice as slowly. The
+    // result is meaningless once the token is cancelled
+    bool verifyModuleCancellable(const llvm::Module &module, llvm::raw_ostream *stream,
+                                 const CancellationToken &token);
 }
@@ -19,6 +19,7 @@
 #include "IR/Instruction.h"
 #include "IR/Instructions.h"
 #include "IR/IRBuilder.h"
+#include "IR/IRCursor.h"
 #include "IR/Metadata.h"
 #include "IR/DebugInfoMetadata.h"
 #include "IR/DebugLoc.h"
@@ -4,3 +4,5 @@
 #include <llvm/IRReader/IRReader.h>
 
 Napi::Value parseIRFile(const Napi::CallbackInfo &info);
+
+Napi::Value parseIRFileAsync(const Napi::CallbackInfo &info);
@@ -2,19 +2,25 @@
 
 #include <napi.h>
 #include <llvm/Linker/Linker.h>
+#include "Util/AddonData.h"
 
 class Linker : public Napi::ObjectWrap<Linker> {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
     explicit Linker(const Napi::CallbackInfo &info);
 
+    ~Linker() override;
+
 private:
     Napi::Value linkInModule(const Napi::CallbackInfo &info);
 
     static Napi::Value linkModules(const Napi::CallbackInfo &info);
 
     llvm::Linker *linker = nullptr;
+
+    // the destination module must outlive the linker
+    Napi::ObjectReference destRef;
 };
@@ -2,10 +2,11 @@
 
 #include <napi.h>
 #include <llvm/MC/TargetRegistry.h>
+#include "Util/AddonData.h"
 
 class Target : public Napi::ObjectWrap<Target> {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
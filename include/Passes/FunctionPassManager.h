@@ -0,0 +1,51 @@
+#pragma once
+
+#include <napi.h>
+#include <memory>
+#include "Util/ErrMsg.h"
+#include "Util/Dispose.h"
+#include "Util/AddonData.h"
+
+class PassBuilder;
+
+//===--------------------------------------------------------------------===//
+// A function pipeline run on one Function at a time
+//
+// The pipeline is parsed once and the analysis managers live as long as the
+// wrapper, so the results the passes preserve are reused by the next run on
+// the same function. The cached results of a function are dropped when it is
+// deleted; after changing a function outside of the manager, call
+// invalidate() on it before running again.
+//===--------------------------------------------------------------------===//
+
+class FunctionPassManager : public Napi::ObjectWrap<FunctionPassManager> {
+public:
+    static inline ConstructorReference constructor; // NOLINT
+
+    static void Init(Napi::Env env, Napi::Object &exports);
+
+    explicit FunctionPassManager(const Napi::CallbackInfo &info);
+
+    ~FunctionPassManager() override;
+
+    bool isDisposed();
+
+    struct State;
+
+private:
+    // keeps the builder, and the machine its analyses were registered with, alive as long as the manager
+    Napi::ObjectReference passBuilderRef;
+    PassBuilder *passBuilder = nullptr;
+
+    std::unique_ptr<State> state;
+
+    disposeGuardMacro(FunctionPassManager)
+
+    Napi::Value run(const Napi::CallbackInfo &info);
+
+    void invalidate(const Napi::CallbackInfo &info);
+
+    void clear(const Napi::CallbackInfo &info);
+
+    void dispose(const Napi::CallbackInfo &info);
+};
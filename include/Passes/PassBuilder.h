@@ -0,0 +1,78 @@
+#pragma once
+
+#include <napi.h>
+#include <functional>
+#include <optional>
+#include <llvm/Passes/OptimizationLevel.h>
+#include <llvm/Passes/PassBuilder.h>
+#include "Passes/PassInstrumentation.h"
+#include "Util/CancellationToken.h"
+#include "Util/ErrMsg.h"
+#include "Util/AddonData.h"
+
+class TargetMachine;
+
+namespace OptimizationLevel {
+    // O0, O1, O2, O3, Os and Oz as numbers
+    void Init(Napi::Env env, Napi::Object &exports);
+}
+
+//===--------------------------------------------------------------------===//
+// Optimization pipelines of the new pass manager
+//
+// The wrapper keeps the tuning options and the TargetMachine the cost models
+// come from. An llvm::PassBuilder and fresh analysis managers are set up for
+// every run, so that a machine disposed in between is noticed instead of
+// being dereferenced and no analysis outlives the module it was computed on.
+// runAsync locks the context of the module and marks the machine busy until
+// the promise settles.
+//===--------------------------------------------------------------------===//
+
+class PassBuilder : public Napi::ObjectWrap<PassBuilder> {
+public:
+    static inline ConstructorReference constructor; // NOLINT
+
+    static void Init(Napi::Env env, Napi::Object &exports);
+
+    static bool IsClassOf(const Napi::Value &value);
+
+    static PassBuilder *Extract(const Napi::Value &value);
+
+    explicit PassBuilder(const Napi::CallbackInfo &info);
+
+    static bool ParseOptimizationLevel(const Napi::Value &value, llvm::OptimizationLevel &level);
+
+    // null without a machine, throws if the machine has been disposed or is emitting asynchronously
+    llvm::TargetMachine *getTargetMachine(Napi::Env env);
+
+    const llvm::PipelineTuningOptions &getTuningOptions();
+
+    using BuildPipeline = std::function<llvm::Error(llvm::PassBuilder &, llvm::ModulePassManager &)>;
+
+    // build a module pipeline with the callback and run it over the module, on any thread: the recorder is created
+    // when the options ask for one, and the optional passes are skipped once the token is cancelled
+    static llvm::Error RunModulePipeline(llvm::Module &module, llvm::TargetMachine *machine,
+                                         const llvm::PipelineTuningOptions &tuningOptions,
+                                         const PassRecorder::Options &recordOptions,
+                                         std::optional<PassRecorder> &recorder, const CancellationToken &cancellation,
+                                         const BuildPipeline &build);
+
+    // buildO0DefaultPipeline or buildPerModuleDefaultPipeline
+    static BuildPipeline DefaultPipeline(llvm::OptimizationLevel level);
+
+    // parsePassPipeline
+    static BuildPipeline TextualPipeline(std::string pipeline);
+
+private:
+    // keeps the machine alive as long as the builder
+    Napi::ObjectReference targetMachineRef;
+    TargetMachine *targetMachine = nullptr;
+
+    llvm::PipelineTuningOptions tuningOptions;
+
+    Napi::Value runDefaultPipeline(const Napi::CallbackInfo &info);
+
+    Napi::Value runPassPipeline(const Napi::CallbackInfo &info);
+
+    Napi::Value runAsync(const Napi::CallbackInfo &info);
+};
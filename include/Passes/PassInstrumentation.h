@@ -0,0 +1,105 @@
+#pragma once
+
+#include <napi.h>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include <llvm/ADT/Any.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/IR/PassInstrumentation.h>
+#include "Util/CancellationToken.h"
+
+//===--------------------------------------------------------------------===//
+// Opt-in measurements of a run of the new pass manager
+//
+// With 'instrument', every pass run on an IR unit gets a record of its wall
+// time, the instruction count of the unit before and after, and whether it
+// reported a change. Pass managers and adaptors are left out, so the time of
+// a pass is not counted twice. With 'statistics', the llvm::Statistic
+// counters which moved during the run are reported; they are process-wide,
+// so work on other threads in the meantime shows up too, and they stay empty
+// when LLVM was built without statistics.
+//===--------------------------------------------------------------------===//
+
+class PassRecorder {
+public:
+    struct Options {
+        bool instrument = false;
+        bool statistics = false;
+
+        // false if the value is neither undefined nor { instrument?: boolean, statistics?: boolean }
+        bool parse(const Napi::Value &value);
+
+        // whether there were options at all, and so a report to return
+        bool enabled() const;
+
+    private:
+        bool requested = false;
+    };
+
+    PassRecorder(const Options &options, llvm::PassInstrumentationCallbacks &callbacks);
+
+    // forward the pass callbacks to the recorder *current points at, if any, so that callbacks registered once
+    // with long-lived analysis managers can be switched on per run
+    static void Register(llvm::PassInstrumentationCallbacks &callbacks, PassRecorder *const *current);
+
+    // take the statistics counters once the run is over
+    void finish();
+
+    // { passes: PassRecord[], statistics: { [name: string]: number } }
+    Napi::Object toObject(Napi::Env env) const;
+
+private:
+    struct Record {
+        std::string pass;
+        std::string passName;
+        const char *unit;
+        std::string name;
+        double elapsed = 0;
+        unsigned instructionsBefore = 0;
+        unsigned instructionsAfter = 0;
+        bool changed = false;
+        // the IR unit was deleted by the pass
+        bool invalidated = false;
+    };
+
+    struct Running {
+        size_t record;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    Options options;
+
+    llvm::PassInstrumentationCallbacks &callbacks;
+
+    std::vector<Record> records;
+
+    std::vector<Running> running;
+
+    std::map<std::string, uint64_t> statisticsBefore;
+
+    std::map<std::string, uint64_t> statistics;
+
+    void beforePass(llvm::StringRef pass, const llvm::Any &unit);
+
+    void afterPass(llvm::StringRef pass, const llvm::Any &unit, bool changed);
+
+    void afterPassInvalidated(llvm::StringRef pass);
+
+    static std::map<std::string, uint64_t> takeStatistics();
+};
+
+//===--------------------------------------------------------------------===//
+// Cancellation of a run of the new pass manager
+//
+// The token is polled before every optional pass, which is skipped once it is
+// cancelled. The passes a pipeline requires still run, so the IR is left
+// valid but only partly optimized, and the caller reports the cancellation.
+//===--------------------------------------------------------------------===//
+
+namespace PassCancellation {
+    // poll the token *current points at, if any, like PassRecorder::Register
+    void Register(llvm::PassInstrumentationCallbacks &callbacks, const CancellationToken *const *current);
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+#include <napi.h>
+#include "Passes/FunctionPassManager.h"
+#include "Passes/PassBuilder.h"
+#include "Passes/PassInstrumentation.h"
+
+void InitPasses(Napi::Env env, Napi::Object &exports);
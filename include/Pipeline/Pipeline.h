@@ -0,0 +1,80 @@
+#pragma once
+
+#include <napi.h>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "Util/AddonData.h"
+#include "Util/ThreadPool.h"
+
+struct PipelineJob;
+
+//===--------------------------------------------------------------------===//
+// Scheduler of compile jobs on a native thread pool
+//
+// A job reads one module into an LLVMContext of its own and runs its stages
+// on it, so jobs never share state and run on all cores at once. Jobs may be
+// named and run after other jobs, forming a DAG; each one is admitted once its
+// dependencies are done, a thread is free and its memory estimate fits the
+// budget, and settles its own Promise on the JS thread.
+//===--------------------------------------------------------------------===//
+
+class Pipeline : public Napi::ObjectWrap<Pipeline> {
+public:
+    static inline ConstructorReference constructor; // NOLINT
+
+    static void Init(Napi::Env env, Napi::Object &exports);
+
+    explicit Pipeline(const Napi::CallbackInfo &info);
+
+    ~Pipeline() override;
+
+    static void Settle(Napi::Env env, Napi::Function, Pipeline *pipeline, PipelineJob *job);
+
+private:
+    using Completions = Napi::TypedThreadSafeFunction<Pipeline, PipelineJob, &Pipeline::Settle>;
+
+    struct NamedJob {
+        PipelineJob *pending;
+        bool failed;
+    };
+
+    std::unique_ptr<ThreadPool> pool;
+
+    std::uint64_t memoryBudget = 0;
+
+    Completions completions;
+
+    // number of jobs whose promise has not settled yet, only used on the JS thread
+    unsigned outstanding = 0;
+
+    // guards the members below, which are shared with the pool threads
+    std::mutex mutex;
+
+    std::unordered_map<PipelineJob *, std::unique_ptr<PipelineJob>> jobs;
+
+    std::unordered_map<std::string, NamedJob> named;
+
+    std::deque<PipelineJob *> ready;
+
+    unsigned running = 0;
+
+    std::uint64_t memoryInFlight = 0;
+
+    // set by the destructor, after which the jobs finishing on the pool threads dispatch no other
+    bool stopping = false;
+
+    Napi::Value submit(const Napi::CallbackInfo &info);
+
+    Napi::Value getConcurrency(const Napi::CallbackInfo &info);
+
+    Napi::Value getMemoryBudget(const Napi::CallbackInfo &info);
+
+    void dispatch();
+
+    void run(PipelineJob *job);
+
+    void finish(PipelineJob *job);
+};
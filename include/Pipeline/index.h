@@ -0,0 +1,6 @@
+#pragma once
+
+#include <napi.h>
+#include "Pipeline/Pipeline.h"
+
+void InitPipeline(Napi::Env env, Napi::Object &exports);
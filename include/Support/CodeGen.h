@@ -0,0 +1,9 @@
+#pragma once
+
+#include <napi.h>
+#include <llvm/Support/CodeGen.h>
+
+namespace CodeGen {
+    // the Reloc, CodeModel and CodeGenOpt namespaces
+    void Init(Napi::Env env, Napi::Object &exports);
+}
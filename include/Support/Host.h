@@ -0,0 +1,12 @@
+#pragma once
+
+#include <napi.h>
+#include <string>
+#include <llvm/Support/Host.h>
+
+namespace sys {
+    void Init(Napi::Env env, Napi::Object &exports);
+
+    // the features detected on the host as "+feature,-feature", sorted so that equal hosts give equal strings
+    std::string getHostCPUFeatureString();
+}
@@ -2,10 +2,11 @@
 
 #include <napi.h>
 #include <llvm/Support/SourceMgr.h>
+#include "Util/AddonData.h"
 
 class SMDiagnostic : public Napi::ObjectWrap<SMDiagnostic> {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
@@ -15,6 +16,8 @@ public:
 
     explicit SMDiagnostic(const Napi::CallbackInfo &info);
 
+    ~SMDiagnostic() override;
+
     llvm::SMDiagnostic &getLLVMPrimitive();
 
 private:
@@ -4,3 +4,6 @@
 #include <llvm/Support/TargetSelect.h>
 
 void InitTargetSelect(Napi::Env env, Napi::Object &exports);
+
+// the native target and its asm printer, under the same lock as the Initialize* functions; false on failure
+bool InitializeNativeCodeGen();
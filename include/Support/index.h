@@ -1,6 +1,8 @@
 #pragma once
 
 #include <napi.h>
+#include "Support/CodeGen.h"
+#include "Support/Host.h"
 #include "Support/SourceMgr.h"
 #include "Support/TargetSelect.h"
 
@@ -1,22 +1,72 @@
 #pragma once
 
 #include <napi.h>
+#include <llvm/Support/CodeGen.h>
+#include <llvm/Support/raw_ostream.h>
 #include <llvm/Target/TargetMachine.h>
+#include "Target/TargetMachineCache.h"
+#include "Util/CancellationToken.h"
+#include "Util/ErrMsg.h"
+#include "Util/Dispose.h"
+#include "Util/AddonData.h"
 
 class TargetMachine : public Napi::ObjectWrap<TargetMachine> {
 public:
-    static inline Napi::FunctionReference constructor; // NOLINT
+    static inline ConstructorReference constructor; // NOLINT
 
     static void Init(Napi::Env env, Napi::Object &exports);
 
+    // the wrapper takes the ownership of the machine
     static Napi::Object New(Napi::Env env, llvm::TargetMachine *machine);
 
+    // disposing the wrapper ends the lease
+    static Napi::Object New(Napi::Env env, TargetMachineCache::Lease machine);
+
     static bool IsClassOf(const Napi::Value &value);
 
     explicit TargetMachine(const Napi::CallbackInfo &info);
 
+    ~TargetMachine() override;
+
+    bool isDisposed();
+
+    // an asynchronous emission runs on the machine, which is not shared between threads
+    bool isBusy();
+
+    void setBusy(bool value);
+
+    llvm::TargetMachine *getLLVMPrimitive();
+
+    // 'obj' or 'asm'
+    static bool ParseFileType(const Napi::Value &value, llvm::CodeGenFileType &fileType);
+
+    // give the module the triple and the data layout of the machine where it has none; the message of the error
+    // if it targets another platform or has another data layout, nullptr otherwise
+    static const char *MatchModule(llvm::TargetMachine &machine, llvm::Module &module);
+
+    // run the code generator over the module, which its IR passes modify like in llc, after matching it with the
+    // machine; the message of the error if they don't match or if the machine cannot emit this kind of file,
+    // nullptr otherwise. Once the token is cancelled, the passes the code generator can do without are skipped and
+    // the output is only good to be thrown away.
+    static const char *Emit(llvm::TargetMachine &machine, llvm::Module &module, llvm::raw_pwrite_stream &stream,
+                            llvm::CodeGenFileType fileType, const CancellationToken *cancellation = nullptr);
+
 private:
-    const llvm::TargetMachine *targetMachine = nullptr;
+    TargetMachineCache::Lease targetMachine;
+
+    bool busy = false;
+
+    disposeGuardMacro(TargetMachine)
 
     Napi::Value createDataLayout(const Napi::CallbackInfo &info);
+
+    void emitToFile(const Napi::CallbackInfo &info);
+
+    Napi::Value emitToBuffer(const Napi::CallbackInfo &info);
+
+    Napi::Value emitToFileAsync(const Napi::CallbackInfo &info);
+
+    Napi::Value emitToBufferAsync(const Napi::CallbackInfo &info);
+
+    void dispose(const Napi::CallbackInfo &info);
 };
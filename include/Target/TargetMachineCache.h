@@ -0,0 +1,83 @@
+#pragma once
+
+#include <napi.h>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <llvm/Target/TargetMachine.h>
+#include "Target/TargetOptions.h"
+
+//===--------------------------------------------------------------------===//
+// Process-wide cache of TargetMachines keyed by triple, cpu, features and
+// options
+//
+// A TargetMachine is not shared between threads, so the cache hands out
+// leases: an acquired machine belongs to its holder until the lease ends,
+// which puts it back among the idle machines of its key. Idle machines past
+// the capacity are evicted, least recently released first.
+//===--------------------------------------------------------------------===//
+
+class TargetMachineCache {
+public:
+    // the llvm.TargetMachineCache namespace
+    static void Init(Napi::Env env, Napi::Object &exports);
+
+    // returns the machine to the cache it came from, or deletes it if there is none
+    struct Release {
+        TargetMachineCache *cache = nullptr;
+        std::string key;
+
+        void operator()(llvm::TargetMachine *machine) const;
+    };
+
+    using Lease = std::unique_ptr<llvm::TargetMachine, Release>;
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        size_t size = 0;
+        size_t capacity = 0;
+    };
+
+    // the cache is never destroyed, since leases may end during the teardown of the process
+    static TargetMachineCache &Global();
+
+    // an idle machine for the key, or else a new one; empty with the error set when the target is not registered
+    Lease acquire(const std::string &triple, const std::string &cpu, const std::string &features,
+                  const TargetMachineOptions &options, std::string &error);
+
+    void setCapacity(size_t value);
+
+    // evict every idle machine, the counters are kept
+    void clear();
+
+    Stats getStats();
+
+private:
+    using Entry = std::pair<std::string, std::unique_ptr<llvm::TargetMachine>>;
+
+    std::mutex mutex;
+
+    size_t capacity = 8;
+
+    // idle machines, most recently released first
+    std::list<Entry> idle;
+
+    std::unordered_multimap<std::string, std::list<Entry>::iterator> index;
+
+    uint64_t hits = 0;
+
+    uint64_t misses = 0;
+
+    uint64_t evictions = 0;
+
+    void release(const std::string &key, std::unique_ptr<llvm::TargetMachine> machine);
+
+    // with the mutex held, the machines are returned to be deleted outside of it
+    std::list<Entry> trim(size_t limit);
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <napi.h>
+#include <string>
+#include <llvm/ADT/Optional.h>
+#include <llvm/Support/CodeGen.h>
+#include <llvm/Target/TargetOptions.h>
+
+namespace TargetOptions {
+    // the FloatABI and FPOpFusion namespaces
+    void Init(Napi::Env env, Napi::Object &exports);
+}
+
+//===--------------------------------------------------------------------===//
+// Everything Target.createTargetMachine takes besides triple, cpu and
+// features, read from a JS options object on the JS thread
+//===--------------------------------------------------------------------===//
+
+struct TargetMachineOptions {
+    llvm::TargetOptions options;
+    llvm::Optional<llvm::Reloc::Model> relocModel;
+    llvm::Optional<llvm::CodeModel::Model> codeModel;
+    llvm::CodeGenOpt::Level optLevel = llvm::CodeGenOpt::Default;
+    bool jit = false;
+
+    // the fields set by parse() in a canonical form, which keys the TargetMachineCache
+    std::string key;
+
+    // false if a field has the wrong type or is out of range, undefined leaves the defaults
+    bool parse(const Napi::Value &value);
+};
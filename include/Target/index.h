@@ -2,5 +2,7 @@
 
 #include <napi.h>
 #include "Target/TargetMachine.h"
+#include "Target/TargetMachineCache.h"
+#include "Target/TargetOptions.h"
 
 void InitTarget(Napi::Env env, Napi::Object &exports);
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <napi.h>
+#include <vector>
+#include <unordered_map>
+#include <llvm/IR/LLVMContext.h>
+#include "Util/WrapperCache.h"
+
+//===--------------------------------------------------------------------===//
+// State of the addon for one Node.js environment
+//
+// The main thread and every worker_threads Worker load the addon into their
+// own environment, so nothing referring to JS objects may be static: it lives
+// here instead, attached with napi_set_instance_data and released by Node.js
+// when the environment is torn down.
+//===--------------------------------------------------------------------===//
+
+class AddonData {
+public:
+    static AddonData &Get(Napi::Env env);
+
+    // one slot per wrapper class, assigned when the class is loaded
+    static std::size_t NewConstructorSlot();
+
+    std::vector<Napi::FunctionReference> constructors;
+
+    std::unordered_map<const llvm::LLVMContext *, WrapperCache> wrapperCaches;
+
+    // key of the hidden owner property of Value/Type wrappers
+    Napi::Reference<Napi::Symbol> ownerKey;
+};
+
+//===--------------------------------------------------------------------===//
+// Constructor of a wrapper class, resolved in the environment of the caller
+//===--------------------------------------------------------------------===//
+
+class ConstructorReference {
+public:
+    ConstructorReference();
+
+    void Reset(Napi::Env env, const Napi::Function &func);
+
+    Napi::Function Value(Napi::Env env) const;
+
+    Napi::Object New(Napi::Env env, const std::initializer_list<napi_value> &args) const;
+
+private:
+    const std::size_t slot;
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <napi.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+//===--------------------------------------------------------------------===//
+// Cancellation of a native operation from JS
+//
+// Built on the JS thread from the { signal?: AbortSignal, timeout?: number }
+// options of an asynchronous call. The abort listener only sets a flag, which
+// the thread running the operation polls through isCancelled() at function or
+// pass boundaries. The signal and the listener are released by detach(), back
+// on the JS thread once the operation has settled.
+//===--------------------------------------------------------------------===//
+
+class CancellationToken {
+public:
+    CancellationToken() = default;
+
+    // throw a TypeError with the given message when the options are malformed
+    static CancellationToken FromOptions(Napi::Env env, const Napi::Value &options, const char *errMsg);
+
+    // whether there is a signal or a deadline to poll at all
+    bool isActive() const;
+
+    bool isCancelled() const;
+
+    // the value a cancelled operation is rejected with: the reason of the signal, or an AbortError/TimeoutError
+    Napi::Value getReason(Napi::Env env) const;
+
+    void detach();
+
+private:
+    std::shared_ptr<std::atomic<bool>> aborted;
+
+    bool hasDeadline = false;
+
+    std::chrono::steady_clock::time_point deadline;
+
+    Napi::ObjectReference signal;
+
+    Napi::FunctionReference listener;
+};
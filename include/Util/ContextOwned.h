@@ -0,0 +1,86 @@
+#pragma once
+
+#include <napi.h>
+#include <memory>
+#include <unordered_map>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Value.h>
+#include <llvm/IR/Type.h>
+#include "Util/Dispose.h"
+#include "Util/HierarchyWrapper.h"
+
+class ContextOwned;
+
+//===--------------------------------------------------------------------===//
+// State of an LLVMContext shared by its wrapper, its WrapperCache and the
+// wrappers of the Values/Types living in it
+//
+// It outlives the context, so that a wrapper still knows its primitive has
+// been freed after the context is gone.
+//===--------------------------------------------------------------------===//
+
+struct ContextState {
+    // the context has been freed or handed over to an LLJIT
+    bool released = false;
+
+    // held while an asynchronous operation uses the context on another thread
+    bool locked = false;
+
+    // the wrapper of each primitive, looked up to invalidate it when the primitive is freed
+    std::unordered_map<const void *, ContextOwned *> wrappers;
+
+    // invalidate the wrappers of a value and of what it contains (arguments, basic blocks, instructions)
+    void invalidate(const llvm::Value *value);
+
+    // invalidate the wrappers of everything a module contains
+    void invalidate(const llvm::Module *module);
+
+private:
+    void invalidateOne(const void *primitive);
+};
+
+//===--------------------------------------------------------------------===//
+// Second base of the Value/Type wrappers
+//
+// Instance methods are bound through guarded/guardedVoid (ownedGuardMacro) and
+// Extract goes through extractKind, so that using a wrapper whose primitive has
+// been freed throws instead of touching freed memory, and so does using it
+// while the context is locked.
+//===--------------------------------------------------------------------===//
+
+class ContextOwned : public HierarchyWrapper {
+public:
+    ContextOwned() = default;
+
+    ~ContextOwned();
+
+    void bind(std::shared_ptr<ContextState> contextState, const llvm::Value *value);
+
+    void bind(std::shared_ptr<ContextState> contextState, const llvm::Type *type);
+
+    void invalidate();
+
+    // keep the JS object owning the primitive alive as long as this wrapper
+    void retainOwner(const Napi::Object &owner);
+
+    // throws a JS error if the primitive has been freed or the context is locked
+    void checkUsable(Napi::Env env) const;
+
+protected:
+    // to be called before a wrapped primitive frees the value, and what it contains
+    void invalidateTree(const llvm::Value *value);
+
+private:
+    std::shared_ptr<ContextState> state;
+
+    // the Module for values inside a module, the LLVMContext otherwise
+    Napi::ObjectReference owner;
+
+    bool isType = false;
+
+    bool invalidated = false;
+
+    void bindState(std::shared_ptr<ContextState> contextState);
+};
+
+#define ownedGuardMacro(className) guardMacroImpl(className, checkUsable(info.Env());)
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <napi.h>
+#include <memory>
+#include <vector>
+#include "Util/CancellationToken.h"
+
+class LLVMContext;
+
+//===--------------------------------------------------------------------===//
+// Base of the *Async functions
+//
+// Execute runs on the libuv thread pool, then Resolve builds the value the
+// returned Promise is resolved with back on the JS thread. The context is
+// locked from Start until the promise settles, and the objects passed to
+// keepAlive are referenced for as long. Execute polls isCancelled() where it
+// can stop early, and the promise is then rejected with the reason of the
+// cancellation instead of resolved.
+//===--------------------------------------------------------------------===//
+
+class ContextWorker : public Napi::AsyncWorker {
+public:
+    // throw instead of queueing the worker if the context is already locked
+    static Napi::Promise Start(std::unique_ptr<ContextWorker> worker);
+
+    // built from the { signal?, timeout? } options argument of the call
+    void setCancellation(CancellationToken token);
+
+protected:
+    ContextWorker(Napi::Env env, const char *resourceName, LLVMContext *context);
+
+    void keepAlive(const Napi::Value &value);
+
+    // true once the operation has been cancelled, Execute should return then
+    bool isCancelled();
+
+    const CancellationToken &getCancellation() const;
+
+    virtual Napi::Value Resolve(Napi::Env env) = 0;
+
+private:
+    Napi::Promise::Deferred deferred;
+
+    LLVMContext *context = nullptr;
+
+    std::vector<Napi::Reference<Napi::Value>> refs;
+
+    CancellationToken cancellation;
+
+    bool cancelled = false;
+
+    void OnOK() final;
+
+    void OnError(const Napi::Error &error) final;
+
+    void release();
+};
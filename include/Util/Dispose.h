@@ -0,0 +1,41 @@
+#pragma once
+
+#include <napi.h>
+
+//===--------------------------------------------------------------------===//
+// Explicit disposal of wrappers which own native memory
+//
+// Instance methods of a disposable class are bound through guarded/guardedVoid
+// so that calling them after dispose() throws instead of touching freed memory.
+// The class provides isDisposed() and ErrMsg::Class::<className>::disposed.
+//===--------------------------------------------------------------------===//
+
+#define guardMacroImpl(className, check) \
+template<Napi::Value (className::*method)(const Napi::CallbackInfo &)> \
+Napi::Value guarded(const Napi::CallbackInfo &info) { \
+    check \
+    return (this->*method)(info); \
+} \
+template<void (className::*method)(const Napi::CallbackInfo &)> \
+void guardedVoid(const Napi::CallbackInfo &info) { \
+    check \
+    (this->*method)(info); \
+}
+
+#define disposeGuardMacro(className) guardMacroImpl(className, \
+    if (isDisposed()) { \
+        throw Napi::Error::New(info.Env(), ErrMsg::Class::className::disposed); \
+    })
+
+// for classes living in an LLVMContext, which also provide isLocked() to refuse calls while an asynchronous
+// operation is using the context
+#define contextGuardMacro(className) guardMacroImpl(className, \
+    if (isDisposed()) { \
+        throw Napi::Error::New(info.Env(), ErrMsg::Class::className::disposed); \
+    } \
+    if (isLocked()) { \
+        throw Napi::Error::New(info.Env(), ErrMsg::Class::LLVMContext::locked); \
+    })
+
+// alias prototype[Symbol.dispose] to prototype.dispose on runtimes which support explicit resource management
+void DefineSymbolDispose(Napi::Env env, Napi::Function ctor);
@@ -13,6 +13,9 @@ namespace ErrMsg {
 
         namespace LLVMContext {
             constexpr const char *constructor = "LLVMContext.constructor needs to be called with new ()";
+            constexpr const char *disposed = "LLVMContext has been disposed";
+            constexpr const char *locked = "LLVMContext is locked by a pending asynchronous operation";
+            constexpr const char *release = "LLVMContext can't be handed over while it still owns a module";
         }
 
         namespace Module {
@@ -36,11 +39,19 @@ namespace ErrMsg {
             constexpr const char *addModuleFlag =
                     "Module.addModuleFlag needs to be called with (behavior: number, key: string, value: number)"
                     "\n\t - limit: behavior should belong to [1, 7]";
+            constexpr const char *printAsync =
+                    "Module.printAsync needs to be called with (options?: { signal?: AbortSignal, timeout?: number })";
+            constexpr const char *findInstructions = "Module.findInstructions needs to be called with (query: InstructionQuery)"
+                    "\n\t - limit: opcode should be an opcode number or name such as \"call\"";
+            constexpr const char *disposed = "Module has been disposed or linked into another module";
+            constexpr const char *release =
+                    "Module can only be moved out of the wrapper owning it, which must not have been disposed";
         }
 
         namespace Type {
             constexpr const char *constructor =
                     "Type.constructor needs to be called with new (external: Napi::External<llvm::Type>)";
+            constexpr const char *disposed = "Type has been freed along with its LLVMContext";
             constexpr const char *getPointerTo = "Type.getPointer needs to called with: (addrSpace?: number)";
             constexpr const char *getIntNTy =
                     "Type.getIntNTy needs to be called with: (context: LLVMContext, numBits: number)";
@@ -116,6 +127,8 @@ namespace ErrMsg {
             constexpr const char *setName = "Value.setName needs to be called with (name: string)";
             constexpr const char *replaceAllUsesWith =
                     "Value.replaceAllUsesWith needs to be called with: (newValue: Value)";
+            constexpr const char *disposed =
+                    "Value has been erased, or freed along with its Module or LLVMContext";
         }
 
         namespace Argument {
@@ -202,10 +215,17 @@ namespace ErrMsg {
         namespace ConstantDataArray {
             constexpr const char *constructor =
                     "ConstantDataArray.constructor needs to be called with new (external: Napi::External<llvm::ConstantDataArray>)";
-            constexpr const char *get =
-                    "ConstantArray.get needs to be called with (context: LLVMContext, elements: number[])";
+            constexpr const char *get = "ConstantDataArray.get needs to be called with"
+                    " (context: LLVMContext, elements: number[] | TypedArray | Buffer)";
             constexpr const char *getString =
-                    "ConstantArray.getString needs to be called with (context: LLVMContext, initializer: string, addNull?: boolean)";
+                    "ConstantDataArray.getString needs to be called with (context: LLVMContext, initializer: string, addNull?: boolean)";
+        }
+
+        namespace ConstantDataVector {
+            constexpr const char *constructor =
+                    "ConstantDataVector.constructor needs to be called with new (external: Napi::External<llvm::ConstantDataVector>)";
+            constexpr const char *get =
+                    "ConstantDataVector.get needs to be called with (context: LLVMContext, elements: TypedArray | Buffer)";
         }
 
         namespace ConstantExpr {
@@ -642,6 +662,7 @@ namespace ErrMsg {
                     "\n\t - new (theBB: BasicBlock)"
                     "\n\t - new (context: LLVMContext)"
                     "\n\t - new (ip: Instruction)";
+            constexpr const char *disposed = "IRBuilder has been disposed";
 
             namespace InsertPoint {
                 constexpr const char *constructor = "IRBuilder.InsertPoint.constructor needs to be called with new ()";
@@ -729,6 +750,15 @@ namespace ErrMsg {
                     "IRBuilder.CreateLandingPad needs to be called with (type: Type, numClauses: number, name?: string)";
             constexpr const char *CreatePtrDiff =
                     "IRBuilder.CreatePtrDiff needs to be called with (elemType: Type, lhs: Value, rhs: Value, name?: string)";
+            constexpr const char *emitBatch = "IRBuilder.emitBatch needs to be called with"
+                    " (program: Int32Array | ArrayBuffer, values: Value[], types?: Type[], results?: number[])";
+            constexpr const char *emitBatchOperation = "IRBuilder.emitBatch found an invalid operation at offset ";
+        }
+
+        namespace IRCursor {
+            constexpr const char *constructor = "IRCursor.constructor needs to be called with new (module: Module)";
+            constexpr const char *noPosition = "IRCursor does not point at a function, basic block or instruction";
+            constexpr const char *disposed = "IRCursor walks a module which has been disposed or linked into another module";
         }
 
         namespace Metadata {
@@ -899,6 +929,71 @@ namespace ErrMsg {
                     "Linker.linkModules needs to be called with (dest: Module, src: Module)";
         }
 
+        namespace Pipeline {
+            constexpr const char *constructor =
+                    "Pipeline.constructor needs to be called with new (options?: { concurrency?: number, memoryBudget?: number })";
+            constexpr const char *submit = "Pipeline.submit needs to be called with (job: PipelineJob)";
+            constexpr const char *unknownStage = "Pipeline.submit found an unknown stage: ";
+            constexpr const char *unknownJob = "Pipeline.submit found no job named ";
+            constexpr const char *duplicateJob = "Pipeline.submit found a pending job named ";
+            constexpr const char *dependencyFailed = "Pipeline job depends on a job which has failed: ";
+        }
+
+        namespace LLJIT {
+            constexpr const char *constructor = "LLJIT.constructor needs to be called with"
+                    " new (options?: { optLevel?: number, numCompileThreads?: number,"
+                    " lazy?: boolean, speculate?: boolean, tiered?: boolean, tierUpThreshold?: number,"
+                    " tierUpLevel?: number })"
+                    "\n\t - limit: optLevel should be a value of llvm.CodeGenOpt"
+                    "\n\t - limit: speculate needs lazy"
+                    "\n\t - limit: tiered cannot be combined with lazy or optLevel"
+                    "\n\t - limit: tierUpThreshold should be positive"
+                    "\n\t - limit: tierUpLevel should be a value of llvm.OptimizationLevel other than O0";
+            constexpr const char *disposed = "LLJIT has been disposed";
+            constexpr const char *nativeTarget = "LLJIT cannot initialize the native target";
+            constexpr const char *addModule = "LLJIT.addModule needs to be called with (module: Module)";
+            constexpr const char *takeModule =
+                    "LLJIT takes a module together with its LLVMContext, which must not own any other module";
+            constexpr const char *lookup = "LLJIT.lookup needs to be called with (name: string)";
+            constexpr const char *getFunction = "LLJIT.getFunction needs to be called with"
+                    " (name: string, signature: { result?: NativeType, params?: NativeType[], unchecked?: boolean })"
+                    "\n\t - limit: a param cannot be 'void' and the result cannot be 'ptr'"
+                    "\n\t - limit: unless unchecked is true, the function should be defined by an added module, with a"
+                    " type the signature matches (no varargs, and only the IR types of NativeType)";
+            constexpr const char *getTier = "LLJIT.getTier needs to be called with (name: string)";
+        }
+
+        namespace FunctionPassManager {
+            constexpr const char *constructor = "FunctionPassManager.constructor needs to be called with"
+                    " new (pipeline: string, passBuilder?: PassBuilder)";
+            constexpr const char *disposed = "FunctionPassManager has been disposed";
+            constexpr const char *run = "FunctionPassManager.run needs to be called with"
+                    " (func: Function, options?: { instrument?: boolean, statistics?: boolean, signal?: AbortSignal,"
+                    " timeout?: number })"
+                    "\n\t - limit: the function should be inside a module";
+            constexpr const char *invalidate = "FunctionPassManager.invalidate needs to be called with (func: Function)"
+                    "\n\t - limit: the function should be inside a module";
+        }
+
+        namespace PassBuilder {
+            constexpr const char *constructor = "PassBuilder.constructor needs to be called with"
+                    " new (targetMachine?: TargetMachine | null, options?: PipelineTuningOptions)";
+            constexpr const char *runDefaultPipeline =
+                    "PassBuilder.runDefaultPipeline needs to be called with"
+                    " (module: Module, level: number, options?: { instrument?: boolean, statistics?: boolean,"
+                    " signal?: AbortSignal, timeout?: number })"
+                    "\n\t - limit: level should be a value of llvm.OptimizationLevel";
+            constexpr const char *runPassPipeline =
+                    "PassBuilder.runPassPipeline needs to be called with"
+                    " (module: Module, pipeline: string, options?: { instrument?: boolean, statistics?: boolean,"
+                    " signal?: AbortSignal, timeout?: number })";
+            constexpr const char *runAsync =
+                    "PassBuilder.runAsync needs to be called with"
+                    " (module: Module, levelOrPipeline: number | string, options?: { instrument?: boolean,"
+                    " statistics?: boolean, signal?: AbortSignal, timeout?: number })"
+                    "\n\t - limit: a level should be a value of llvm.OptimizationLevel";
+        }
+
         namespace SMDiagnostic {
             constexpr const char *constructor = "SMDiagnostic.constructor needs to be called with new ()";
         }
@@ -907,7 +1002,10 @@ namespace ErrMsg {
             constexpr const char *constructor =
                     "Target.constructor needs to be called with new (external: Napi::External<llvm::Target>)";
             constexpr const char *createTargetMachine =
-                    "Target.createTargetMachine needs to be called with (targetTriple: string, cpu: string, features?: string)";
+                    "Target.createTargetMachine needs to be called with"
+                    " (targetTriple: string, cpu: string, features?: string, options?: TargetMachineOptions)"
+                    "\n\t - limit: the enumerators of options should be values of llvm.Reloc, llvm.CodeModel, llvm.CodeGenOpt,"
+                    " llvm.FloatABI and llvm.FPOpFusion";
         }
 
         namespace TargetRegistry {
@@ -917,6 +1015,19 @@ namespace ErrMsg {
         namespace TargetMachine {
             constexpr const char *constructor =
                     "TargetMachine.constructor needs to be called with new (external: Napi::External<llvm::TargetMachine>)";
+            constexpr const char *disposed = "TargetMachine has been disposed";
+            constexpr const char *busy = "TargetMachine is used by a pending asynchronous emission";
+            constexpr const char *cannotEmit = "TargetMachine can't emit a file of this type";
+            constexpr const char *tripleMismatch = "TargetMachine doesn't target the platform of the module's triple";
+            constexpr const char *dataLayoutMismatch = "TargetMachine doesn't match the data layout of the module";
+            constexpr const char *emitToFile =
+                    "TargetMachine.emitToFile needs to be called with (module: Module, filename: string, fileType: 'obj' | 'asm')";
+            constexpr const char *emitToBuffer =
+                    "TargetMachine.emitToBuffer needs to be called with (module: Module, fileType: 'obj' | 'asm')";
+            constexpr const char *emitToFileAsync = "TargetMachine.emitToFileAsync needs to be called with"
+                    " (module: Module, filename: string, fileType: 'obj' | 'asm', options?: { signal?: AbortSignal, timeout?: number })";
+            constexpr const char *emitToBufferAsync = "TargetMachine.emitToBufferAsync needs to be called with"
+                    " (module: Module, fileType: 'obj' | 'asm', options?: { signal?: AbortSignal, timeout?: number })";
         }
     }
 
@@ -925,12 +1036,30 @@ namespace ErrMsg {
                 "Intrinsic.getDeclaration needs to be called with: (module: Module, id: number, types?: [])";
     }
 
+    namespace Namespace::TargetMachineCache {
+        constexpr const char *get = "TargetMachineCache.get needs to be called with"
+                " (targetTriple: string, cpu: string, features?: string, options?: TargetMachineOptions)";
+        constexpr const char *setCapacity = "TargetMachineCache.setCapacity needs to be called with (capacity: number)"
+                "\n\t - limit: capacity >= 0";
+    }
+
     namespace Function {
         constexpr const char *WriteBitcodeToFile =
                 "WriteBitcodeToFile needs to be called with: (module: Module, filename: string)";
+        constexpr const char *WriteBitcodeToFileAsync =
+                "WriteBitcodeToFileAsync needs to be called with:"
+                " (module: Module, filename: string, options?: { signal?: AbortSignal, timeout?: number })";
         constexpr const char *verifyFunction = "verifyFunction needs to be called with (func: Function)";
         constexpr const char *verifyModule = "verifyModule needs to be called with (module: Module)";
+        constexpr const char *verifyModuleAsync = "verifyModuleAsync needs to be called with"
+                " (module: Module, options?: { signal?: AbortSignal, timeout?: number })";
         constexpr const char *parseIRFile =
                 "parseIRFile needs to be called with (filename: string, err: SMDiagnostic, context: LLVMContext)";
+        constexpr const char *parseIRFileAsync =
+                "parseIRFileAsync needs to be called with"
+                " (filename: string, err: SMDiagnostic, context: LLVMContext, options?: { signal?: AbortSignal, timeout?: number })";
+        constexpr const char *createNativeTargetMachine =
+                "createNativeTargetMachine needs to be called with (options?: TargetMachineOptions)";
+        constexpr const char *nativeTargetUnavailable = "createNativeTargetMachine cannot initialize the native target: ";
     }
 }
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <napi.h>
+
+namespace llvm {
+    class Value;
+
+    class Type;
+
+    class Metadata;
+}
+
+//===--------------------------------------------------------------------===//
+// Common base of the wrappers of the Value, Type and Metadata hierarchies
+//
+// The classes of a hierarchy are unrelated Napi::ObjectWraps, and Unwrap may
+// only be used with the class an object has been constructed with. Every such
+// wrapper registers itself under the pointer napi_unwrap returns for its
+// object, and holds its primitive as a pointer to the root LLVM class, so the
+// primitive of an object of any class of the hierarchy is found without
+// knowing the wrapper class.
+//===--------------------------------------------------------------------===//
+
+class HierarchyWrapper {
+public:
+    HierarchyWrapper() = default;
+
+    HierarchyWrapper(const HierarchyWrapper &) = delete;
+
+    HierarchyWrapper &operator=(const HierarchyWrapper &) = delete;
+
+    ~HierarchyWrapper();
+
+    // the wrapper of the object, nullptr if it is not the object of a registered wrapper
+    static HierarchyWrapper *Find(const Napi::Object &object);
+
+    // to be called from the constructor of the wrapper class, which napi_wrap has been given as is
+    template<typename WrapperClass>
+    void registerWrapper(WrapperClass *wrapper) {
+        registerKey(static_cast<const void *>(wrapper));
+    }
+
+    // the primitive, as a pointer to the root class it has been set with
+    template<typename LLVMRoot>
+    LLVMRoot *getRoot() const {
+        return static_cast<LLVMRoot *>(const_cast<void *>(root));
+    }
+
+protected:
+    void setRoot(const llvm::Value *value);
+
+    void setRoot(const llvm::Type *type);
+
+    void setRoot(const llvm::Metadata *metadata);
+
+    const void *getRootAddress() const;
+
+private:
+    const void *key = nullptr;
+
+    const void *root = nullptr;
+
+    void registerKey(const void *wrapperKey);
+};
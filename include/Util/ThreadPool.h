@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//===--------------------------------------------------------------------===//
+// Work-stealing pool of native threads, independent of the libuv pool
+//
+// Every thread owns a deque: tasks queued from one of the pool threads go to
+// the back of its own deque and are taken from there first, so a task spawned
+// by a finishing one runs on the same core, while idle threads steal from the
+// front of the others. Tasks queued from any other thread are spread round
+// robin. Destroying the pool waits for the running tasks and drops the queued
+// ones, including those the running tasks queue meanwhile.
+//===--------------------------------------------------------------------===//
+
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned threadCount);
+
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    void async(std::function<void()> task);
+
+    unsigned getThreadCount() const;
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    std::vector<std::thread> threads;
+
+    std::mutex sleepMutex;
+
+    std::condition_variable wakeup;
+
+    std::atomic<std::size_t> queued{0};
+
+    std::atomic<unsigned> nextWorker{0};
+
+    // read without the lock by the threads between two tasks
+    std::atomic<bool> stopping{false};
+
+    void run(unsigned index);
+
+    bool take(unsigned index, std::function<void()> &task);
+};
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <napi.h>
+#include <type_traits>
+#include <llvm/Support/Casting.h>
+#include "Util/ContextOwned.h"
+#include "Util/HierarchyWrapper.h"
+
+//===--------------------------------------------------------------------===//
+// Type tags attached to every wrapper in its constructor
+//
+// Classes mirroring an LLVM class hierarchy (Value, Type, Metadata) share the
+// tag of the hierarchy root and are told apart by LLVM's own RTTI on the
+// wrapped pointer, so IsClassOf is a constant-time native check instead of a
+// walk along the JS prototype chain.
+//===--------------------------------------------------------------------===//
+
+namespace TypeTag {
+    // "llvm-bin" in the lower half keeps the tags apart from other addons
+    constexpr uint64_t Prefix = 0x6c6c766d2d62696eULL;
+
+    constexpr napi_type_tag Value = {Prefix, 1};
+    constexpr napi_type_tag Type = {Prefix, 2};
+    constexpr napi_type_tag Metadata = {Prefix, 3};
+    constexpr napi_type_tag LLVMContext = {Prefix, 4};
+    constexpr napi_type_tag Module = {Prefix, 5};
+    constexpr napi_type_tag IRBuilder = {Prefix, 6};
+    constexpr napi_type_tag IRBuilderInsertPoint = {Prefix, 7};
+    constexpr napi_type_tag DataLayout = {Prefix, 8};
+    constexpr napi_type_tag DebugLoc = {Prefix, 9};
+    constexpr napi_type_tag Attribute = {Prefix, 10};
+    constexpr napi_type_tag FunctionCallee = {Prefix, 11};
+    constexpr napi_type_tag DIBuilder = {Prefix, 12};
+    constexpr napi_type_tag DITypeRefArray = {Prefix, 13};
+    constexpr napi_type_tag APInt = {Prefix, 14};
+    constexpr napi_type_tag APFloat = {Prefix, 15};
+    constexpr napi_type_tag SMDiagnostic = {Prefix, 16};
+    constexpr napi_type_tag TargetMachine = {Prefix, 17};
+    constexpr napi_type_tag IRCursor = {Prefix, 18};
+    constexpr napi_type_tag PassBuilder = {Prefix, 19};
+    constexpr napi_type_tag LLJIT = {Prefix, 20};
+}
+
+inline void tagWrapper(const Napi::CallbackInfo &info, const napi_type_tag &tag) {
+    info.This().As<Napi::Object>().TypeTag(&tag);
+}
+
+// for the classes of the Value, Type and Metadata hierarchies, which also register their HierarchyWrapper base
+template<typename WrapperClass>
+inline void tagWrapper(const Napi::CallbackInfo &info, const napi_type_tag &tag, WrapperClass *wrapper) {
+    tagWrapper(info, tag);
+    wrapper->registerWrapper(wrapper);
+}
+
+inline bool hasTypeTag(const Napi::Value &value, const napi_type_tag &tag) {
+    return value.IsObject() && value.As<Napi::Object>().CheckTypeTag(&tag);
+}
+
+//===--------------------------------------------------------------------===//
+// Check the tag of the hierarchy root, then the LLVM class of the primitive
+//
+// The object may belong to any wrapper class of the hierarchy, so it is only
+// reached through its HierarchyWrapper base, never through the Unwrap of
+// another class.
+//===--------------------------------------------------------------------===//
+
+template<typename LLVMRoot>
+inline HierarchyWrapper *findUsable(const Napi::Value &value) {
+    HierarchyWrapper *wrapper = HierarchyWrapper::Find(value.As<Napi::Object>());
+    // Value and Type wrappers are ContextOwned, reading the class of the primitive is already a use of it
+    if constexpr (!std::is_same_v<LLVMRoot, llvm::Metadata>) {
+        if (wrapper != nullptr) {
+            static_cast<ContextOwned *>(wrapper)->checkUsable(value.Env());
+        }
+    }
+    return wrapper;
+}
+
+template<typename LLVMType, typename LLVMRoot>
+inline bool isKindOf(const Napi::Value &value, const napi_type_tag &rootTag) {
+    if (!hasTypeTag(value, rootTag)) {
+        return false;
+    }
+    const HierarchyWrapper *wrapper = findUsable<LLVMRoot>(value);
+    return wrapper != nullptr && llvm::isa_and_nonnull<LLVMType>(wrapper->getRoot<LLVMRoot>());
+}
+
+// the primitive of an object IsClassOf has accepted, whatever its wrapper class
+template<typename LLVMType, typename LLVMRoot>
+inline LLVMType *extractKind(const Napi::Value &value) {
+    const HierarchyWrapper *wrapper = findUsable<LLVMRoot>(value);
+    return wrapper != nullptr ? llvm::cast_or_null<LLVMType>(wrapper->getRoot<LLVMRoot>()) : nullptr;
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <napi.h>
+#include <memory>
+#include <unordered_map>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Value.h>
+#include <llvm/IR/Type.h>
+#include "Util/ContextOwned.h"
+
+//===--------------------------------------------------------------------===//
+// Identity cache of Value/Type wrappers, one table per LLVMContext and
+// environment, owned by AddonData
+//
+// Entries hold weak references: the same JS object is handed out for a
+// pointer as long as JS keeps it alive, and a new one is created once it has
+// been collected. The kind (ValueID/TypeID) is stored alongside so that an
+// address reused by a different kind of object never resolves to a wrapper
+// of the wrong class.
+//
+// Every wrapper also holds a native reference to the JS object owning its
+// primitive (the Module for values inside a module, the LLVMContext otherwise),
+// so the owner is never collected while one of its values is reachable.
+//
+// Wrappers are bound to the ContextState of the cache, which is marked as
+// released when the cache is dropped along with its context.
+//===--------------------------------------------------------------------===//
+
+class WrapperCache {
+public:
+    static WrapperCache &Get(Napi::Env env, llvm::LLVMContext &context);
+
+    static void Drop(Napi::Env env, llvm::LLVMContext &context);
+
+    // keep the owner alive as long as an object which is not a ContextOwned wrapper, through a hidden property
+    static void RetainOwner(Napi::Object object, const Napi::Object &owner);
+
+    Napi::Object lookup(const void *primitive, unsigned kind);
+
+    void insert(const void *primitive, unsigned kind, const Napi::Object &wrapper);
+
+    void setContext(const Napi::Object &context);
+
+    Napi::Object getContext();
+
+    void registerModule(const llvm::Module *module, const Napi::Object &wrapper);
+
+    void unregisterModule(const llvm::Module *module);
+
+    Napi::Object lookupModule(const llvm::Module *module);
+
+    const std::shared_ptr<ContextState> &getState() const;
+
+    void retainOwner(ContextOwned &owned, const llvm::Value *value);
+
+    void retainOwner(ContextOwned &owned, const llvm::Type *type);
+
+private:
+    struct Entry {
+        unsigned kind;
+        Napi::ObjectReference ref;
+    };
+
+    std::unordered_map<const void *, Entry> entries;
+
+    std::shared_ptr<ContextState> state = std::make_shared<ContextState>();
+
+    Napi::ObjectReference context;
+
+    std::unordered_map<const llvm::Module *, Napi::ObjectReference> modules;
+
+    std::size_t sweepThreshold = 1024;
+
+    void sweep();
+};
+
+inline unsigned getWrapperKind(const llvm::Value *value) {
+    return value->getValueID();
+}
+
+inline unsigned getWrapperKind(const llvm::Type *type) {
+    return type->getTypeID();
+}
+
+//===--------------------------------------------------------------------===//
+// Create the wrapper of a Value/Type, or return the live one from the cache
+//===--------------------------------------------------------------------===//
+
+template<typename WrappedType, typename LLVMType>
+inline Napi::Object wrapCached(Napi::Env env, LLVMType *primitive) {
+    if (primitive == nullptr) {
+        return WrappedType::constructor.New(env, {Napi::External<LLVMType>::New(env, primitive)});
+    }
+    WrapperCache &cache = WrapperCache::Get(env, primitive->getContext());
+    const unsigned kind = getWrapperKind(primitive);
+    Napi::Object wrapper = cache.lookup(primitive, kind);
+    if (wrapper.IsEmpty()) {
+        wrapper = WrappedType::constructor.New(env, {Napi::External<LLVMType>::New(env, primitive)});
+        WrappedType *owned = WrappedType::Unwrap(wrapper);
+        owned->bind(cache.getState(), primitive);
+        cache.insert(primitive, kind, wrapper);
+        cache.retainOwner(*owned, primitive);
+    }
+    return wrapper;
+}
+
+//===--------------------------------------------------------------------===//
+// Register a wrapper which has been constructed from JS rather than wrapCached
+//===--------------------------------------------------------------------===//
+
+template<typename LLVMType>
+inline void registerCached(ContextOwned &owned, const Napi::Object &wrapper, LLVMType *primitive) {
+    WrapperCache &cache = WrapperCache::Get(wrapper.Env(), primitive->getContext());
+    owned.bind(cache.getState(), primitive);
+    cache.insert(primitive, getWrapperKind(primitive), wrapper);
+    cache.retainOwner(owned, primitive);
+}
@@ -2,4 +2,13 @@
 
 #include "Util/Array.h"
 #include "Util/Inherit.h"
-#include "Util/ErrMsg.h"
\ No newline at end of file
+#include "Util/Dispose.h"
+#include "Util/HierarchyWrapper.h"
+#include "Util/ContextOwned.h"
+#include "Util/ErrMsg.h"
+#include "Util/WrapperCache.h"
+#include "Util/AddonData.h"
+#include "Util/CancellationToken.h"
+#include "Util/ContextWorker.h"
+#include "Util/ThreadPool.h"
+#include "Util/TypeTag.h"
\ No newline at end of file
@@ -80,8 +80,19 @@ declare namespace llvm {
         }
     }
 
+    // customized
+    interface AsyncOptions {
+        // rejects the promise with signal.reason once aborted
+        signal?: AbortSignal;
+        // milliseconds, rejects the promise with a TimeoutError once elapsed
+        timeout?: number;
+    }
+
     function WriteBitcodeToFile(module: Module, filename: string): void;
 
+    // customized
+    function WriteBitcodeToFileAsync(module: Module, filename: string, options?: AsyncOptions): Promise<void>;
+
     namespace config {
         const LLVM_DEFAULT_TARGET_TRIPLE: string;
         const LLVM_HOST_TRIPLE: string;
@@ -92,8 +103,69 @@ declare namespace llvm {
         const LLVM_VERSION_STRING: string;
     }
 
+    // customized
+    interface LLJITOptions {
+        optLevel?: number;
+        numCompileThreads?: number;
+        // compile every function on its first call
+        lazy?: boolean;
+        // with lazy, compile the functions a compiled function calls ahead on the compile threads
+        speculate?: boolean;
+        // compile at CodeGenOpt.None first, then recompile every function called tierUpThreshold times
+        // (1000 by default) in the background with the default pipeline of tierUpLevel (O3 by default)
+        tiered?: boolean;
+        tierUpThreshold?: number;
+        tierUpLevel?: number;
+    }
+
+    // customized
+    type NativeType = 'void' | 'bool' | 'i32' | 'u32' | 'i64' | 'u64' | 'f32' | 'f64' | 'ptr';
+
+    // customized
+    interface NativeSignature {
+        // 'void' when omitted, 'ptr' is only allowed as a param
+        result?: NativeType;
+        params?: NativeType[];
+        // skips the check against the type of the function, for symbols no added module defines
+        unchecked?: boolean;
+    }
+
+    // customized
+    class LLJIT {
+        public constructor(options?: LLJITOptions);
+
+        // the module is compiled in its own LLVMContext, so the JIT takes both: the two wrappers are disposed
+        // afterwards, the values and types of the context throw when used, and the context must not own any
+        // other module
+        public addModule(module: Module): void;
+
+        // the address of the symbol, which is compiled on first lookup
+        public lookup(name: string): bigint;
+
+        // a JS function calling the compiled function through a trampoline: i64 and u64 are passed as bigint,
+        // ptr as the data of a TypedArray or Buffer; the function throws once the JIT is disposed. The signature
+        // is checked against the type of the function defined by an added module, and a TypeError is thrown for
+        // other symbols or for types no signature matches (varargs, i8, i16, structs...) unless it is unchecked
+        public getFunction(name: string, signature: NativeSignature): (...args: any[]) => any;
+
+        // 0 or 1 for a function of a tiered JIT, -1 otherwise
+        public getTier(name: string): number;
+
+        // block until the queued tier-ups have been compiled
+        public waitForTierUps(): void;
+
+        public getTargetTriple(): string;
+
+        public getDataLayout(): DataLayout;
+
+        public dispose(): void;
+    }
+
     class LLVMContext {
         public constructor();
+
+        // customized, frees the modules of the context too; its values and types throw when used afterwards
+        public dispose(): void;
     }
 
     class Attribute {
@@ -185,6 +257,25 @@ declare namespace llvm {
         protected constructor();
     }
 
+    // customized
+    interface InstructionQuery {
+        // opcode number or name, e.g. "call" or "alloca"
+        opcode?: number | string;
+        // name of the function called directly by a call, invoke or callbr
+        calleeName?: string;
+        // Type.TypeID of the result type
+        typeID?: number;
+        // address space of the pointer accessed by a load, store, atomic, GEP or alloca
+        addressSpace?: number;
+        // whether the instruction has any metadata, or the name of a metadata kind it must have
+        hasMetadata?: boolean | string;
+        inEntryBlock?: boolean;
+        // only search the function of this name
+        function?: string;
+        // split the functions across threads
+        parallel?: boolean;
+    }
+
     class Module {
         public static readonly ModFlagBehavior: {
             Error: number;
@@ -227,12 +318,34 @@ declare namespace llvm {
 
         public getGlobalVariable(name: string, allowInternal?: boolean): GlobalVariable | null;
 
+        // customized
+        public getFunctions(): Function[];
+
+        // customized
+        public getGlobalVariables(): GlobalVariable[];
+
         public addModuleFlag(behavior: number, key: string, value: number): void;
 
         public empty(): boolean;
 
         // customized
         public print(): string;
+
+        /**
+         * Print the module on the thread pool. Until the promise settles, the context of the module is locked:
+         * using it, its modules or builders throws.
+         */
+        // customized
+        public printAsync(options?: AsyncOptions): Promise<string>;
+
+        // customized
+        public cursor(): IRCursor;
+
+        // customized
+        public findInstructions(query: InstructionQuery): Instruction[];
+
+        // customized, the values in the module throw when used afterwards
+        public dispose(): void;
     }
 
     class Type {
@@ -537,6 +650,9 @@ declare namespace llvm {
 
         public user_empty(): boolean;
 
+        // customized
+        public getUsers(): User[];
+
         protected constructor();
     }
 
@@ -570,6 +686,9 @@ declare namespace llvm {
 
         public getFirstNonPHI(): Instruction | null;
 
+        // customized
+        public getInstructions(): Instruction[];
+
         public insertInto(parent: Function, insertBefore?: BasicBlock): void;
 
         public removeFromParent(): void;
@@ -596,6 +715,9 @@ declare namespace llvm {
 
         public getNumOperands(): number;
 
+        // customized
+        public getOperands(): Value[];
+
         // duplicated
         public getType(): Type;
 
@@ -674,6 +796,8 @@ declare namespace llvm {
 
     class ConstantDataArray extends Constant {
         public static get(context: LLVMContext, elements: number[]): Constant;
+        // customized
+        public static get(context: LLVMContext, elements: Int8Array | Uint8Array | Uint8ClampedArray | Int16Array | Uint16Array | Int32Array | Uint32Array | BigInt64Array | BigUint64Array | Float32Array | Float64Array): Constant;
 
         public static getString(context: LLVMContext, initializer: string, addNull?: boolean): Constant;
 
@@ -682,6 +806,15 @@ declare namespace llvm {
         protected constructor();
     }
 
+    class ConstantDataVector extends Constant {
+        // customized
+        public static get(context: LLVMContext, elements: Int8Array | Uint8Array | Uint8ClampedArray | Int16Array | Uint16Array | Int32Array | Uint32Array | BigInt64Array | BigUint64Array | Float32Array | Float64Array): Constant;
+
+        public getType(): VectorType;
+
+        protected constructor();
+    }
+
     class ConstantExpr extends Constant {
         /**
          * getAlignOf constant expr - computes the alignment of a type in a target
@@ -835,6 +968,9 @@ declare namespace llvm {
 
         public getArg(i: number): Argument;
 
+        // customized
+        public getArguments(): Argument[];
+
         public getReturnType(): Type;
 
         // customized
@@ -842,6 +978,9 @@ declare namespace llvm {
 
         public getEntryBlock(): BasicBlock;
 
+        // customized
+        public getBasicBlocks(): BasicBlock[];
+
         // extra
         public getExitBlock(): BasicBlock;
 
@@ -1033,6 +1172,19 @@ declare namespace llvm {
     }
 
     class ICmpInst extends Instruction {
+        public static readonly Predicate: {
+            ICMP_EQ: number;
+            ICMP_NE: number;
+            ICMP_UGT: number;
+            ICMP_UGE: number;
+            ICMP_ULT: number;
+            ICMP_ULE: number;
+            ICMP_SGT: number;
+            ICMP_SGE: number;
+            ICMP_SLT: number;
+            ICMP_SLE: number;
+        };
+
         // duplicated
         public getType(): Type;
 
@@ -1043,6 +1195,25 @@ declare namespace llvm {
     }
 
     class FCmpInst extends Instruction {
+        public static readonly Predicate: {
+            FCMP_FALSE: number;
+            FCMP_OEQ: number;
+            FCMP_OGT: number;
+            FCMP_OGE: number;
+            FCMP_OLT: number;
+            FCMP_OLE: number;
+            FCMP_ONE: number;
+            FCMP_ORD: number;
+            FCMP_UNO: number;
+            FCMP_UEQ: number;
+            FCMP_UGT: number;
+            FCMP_UGE: number;
+            FCMP_ULT: number;
+            FCMP_ULE: number;
+            FCMP_UNE: number;
+            FCMP_TRUE: number;
+        };
+
         // duplicated
         public getType(): Type;
 
@@ -1760,6 +1931,109 @@ declare namespace llvm {
         public CreateIsNotNull(value: Value, name?: string): Value;
 
         public CreatePtrDiff(elemType: Type, lhs: Value, rhs: Value, name?: string): Value;
+
+        //===--------------------------------------------------------------------===//
+        // Batched emission
+        //===--------------------------------------------------------------------===//
+
+        // customized
+        public static readonly BatchOp: {
+            SetInsertPoint: number;
+            ConstInt: number;
+            Add: number;
+            FAdd: number;
+            Sub: number;
+            FSub: number;
+            Mul: number;
+            FMul: number;
+            UDiv: number;
+            SDiv: number;
+            FDiv: number;
+            URem: number;
+            SRem: number;
+            FRem: number;
+            Shl: number;
+            LShr: number;
+            AShr: number;
+            And: number;
+            Or: number;
+            Xor: number;
+            Neg: number;
+            FNeg: number;
+            Not: number;
+            ICmp: number;
+            FCmp: number;
+            Trunc: number;
+            ZExt: number;
+            SExt: number;
+            FPToUI: number;
+            FPToSI: number;
+            UIToFP: number;
+            SIToFP: number;
+            FPTrunc: number;
+            FPExt: number;
+            PtrToInt: number;
+            IntToPtr: number;
+            BitCast: number;
+            Alloca: number;
+            Load: number;
+            Store: number;
+            GEP: number;
+            InBoundsGEP: number;
+            Call: number;
+            Select: number;
+            PHI: number;
+            AddIncoming: number;
+            Ret: number;
+            RetVoid: number;
+            Br: number;
+            CondBr: number;
+            Unreachable: number;
+            ConstInt64: number;
+        };
+
+        // customized
+        public emitBatch(program: Int32Array | ArrayBuffer, values: Value[], types?: Type[], results?: number[]): (Value | null)[];
+
+        // customized
+        public dispose(): void;
+    }
+
+    // customized
+    class IRCursor {
+        public constructor(module: Module);
+
+        /**
+         * Move to the next instruction of the module, entering the following blocks and functions
+         */
+        public next(): boolean;
+
+        public nextFunction(): boolean;
+
+        public nextBasicBlock(): boolean;
+
+        public nextInstruction(): boolean;
+
+        public reset(): void;
+
+        /**
+         * The opcode of the current instruction, 0 when pointing at a function or basic block
+         */
+        public getOpcode(): number;
+
+        public getOpcodeName(): string;
+
+        public getNumOperands(): number;
+
+        public getTypeID(): number;
+
+        public getName(): string;
+
+        public getFunction(): Function | null;
+
+        public getBasicBlock(): BasicBlock | null;
+
+        public getInstruction(): Instruction | null;
     }
 
     namespace IRBuilder {
@@ -1968,6 +2242,9 @@ declare namespace llvm {
 
     function verifyModule(module: Module): boolean;
 
+    // customized
+    function verifyModuleAsync(module: Module, options?: AsyncOptions): Promise<boolean>;
+
     namespace Intrinsic {
         const abs: number;
         const addressofreturnaddress: number;
@@ -2279,7 +2556,10 @@ declare namespace llvm {
         function getDeclaration(module: Module, id: number, types?: Type[]): Function;
     }
 
-    function parseIRFile(filename: string, err: SMDiagnostic, context: LLVMContext): Module;
+    function parseIRFile(filename: string, err: SMDiagnostic, context: LLVMContext): Module | null;
+
+    // customized
+    function parseIRFileAsync(filename: string, err: SMDiagnostic, context: LLVMContext, options?: AsyncOptions): Promise<Module | null>;
 
     class Linker {
         public constructor(module: Module);
@@ -2289,8 +2569,208 @@ declare namespace llvm {
         public static linkModules(destModule: Module, srcModule: Module): boolean;
     }
 
+    namespace OptimizationLevel {
+        const O0: number;
+        const O1: number;
+        const O2: number;
+        const O3: number;
+        const Os: number;
+        const Oz: number;
+    }
+
+    interface PipelineTuningOptions {
+        loopInterleaving?: boolean;
+        loopVectorization?: boolean;
+        slpVectorization?: boolean;
+        loopUnrolling?: boolean;
+        forgetAllSCEVInLoopUnroll?: boolean;
+        callGraphProfile?: boolean;
+        mergeFunctions?: boolean;
+    }
+
+    // customized, once the signal is aborted or the timeout elapsed, the optional passes are skipped and the run
+    // throws the reason, leaving the IR valid but only partly optimized
+    interface PassRunOptions extends AsyncOptions {
+        // a record per pass run on an IR unit
+        instrument?: boolean;
+        // the llvm::Statistic counters which moved during the run, empty if LLVM was built without statistics
+        statistics?: boolean;
+    }
+
+    // customized
+    interface PassRecord {
+        // the class name, like 'InstCombinePass'
+        pass: string;
+        // the name in textual pipelines, like 'instcombine'
+        passName: string;
+        unit: 'module' | 'cgscc' | 'function' | 'loop';
+        name: string;
+        // milliseconds
+        elapsed: number;
+        instructionsBefore: number;
+        instructionsAfter: number;
+        changed: boolean;
+        // the unit was deleted by the pass
+        invalidated: boolean;
+    }
+
+    // customized
+    interface PassReport {
+        passes: PassRecord[];
+        statistics: { [name: string]: number };
+    }
+
+    class PassBuilder {
+        // the cost models of the optimizers come from the machine when there is one
+        public constructor(targetMachine?: TargetMachine | null, options?: PipelineTuningOptions);
+
+        // customized, buildO0DefaultPipeline or buildPerModuleDefaultPipeline run over the module
+        public runDefaultPipeline(module: Module, level: number): void;
+        public runDefaultPipeline(module: Module, level: number, options: PassRunOptions): PassReport;
+
+        // customized, a textual pipeline like 'function(mem2reg,instcombine)' parsed by parsePassPipeline
+        public runPassPipeline(module: Module, pipeline: string): void;
+        public runPassPipeline(module: Module, pipeline: string, options: PassRunOptions): PassReport;
+
+        // customized, the default pipeline of a level or a textual pipeline run on the libuv thread pool, while the
+        // context of the module is locked and the machine busy
+        public runAsync(module: Module, levelOrPipeline: number | string): Promise<void>;
+        public runAsync(module: Module, levelOrPipeline: number | string, options: PassRunOptions): Promise<PassReport>;
+    }
+
+    // customized, the analyses the passes preserve are kept between runs, call invalidate() on a function
+    // changed outside of the manager before running it again
+    class FunctionPassManager {
+        // a function pipeline like 'mem2reg,instcombine,simplifycfg,gvn'
+        public constructor(pipeline: string, passBuilder?: PassBuilder);
+
+        public run(func: Function): void;
+        public run(func: Function, options: PassRunOptions): PassReport;
+
+        public invalidate(func: Function): void;
+
+        public clear(): void;
+
+        public dispose(): void;
+    }
+
+    // customized
+    interface PipelineStage {
+        kind: 'verify' | 'print' | 'link' | 'optimize' | 'writeBitcode' | 'writeIR' | 'emit';
+        // the module linked in, or the file written
+        file?: string;
+        // of an optimize stage, a value of llvm.OptimizationLevel, O2 by default
+        level?: number;
+        // of an optimize stage, a textual pipeline like 'function(mem2reg,instcombine)' run instead of the level's
+        pipeline?: string;
+        // of an emit stage, 'obj' by default
+        fileType?: 'obj' | 'asm';
+        // of an emit stage, the triple of the module or else the host by default; an optimize stage only uses the
+        // cost models of a target when it or the module has a triple
+        triple?: string;
+        cpu?: string;
+        features?: string;
+        options?: TargetMachineOptions;
+    }
+
+    // customized
+    interface PipelineJob extends AsyncOptions {
+        name?: string;
+        // names of the jobs which have to complete before this one starts
+        after?: string[];
+        // the input, either an IR or bitcode file or IR text
+        file?: string;
+        ir?: string;
+        stages?: PipelineStage[];
+        // bytes held while the job runs, estimated from the input size by default
+        memoryEstimate?: number;
+    }
+
+    // customized
+    interface PipelineResult {
+        name: string;
+        // the module printed by a print stage
+        ir?: string;
+    }
+
+    // customized
+    class Pipeline {
+        public constructor(options?: { concurrency?: number; memoryBudget?: number });
+
+        public submit(job: PipelineJob): Promise<PipelineResult>;
+
+        public getConcurrency(): number;
+
+        public getMemoryBudget(): number;
+    }
+
+    namespace Reloc {
+        const Static: number;
+        const PIC_: number;
+        const DynamicNoPIC: number;
+        const ROPI: number;
+        const RWPI: number;
+        const ROPI_RWPI: number;
+    }
+
+    namespace CodeModel {
+        const Tiny: number;
+        const Small: number;
+        const Kernel: number;
+        const Medium: number;
+        const Large: number;
+    }
+
+    namespace CodeGenOpt {
+        const None: number;
+        const Less: number;
+        const Default: number;
+        const Aggressive: number;
+    }
+
+    namespace FloatABI {
+        const Default: number;
+        const Soft: number;
+        const Hard: number;
+    }
+
+    namespace FPOpFusion {
+        const Fast: number;
+        const Standard: number;
+        const Strict: number;
+    }
+
+    // customized
+    interface TargetMachineOptions {
+        relocModel?: number;
+        codeModel?: number;
+        optLevel?: number;
+        jit?: boolean;
+        // fields of llvm::TargetOptions
+        floatABIType?: number;
+        allowFPOpFusion?: number;
+        unsafeFPMath?: boolean;
+        noInfsFPMath?: boolean;
+        noNaNsFPMath?: boolean;
+        noTrappingFPMath?: boolean;
+        noSignedZerosFPMath?: boolean;
+        approxFuncFPMath?: boolean;
+        enableFastISel?: boolean;
+        enableGlobalISel?: boolean;
+        guaranteedTailCallOpt?: boolean;
+        functionSections?: boolean;
+        dataSections?: boolean;
+        uniqueSectionNames?: boolean;
+        trapUnreachable?: boolean;
+        enableIPRA?: boolean;
+        enableMachineOutliner?: boolean;
+        emitStackSizeSection?: boolean;
+        emitAddrsig?: boolean;
+        emulatedTLS?: boolean;
+    }
+
     class Target {
-        public createTargetMachine(targetTriple: string, cpu: string, features?: string): TargetMachine;
+        public createTargetMachine(targetTriple: string, cpu: string, features?: string, options?: TargetMachineOptions): TargetMachine;
 
         public getName(): string;
 
@@ -2305,6 +2785,41 @@ declare namespace llvm {
         protected constructor();
     }
 
+    // customized
+    interface TargetMachineCacheStats {
+        hits: number;
+        misses: number;
+        evictions: number;
+        // idle machines
+        size: number;
+        capacity: number;
+    }
+
+    // customized, a machine from get() is leased: dispose() or the GC returns it to the idle machines of its key
+    namespace TargetMachineCache {
+        function get(targetTriple: string, cpu: string, features?: string, options?: TargetMachineOptions): TargetMachine;
+
+        function getStats(): TargetMachineCacheStats;
+
+        function setCapacity(capacity: number): void;
+
+        function clear(): void;
+    }
+
+    // customized, a machine for llvm.sys.getProcessTriple() with the host CPU and features
+    function createNativeTargetMachine(options?: TargetMachineOptions): TargetMachine;
+
+    namespace sys {
+        function getHostCPUName(): string;
+
+        // customized, the features detected on the host as a sorted "+feature,-feature" string
+        function getHostCPUFeatures(): string;
+
+        function getProcessTriple(): string;
+
+        function getDefaultTargetTriple(): string;
+    }
+
     class SMDiagnostic {
         public constructor();
     }
@@ -2312,6 +2827,23 @@ declare namespace llvm {
     class TargetMachine {
         public createDataLayout(): DataLayout;
 
+        // customized, the IR passes of the code generator modify the module like in llc. A module without a triple or
+        // a data layout gets those of the machine, emitting one that has others throws (or rejects for the async forms)
+        public emitToFile(module: Module, filename: string, fileType: 'obj' | 'asm'): void;
+
+        // customized
+        public emitToBuffer(module: Module, fileType: 'obj' | 'asm'): Buffer;
+
+        // customized, cancelling skips the optional passes right away and stops the code generator before its next
+        // function, the emission is rejected and the module keeps the changes of the passes run until then
+        public emitToFileAsync(module: Module, filename: string, fileType: 'obj' | 'asm', options?: AsyncOptions): Promise<void>;
+
+        // customized
+        public emitToBufferAsync(module: Module, fileType: 'obj' | 'asm', options?: AsyncOptions): Promise<Buffer>;
+
+        // customized
+        public dispose(): void;
+
         protected constructor();
     }
 
@@ -4,13 +4,12 @@
 void APFloat::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "APFloat", {});
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
+    constructor.Reset(env, func);
     exports.Set("APFloat", func);
 }
 
 bool APFloat::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || hasTypeTag(value, TypeTag::APFloat);
 }
 
 llvm::APFloat &APFloat::Extract(const Napi::Value &value) {
@@ -18,6 +17,7 @@ llvm::APFloat &APFloat::Extract(const Napi::Value &value) {
 }
 
 APFloat::APFloat(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::APFloat);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsNumber()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::APFloat::constructor);
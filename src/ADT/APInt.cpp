@@ -4,13 +4,12 @@
 void APInt::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "APInt", {});
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
+    constructor.Reset(env, func);
     exports.Set("APInt", func);
 }
 
 bool APInt::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || hasTypeTag(value, TypeTag::APInt);
 }
 
 llvm::APInt &APInt::Extract(const Napi::Value &value) {
@@ -18,6 +17,7 @@ llvm::APInt &APInt::Extract(const Napi::Value &value) {
 }
 
 APInt::APInt(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::APInt);
     const Napi::Env env = info.Env();
     const unsigned argsLen = info.Length();
     if (!info.IsConstructCall() || argsLen < 2 || !info[0].IsNumber() || !info[1].IsNumber() || argsLen >= 3 && !info[2].IsBoolean()) {
@@ -20,8 +20,61 @@ static void WriteBitcodeToFile(const Napi::CallbackInfo &info) {
     llvm::WriteBitcodeToFile(*module, byteCodeFile);
     byteCodeFile.flush();
     byteCodeFile.close();
+    Module::UpdateExternalMemory(info[0]);
+}
+
+class WriteBitcodeToFileWorker : public ContextWorker {
+public:
+    WriteBitcodeToFileWorker(Napi::Env env, const Napi::Object &moduleObj, Module *wrapper, std::string fileName) :
+            ContextWorker(env, "llvm.WriteBitcodeToFileAsync", wrapper->getContextWrapper()),
+            moduleObj(Napi::Persistent(moduleObj)),
+            module(wrapper->getLLVMPrimitive()),
+            fileName(std::move(fileName)) {
+    }
+
+protected:
+    void Execute() override {
+        if (isCancelled()) {
+            return;
+        }
+        std::error_code errorCode;
+        llvm::raw_fd_ostream byteCodeFile(fileName, errorCode);
+        if (errorCode) {
+            SetError(errorCode.message() + ": " + fileName);
+            return;
+        }
+        llvm::WriteBitcodeToFile(*module, byteCodeFile);
+        byteCodeFile.close();
+        if (byteCodeFile.has_error()) {
+            SetError(byteCodeFile.error().message() + ": " + fileName);
+            byteCodeFile.clear_error();
+        }
+    }
+
+    Napi::Value Resolve(Napi::Env env) override {
+        Module::UpdateExternalMemory(moduleObj.Value());
+        return env.Undefined();
+    }
+
+private:
+    Napi::ObjectReference moduleObj;
+    const llvm::Module *module;
+    std::string fileName;
+};
+
+static Napi::Value WriteBitcodeToFileAsync(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    if (info.Length() < 2 || !info[0].IsObject() || !Module::IsClassOf(info[0]) || !info[1].IsString()) {
+        throw Napi::TypeError::New(env, ErrMsg::Function::WriteBitcodeToFileAsync);
+    }
+    const auto moduleObj = info[0].As<Napi::Object>();
+    auto worker = std::make_unique<WriteBitcodeToFileWorker>(
+            env, moduleObj, Module::Unwrap(moduleObj), info[1].As<Napi::String>());
+    worker->setCancellation(CancellationToken::FromOptions(env, info[2], ErrMsg::Function::WriteBitcodeToFileAsync));
+    return ContextWorker::Start(std::move(worker));
 }
 
 void InitBitcodeWriter(Napi::Env env, Napi::Object &exports) {
     exports.Set("WriteBitcodeToFile", Napi::Function::New(env, WriteBitcodeToFile));
+    exports.Set("WriteBitcodeToFileAsync", Napi::Function::New(env, WriteBitcodeToFileAsync));
 }
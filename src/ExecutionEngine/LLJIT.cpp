@@ -0,0 +1,336 @@
+#include <vector>
+#include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
+#include <llvm/Support/Threading.h>
+#include "ExecutionEngine/index.h"
+#include "IR/index.h"
+#include "Passes/index.h"
+#include "Support/index.h"
+#include "Util/index.h"
+
+void LLJIT::Init(Napi::Env env, Napi::Object &exports) {
+    Napi::HandleScope scope(env);
+    const Napi::Function func = DefineClass(env, "LLJIT", {
+            InstanceMethod("addModule", &LLJIT::guardedVoid<&LLJIT::addModule>),
+            InstanceMethod("lookup", &LLJIT::guarded<&LLJIT::lookup>),
+            InstanceMethod("getFunction", &LLJIT::guarded<&LLJIT::getFunction>),
+            InstanceMethod("getTier", &LLJIT::guarded<&LLJIT::getTier>),
+            InstanceMethod("waitForTierUps", &LLJIT::guardedVoid<&LLJIT::waitForTierUps>),
+            InstanceMethod("getTargetTriple", &LLJIT::guarded<&LLJIT::getTargetTriple>),
+            InstanceMethod("getDataLayout", &LLJIT::guarded<&LLJIT::getDataLayout>),
+            InstanceMethod("dispose", &LLJIT::dispose)
+    });
+    DefineSymbolDispose(env, func);
+    constructor.Reset(env, func);
+    exports.Set("LLJIT", func);
+}
+
+bool LLJIT::IsClassOf(const Napi::Value &value) {
+    return hasTypeTag(value, TypeTag::LLJIT);
+}
+
+LLJIT *LLJIT::Extract(const Napi::Value &value) {
+    return Unwrap(value.As<Napi::Object>());
+}
+
+Napi::Error LLJIT::ToError(Napi::Env env, llvm::Error error) {
+    return Napi::Error::New(env, llvm::toString(std::move(error)));
+}
+
+struct LLJITOptions {
+    bool hasOptLevel = false;
+    unsigned numCompileThreads = 0;
+    bool lazy = false;
+    bool speculate = false;
+    bool tiered = false;
+    TieredCompiler::Options tierUp;
+};
+
+static bool parseBoolean(const Napi::Object &object, const char *name, bool &result) {
+    const Napi::Value value = object.Get(name);
+    if (value.IsUndefined()) {
+        return true;
+    }
+    if (!value.IsBoolean()) {
+        return false;
+    }
+    result = value.As<Napi::Boolean>();
+    return true;
+}
+
+// { optLevel?: number, numCompileThreads?: number, lazy?: boolean, speculate?: boolean,
+//   tiered?: boolean, tierUpThreshold?: number, tierUpLevel?: number }
+static bool parseOptions(const Napi::Value &value, LLJITOptions &options,
+                         llvm::orc::JITTargetMachineBuilder &machineBuilder) {
+    if (value.IsUndefined()) {
+        return true;
+    }
+    if (!value.IsObject()) {
+        return false;
+    }
+    const auto object = value.As<Napi::Object>();
+    const Napi::Value optLevel = object.Get("optLevel");
+    if (!optLevel.IsUndefined()) {
+        if (!optLevel.IsNumber()) {
+            return false;
+        }
+        const int32_t level = optLevel.As<Napi::Number>().Int32Value();
+        if (level < llvm::CodeGenOpt::None || level > llvm::CodeGenOpt::Aggressive) {
+            return false;
+        }
+        machineBuilder.setCodeGenOptLevel(static_cast<llvm::CodeGenOpt::Level>(level));
+        options.hasOptLevel = true;
+    }
+    const Napi::Value numCompileThreads = object.Get("numCompileThreads");
+    if (!numCompileThreads.IsUndefined()) {
+        if (!numCompileThreads.IsNumber() || numCompileThreads.As<Napi::Number>().Int32Value() < 0) {
+            return false;
+        }
+        options.numCompileThreads = numCompileThreads.As<Napi::Number>().Uint32Value();
+    }
+    if (!parseBoolean(object, "lazy", options.lazy) || !parseBoolean(object, "speculate", options.speculate)) {
+        return false;
+    }
+    if (!parseBoolean(object, "tiered", options.tiered) || (options.tiered && (options.lazy || options.hasOptLevel))) {
+        return false;
+    }
+    const Napi::Value tierUpThreshold = object.Get("tierUpThreshold");
+    if (!tierUpThreshold.IsUndefined()) {
+        if (!tierUpThreshold.IsNumber() || tierUpThreshold.As<Napi::Number>().Int64Value() < 1) {
+            return false;
+        }
+        options.tierUp.threshold = tierUpThreshold.As<Napi::Number>().Int64Value();
+    }
+    const Napi::Value tierUpLevel = object.Get("tierUpLevel");
+    if (!tierUpLevel.IsUndefined() && (!PassBuilder::ParseOptimizationLevel(tierUpLevel, options.tierUp.level) ||
+                                       options.tierUp.level == llvm::OptimizationLevel::O0)) {
+        return false;
+    }
+    if (options.speculate) {
+        if (!options.lazy) {
+            return false;
+        }
+        // speculative compiles are only worth it off the JS thread
+        if (options.numCompileThreads == 0) {
+            options.numCompileThreads = llvm::hardware_concurrency().compute_thread_count();
+        }
+    }
+    return true;
+}
+
+template<typename BuilderT>
+static auto createJIT(llvm::orc::JITTargetMachineBuilder machineBuilder, const LLJITOptions &options) {
+    BuilderT builder;
+    builder.setJITTargetMachineBuilder(std::move(machineBuilder));
+    builder.setNumCompileThreads(options.numCompileThreads);
+    return builder.create();
+}
+
+LLJIT::LLJIT(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::LLJIT);
+    const Napi::Env env = info.Env();
+    if (!info.IsConstructCall() || info.Length() > 1) {
+        throw Napi::TypeError::New(env, ErrMsg::Class::LLJIT::constructor);
+    }
+    if (!InitializeNativeCodeGen()) {
+        throw Napi::Error::New(env, ErrMsg::Class::LLJIT::nativeTarget);
+    }
+    llvm::Expected<llvm::orc::JITTargetMachineBuilder> machineBuilder = llvm::orc::JITTargetMachineBuilder::detectHost();
+    if (!machineBuilder) {
+        throw ToError(env, machineBuilder.takeError());
+    }
+    LLJITOptions options;
+    if (!parseOptions(info[0], options, *machineBuilder)) {
+        throw Napi::TypeError::New(env, ErrMsg::Class::LLJIT::constructor);
+    }
+    if (options.lazy) {
+        auto created = createJIT<llvm::orc::LLLazyJITBuilder>(std::move(*machineBuilder), options);
+        if (!created) {
+            throw ToError(env, created.takeError());
+        }
+        if (options.speculate) {
+            speculator = std::make_shared<SpeculativeCompiler>(**created);
+            SpeculativeCompiler::Install(**created, speculator);
+        }
+        jit = std::move(*created);
+        lazy = true;
+    } else if (options.tiered) {
+        llvm::orc::JITTargetMachineBuilder optimizedBuilder = *machineBuilder;
+        optimizedBuilder.setCodeGenOptLevel(options.tierUp.level == llvm::OptimizationLevel::O3
+                                            ? llvm::CodeGenOpt::Aggressive : llvm::CodeGenOpt::Default);
+        machineBuilder->setCodeGenOptLevel(llvm::CodeGenOpt::None);
+        auto created = createJIT<llvm::orc::LLJITBuilder>(std::move(*machineBuilder), options);
+        if (!created) {
+            throw ToError(env, created.takeError());
+        }
+        jit = std::move(*created);
+        tiered = std::make_unique<TieredCompiler>(*jit, std::move(optimizedBuilder), options.tierUp);
+    } else {
+        auto created = createJIT<llvm::orc::LLJITBuilder>(std::move(*machineBuilder), options);
+        if (!created) {
+            throw ToError(env, created.takeError());
+        }
+        jit = std::move(*created);
+    }
+    // generated code may call into the C library and everything else loaded in the process
+    auto generator = llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(
+            jit->getDataLayout().getGlobalPrefix());
+    if (!generator) {
+        throw ToError(env, generator.takeError());
+    }
+    jit->getMainJITDylib().addGenerator(std::move(*generator));
+}
+
+bool LLJIT::isDisposed() {
+    return jit == nullptr;
+}
+
+llvm::orc::LLJIT *LLJIT::getLLVMPrimitive() {
+    return jit.get();
+}
+
+llvm::orc::ThreadSafeModule LLJIT::TakeModule(Napi::Env env, const Napi::Value &module) {
+    Module *moduleWrapper = Module::Unwrap(module.As<Napi::Object>());
+    LLVMContext *contextWrapper = moduleWrapper->isDisposed() ? nullptr : moduleWrapper->getContextWrapper();
+    if (contextWrapper == nullptr || contextWrapper->getModuleCount() != 1) {
+        throw Napi::Error::New(env, ErrMsg::Class::LLJIT::takeModule);
+    }
+    std::unique_ptr<llvm::Module> released = Module::Release(module);
+    std::unique_ptr<llvm::LLVMContext> context = contextWrapper->release();
+    return {std::move(released), llvm::orc::ThreadSafeContext(std::move(context))};
+}
+
+// lookups return addresses through these, whichever of the two the ORC version hands out
+static uint64_t toAddress(const llvm::orc::ExecutorAddr &address) {
+    return address.getValue();
+}
+
+static uint64_t toAddress(const llvm::JITEvaluatedSymbol &symbol) {
+    return symbol.getAddress();
+}
+
+uint64_t LLJIT::LookupAddress(Napi::Env env, llvm::orc::LLJIT &jit, const std::string &name) {
+    auto symbol = jit.lookup(name);
+    if (!symbol) {
+        throw ToError(env, symbol.takeError());
+    }
+    return toAddress(*symbol);
+}
+
+// a lazy lookup returns the stub of the function, start compiling the body before the first call
+void LLJIT::speculateBody(const std::string &name) {
+    if (speculator) {
+        speculator->request({name});
+    }
+}
+
+llvm::Error LLJIT::addIRModule(llvm::orc::ThreadSafeModule module) {
+    if (tiered) {
+        return tiered->addModule(std::move(module));
+    }
+    if (!lazy) {
+        return jit->addIRModule(std::move(module));
+    }
+    if (speculator) {
+        module.withModuleDo([this](llvm::Module &m) {
+            speculator->addCandidates(m);
+        });
+    }
+    return static_cast<llvm::orc::LLLazyJIT &>(*jit).addLazyIRModule(std::move(module));
+}
+
+void LLJIT::addModule(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    if (info.Length() != 1 || !Module::IsClassOf(info[0]) || !info[0].IsObject()) {
+        throw Napi::TypeError::New(env, ErrMsg::Class::LLJIT::addModule);
+    }
+    llvm::orc::ThreadSafeModule module = TakeModule(env, info[0]);
+    std::vector<std::pair<std::string, std::string>> defined;
+    module.withModuleDo([&defined](llvm::Module &m) {
+        for (const llvm::Function &function: m) {
+            if (!function.isDeclaration() && !function.hasLocalLinkage()) {
+                defined.emplace_back(function.getName().str(), Trampoline::GetTypeKey(*function.getFunctionType()));
+            }
+        }
+    });
+    if (llvm::Error error = addIRModule(std::move(module))) {
+        throw ToError(env, std::move(error));
+    }
+    typeKeys.insert(defined.begin(), defined.end());
+}
+
+Napi::Value LLJIT::lookup(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    if (info.Length() != 1 || !info[0].IsString()) {
+        throw Napi::TypeError::New(env, ErrMsg::Class::LLJIT::lookup);
+    }
+    const std::string name = info[0].As<Napi::String>();
+    const uint64_t address = LookupAddress(env, *jit, name);
+    speculateBody(name);
+    return Napi::BigInt::New(env, address);
+}
+
+Napi::Value LLJIT::getFunction(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    Trampoline::Signature signature;
+    if (info.Length() != 2 || !info[0].IsString() || !signature.parse(info[1])) {
+        throw Napi::TypeError::New(env, ErrMsg::Class::LLJIT::getFunction);
+    }
+    const std::string name = info[0].As<Napi::String>();
+    // a symbol no added module defines, or whose type no trampoline passes the arguments of, has no signature to
+    // check against: calling it through a mismatched one is undefined behavior, so it takes an explicit opt-in
+    if (!signature.unchecked) {
+        const auto typeKey = typeKeys.find(name);
+        if (typeKey == typeKeys.end() || typeKey->second.empty() || typeKey->second != signature.typeKey()) {
+            throw Napi::TypeError::New(env, ErrMsg::Class::LLJIT::getFunction);
+        }
+    }
+    std::unique_ptr<Trampoline::CallTarget> &callTarget = callTargets[name + ':' + signature.key()];
+    if (callTarget == nullptr) {
+        void *address = reinterpret_cast<void *>(LookupAddress(env, *jit, name));
+        speculateBody(name);
+        callTarget = std::make_unique<Trampoline::CallTarget>(Trampoline::CallTarget{address});
+    }
+    const napi_callback callback = Trampoline::Get(env, signature);
+    napi_value function;
+    const napi_status status = napi_create_function(env, name.c_str(), name.size(), callback, callTarget.get(),
+                                                    &function);
+    NAPI_THROW_IF_FAILED(env, status, Napi::Value());
+    // the call targets live as long as this wrapper
+    const Napi::Function result(env, function);
+    WrapperCache::RetainOwner(result, Value());
+    return result;
+}
+
+Napi::Value LLJIT::getTier(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    if (info.Length() != 1 || !info[0].IsString()) {
+        throw Napi::TypeError::New(env, ErrMsg::Class::LLJIT::getTier);
+    }
+    return Napi::Number::New(env, tiered ? tiered->getTier(info[0].As<Napi::String>()) : -1);
+}
+
+void LLJIT::waitForTierUps(const Napi::CallbackInfo &info) {
+    if (tiered) {
+        tiered->wait();
+    }
+}
+
+Napi::Value LLJIT::getTargetTriple(const Napi::CallbackInfo &info) {
+    return Napi::String::New(info.Env(), jit->getTargetTriple().str());
+}
+
+Napi::Value LLJIT::getDataLayout(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    return DataLayout::constructor.New(env, {Napi::String::New(env, jit->getDataLayout().getStringRepresentation())});
+}
+
+void LLJIT::dispose(const Napi::CallbackInfo &info) {
+    for (const auto &[key, callTarget]: callTargets) {
+        callTarget->address = nullptr;
+    }
+    // before the JIT the tier-ups compile into
+    tiered.reset();
+    jit.reset();
+    speculator.reset();
+}
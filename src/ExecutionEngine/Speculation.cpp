@@ -0,0 +1,64 @@
+#include <llvm/ExecutionEngine/Orc/Core.h>
+#include "ExecutionEngine/Speculation.h"
+
+SpeculativeCompiler::SpeculativeCompiler(llvm::orc::LLLazyJIT &jit) : jit(jit) {
+}
+
+void SpeculativeCompiler::Install(llvm::orc::LLLazyJIT &jit, std::shared_ptr<SpeculativeCompiler> speculator) {
+    jit.getIRTransformLayer().setTransform(
+            [speculator](llvm::orc::ThreadSafeModule module, const llvm::orc::MaterializationResponsibility &) {
+                module.withModuleDo([&](llvm::Module &m) {
+                    speculator->speculate(m);
+                });
+                return llvm::Expected<llvm::orc::ThreadSafeModule>(std::move(module));
+            });
+}
+
+void SpeculativeCompiler::addCandidates(const llvm::Module &module) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const llvm::Function &function: module) {
+        // local functions are renamed when the compile-on-demand layer splits the module
+        if (!function.isDeclaration() && !function.hasLocalLinkage()) {
+            candidates.insert(function.getName().str());
+        }
+    }
+}
+
+void SpeculativeCompiler::speculate(const llvm::Module &module) {
+    // a partition holds the function being compiled and declarations of what it refers to
+    std::vector<std::string> names;
+    for (const llvm::Function &function: module) {
+        if (function.isDeclaration() && !function.use_empty()) {
+            names.push_back(function.getName().str());
+        }
+    }
+    request(names);
+}
+
+void SpeculativeCompiler::request(const std::vector<std::string> &names) {
+    llvm::orc::SymbolLookupSet symbols;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const std::string &name: names) {
+            if (candidates.erase(name) != 0) {
+                symbols.add(jit.mangleAndIntern(name));
+            }
+        }
+    }
+    if (symbols.empty()) {
+        return;
+    }
+    llvm::orc::ExecutionSession &session = jit.getExecutionSession();
+    // the function bodies live in the implementation JITDylib, the main one only holds their stubs
+    llvm::orc::JITDylib *impl = session.getJITDylibByName(jit.getMainJITDylib().getName() + ".impl");
+    if (impl == nullptr) {
+        return;
+    }
+    session.lookup(llvm::orc::LookupKind::Static,
+                   llvm::orc::makeJITDylibSearchOrder({impl}, llvm::orc::JITDylibLookupFlags::MatchAllSymbols),
+                   std::move(symbols), llvm::orc::SymbolState::Ready,
+                   [](llvm::Expected<llvm::orc::SymbolMap> result) {
+                       // a function failing to compile fails again when it is called
+                       llvm::consumeError(result.takeError());
+                   }, llvm::orc::NoDependenciesToRegister);
+}
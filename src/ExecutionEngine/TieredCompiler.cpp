@@ -0,0 +1,248 @@
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/ExecutionEngine/Orc/CompileUtils.h>
+#include <llvm/ExecutionEngine/Orc/Core.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Transforms/Utils/BasicBlockUtils.h>
+#include "ExecutionEngine/TieredCompiler.h"
+
+static const char *const tier0Suffix = ".tier0";
+static const char *const tier1Suffix = ".tier1";
+
+TieredCompiler::TieredCompiler(llvm::orc::LLJIT &jit, llvm::orc::JITTargetMachineBuilder optimizedBuilder,
+                               const Options &options)
+        : jit(jit), optimizedBuilder(optimizedBuilder),
+          optimizedLayer(jit.getExecutionSession(), jit.getObjLinkingLayer(),
+                         std::make_unique<llvm::orc::ConcurrentIRCompiler>(optimizedBuilder)),
+          stubs(llvm::orc::createLocalIndirectStubsManagerBuilder(jit.getTargetTriple())()),
+          options(options) {
+}
+
+TieredCompiler::~TieredCompiler() {
+    wait();
+}
+
+void TieredCompiler::OnHot(FunctionTier *function) {
+    TieredCompiler &compiler = *function->compiler;
+    {
+        std::lock_guard<std::mutex> lock(compiler.mutex);
+        ++compiler.pending;
+    }
+    compiler.pool.async([&compiler, function]() {
+        // the function keeps running its tier-0 code
+        llvm::consumeError(compiler.tierUp(*function));
+        std::lock_guard<std::mutex> lock(compiler.mutex);
+        if (--compiler.pending == 0) {
+            compiler.idle.notify_all();
+        }
+    });
+}
+
+static llvm::Constant *getHostPointer(llvm::Type *type, const void *pointer) {
+    llvm::LLVMContext &context = type->getContext();
+    llvm::Constant *address = llvm::ConstantInt::get(llvm::Type::getInt64Ty(context), reinterpret_cast<uintptr_t>(pointer));
+    return llvm::ConstantExpr::getIntToPtr(address, type);
+}
+
+// count the call at the entry, after the static allocas, and report the one reaching the threshold
+void TieredCompiler::instrument(llvm::Function &function, FunctionTier &tier) {
+    llvm::BasicBlock &entry = function.getEntryBlock();
+    llvm::BasicBlock::iterator insertPoint = entry.getFirstInsertionPt();
+    while (llvm::isa<llvm::AllocaInst>(*insertPoint)) {
+        ++insertPoint;
+    }
+    llvm::IRBuilder<> builder(&entry, insertPoint);
+    llvm::Type *countType = builder.getInt64Ty();
+    llvm::Value *counter = getHostPointer(countType->getPointerTo(), &tier.calls);
+    llvm::Value *previous = builder.CreateAtomicRMW(llvm::AtomicRMWInst::Add, counter, builder.getInt64(1),
+                                                    llvm::MaybeAlign(8), llvm::AtomicOrdering::Monotonic);
+    llvm::Value *isHot = builder.CreateICmpEQ(previous, builder.getInt64(options.threshold - 1));
+    llvm::Instruction *notify = llvm::SplitBlockAndInsertIfThen(isHot, &*builder.GetInsertPoint(), false);
+    builder.SetInsertPoint(notify);
+    llvm::Type *tierType = builder.getInt8PtrTy();
+    auto *onHotType = llvm::FunctionType::get(builder.getVoidTy(), {tierType}, false);
+    llvm::Value *onHot = getHostPointer(onHotType->getPointerTo(), reinterpret_cast<const void *>(&OnHot));
+    builder.CreateCall(onHotType, onHot, {getHostPointer(tierType, &tier)});
+}
+
+llvm::Error TieredCompiler::addModule(llvm::orc::ThreadSafeModule module) {
+    const unsigned moduleIndex = moduleCount++;
+    std::vector<FunctionTier *> added;
+    auto bitcode = std::make_shared<llvm::SmallVector<char, 0>>();
+    std::string duplicate;
+    module.withModuleDo([&](llvm::Module &m) {
+        std::vector<llvm::Function *> tiered;
+        for (llvm::Function &function: m) {
+            if (!function.isDeclaration() && !function.hasLocalLinkage()) {
+                tiered.push_back(&function);
+            }
+        }
+        {
+            // checked before anything changes: replacing the tier of a function would free the counter and the
+            // callback its tier-0 code still uses
+            std::lock_guard<std::mutex> lock(mutex);
+            for (const llvm::Function *function: tiered) {
+                if (functions.count(function->getName().str()) != 0) {
+                    duplicate = function->getName().str();
+                    return;
+                }
+            }
+        }
+
+        // the tier-up code refers to the globals of the tier-0 code, so none of them can stay local
+        for (llvm::GlobalVariable &global: m.globals()) {
+            if (global.hasLocalLinkage()) {
+                global.setName("tier." + llvm::Twine(moduleIndex) + "." + global.getName());
+                global.setLinkage(llvm::GlobalValue::ExternalLinkage);
+                global.setVisibility(llvm::GlobalValue::HiddenVisibility);
+            }
+        }
+        llvm::raw_svector_ostream stream(*bitcode);
+        llvm::WriteBitcodeToFile(m, stream);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for (llvm::Function *function: tiered) {
+            const std::string name = function->getName().str();
+            auto tier = std::make_unique<FunctionTier>();
+            tier->compiler = this;
+            tier->name = name;
+            tier->bitcode = bitcode;
+            // every call goes through the stub from now on
+            function->setName(name + tier0Suffix);
+            llvm::Function *stub = llvm::Function::Create(function->getFunctionType(), llvm::GlobalValue::ExternalLinkage,
+                                                          name, m);
+            stub->setCallingConv(function->getCallingConv());
+            stub->setAttributes(function->getAttributes());
+            function->replaceAllUsesWith(stub);
+            instrument(*function, *tier);
+            added.push_back(tier.get());
+            functions[name] = std::move(tier);
+        }
+    });
+    if (!duplicate.empty()) {
+        return llvm::make_error<llvm::orc::DuplicateDefinition>(duplicate);
+    }
+
+    llvm::orc::IndirectStubsManager::StubInitsMap stubInits;
+    for (const FunctionTier *function: added) {
+        stubInits[function->name] = {0, llvm::JITSymbolFlags::Exported | llvm::JITSymbolFlags::Callable};
+    }
+    if (llvm::Error error = stubs->createStubs(stubInits)) {
+        return error;
+    }
+    llvm::orc::SymbolMap stubSymbols;
+    llvm::orc::SymbolLookupSet tier0Symbols;
+    for (const FunctionTier *function: added) {
+        stubSymbols[jit.mangleAndIntern(function->name)] = stubs->findStub(function->name, false);
+        tier0Symbols.add(jit.mangleAndIntern(function->name + tier0Suffix));
+    }
+    llvm::orc::JITDylib &mainJITDylib = jit.getMainJITDylib();
+    if (llvm::Error error = mainJITDylib.define(llvm::orc::absoluteSymbols(std::move(stubSymbols)))) {
+        return error;
+    }
+    if (llvm::Error error = jit.addIRModule(std::move(module))) {
+        return error;
+    }
+    // compile the whole module now and point the stubs at it
+    llvm::Expected<llvm::orc::SymbolMap> compiled = jit.getExecutionSession().lookup(
+            llvm::orc::makeJITDylibSearchOrder(&mainJITDylib), std::move(tier0Symbols));
+    if (!compiled) {
+        return compiled.takeError();
+    }
+    for (const FunctionTier *function: added) {
+        const llvm::JITEvaluatedSymbol &symbol = (*compiled)[jit.mangleAndIntern(function->name + tier0Suffix)];
+        if (llvm::Error error = stubs->updatePointer(function->name, symbol.getAddress())) {
+            return error;
+        }
+    }
+    return llvm::Error::success();
+}
+
+int TieredCompiler::getTier(const std::string &name) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto iter = functions.find(name);
+    return iter == functions.end() ? -1 : iter->second->tier.load();
+}
+
+void TieredCompiler::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this]() {
+        return pending == 0;
+    });
+}
+
+// the function alone, everything else it refers to being reached through the tier-0 module and the stubs
+static void isolateFunction(llvm::Module &module, llvm::Function &target) {
+    for (llvm::GlobalAlias &alias: llvm::make_early_inc_range(module.aliases())) {
+        alias.replaceAllUsesWith(alias.getAliasee());
+        alias.eraseFromParent();
+    }
+    for (llvm::GlobalVariable &global: llvm::make_early_inc_range(module.globals())) {
+        if (global.getName().startswith("llvm.")) {
+            global.eraseFromParent();
+        } else if (!global.isDeclaration()) {
+            global.setInitializer(nullptr);
+            global.setComdat(nullptr);
+            global.setLinkage(llvm::GlobalValue::ExternalLinkage);
+        }
+    }
+    for (llvm::Function &function: module) {
+        if (&function != &target && !function.isDeclaration() && !function.hasLocalLinkage()) {
+            function.deleteBody();
+            function.setComdat(nullptr);
+        }
+    }
+    target.setComdat(nullptr);
+}
+
+llvm::Error TieredCompiler::tierUp(FunctionTier &function) {
+    auto context = std::make_unique<llvm::LLVMContext>();
+    const llvm::MemoryBufferRef buffer(llvm::StringRef(function.bitcode->data(), function.bitcode->size()), function.name);
+    llvm::Expected<std::unique_ptr<llvm::Module>> parsed = llvm::parseBitcodeFile(buffer, *context);
+    if (!parsed) {
+        return parsed.takeError();
+    }
+    llvm::Module &module = **parsed;
+    llvm::Function *target = module.getFunction(function.name);
+    if (target == nullptr) {
+        return llvm::createStringError(llvm::inconvertibleErrorCode(), "no function named " + function.name);
+    }
+    isolateFunction(module, *target);
+    target->setName(function.name + tier1Suffix);
+
+    llvm::Expected<std::unique_ptr<llvm::TargetMachine>> machine = optimizedBuilder.createTargetMachine();
+    if (!machine) {
+        return machine.takeError();
+    }
+    {
+        // declared in this order so that they are destroyed in the reverse one
+        llvm::LoopAnalysisManager loopAnalyses;
+        llvm::FunctionAnalysisManager functionAnalyses;
+        llvm::CGSCCAnalysisManager cgsccAnalyses;
+        llvm::ModuleAnalysisManager moduleAnalyses;
+        llvm::PassBuilder builder(machine->get());
+        builder.registerModuleAnalyses(moduleAnalyses);
+        builder.registerCGSCCAnalyses(cgsccAnalyses);
+        builder.registerFunctionAnalyses(functionAnalyses);
+        builder.registerLoopAnalyses(loopAnalyses);
+        builder.crossRegisterProxies(loopAnalyses, functionAnalyses, cgsccAnalyses, moduleAnalyses);
+        builder.buildPerModuleDefaultPipeline(options.level).run(module, moduleAnalyses);
+    }
+
+    if (llvm::Error error = optimizedLayer.add(jit.getMainJITDylib(),
+                                               llvm::orc::ThreadSafeModule(std::move(*parsed), std::move(context)))) {
+        return error;
+    }
+    auto symbol = jit.lookup(function.name + tier1Suffix);
+    if (!symbol) {
+        return symbol.takeError();
+    }
+    if (llvm::Error error = stubs->updatePointer(function.name, symbol->getAddress())) {
+        return error;
+    }
+    function.tier = 1;
+    return llvm::Error::success();
+}
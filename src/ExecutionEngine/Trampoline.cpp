@@ -0,0 +1,463 @@
+#include <mutex>
+#include <unordered_map>
+#include <llvm/ExecutionEngine/Orc/Core.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Module.h>
+#include "ExecutionEngine/index.h"
+#include "Support/index.h"
+#include "Util/index.h"
+
+using Trampoline::Kind;
+
+static const std::pair<const char *, Kind> kindNames[] = {
+        {"void", Kind::Void},
+        {"bool", Kind::Bool},
+        {"i32", Kind::I32},
+        {"u32", Kind::U32},
+        {"i64", Kind::I64},
+        {"u64", Kind::U64},
+        {"f32", Kind::F32},
+        {"f64", Kind::F64},
+        {"ptr", Kind::Ptr}
+};
+
+static bool parseKind(const Napi::Value &value, Kind &kind) {
+    if (!value.IsString()) {
+        return false;
+    }
+    const std::string name = value.As<Napi::String>();
+    for (const auto &[kindName, kindValue]: kindNames) {
+        if (name == kindName) {
+            kind = kindValue;
+            return true;
+        }
+    }
+    return false;
+}
+
+static const char *getKindName(Kind kind) {
+    for (const auto &[kindName, kindValue]: kindNames) {
+        if (kind == kindValue) {
+            return kindName;
+        }
+    }
+    return "";
+}
+
+bool Trampoline::Signature::parse(const Napi::Value &value) {
+    if (!value.IsObject()) {
+        return false;
+    }
+    const auto object = value.As<Napi::Object>();
+    const Napi::Value uncheckedValue = object.Get("unchecked");
+    if (!uncheckedValue.IsUndefined()) {
+        if (!uncheckedValue.IsBoolean()) {
+            return false;
+        }
+        unchecked = uncheckedValue.As<Napi::Boolean>();
+    }
+    const Napi::Value resultValue = object.Get("result");
+    if (!resultValue.IsUndefined() && (!parseKind(resultValue, result) || result == Kind::Ptr)) {
+        return false;
+    }
+    const Napi::Value paramsValue = object.Get("params");
+    if (paramsValue.IsUndefined()) {
+        return true;
+    }
+    if (!paramsValue.IsArray()) {
+        return false;
+    }
+    const auto paramsArray = paramsValue.As<Napi::Array>();
+    for (uint32_t i = 0; i < paramsArray.Length(); ++i) {
+        Kind kind;
+        if (!parseKind(paramsArray.Get(i), kind) || kind == Kind::Void) {
+            return false;
+        }
+        params.push_back(kind);
+    }
+    return true;
+}
+
+std::string Trampoline::Signature::key() const {
+    std::string result = getKindName(this->result);
+    result += '(';
+    for (size_t i = 0; i < params.size(); ++i) {
+        if (i != 0) {
+            result += ',';
+        }
+        result += getKindName(params[i]);
+    }
+    result += ')';
+    return result;
+}
+
+// the IR type the trampolines pass a value of the kind as
+static const char *getKindTypeName(Kind kind) {
+    switch (kind) {
+        case Kind::Void:
+            return "void";
+        case Kind::Bool:
+            return "i1";
+        case Kind::I32:
+        case Kind::U32:
+            return "i32";
+        case Kind::I64:
+        case Kind::U64:
+            return "i64";
+        case Kind::F32:
+            return "float";
+        case Kind::F64:
+            return "double";
+        default:
+            return "ptr";
+    }
+}
+
+static const char *getTypeName(const llvm::Type *type) {
+    if (type->isVoidTy()) {
+        return "void";
+    } else if (type->isIntegerTy(1)) {
+        return "i1";
+    } else if (type->isIntegerTy(32)) {
+        return "i32";
+    } else if (type->isIntegerTy(64)) {
+        return "i64";
+    } else if (type->isFloatTy()) {
+        return "float";
+    } else if (type->isDoubleTy()) {
+        return "double";
+    } else if (type->isPointerTy() && type->getPointerAddressSpace() == 0) {
+        return "ptr";
+    }
+    return nullptr;
+}
+
+std::string Trampoline::Signature::typeKey() const {
+    std::string result = getKindTypeName(this->result);
+    result += '(';
+    for (size_t i = 0; i < params.size(); ++i) {
+        if (i != 0) {
+            result += ',';
+        }
+        result += getKindTypeName(params[i]);
+    }
+    result += ')';
+    return result;
+}
+
+std::string Trampoline::GetTypeKey(const llvm::FunctionType &type) {
+    const char *resultName = getTypeName(type.getReturnType());
+    if (resultName == nullptr || type.isVarArg()) {
+        return "";
+    }
+    std::string result = resultName;
+    result += '(';
+    for (unsigned i = 0; i < type.getNumParams(); ++i) {
+        const char *paramName = getTypeName(type.getParamType(i));
+        if (paramName == nullptr) {
+            return "";
+        }
+        if (i != 0) {
+            result += ',';
+        }
+        result += paramName;
+    }
+    result += ')';
+    return result;
+}
+
+//===----------------------------------------------------------------------===//
+// Generation of the trampolines
+//===----------------------------------------------------------------------===//
+
+// the N-API functions the trampolines call, bound to the addresses this addon links against
+#define NAPI_TRAMPOLINE_SYMBOLS(X) \
+    X(napi_get_cb_info) \
+    X(napi_get_value_bool) \
+    X(napi_get_value_int32) \
+    X(napi_get_value_uint32) \
+    X(napi_get_value_bigint_int64) \
+    X(napi_get_value_bigint_uint64) \
+    X(napi_get_value_double) \
+    X(napi_get_typedarray_info) \
+    X(napi_get_undefined) \
+    X(napi_get_boolean) \
+    X(napi_create_int32) \
+    X(napi_create_uint32) \
+    X(napi_create_bigint_int64) \
+    X(napi_create_bigint_uint64) \
+    X(napi_create_double) \
+    X(napi_throw_error) \
+    X(napi_throw_type_error)
+
+// napi_value (*)(napi_env env, napi_callback_info info), with every N-API handle as an i8*
+class TrampolineBuilder {
+public:
+    TrampolineBuilder(llvm::Module &module, const Trampoline::Signature &signature)
+            : module(module), builder(module.getContext()), signature(signature) {
+        ptrType = builder.getInt8PtrTy();
+        sizeType = module.getDataLayout().getIntPtrType(module.getContext());
+    }
+
+    void build(const std::string &name) {
+        llvm::LLVMContext &context = module.getContext();
+        auto *function = llvm::Function::Create(llvm::FunctionType::get(ptrType, {ptrType, ptrType}, false),
+                                                llvm::Function::ExternalLinkage, name, module);
+        llvm::Value *env = function->getArg(0);
+        llvm::Value *info = function->getArg(1);
+        auto *entry = llvm::BasicBlock::Create(context, "entry", function);
+        auto *disposed = llvm::BasicBlock::Create(context, "disposed", function);
+        auto *unpack = llvm::BasicBlock::Create(context, "unpack", function);
+        auto *badArguments = llvm::BasicBlock::Create(context, "bad_arguments", function);
+        auto *call = llvm::BasicBlock::Create(context, "call", function);
+
+        builder.SetInsertPoint(entry);
+        const unsigned argc = signature.params.size();
+        llvm::Value *argcSlot = builder.CreateAlloca(sizeType);
+        llvm::Value *argvSlot = builder.CreateAlloca(ptrType, builder.getInt32(std::max(argc, 1u)));
+        llvm::Value *dataSlot = builder.CreateAlloca(ptrType);
+        llvm::Value *resultSlot = builder.CreateAlloca(ptrType);
+        llvm::Value *losslessSlot = builder.CreateAlloca(builder.getInt8Ty());
+        std::vector<llvm::Value *> paramSlots;
+        for (Kind kind: signature.params) {
+            paramSlots.push_back(builder.CreateAlloca(getSlotType(kind)));
+        }
+        builder.CreateStore(llvm::ConstantInt::get(sizeType, argc), argcSlot);
+        // missing arguments come back as undefined, which none of the getters accepts
+        llvm::Value *failed = isFailed(callNapi("napi_get_cb_info", {
+                env, info, argcSlot, argvSlot, getNull(ptrType->getPointerTo()), dataSlot
+        }));
+        // the data is a Trampoline::CallTarget, whose address is its first field
+        llvm::Value *target = builder.CreateLoad(ptrType, dataSlot);
+        llvm::Value *address = builder.CreateLoad(ptrType, builder.CreateBitCast(target, ptrType->getPointerTo()));
+        builder.CreateCondBr(builder.CreateIsNull(address), disposed, unpack);
+
+        builder.SetInsertPoint(disposed);
+        throwError("napi_throw_error", env, ErrMsg::Class::LLJIT::disposed);
+
+        builder.SetInsertPoint(unpack);
+        std::vector<llvm::Type *> paramTypes;
+        std::vector<llvm::Value *> args;
+        for (unsigned i = 0; i < argc; ++i) {
+            const Kind kind = signature.params[i];
+            llvm::Value *arg = builder.CreateLoad(ptrType, builder.CreateConstGEP1_32(ptrType, argvSlot, i));
+            failed = builder.CreateOr(failed, isFailed(unpackArgument(kind, env, arg, paramSlots[i], losslessSlot)));
+            llvm::Value *value = builder.CreateLoad(getSlotType(kind), paramSlots[i]);
+            if (kind == Kind::Bool) {
+                value = builder.CreateICmpNE(value, builder.getInt8(0));
+            } else if (kind == Kind::F32) {
+                value = builder.CreateFPTrunc(value, builder.getFloatTy());
+            }
+            paramTypes.push_back(getNativeType(kind));
+            args.push_back(value);
+        }
+        builder.CreateCondBr(failed, badArguments, call);
+
+        builder.SetInsertPoint(badArguments);
+        throwError("napi_throw_type_error", env, "the native function needs to be called with " + signature.key());
+
+        builder.SetInsertPoint(call);
+        auto *nativeType = llvm::FunctionType::get(getNativeType(signature.result), paramTypes, false);
+        llvm::Value *callee = builder.CreateBitCast(address, nativeType->getPointerTo());
+        llvm::CallInst *returned = builder.CreateCall(nativeType, callee, args);
+        // a C bool is passed zero-extended
+        for (unsigned i = 0; i < argc; ++i) {
+            if (signature.params[i] == Kind::Bool) {
+                returned->addParamAttr(i, llvm::Attribute::ZExt);
+            }
+        }
+        if (signature.result == Kind::Bool) {
+            returned->addRetAttr(llvm::Attribute::ZExt);
+        }
+        boxResult(env, returned, resultSlot);
+        builder.CreateRet(builder.CreateLoad(ptrType, resultSlot));
+    }
+
+private:
+    llvm::Module &module;
+    llvm::IRBuilder<> builder;
+    const Trampoline::Signature &signature;
+    llvm::Type *ptrType;
+    llvm::Type *sizeType;
+
+    // the type the N-API getter writes an argument of the kind as
+    llvm::Type *getSlotType(Kind kind) {
+        switch (kind) {
+            case Kind::Bool:
+                return builder.getInt8Ty();
+            case Kind::I32:
+            case Kind::U32:
+                return builder.getInt32Ty();
+            case Kind::I64:
+            case Kind::U64:
+                return builder.getInt64Ty();
+            case Kind::F32:
+            case Kind::F64:
+                return builder.getDoubleTy();
+            default:
+                return ptrType;
+        }
+    }
+
+    llvm::Type *getNativeType(Kind kind) {
+        switch (kind) {
+            case Kind::Void:
+                return builder.getVoidTy();
+            case Kind::Bool:
+                return builder.getInt1Ty();
+            case Kind::F32:
+                return builder.getFloatTy();
+            default:
+                return getSlotType(kind);
+        }
+    }
+
+    llvm::Constant *getNull(llvm::Type *type) {
+        return llvm::Constant::getNullValue(type);
+    }
+
+    // every N-API function returns a napi_status, declared from the types of the arguments
+    llvm::Value *callNapi(const char *name, llvm::ArrayRef<llvm::Value *> args) {
+        std::vector<llvm::Type *> params;
+        for (llvm::Value *arg: args) {
+            params.push_back(arg->getType());
+        }
+        auto *type = llvm::FunctionType::get(builder.getInt32Ty(), params, false);
+        return builder.CreateCall(module.getOrInsertFunction(name, type), args);
+    }
+
+    llvm::Value *isFailed(llvm::Value *status) {
+        return builder.CreateIsNotNull(status);
+    }
+
+    void throwError(const char *name, llvm::Value *env, const std::string &message) {
+        callNapi(name, {env, getNull(ptrType), builder.CreateGlobalStringPtr(message)});
+        builder.CreateRet(getNull(ptrType));
+    }
+
+    llvm::Value *unpackArgument(Kind kind, llvm::Value *env, llvm::Value *arg, llvm::Value *slot, llvm::Value *lossless) {
+        switch (kind) {
+            case Kind::Bool:
+                return callNapi("napi_get_value_bool", {env, arg, slot});
+            case Kind::I32:
+                return callNapi("napi_get_value_int32", {env, arg, slot});
+            case Kind::U32:
+                return callNapi("napi_get_value_uint32", {env, arg, slot});
+            // the value is truncated to 64 bits as BigInt.asIntN / asUintN would
+            case Kind::I64:
+                return callNapi("napi_get_value_bigint_int64", {env, arg, slot, lossless});
+            case Kind::U64:
+                return callNapi("napi_get_value_bigint_uint64", {env, arg, slot, lossless});
+            case Kind::F32:
+            case Kind::F64:
+                return callNapi("napi_get_value_double", {env, arg, slot});
+            default: {
+                // only the data is asked for, N-API skips the other out pointers when they are null
+                llvm::Constant *nullSize = getNull(sizeType->getPointerTo());
+                return callNapi("napi_get_typedarray_info", {
+                        env, arg, getNull(builder.getInt32Ty()->getPointerTo()), nullSize, slot,
+                        getNull(ptrType->getPointerTo()), nullSize
+                });
+            }
+        }
+    }
+
+    void boxResult(llvm::Value *env, llvm::Value *returned, llvm::Value *resultSlot) {
+        switch (signature.result) {
+            case Kind::Void:
+                callNapi("napi_get_undefined", {env, resultSlot});
+                break;
+            case Kind::Bool:
+                callNapi("napi_get_boolean", {env, builder.CreateZExt(returned, builder.getInt8Ty()), resultSlot});
+                break;
+            case Kind::I32:
+                callNapi("napi_create_int32", {env, returned, resultSlot});
+                break;
+            case Kind::U32:
+                callNapi("napi_create_uint32", {env, returned, resultSlot});
+                break;
+            case Kind::I64:
+                callNapi("napi_create_bigint_int64", {env, returned, resultSlot});
+                break;
+            case Kind::U64:
+                callNapi("napi_create_bigint_uint64", {env, returned, resultSlot});
+                break;
+            case Kind::F32:
+                callNapi("napi_create_double", {env, builder.CreateFPExt(returned, builder.getDoubleTy()), resultSlot});
+                break;
+            default:
+                callNapi("napi_create_double", {env, returned, resultSlot});
+                break;
+        }
+    }
+};
+
+//===----------------------------------------------------------------------===//
+// The JIT of the trampolines
+//===----------------------------------------------------------------------===//
+
+namespace {
+    struct TrampolineJIT {
+        std::mutex mutex;
+        std::unique_ptr<llvm::orc::LLJIT> jit;
+        std::unordered_map<std::string, napi_callback> callbacks;
+    };
+}
+
+// leaked, the JS functions created from its trampolines may outlive every static destructor
+static TrampolineJIT &getTrampolineJIT() {
+    static auto *trampolineJIT = new TrampolineJIT();
+    return *trampolineJIT;
+}
+
+static llvm::Expected<std::unique_ptr<llvm::orc::LLJIT>> createTrampolineJIT() {
+    llvm::Expected<std::unique_ptr<llvm::orc::LLJIT>> created = llvm::orc::LLJITBuilder().create();
+    if (!created) {
+        return created.takeError();
+    }
+    llvm::orc::LLJIT &jit = **created;
+    llvm::orc::SymbolMap symbols;
+#define DEFINE_NAPI_SYMBOL(name) \
+    symbols[jit.mangleAndIntern(#name)] = llvm::JITEvaluatedSymbol( \
+            llvm::pointerToJITTargetAddress(&name), llvm::JITSymbolFlags::Exported);
+    NAPI_TRAMPOLINE_SYMBOLS(DEFINE_NAPI_SYMBOL)
+#undef DEFINE_NAPI_SYMBOL
+    if (llvm::Error error = jit.getMainJITDylib().define(llvm::orc::absoluteSymbols(std::move(symbols)))) {
+        return std::move(error);
+    }
+    return created;
+}
+
+napi_callback Trampoline::Get(Napi::Env env, const Signature &signature) {
+    TrampolineJIT &shared = getTrampolineJIT();
+    const std::string key = signature.key();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    const auto iter = shared.callbacks.find(key);
+    if (iter != shared.callbacks.end()) {
+        return iter->second;
+    }
+    if (!shared.jit) {
+        if (!InitializeNativeCodeGen()) {
+            throw Napi::Error::New(env, ErrMsg::Class::LLJIT::nativeTarget);
+        }
+        llvm::Expected<std::unique_ptr<llvm::orc::LLJIT>> created = createTrampolineJIT();
+        if (!created) {
+            throw LLJIT::ToError(env, created.takeError());
+        }
+        shared.jit = std::move(*created);
+    }
+    const std::string name = "trampoline." + std::to_string(shared.callbacks.size());
+    auto context = std::make_unique<llvm::LLVMContext>();
+    auto module = std::make_unique<llvm::Module>(key, *context);
+    module->setDataLayout(shared.jit->getDataLayout());
+    module->setTargetTriple(shared.jit->getTargetTriple().str());
+    TrampolineBuilder(*module, signature).build(name);
+    llvm::orc::ThreadSafeModule threadSafeModule(std::move(module), llvm::orc::ThreadSafeContext(std::move(context)));
+    if (llvm::Error error = shared.jit->addIRModule(std::move(threadSafeModule))) {
+        throw LLJIT::ToError(env, std::move(error));
+    }
+    auto callback = reinterpret_cast<napi_callback>(LLJIT::LookupAddress(env, *shared.jit, name));
+    shared.callbacks.emplace(key, callback);
+    return callback;
+}
@@ -0,0 +1,5 @@
+#include "ExecutionEngine/index.h"
+
+void InitExecutionEngine(Napi::Env env, Napi::Object &exports) {
+    LLJIT::Init(env, exports);
+}
@@ -4,33 +4,33 @@
 void Argument::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "Argument", {
-            InstanceMethod("getParent", &Argument::getParent),
-            InstanceMethod("getArgNo", &Argument::getArgNo),
-            InstanceMethod("getType", &Argument::getType),
-            InstanceMethod("setName", &Argument::setName)
+            InstanceMethod("getParent", &Argument::guarded<&Argument::getParent>),
+            InstanceMethod("getArgNo", &Argument::guarded<&Argument::getArgNo>),
+            InstanceMethod("getType", &Argument::guarded<&Argument::getType>),
+            InstanceMethod("setName", &Argument::guardedVoid<&Argument::setName>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Value::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Value::constructor.Value(env));
     exports.Set("Argument", func);
 }
 
 Napi::Object Argument::New(Napi::Env env, llvm::Argument *argument) {
-    return constructor.New({Napi::External<llvm::Argument>::New(env, argument)});
+    return wrapCached<Argument>(env, argument);
 }
 
 bool Argument::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::Argument, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::Argument *Argument::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::Argument, llvm::Value>(value);
 }
 
 Argument::Argument(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     const unsigned argsLen = info.Length();
     if (!info.IsConstructCall() ||
@@ -60,6 +60,7 @@ Argument::Argument(const Napi::CallbackInfo &info) : ObjectWrap(info) {
         argNo = info[3].As<Napi::Number>();
     }
     argument = new llvm::Argument(type, name, func, argNo);
+    registerCached(*this, info.This().As<Napi::Object>(), argument);
 }
 
 llvm::Argument *Argument::getLLVMPrimitive() {
@@ -93,17 +93,16 @@ void Attribute::Init(Napi::Env env, Napi::Object &exports) {
             StaticMethod("get", &Attribute::get)
     });
 
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
+    constructor.Reset(env, func);
     exports.Set("Attribute", func);
 }
 
 Napi::Object Attribute::New(Napi::Env env, llvm::AttributeImpl *_attrImpl) {
-    return constructor.New({Napi::External<llvm::AttributeImpl>::New(env, _attrImpl)});
+    return constructor.New(env, {Napi::External<llvm::AttributeImpl>::New(env, _attrImpl)});
 }
 
 bool Attribute::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || hasTypeTag(value, TypeTag::Attribute);
 }
 
 llvm::Attribute Attribute::Extract(const Napi::Value &value) {
@@ -111,6 +110,7 @@ llvm::Attribute Attribute::Extract(const Napi::Value &value) {
 }
 
 Attribute::Attribute(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Attribute);
     const Napi::Env env = info.Env();
     const unsigned argsLen = info.Length();
 
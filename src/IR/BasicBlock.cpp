@@ -5,39 +5,40 @@ void BasicBlock::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "BasicBlock", {
             StaticMethod("Create", &BasicBlock::Create),
-            InstanceMethod("getParent", &BasicBlock::getParent),
-            InstanceMethod("getModule", &BasicBlock::getModule),
-            InstanceMethod("getTerminator", &BasicBlock::getTerminator),
-            InstanceMethod("getFirstNonPHI", &BasicBlock::getFirstNonPHI),
-            InstanceMethod("insertInto", &BasicBlock::insertInto),
-            InstanceMethod("removeFromParent", &BasicBlock::removeFromParent),
-            InstanceMethod("eraseFromParent", &BasicBlock::eraseFromParent),
-            InstanceMethod("use_empty", &BasicBlock::useEmpty),
-            InstanceMethod("getType", &BasicBlock::getType),
-            InstanceMethod("deleteSelf", &BasicBlock::deleteSelf)
+            InstanceMethod("getParent", &BasicBlock::guarded<&BasicBlock::getParent>),
+            InstanceMethod("getModule", &BasicBlock::guarded<&BasicBlock::getModule>),
+            InstanceMethod("getTerminator", &BasicBlock::guarded<&BasicBlock::getTerminator>),
+            InstanceMethod("getFirstNonPHI", &BasicBlock::guarded<&BasicBlock::getFirstNonPHI>),
+            InstanceMethod("getInstructions", &BasicBlock::guarded<&BasicBlock::getInstructions>),
+            InstanceMethod("insertInto", &BasicBlock::guardedVoid<&BasicBlock::insertInto>),
+            InstanceMethod("removeFromParent", &BasicBlock::guardedVoid<&BasicBlock::removeFromParent>),
+            InstanceMethod("eraseFromParent", &BasicBlock::guardedVoid<&BasicBlock::eraseFromParent>),
+            InstanceMethod("use_empty", &BasicBlock::guarded<&BasicBlock::useEmpty>),
+            InstanceMethod("getType", &BasicBlock::guarded<&BasicBlock::getType>),
+            InstanceMethod("deleteSelf", &BasicBlock::guardedVoid<&BasicBlock::deleteSelf>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Value::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Value::constructor.Value(env));
     exports.Set("BasicBlock", func);
 }
 
 Napi::Object BasicBlock::New(Napi::Env env, llvm::BasicBlock *basicBlock) {
-    return constructor.New({Napi::External<llvm::BasicBlock>::New(env, basicBlock)});
+    return wrapCached<BasicBlock>(env, basicBlock);
 }
 
 bool BasicBlock::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::BasicBlock, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::BasicBlock *BasicBlock::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::BasicBlock, llvm::Value>(value);
 }
 
 BasicBlock::BasicBlock(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::BasicBlock::constructor);
@@ -113,6 +114,16 @@ Napi::Value BasicBlock::getFirstNonPHI(const Napi::CallbackInfo &info) {
     return env.Null();
 }
 
+Napi::Value BasicBlock::getInstructions(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    Napi::Array instructions = Napi::Array::New(env, basicBlock->size());
+    uint32_t i = 0;
+    for (llvm::Instruction &inst: *basicBlock) {
+        instructions.Set(i++, Instruction::New(env, &inst));
+    }
+    return instructions;
+}
+
 void BasicBlock::insertInto(const Napi::CallbackInfo &info) {
     const Napi::Env env = info.Env();
     const unsigned argsLen = info.Length();
@@ -131,6 +142,7 @@ void BasicBlock::removeFromParent(const Napi::CallbackInfo &info) {
 }
 
 void BasicBlock::eraseFromParent(const Napi::CallbackInfo &info) {
+    invalidateTree(basicBlock);
     basicBlock->eraseFromParent();
 }
 
@@ -149,6 +161,7 @@ void BasicBlock::deleteSelf(const Napi::CallbackInfo &info) {
     if (!basicBlock) {
         throw Napi::Error::New(env, "Attempt to delete a null BasicBlock");
     }
+    invalidateTree(basicBlock);
     delete basicBlock;
     basicBlock = nullptr;
 }
@@ -11,53 +11,33 @@ void Constant::Init(Napi::Env env, Napi::Object &exports) {
     const Napi::Function func = DefineClass(env, "Constant", {
             StaticMethod("getNullValue", Constant::getNullValue),
             StaticMethod("getAllOnesValue", Constant::getAllOnesValue),
-            InstanceMethod("isNullValue", &Constant::isNullValue),
-            InstanceMethod("isOneValue", &Constant::isOneValue),
-            InstanceMethod("isAllOnesValue", &Constant::isAllOnesValue),
-            InstanceMethod("getType", &Constant::getType)
+            InstanceMethod("isNullValue", &Constant::guarded<&Constant::isNullValue>),
+            InstanceMethod("isOneValue", &Constant::guarded<&Constant::isOneValue>),
+            InstanceMethod("isAllOnesValue", &Constant::guarded<&Constant::isAllOnesValue>),
+            InstanceMethod("getType", &Constant::guarded<&Constant::getType>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), User::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), User::constructor.Value(env));
     exports.Set("Constant", func);
 }
 
 Napi::Object Constant::New(Napi::Env env, llvm::Constant *constant) {
-    if (llvm::isa<llvm::GlobalValue>(constant)) {
-        return GlobalValue::New(env, llvm::cast<llvm::GlobalValue>(constant));
-    } else if (llvm::isa<llvm::ConstantInt>(constant)) {
-        return ConstantInt::New(env, llvm::cast<llvm::ConstantInt>(constant));
-    } else if (llvm::isa<llvm::ConstantFP>(constant)) {
-        return ConstantFP::New(env, llvm::cast<llvm::ConstantFP>(constant));
-    } else if (llvm::isa<llvm::ConstantArray>(constant)) {
-        return ConstantArray::New(env, llvm::cast<llvm::ConstantArray>(constant));
-    } else if (llvm::isa<llvm::ConstantStruct>(constant)) {
-        return ConstantStruct::New(env, llvm::cast<llvm::ConstantStruct>(constant));
-    } else if (llvm::isa<llvm::ConstantPointerNull>(constant)) {
-        return ConstantPointerNull::New(env, llvm::cast<llvm::ConstantPointerNull>(constant));
-    } else if (llvm::isa<llvm::ConstantDataArray>(constant)) {
-        return ConstantDataArray::New(env, llvm::cast<llvm::ConstantDataArray>(constant));
-    } else if (llvm::isa<llvm::ConstantExpr>(constant)) {
-        return ConstantExpr::New(env, llvm::cast<llvm::ConstantExpr>(constant));
-    } else if (llvm::isa<llvm::UndefValue>(constant)) {
-        return UndefValue::New(env, llvm::cast<llvm::UndefValue>(constant));
-    }
-    // TODO: more structured clearly
-    return constructor.New({Napi::External<llvm::Constant>::New(env, constant)});
+    return Value::New(env, constant).As<Napi::Object>();
 }
 
 bool Constant::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::Constant, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::Constant *Constant::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::Constant, llvm::Value>(value);
 }
 
 Constant::Constant(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::Constant::constructor);
@@ -134,30 +114,30 @@ void ConstantInt::Init(Napi::Env env, Napi::Object &exports) {
             StaticMethod("get", &ConstantInt::get),
             StaticMethod("getTrue", &getBoolFactory<llvm::ConstantInt::getTrue>),
             StaticMethod("getFalse", &getBoolFactory<llvm::ConstantInt::getFalse>),
-            InstanceMethod("getType", &ConstantInt::getType)
+            InstanceMethod("getType", &ConstantInt::guarded<&ConstantInt::getType>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Constant::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Constant::constructor.Value(env));
     exports.Set("ConstantInt", func);
 }
 
 Napi::Object ConstantInt::New(Napi::Env env, llvm::ConstantInt *constantInt) {
-    return constructor.New({Napi::External<llvm::ConstantInt>::New(env, constantInt)});
+    return wrapCached<ConstantInt>(env, constantInt);
 }
 
 bool ConstantInt::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::ConstantInt, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::ConstantInt *ConstantInt::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::ConstantInt, llvm::Value>(value);
 }
 
 ConstantInt::ConstantInt(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::ConstantInt::constructor);
@@ -211,30 +191,30 @@ void ConstantFP::Init(Napi::Env env, Napi::Object &exports) {
     const Napi::Function func = DefineClass(env, "ConstantFP", {
             StaticMethod("get", &ConstantFP::get),
             StaticMethod("getNaN", &ConstantFP::getNaN),
-            InstanceMethod("getType", &ConstantFP::getType)
+            InstanceMethod("getType", &ConstantFP::guarded<&ConstantFP::getType>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Constant::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Constant::constructor.Value(env));
     exports.Set("ConstantFP", func);
 }
 
 Napi::Object ConstantFP::New(Napi::Env env, llvm::ConstantFP *constantFP) {
-    return constructor.New({Napi::External<llvm::ConstantFP>::New(env, constantFP)});
+    return wrapCached<ConstantFP>(env, constantFP);
 }
 
 bool ConstantFP::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::ConstantFP, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::ConstantFP *ConstantFP::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::ConstantFP, llvm::Value>(value);
 }
 
 ConstantFP::ConstantFP(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::ConstantFP::constructor);
@@ -300,30 +280,30 @@ void ConstantArray::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "ConstantArray", {
             StaticMethod("get", &ConstantArray::get),
-            InstanceMethod("getType", &ConstantArray::getType)
+            InstanceMethod("getType", &ConstantArray::guarded<&ConstantArray::getType>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Constant::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Constant::constructor.Value(env));
     exports.Set("ConstantArray", func);
 }
 
 Napi::Object ConstantArray::New(Napi::Env env, llvm::ConstantArray *constantArray) {
-    return constructor.New({Napi::External<llvm::ConstantArray>::New(env, constantArray)});
+    return wrapCached<ConstantArray>(env, constantArray);
 }
 
 bool ConstantArray::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::ConstantArray, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::ConstantArray *ConstantArray::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::ConstantArray, llvm::Value>(value);
 }
 
 ConstantArray::ConstantArray(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::ConstantArray::constructor);
@@ -366,30 +346,30 @@ void ConstantStruct::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "ConstantStruct", {
             StaticMethod("get", &ConstantStruct::get),
-            InstanceMethod("getType", &ConstantStruct::getType)
+            InstanceMethod("getType", &ConstantStruct::guarded<&ConstantStruct::getType>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Constant::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Constant::constructor.Value(env));
     exports.Set("ConstantStruct", func);
 }
 
 Napi::Object ConstantStruct::New(Napi::Env env, llvm::ConstantStruct *constantStruct) {
-    return constructor.New({Napi::External<llvm::ConstantStruct>::New(env, constantStruct)});
+    return wrapCached<ConstantStruct>(env, constantStruct);
 }
 
 bool ConstantStruct::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::ConstantStruct, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::ConstantStruct *ConstantStruct::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::ConstantStruct, llvm::Value>(value);
 }
 
 ConstantStruct::ConstantStruct(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::ConstantStruct::constructor);
@@ -432,30 +412,30 @@ void ConstantPointerNull::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "ConstantPointerNull", {
             StaticMethod("get", &ConstantPointerNull::get),
-            InstanceMethod("getType", &ConstantPointerNull::getType)
+            InstanceMethod("getType", &ConstantPointerNull::guarded<&ConstantPointerNull::getType>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Constant::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Constant::constructor.Value(env));
     exports.Set("ConstantPointerNull", func);
 }
 
 Napi::Object ConstantPointerNull::New(Napi::Env env, llvm::ConstantPointerNull *constantPointerNull) {
-    return constructor.New({Napi::External<llvm::ConstantPointerNull>::New(env, constantPointerNull)});
+    return wrapCached<ConstantPointerNull>(env, constantPointerNull);
 }
 
 bool ConstantPointerNull::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::ConstantPointerNull, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::ConstantPointerNull *ConstantPointerNull::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::ConstantPointerNull, llvm::Value>(value);
 }
 
 ConstantPointerNull::ConstantPointerNull(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::ConstantPointerNull::constructor);
@@ -492,30 +472,30 @@ void ConstantDataArray::Init(Napi::Env env, Napi::Object &exports) {
     const Napi::Function func = DefineClass(env, "ConstantDataArray", {
             StaticMethod("get", &ConstantDataArray::get),
             StaticMethod("getString", &ConstantDataArray::getString),
-            InstanceMethod("getType", &ConstantDataArray::getType)
+            InstanceMethod("getType", &ConstantDataArray::guarded<&ConstantDataArray::getType>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Constant::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Constant::constructor.Value(env));
     exports.Set("ConstantDataArray", func);
 }
 
 Napi::Object ConstantDataArray::New(Napi::Env env, llvm::ConstantDataArray *constantDataArray) {
-    return constructor.New({Napi::External<llvm::ConstantDataArray>::New(env, constantDataArray)});
+    return wrapCached<ConstantDataArray>(env, constantDataArray);
 }
 
 bool ConstantDataArray::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::ConstantDataArray, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::ConstantDataArray *ConstantDataArray::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::ConstantDataArray, llvm::Value>(value);
 }
 
 ConstantDataArray::ConstantDataArray(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::ConstantDataArray::constructor);
@@ -528,6 +508,40 @@ llvm::ConstantDataArray *ConstantDataArray::getLLVMPrimitive() {
     return constantDataArray;
 }
 
+//===----------------------------------------------------------------------===//
+// Element type of a TypedArray (or Buffer), whose backing store is handed to
+// getRaw as is, since both are laid out in the host's byte order
+//===----------------------------------------------------------------------===//
+
+static llvm::Type *getTypedArrayElementType(llvm::LLVMContext &context, const Napi::TypedArray &array) {
+    switch (array.TypedArrayType()) {
+        case napi_int8_array:
+        case napi_uint8_array:
+        case napi_uint8_clamped_array:
+            return llvm::Type::getInt8Ty(context);
+        case napi_int16_array:
+        case napi_uint16_array:
+            return llvm::Type::getInt16Ty(context);
+        case napi_int32_array:
+        case napi_uint32_array:
+            return llvm::Type::getInt32Ty(context);
+        case napi_bigint64_array:
+        case napi_biguint64_array:
+            return llvm::Type::getInt64Ty(context);
+        case napi_float32_array:
+            return llvm::Type::getFloatTy(context);
+        case napi_float64_array:
+            return llvm::Type::getDoubleTy(context);
+        default:
+            return nullptr;
+    }
+}
+
+static llvm::StringRef getTypedArrayData(const Napi::TypedArray &array) {
+    const char *data = static_cast<const char *>(array.ArrayBuffer().Data()) + array.ByteOffset();
+    return {data, array.ByteLength()};
+}
+
 Napi::Value ConstantDataArray::get(const Napi::CallbackInfo &info) {
     const Napi::Env env = info.Env();
     const unsigned argsLen = info.Length();
@@ -538,6 +552,13 @@ Napi::Value ConstantDataArray::get(const Napi::CallbackInfo &info) {
             llvm::Constant *constant = llvm::ConstantDataArray::get(context, array);
             return Constant::New(env, constant);
         }
+    } else if (argsLen == 2 && LLVMContext::IsClassOf(info[0]) && info[1].IsTypedArray()) {
+        const auto array = info[1].As<Napi::TypedArray>();
+        llvm::LLVMContext &context = LLVMContext::Extract(info[0]);
+        if (llvm::Type *elementType = getTypedArrayElementType(context, array)) {
+            llvm::Constant *constant = llvm::ConstantDataArray::getRaw(getTypedArrayData(array), array.ElementLength(), elementType);
+            return Constant::New(env, constant);
+        }
     }
     throw Napi::TypeError::New(env, ErrMsg::Class::ConstantDataArray::get);
 }
@@ -566,6 +587,70 @@ Napi::Value ConstantDataArray::getType(const Napi::CallbackInfo &info) {
     return ArrayType::New(env, type);
 }
 
+//===----------------------------------------------------------------------===//
+//                        ConstantDataVector Class
+//===----------------------------------------------------------------------===//
+
+void ConstantDataVector::Init(Napi::Env env, Napi::Object &exports) {
+    Napi::HandleScope scope(env);
+    const Napi::Function func = DefineClass(env, "ConstantDataVector", {
+            StaticMethod("get", &ConstantDataVector::get),
+            InstanceMethod("getType", &ConstantDataVector::guarded<&ConstantDataVector::getType>)
+    });
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Constant::constructor.Value(env));
+    exports.Set("ConstantDataVector", func);
+}
+
+Napi::Object ConstantDataVector::New(Napi::Env env, llvm::ConstantDataVector *constantDataVector) {
+    return wrapCached<ConstantDataVector>(env, constantDataVector);
+}
+
+bool ConstantDataVector::IsClassOf(const Napi::Value &value) {
+    return value.IsNull() || isKindOf<llvm::ConstantDataVector, llvm::Value>(value, TypeTag::Value);
+}
+
+llvm::ConstantDataVector *ConstantDataVector::Extract(const Napi::Value &value) {
+    if (value.IsNull()) {
+        return nullptr;
+    }
+    return extractKind<llvm::ConstantDataVector, llvm::Value>(value);
+}
+
+ConstantDataVector::ConstantDataVector(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
+    const Napi::Env env = info.Env();
+    if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
+        throw Napi::TypeError::New(env, ErrMsg::Class::ConstantDataVector::constructor);
+    }
+    const auto external = info[0].As<Napi::External<llvm::ConstantDataVector>>();
+    constantDataVector = external.Data();
+}
+
+llvm::ConstantDataVector *ConstantDataVector::getLLVMPrimitive() {
+    return constantDataVector;
+}
+
+Napi::Value ConstantDataVector::get(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    if (info.Length() == 2 && LLVMContext::IsClassOf(info[0]) && info[1].IsTypedArray()) {
+        const auto array = info[1].As<Napi::TypedArray>();
+        llvm::LLVMContext &context = LLVMContext::Extract(info[0]);
+        llvm::Type *elementType = getTypedArrayElementType(context, array);
+        if (elementType != nullptr && array.ElementLength() != 0) {
+            llvm::Constant *constant = llvm::ConstantDataVector::getRaw(getTypedArrayData(array), array.ElementLength(), elementType);
+            return Constant::New(env, constant);
+        }
+    }
+    throw Napi::TypeError::New(env, ErrMsg::Class::ConstantDataVector::get);
+}
+
+Napi::Value ConstantDataVector::getType(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    llvm::VectorType *type = constantDataVector->getType();
+    return VectorType::New(env, type);
+}
+
 //===----------------------------------------------------------------------===//
 //                        ConstantExpr Class
 //===----------------------------------------------------------------------===//
@@ -600,30 +685,30 @@ void ConstantExpr::Init(Napi::Env env, Napi::Object &exports) {
             StaticMethod("getSIToFP",&ConstantExpr::getUIToFP),
             StaticMethod("getFPToUI",&ConstantExpr::getFPToUI),
             StaticMethod("getFPToSI",&ConstantExpr::getFPToSI),
-            InstanceMethod("getType", &ConstantExpr::getType),
+            InstanceMethod("getType", &ConstantExpr::guarded<&ConstantExpr::getType>),
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Constant::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Constant::constructor.Value(env));
     exports.Set("ConstantExpr", func);
 }
 
 Napi::Object ConstantExpr::New(Napi::Env env, llvm::ConstantExpr *constantExpr) {
-    return constructor.New({Napi::External<llvm::ConstantExpr>::New(env, constantExpr)});
+    return wrapCached<ConstantExpr>(env, constantExpr);
 }
 
 bool ConstantExpr::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::ConstantExpr, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::ConstantExpr *ConstantExpr::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::ConstantExpr, llvm::Value>(value);
 }
 
 ConstantExpr::ConstantExpr(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::ConstantExpr::constructor);
@@ -791,16 +876,16 @@ Napi::Value ConstantExpr::getOffsetOf(const Napi::CallbackInfo &info)
 
     const Napi::Object obj0 = info[0].As<Napi::Object>();
 
-    if (obj0.InstanceOf(StructType::constructor.Value()) && info[1].IsNumber())
+    if (StructType::IsClassOf(obj0) && info[1].IsNumber())
     {
         llvm::StructType *type = StructType::Extract(obj0);
         const unsigned fieldNo = info[1].As<Napi::Number>().Uint32Value();
         llvm::Constant *c = llvm::ConstantExpr::getOffsetOf(type, fieldNo);
         return Constant::New(env, c);
     }
-    else if (obj0.InstanceOf(Type::constructor.Value()) &&
+    else if (Type::IsClassOf(obj0) &&
              info[1].IsObject() &&
-             info[1].As<Napi::Object>().InstanceOf(Constant::constructor.Value()))
+             Constant::IsClassOf(info[1]))
     {
         llvm::Type *type = Type::Extract(obj0);
         llvm::Constant *FieldNo = Constant::Extract(info[1]);
@@ -1083,30 +1168,30 @@ void UndefValue::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "UndefValue", {
             StaticMethod("get", &UndefValue::get),
-            InstanceMethod("getType", &UndefValue::getType)
+            InstanceMethod("getType", &UndefValue::guarded<&UndefValue::getType>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Constant::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Constant::constructor.Value(env));
     exports.Set("UndefValue", func);
 }
 
 Napi::Object UndefValue::New(Napi::Env env, llvm::UndefValue *undefValue) {
-    return constructor.New({Napi::External<llvm::UndefValue>::New(env, undefValue)});
+    return wrapCached<UndefValue>(env, undefValue);
 }
 
 bool UndefValue::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::UndefValue, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::UndefValue *UndefValue::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::UndefValue, llvm::Value>(value);
 }
 
 UndefValue::UndefValue(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::UndefValue::constructor);
@@ -21,17 +21,16 @@ void DIBuilder::Init(Napi::Env env, Napi::Object &exports) {
             InstanceMethod("finalize", &DIBuilder::finalize),
 
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
+    constructor.Reset(env, func);
     exports.Set("DIBuilder", func);
 }
 
 Napi::Value DIBuilder::New(Napi::Env env, llvm::DIBuilder *builder) {
-    return constructor.New({Napi::External<llvm::DIBuilder>::New(env, builder)});
+    return constructor.New(env, {Napi::External<llvm::DIBuilder>::New(env, builder)});
 }
 
 bool DIBuilder::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || hasTypeTag(value, TypeTag::DIBuilder);
 }
 
 llvm::DIBuilder *DIBuilder::Extract(const Napi::Value &value) {
@@ -42,6 +41,7 @@ llvm::DIBuilder *DIBuilder::Extract(const Napi::Value &value) {
 }
 
 DIBuilder::DIBuilder(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::DIBuilder);
     const Napi::Env env = info.Env();
     if (info.Length() == 1) {
         if (info[0].IsExternal()) {
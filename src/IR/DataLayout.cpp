@@ -7,17 +7,16 @@ void DataLayout::Init(Napi::Env env, Napi::Object &exports) {
             InstanceMethod("getStringRepresentation", &DataLayout::getStringRepresentation),
             InstanceMethod("getTypeAllocSize", &DataLayout::getTypeAllocSize)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
+    constructor.Reset(env, func);
     exports.Set("DataLayout", func);
 }
 
 Napi::Object DataLayout::New(Napi::Env env, llvm::DataLayout *dl) {
-    return constructor.New({Napi::External<llvm::DataLayout>::New(env, dl)});
+    return constructor.New(env, {Napi::External<llvm::DataLayout>::New(env, dl)});
 }
 
 bool DataLayout::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || hasTypeTag(value, TypeTag::DataLayout);
 }
 
 llvm::DataLayout &DataLayout::Extract(const Napi::Value &value) {
@@ -25,6 +24,7 @@ llvm::DataLayout &DataLayout::Extract(const Napi::Value &value) {
 }
 
 DataLayout::DataLayout(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::DataLayout);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 ||
         !info[0].IsExternal() && !info[0].IsString()) {
@@ -35,6 +35,13 @@ DataLayout::DataLayout(const Napi::CallbackInfo &info) : ObjectWrap(info) {
         dataLayout = external.Data();
     } else if (info[0].IsString()) {
         dataLayout = new llvm::DataLayout(std::string(info[0].As<Napi::String>()));
+        owned = true;
+    }
+}
+
+DataLayout::~DataLayout() {
+    if (owned) {
+        delete dataLayout;
     }
 }
 
@@ -9,17 +9,16 @@ void DITypeRefArray::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "DITypeRefArray", {
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
+    constructor.Reset(env, func);
     exports.Set("DITypeRefArray", func);
 }
 
 Napi::Value DITypeRefArray::New(Napi::Env env, llvm::DITypeRefArray *array) {
-    return constructor.New({Napi::External<llvm::DITypeRefArray>::New(env, array)});
+    return constructor.New(env, {Napi::External<llvm::DITypeRefArray>::New(env, array)});
 }
 
 bool DITypeRefArray::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || hasTypeTag(value, TypeTag::DITypeRefArray);
 }
 
 llvm::DITypeRefArray *DITypeRefArray::Extract(const Napi::Value &value) {
@@ -30,6 +29,7 @@ llvm::DITypeRefArray *DITypeRefArray::Extract(const Napi::Value &value) {
 }
 
 DITypeRefArray::DITypeRefArray(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::DITypeRefArray);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::DITypeRefArray::constructor);
@@ -106,9 +106,8 @@ void DINode::Init(Napi::Env env, Napi::Object &exports) {
             StaticValue("DIFlags", diFlagsNS),
             StaticValue("DISPFlags", diSPFlagsNS),
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), MDNode::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), MDNode::constructor.Value(env));
     exports.Set("DINode", func);
 }
 
@@ -118,27 +117,29 @@ Napi::Value DINode::New(Napi::Env env, llvm::DINode *node) {
     } else if (llvm::isa<llvm::DIVariable>(node)) {
         return DIVariable::New(env, llvm::cast<llvm::DIVariable>(node));
     }
-    return constructor.New({Napi::External<llvm::DINode>::New(env, node)});
+    return constructor.New(env, {Napi::External<llvm::DINode>::New(env, node)});
 }
 
 bool DINode::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::DINode, llvm::Metadata>(value, TypeTag::Metadata);
 }
 
 llvm::DINode *DINode::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::DINode, llvm::Metadata>(value);
 }
 
 DINode::DINode(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Metadata, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::DINode::constructor);
     }
     const auto external = info[0].As<Napi::External<llvm::DINode>>();
     node = external.Data();
+    setRoot(node);
 }
 
 llvm::DINode *DINode::getLLVMPrimitive() {
@@ -153,9 +154,8 @@ void DIScope::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "DIScope", {
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), DINode::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), DINode::constructor.Value(env));
     exports.Set("DIScope", func);
 }
 
@@ -171,27 +171,29 @@ Napi::Value DIScope::New(Napi::Env env, llvm::DIScope *scope) {
     } else if (llvm::isa<llvm::DINamespace>(scope)) {
         return DINamespace::New(env, llvm::cast<llvm::DINamespace>(scope));
     }
-    return constructor.New({Napi::External<llvm::DIScope>::New(env, scope)});
+    return constructor.New(env, {Napi::External<llvm::DIScope>::New(env, scope)});
 }
 
 bool DIScope::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::DIScope, llvm::Metadata>(value, TypeTag::Metadata);
 }
 
 llvm::DIScope *DIScope::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::DIScope, llvm::Metadata>(value);
 }
 
 DIScope::DIScope(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Metadata, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::DIScope::constructor);
     }
     const auto external = info[0].As<Napi::External<llvm::DIScope>>();
     scope = external.Data();
+    setRoot(scope);
 }
 
 llvm::DIScope *DIScope::getLLVMPrimitive() {
@@ -206,34 +208,35 @@ void DIFile::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "DIFile", {
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), DIScope::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), DIScope::constructor.Value(env));
     exports.Set("DIFile", func);
 }
 
 Napi::Value DIFile::New(Napi::Env env, llvm::DIFile *file) {
-    return constructor.New({Napi::External<llvm::DIFile>::New(env, file)});
+    return constructor.New(env, {Napi::External<llvm::DIFile>::New(env, file)});
 }
 
 bool DIFile::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::DIFile, llvm::Metadata>(value, TypeTag::Metadata);
 }
 
 llvm::DIFile *DIFile::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::DIFile, llvm::Metadata>(value);
 }
 
 DIFile::DIFile(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Metadata, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::DIFile::constructor);
     }
     const auto external = info[0].As<Napi::External<llvm::DIFile>>();
     file = external.Data();
+    setRoot(file);
 }
 
 llvm::DIFile *DIFile::getLLVMPrimitive() {
@@ -248,9 +251,8 @@ void DIType::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "DIType", {
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), DIScope::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), DIScope::constructor.Value(env));
     exports.Set("DIType", func);
 }
 
@@ -264,27 +266,29 @@ Napi::Value DIType::New(Napi::Env env, llvm::DIType *type) {
     } else if (llvm::isa<llvm::DISubroutineType>(type)) {
         return DISubroutineType::New(env, llvm::cast<llvm::DISubroutineType>(type));
     }
-    return constructor.New({Napi::External<llvm::DIType>::New(env, type)});
+    return constructor.New(env, {Napi::External<llvm::DIType>::New(env, type)});
 }
 
 bool DIType::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::DIType, llvm::Metadata>(value, TypeTag::Metadata);
 }
 
 llvm::DIType *DIType::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::DIType, llvm::Metadata>(value);
 }
 
 DIType::DIType(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Metadata, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::DIType::constructor);
     }
     const auto external = info[0].As<Napi::External<llvm::DIType>>();
     type = external.Data();
+    setRoot(type);
 }
 
 llvm::DIType *DIType::getLLVMPrimitive() {
@@ -299,34 +303,35 @@ void DIBasicType::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "DIBasicType", {
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), DIType::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), DIType::constructor.Value(env));
     exports.Set("DIBasicType", func);
 }
 
 Napi::Value DIBasicType::New(Napi::Env env, llvm::DIBasicType *type) {
-    return constructor.New({Napi::External<llvm::DIBasicType>::New(env, type)});
+    return constructor.New(env, {Napi::External<llvm::DIBasicType>::New(env, type)});
 }
 
 bool DIBasicType::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::DIBasicType, llvm::Metadata>(value, TypeTag::Metadata);
 }
 
 llvm::DIBasicType *DIBasicType::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::DIBasicType, llvm::Metadata>(value);
 }
 
 DIBasicType::DIBasicType(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Metadata, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::DIBasicType::constructor);
     }
     const auto external = info[0].As<Napi::External<llvm::DIBasicType>>();
     type = external.Data();
+    setRoot(type);
 }
 
 llvm::DIBasicType *DIBasicType::getLLVMPrimitive() {
@@ -341,34 +346,35 @@ void DIDerivedType::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "DIDerivedType", {
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), DIType::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), DIType::constructor.Value(env));
     exports.Set("DIDerivedType", func);
 }
 
 Napi::Value DIDerivedType::New(Napi::Env env, llvm::DIDerivedType *type) {
-    return constructor.New({Napi::External<llvm::DIDerivedType>::New(env, type)});
+    return constructor.New(env, {Napi::External<llvm::DIDerivedType>::New(env, type)});
 }
 
 bool DIDerivedType::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::DIDerivedType, llvm::Metadata>(value, TypeTag::Metadata);
 }
 
 llvm::DIDerivedType *DIDerivedType::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::DIDerivedType, llvm::Metadata>(value);
 }
 
 DIDerivedType::DIDerivedType(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Metadata, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::DIDerivedType::constructor);
     }
     const auto external = info[0].As<Napi::External<llvm::DIDerivedType>>();
     type = external.Data();
+    setRoot(type);
 }
 
 llvm::DIDerivedType *DIDerivedType::getLLVMPrimitive() {
@@ -383,34 +389,35 @@ void DICompositeType::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "DICompositeType", {
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), DIType::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), DIType::constructor.Value(env));
     exports.Set("DICompositeType", func);
 }
 
 Napi::Value DICompositeType::New(Napi::Env env, llvm::DICompositeType *type) {
-    return constructor.New({Napi::External<llvm::DICompositeType>::New(env, type)});
+    return constructor.New(env, {Napi::External<llvm::DICompositeType>::New(env, type)});
 }
 
 bool DICompositeType::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::DICompositeType, llvm::Metadata>(value, TypeTag::Metadata);
 }
 
 llvm::DICompositeType *DICompositeType::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::DICompositeType, llvm::Metadata>(value);
 }
 
 DICompositeType::DICompositeType(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Metadata, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::DICompositeType::constructor);
     }
     const auto external = info[0].As<Napi::External<llvm::DICompositeType>>();
     type = external.Data();
+    setRoot(type);
 }
 
 llvm::DICompositeType *DICompositeType::getLLVMPrimitive() {
@@ -425,34 +432,35 @@ void DISubroutineType::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "DISubroutineType", {
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), DIType::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), DIType::constructor.Value(env));
     exports.Set("DISubroutineType", func);
 }
 
 Napi::Value DISubroutineType::New(Napi::Env env, llvm::DISubroutineType *type) {
-    return constructor.New({Napi::External<llvm::DISubroutineType>::New(env, type)});
+    return constructor.New(env, {Napi::External<llvm::DISubroutineType>::New(env, type)});
 }
 
 bool DISubroutineType::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::DISubroutineType, llvm::Metadata>(value, TypeTag::Metadata);
 }
 
 llvm::DISubroutineType *DISubroutineType::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::DISubroutineType, llvm::Metadata>(value);
 }
 
 DISubroutineType::DISubroutineType(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Metadata, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::DISubroutineType::constructor);
     }
     const auto external = info[0].As<Napi::External<llvm::DISubroutineType>>();
     type = external.Data();
+    setRoot(type);
 }
 
 llvm::DISubroutineType *DISubroutineType::getLLVMPrimitive() {
@@ -468,34 +476,35 @@ void DICompileUnit::Init(Napi::Env env, Napi::Object &exports) {
     const Napi::Function func = DefineClass(env, "DICompileUnit", {
             InstanceMethod("getFile", &DICompileUnit::getFile)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), DIScope::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), DIScope::constructor.Value(env));
     exports.Set("DICompileUnit", func);
 }
 
 Napi::Value DICompileUnit::New(Napi::Env env, llvm::DICompileUnit *unit) {
-    return constructor.New({Napi::External<llvm::DICompileUnit>::New(env, unit)});
+    return constructor.New(env, {Napi::External<llvm::DICompileUnit>::New(env, unit)});
 }
 
 bool DICompileUnit::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::DICompileUnit, llvm::Metadata>(value, TypeTag::Metadata);
 }
 
 llvm::DICompileUnit *DICompileUnit::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::DICompileUnit, llvm::Metadata>(value);
 }
 
 DICompileUnit::DICompileUnit(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Metadata, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::DICompileUnit::constructor);
     }
     const auto external = info[0].As<Napi::External<llvm::DICompileUnit>>();
     unit = external.Data();
+    setRoot(unit);
 }
 
 llvm::DICompileUnit *DICompileUnit::getLLVMPrimitive() {
@@ -514,9 +523,8 @@ void DILocalScope::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "DILocalScope", {
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), DIScope::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), DIScope::constructor.Value(env));
     exports.Set("DILocalScope", func);
 }
 
@@ -526,27 +534,29 @@ Napi::Value DILocalScope::New(Napi::Env env, llvm::DILocalScope *scope) {
     } else if (llvm::isa<llvm::DISubprogram>(scope)) {
         return DISubprogram::New(env, llvm::cast<llvm::DISubprogram>(scope));
     }
-    return constructor.New({Napi::External<llvm::DILocalScope>::New(env, scope)});
+    return constructor.New(env, {Napi::External<llvm::DILocalScope>::New(env, scope)});
 }
 
 bool DILocalScope::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::DILocalScope, llvm::Metadata>(value, TypeTag::Metadata);
 }
 
 llvm::DILocalScope *DILocalScope::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::DILocalScope, llvm::Metadata>(value);
 }
 
 DILocalScope::DILocalScope(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Metadata, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::DILocalScope::constructor);
     }
     const auto external = info[0].As<Napi::External<llvm::DILocalScope>>();
     scope = external.Data();
+    setRoot(scope);
 }
 
 llvm::DILocalScope *DILocalScope::getLLVMPrimitive() {
@@ -562,34 +572,35 @@ void DILocation::Init(Napi::Env env, Napi::Object &exports) {
     const Napi::Function func = DefineClass(env, "DILocation", {
             StaticMethod("get", &DILocation::get)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), MDNode::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), MDNode::constructor.Value(env));
     exports.Set("DILocation", func);
 }
 
 Napi::Value DILocation::New(Napi::Env env, llvm::DILocation *location) {
-    return constructor.New({Napi::External<llvm::DILocation>::New(env, location)});
+    return constructor.New(env, {Napi::External<llvm::DILocation>::New(env, location)});
 }
 
 bool DILocation::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::DILocation, llvm::Metadata>(value, TypeTag::Metadata);
 }
 
 llvm::DILocation *DILocation::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::DILocation, llvm::Metadata>(value);
 }
 
 DILocation::DILocation(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Metadata, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::DILocation::constructor);
     }
     const auto external = info[0].As<Napi::External<llvm::DILocation>>();
     location = external.Data();
+    setRoot(location);
 }
 
 llvm::DILocation *DILocation::getLLVMPrimitive() {
@@ -624,34 +635,35 @@ void DISubprogram::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "DISubprogram", {
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), DILocalScope::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), DILocalScope::constructor.Value(env));
     exports.Set("DISubprogram", func);
 }
 
 Napi::Value DISubprogram::New(Napi::Env env, llvm::DISubprogram *subProgram) {
-    return constructor.New({Napi::External<llvm::DISubprogram>::New(env, subProgram)});
+    return constructor.New(env, {Napi::External<llvm::DISubprogram>::New(env, subProgram)});
 }
 
 bool DISubprogram::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::DISubprogram, llvm::Metadata>(value, TypeTag::Metadata);
 }
 
 llvm::DISubprogram *DISubprogram::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::DISubprogram, llvm::Metadata>(value);
 }
 
 DISubprogram::DISubprogram(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Metadata, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::DISubprogram::constructor);
     }
     const auto external = info[0].As<Napi::External<llvm::DISubprogram>>();
     subprogram = external.Data();
+    setRoot(subprogram);
 }
 
 llvm::DISubprogram *DISubprogram::getLLVMPrimitive() {
@@ -666,9 +678,8 @@ void DILexicalBlock::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope block(env);
     const Napi::Function func = DefineClass(env, "DILexicalBlock", {
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), DILocalScope::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), DILocalScope::constructor.Value(env));
     exports.Set("DILexicalBlock", func);
 }
 
@@ -676,27 +687,29 @@ Napi::Value DILexicalBlock::New(Napi::Env env, llvm::DILexicalBlock *block) {
     if (llvm::isa<llvm::DISubprogram>(block)) {
         return DISubprogram::New(env, llvm::cast<llvm::DISubprogram>(block));
     }
-    return constructor.New({Napi::External<llvm::DILexicalBlock>::New(env, block)});
+    return constructor.New(env, {Napi::External<llvm::DILexicalBlock>::New(env, block)});
 }
 
 bool DILexicalBlock::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::DILexicalBlock, llvm::Metadata>(value, TypeTag::Metadata);
 }
 
 llvm::DILexicalBlock *DILexicalBlock::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::DILexicalBlock, llvm::Metadata>(value);
 }
 
 DILexicalBlock::DILexicalBlock(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Metadata, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::DILexicalBlock::constructor);
     }
     const auto external = info[0].As<Napi::External<llvm::DILexicalBlock>>();
     block = external.Data();
+    setRoot(block);
 }
 
 llvm::DILexicalBlock *DILexicalBlock::getLLVMPrimitive() {
@@ -711,34 +724,35 @@ void DINamespace::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "DINamespace", {
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), DIScope::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), DIScope::constructor.Value(env));
     exports.Set("DINamespace", func);
 }
 
 Napi::Value DINamespace::New(Napi::Env env, llvm::DINamespace *ns) {
-    return constructor.New({Napi::External<llvm::DINamespace>::New(env, ns)});
+    return constructor.New(env, {Napi::External<llvm::DINamespace>::New(env, ns)});
 }
 
 bool DINamespace::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::DINamespace, llvm::Metadata>(value, TypeTag::Metadata);
 }
 
 llvm::DINamespace *DINamespace::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::DINamespace, llvm::Metadata>(value);
 }
 
 DINamespace::DINamespace(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Metadata, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::DINamespace::constructor);
     }
     const auto external = info[0].As<Napi::External<llvm::DINamespace>>();
     ns = external.Data();
+    setRoot(ns);
 }
 
 llvm::DINamespace *DINamespace::getLLVMPrimitive() {
@@ -753,9 +767,8 @@ void DIVariable::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "DIVariable", {
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), DINode::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), DINode::constructor.Value(env));
     exports.Set("DIVariable", func);
 }
 
@@ -765,27 +778,29 @@ Napi::Value DIVariable::New(Napi::Env env, llvm::DIVariable *variable) {
     } else if (llvm::isa<llvm::DIGlobalVariable>(variable)) {
         return DIGlobalVariable::New(env, llvm::cast<llvm::DIGlobalVariable>(variable));
     }
-    return constructor.New({Napi::External<llvm::DIVariable>::New(env, variable)});
+    return constructor.New(env, {Napi::External<llvm::DIVariable>::New(env, variable)});
 }
 
 bool DIVariable::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::DIVariable, llvm::Metadata>(value, TypeTag::Metadata);
 }
 
 llvm::DIVariable *DIVariable::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::DIVariable, llvm::Metadata>(value);
 }
 
 DIVariable::DIVariable(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Metadata, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::DIVariable::constructor);
     }
     const auto external = info[0].As<Napi::External<llvm::DIVariable>>();
     variable = external.Data();
+    setRoot(variable);
 }
 
 llvm::DIVariable *DIVariable::getLLVMPrimitive() {
@@ -800,34 +815,35 @@ void DIExpression::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "DIExpression", {
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), MDNode::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), MDNode::constructor.Value(env));
     exports.Set("DIExpression", func);
 }
 
 Napi::Value DIExpression::New(Napi::Env env, llvm::DIExpression *expression) {
-    return constructor.New({Napi::External<llvm::DIExpression>::New(env, expression)});
+    return constructor.New(env, {Napi::External<llvm::DIExpression>::New(env, expression)});
 }
 
 bool DIExpression::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::DIExpression, llvm::Metadata>(value, TypeTag::Metadata);
 }
 
 llvm::DIExpression *DIExpression::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::DIExpression, llvm::Metadata>(value);
 }
 
 DIExpression::DIExpression(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Metadata, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::DIExpression::constructor);
     }
     const auto external = info[0].As<Napi::External<llvm::DIExpression>>();
     expression = external.Data();
+    setRoot(expression);
 }
 
 llvm::DIExpression *DIExpression::getLLVMPrimitive() {
@@ -842,34 +858,35 @@ void DIGlobalVariable::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "DIGlobalVariable", {
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), DIVariable::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), DIVariable::constructor.Value(env));
     exports.Set("DIGlobalVariable", func);
 }
 
 Napi::Value DIGlobalVariable::New(Napi::Env env, llvm::DIGlobalVariable *variable) {
-    return constructor.New({Napi::External<llvm::DIGlobalVariable>::New(env, variable)});
+    return constructor.New(env, {Napi::External<llvm::DIGlobalVariable>::New(env, variable)});
 }
 
 bool DIGlobalVariable::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::DIGlobalVariable, llvm::Metadata>(value, TypeTag::Metadata);
 }
 
 llvm::DIGlobalVariable *DIGlobalVariable::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::DIGlobalVariable, llvm::Metadata>(value);
 }
 
 DIGlobalVariable::DIGlobalVariable(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Metadata, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::DIGlobalVariable::constructor);
     }
     const auto external = info[0].As<Napi::External<llvm::DIGlobalVariable>>();
     variable = external.Data();
+    setRoot(variable);
 }
 
 llvm::DIGlobalVariable *DIGlobalVariable::getLLVMPrimitive() {
@@ -884,34 +901,35 @@ void DILocalVariable::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "DILocalVariable", {
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), DIVariable::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), DIVariable::constructor.Value(env));
     exports.Set("DILocalVariable", func);
 }
 
 Napi::Value DILocalVariable::New(Napi::Env env, llvm::DILocalVariable *variable) {
-    return constructor.New({Napi::External<llvm::DILocalVariable>::New(env, variable)});
+    return constructor.New(env, {Napi::External<llvm::DILocalVariable>::New(env, variable)});
 }
 
 bool DILocalVariable::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::DILocalVariable, llvm::Metadata>(value, TypeTag::Metadata);
 }
 
 llvm::DILocalVariable *DILocalVariable::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::DILocalVariable, llvm::Metadata>(value);
 }
 
 DILocalVariable::DILocalVariable(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Metadata, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::DILocalVariable::constructor);
     }
     const auto external = info[0].As<Napi::External<llvm::DILocalVariable>>();
     variable = external.Data();
+    setRoot(variable);
 }
 
 llvm::DILocalVariable *DILocalVariable::getLLVMPrimitive() {
@@ -926,34 +944,35 @@ void DIGlobalVariableExpression::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "DIGlobalVariableExpression", {
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), MDNode::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), MDNode::constructor.Value(env));
     exports.Set("DIGlobalVariableExpression", func);
 }
 
 Napi::Value DIGlobalVariableExpression::New(Napi::Env env, llvm::DIGlobalVariableExpression *expression) {
-    return constructor.New({Napi::External<llvm::DIGlobalVariableExpression>::New(env, expression)});
+    return constructor.New(env, {Napi::External<llvm::DIGlobalVariableExpression>::New(env, expression)});
 }
 
 bool DIGlobalVariableExpression::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::DIGlobalVariableExpression, llvm::Metadata>(value, TypeTag::Metadata);
 }
 
 llvm::DIGlobalVariableExpression *DIGlobalVariableExpression::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::DIGlobalVariableExpression, llvm::Metadata>(value);
 }
 
 DIGlobalVariableExpression::DIGlobalVariableExpression(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Metadata, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::DIGlobalVariableExpression::constructor);
     }
     const auto external = info[0].As<Napi::External<llvm::DIGlobalVariableExpression>>();
     expression = external.Data();
+    setRoot(expression);
 }
 
 llvm::DIGlobalVariableExpression *DIGlobalVariableExpression::getLLVMPrimitive() {
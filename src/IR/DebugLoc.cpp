@@ -5,17 +5,16 @@ void DebugLoc::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "DebugLoc", {
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
+    constructor.Reset(env, func);
     exports.Set("DebugLoc", func);
 }
 
 Napi::Value DebugLoc::New(Napi::Env env, llvm::DebugLoc *location) {
-    return constructor.New({Napi::External<llvm::DebugLoc>::New(env, location)});
+    return constructor.New(env, {Napi::External<llvm::DebugLoc>::New(env, location)});
 }
 
 bool DebugLoc::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || hasTypeTag(value, TypeTag::DebugLoc);
 }
 
 llvm::DebugLoc *DebugLoc::Extract(const Napi::Value &value) {
@@ -26,6 +25,7 @@ llvm::DebugLoc *DebugLoc::Extract(const Napi::Value &value) {
 }
 
 DebugLoc::DebugLoc(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::DebugLoc);
     const Napi::Env env = info.Env();
     const unsigned argsLen = info.Length();
     if (argsLen == 0 && info.IsConstructCall()) {
@@ -9,33 +9,33 @@ void IntegerType::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "IntegerType", {
             StaticMethod("get", &IntegerType::get),
-            InstanceMethod("isStructTy", &IntegerType::isStructTy),
-            InstanceMethod("isIntegerTy", &IntegerType::isIntegerTy),
-            InstanceMethod("isVoidTy", &IntegerType::isVoidTy),
-            InstanceMethod("getTypeID", &IntegerType::getTypeID)
+            InstanceMethod("isStructTy", &IntegerType::guarded<&IntegerType::isStructTy>),
+            InstanceMethod("isIntegerTy", &IntegerType::guarded<&IntegerType::isIntegerTy>),
+            InstanceMethod("isVoidTy", &IntegerType::guarded<&IntegerType::isVoidTy>),
+            InstanceMethod("getTypeID", &IntegerType::guarded<&IntegerType::getTypeID>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Type::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Type::constructor.Value(env));
     exports.Set("IntegerType", func);
 }
 
 Napi::Object IntegerType::New(Napi::Env env, llvm::IntegerType *type) {
-    return constructor.New({Napi::External<llvm::IntegerType>::New(env, type)});
+    return wrapCached<IntegerType>(env, type);
 }
 
 bool IntegerType::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::IntegerType, llvm::Type>(value, TypeTag::Type);
 }
 
 llvm::IntegerType *IntegerType::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::IntegerType, llvm::Type>(value);
 }
 
 IntegerType::IntegerType(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Type, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::IntegerType::constructor);
@@ -88,31 +88,31 @@ void FunctionType::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "FunctionType", {
             StaticMethod("get", &FunctionType::get),
-            InstanceMethod("isVoidTy", &FunctionType::isVoidTy),
-            InstanceMethod("getTypeID", &FunctionType::getTypeID)
+            InstanceMethod("isVoidTy", &FunctionType::guarded<&FunctionType::isVoidTy>),
+            InstanceMethod("getTypeID", &FunctionType::guarded<&FunctionType::getTypeID>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Type::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Type::constructor.Value(env));
     exports.Set("FunctionType", func);
 }
 
 Napi::Object FunctionType::New(Napi::Env env, llvm::FunctionType *type) {
-    return constructor.New({Napi::External<llvm::FunctionType>::New(env, type)});
+    return wrapCached<FunctionType>(env, type);
 }
 
 bool FunctionType::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::FunctionType, llvm::Type>(value, TypeTag::Type);
 }
 
 llvm::FunctionType *FunctionType::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::FunctionType, llvm::Type>(value);
 }
 
 FunctionType::FunctionType(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Type, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::FunctionType::constructor);
@@ -167,18 +167,16 @@ void FunctionCallee::Init(Napi::Env env, Napi::Object &exports) {
             InstanceMethod("getFunctionType", &FunctionCallee::getFunctionType),
             InstanceMethod("getCallee", &FunctionCallee::getCallee)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
+    constructor.Reset(env, func);
     exports.Set("FunctionCallee", func);
 }
 
 Napi::Object FunctionCallee::New(Napi::Env env, llvm::FunctionCallee callee) {
-    tmpCallee = callee;
-    return constructor.New({});
+    return constructor.New(env, {Napi::External<llvm::FunctionCallee>::New(env, &callee)});
 }
 
 bool FunctionCallee::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || hasTypeTag(value, TypeTag::FunctionCallee);
 }
 
 llvm::FunctionCallee FunctionCallee::Extract(const Napi::Value &value) {
@@ -189,13 +187,13 @@ llvm::FunctionCallee FunctionCallee::Extract(const Napi::Value &value) {
 }
 
 FunctionCallee::FunctionCallee(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::FunctionCallee);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::FunctionCallee::constructor);
     }
-    if (tmpCallee) {
-        callee = tmpCallee;
-        tmpCallee = llvm::FunctionCallee(nullptr);
+    if (info.Length() >= 1 && info[0].IsExternal()) {
+        callee = *info[0].As<Napi::External<llvm::FunctionCallee>>().Data();
     }
 }
 
@@ -221,41 +219,41 @@ void StructType::Init(Napi::Env env, Napi::Object &exports) {
             StaticMethod("create", &StructType::create),
             StaticMethod("get", &StructType::get),
             StaticMethod("getTypeByName", &StructType::getTypeByName),
-            InstanceMethod("setBody", &StructType::setBody),
-            InstanceMethod("setName", &StructType::setName),
-            InstanceMethod("hasName", &StructType::hasName),
-            InstanceMethod("getName", &StructType::getName),
-            InstanceMethod("isOpaque", &StructType::isOpaque),
-            InstanceMethod("isPacked", &StructType::isPacked),
-            InstanceMethod("isLiteral", &StructType::isLiteral),
-            InstanceMethod("getPointerTo", &StructType::getPointerTo),
-            InstanceMethod("isStructTy", &StructType::isStructTy),
-            InstanceMethod("isIntegerTy", &StructType::isIntegerTy),
-            InstanceMethod("isVoidTy", &StructType::isVoidTy),
-            InstanceMethod("getTypeID", &StructType::getTypeID)
+            InstanceMethod("setBody", &StructType::guardedVoid<&StructType::setBody>),
+            InstanceMethod("setName", &StructType::guardedVoid<&StructType::setName>),
+            InstanceMethod("hasName", &StructType::guarded<&StructType::hasName>),
+            InstanceMethod("getName", &StructType::guarded<&StructType::getName>),
+            InstanceMethod("isOpaque", &StructType::guarded<&StructType::isOpaque>),
+            InstanceMethod("isPacked", &StructType::guarded<&StructType::isPacked>),
+            InstanceMethod("isLiteral", &StructType::guarded<&StructType::isLiteral>),
+            InstanceMethod("getPointerTo", &StructType::guarded<&StructType::getPointerTo>),
+            InstanceMethod("isStructTy", &StructType::guarded<&StructType::isStructTy>),
+            InstanceMethod("isIntegerTy", &StructType::guarded<&StructType::isIntegerTy>),
+            InstanceMethod("isVoidTy", &StructType::guarded<&StructType::isVoidTy>),
+            InstanceMethod("getTypeID", &StructType::guarded<&StructType::getTypeID>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Type::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Type::constructor.Value(env));
     exports.Set("StructType", func);
 }
 
 Napi::Object StructType::New(Napi::Env env, llvm::StructType *type) {
-    return constructor.New({Napi::External<llvm::StructType>::New(env, type)});
+    return wrapCached<StructType>(env, type);
 }
 
 bool StructType::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::StructType, llvm::Type>(value, TypeTag::Type);
 }
 
 llvm::StructType *StructType::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::StructType, llvm::Type>(value);
 }
 
 StructType::StructType(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Type, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::StructType::constructor);
@@ -415,34 +413,34 @@ void ArrayType::Init(Napi::Env env, Napi::Object &exports) {
     const Napi::Function func = DefineClass(env, "ArrayType", {
             StaticMethod("get", &ArrayType::get),
             StaticMethod("isValidElementType", &ArrayType::isValidElementType),
-            InstanceMethod("getNumElements", &ArrayType::getNumElements),
-            InstanceMethod("getElementType", &ArrayType::getElementType),
-            InstanceMethod("isStructTy", &ArrayType::isStructTy),
-            InstanceMethod("isVoidTy", &ArrayType::isVoidTy),
-            InstanceMethod("getTypeID", &ArrayType::getTypeID)
+            InstanceMethod("getNumElements", &ArrayType::guarded<&ArrayType::getNumElements>),
+            InstanceMethod("getElementType", &ArrayType::guarded<&ArrayType::getElementType>),
+            InstanceMethod("isStructTy", &ArrayType::guarded<&ArrayType::isStructTy>),
+            InstanceMethod("isVoidTy", &ArrayType::guarded<&ArrayType::isVoidTy>),
+            InstanceMethod("getTypeID", &ArrayType::guarded<&ArrayType::getTypeID>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Type::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Type::constructor.Value(env));
     exports.Set("ArrayType", func);
 }
 
 Napi::Object ArrayType::New(Napi::Env env, llvm::ArrayType *type) {
-    return constructor.New({Napi::External<llvm::ArrayType>::New(env, type)});
+    return wrapCached<ArrayType>(env, type);
 }
 
 bool ArrayType::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::ArrayType, llvm::Type>(value, TypeTag::Type);
 }
 
 llvm::ArrayType *ArrayType::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::ArrayType, llvm::Type>(value);
 }
 
 ArrayType::ArrayType(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Type, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::ArrayType::constructor);
@@ -501,32 +499,32 @@ Napi::Value ArrayType::getTypeID(const Napi::CallbackInfo &info) {
 void VectorType::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "VectorType", {
-            InstanceMethod("isStructTy", &VectorType::isStructTy),
-            InstanceMethod("isVoidTy", &VectorType::isVoidTy),
-            InstanceMethod("getTypeID", &VectorType::getTypeID)
+            InstanceMethod("isStructTy", &VectorType::guarded<&VectorType::isStructTy>),
+            InstanceMethod("isVoidTy", &VectorType::guarded<&VectorType::isVoidTy>),
+            InstanceMethod("getTypeID", &VectorType::guarded<&VectorType::getTypeID>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Type::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Type::constructor.Value(env));
     exports.Set("VectorType", func);
 }
 
 Napi::Object VectorType::New(Napi::Env env, llvm::VectorType *type) {
-    return constructor.New({Napi::External<llvm::VectorType>::New(env, type)});
+    return wrapCached<VectorType>(env, type);
 }
 
 bool VectorType::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::VectorType, llvm::Type>(value, TypeTag::Type);
 }
 
 llvm::VectorType *VectorType::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::VectorType, llvm::Type>(value);
 }
 
 VectorType::VectorType(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Type, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::VectorType::constructor);
@@ -560,34 +558,34 @@ void PointerType::Init(Napi::Env env, Napi::Object &exports) {
     const Napi::Function func = DefineClass(env, "PointerType", {
             StaticMethod("get", &PointerType::get),
             StaticMethod("getUnqual", &PointerType::getUnqual),
-            InstanceMethod("isPointerTy", &PointerType::isPointerTy),
-            InstanceMethod("isStructTy", &PointerType::isStructTy),
-            InstanceMethod("isIntegerTy", &PointerType::isIntegerTy),
-            InstanceMethod("isVoidTy", &PointerType::isVoidTy),
-            InstanceMethod("getTypeID", &PointerType::getTypeID),
+            InstanceMethod("isPointerTy", &PointerType::guarded<&PointerType::isPointerTy>),
+            InstanceMethod("isStructTy", &PointerType::guarded<&PointerType::isStructTy>),
+            InstanceMethod("isIntegerTy", &PointerType::guarded<&PointerType::isIntegerTy>),
+            InstanceMethod("isVoidTy", &PointerType::guarded<&PointerType::isVoidTy>),
+            InstanceMethod("getTypeID", &PointerType::guarded<&PointerType::getTypeID>),
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Type::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Type::constructor.Value(env));
     exports.Set("PointerType", func);
 }
 
 Napi::Object PointerType::New(Napi::Env env, llvm::PointerType *type) {
-    return constructor.New({Napi::External<llvm::PointerType>::New(env, type)});
+    return wrapCached<PointerType>(env, type);
 }
 
 bool PointerType::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::PointerType, llvm::Type>(value, TypeTag::Type);
 }
 
 llvm::PointerType *PointerType::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::PointerType, llvm::Type>(value);
 }
 
 PointerType::PointerType(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Type, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::PointerType::constructor);
@@ -6,59 +6,61 @@ void Function::Init(Napi::Env env, Napi::Object &exports) {
     const Napi::Function func = DefineClass(env, "Function", {
                                                 StaticMethod("Create", &Function::Create),
                                                 StaticMethod("isTargetIntrinsic", &Function::isTargetIntrinsic_static),
-                                                InstanceMethod("arg_size", &Function::argSize),
-                                                InstanceMethod("getArg", &Function::getArg),
-                                                InstanceMethod("getReturnType", &Function::getReturnType),
-                                                InstanceMethod("addBasicBlock", &Function::addBasicBlock),
-                                                InstanceMethod("getEntryBlock", &Function::getEntryBlock),
-                                                InstanceMethod("getExitBlock", &Function::getExitBlock),
-                                                InstanceMethod("insertAfter", &Function::insertAfter),
-                                                InstanceMethod("deleteBody", &Function::deleteBody),
-                                                InstanceMethod("removeFromParent", &Function::removeFromParent),
-                                                InstanceMethod("eraseFromParent", &Function::eraseFromParent),
-                                                InstanceMethod("use_empty", &Function::useEmpty),
-                                                InstanceMethod("user_empty", &Function::userEmpty),
-                                                InstanceMethod("getNumUses", &Function::getNumUses),
-                                                InstanceMethod("removeDeadConstantUsers", &Function::removeDeadConstantUsers),
-                                                InstanceMethod("hasPersonalityFn", &Function::hasPersonalityFn),
-                                                InstanceMethod("setPersonalityFn", &Function::setPersonalityFn),
-                                                InstanceMethod("setDoesNotThrow", &Function::setDoesNotThrow),
-                                                InstanceMethod("setSubprogram", &Function::setSubprogram),
-                                                InstanceMethod("getSubprogram", &Function::getSubprogram),
-                                                InstanceMethod("getType", &Function::getType),
-                                                InstanceMethod("addFnAttr", &Function::addFnAttr),
-                                                InstanceMethod("addParamAttr", &Function::addParamAttr),
-                                                InstanceMethod("addRetAttr", &Function::addRetAttr),
-                                                InstanceMethod("hasLazyArguments", &Function::hasLazyArguments),
-                                                InstanceMethod("isMaterializable", &Function::isMaterializable),
-                                                InstanceMethod("setIsMaterializable", &Function::setIsMaterializable),
-                                                InstanceMethod("getIntrinsicID", &Function::getIntrinsicID),
-                                                InstanceMethod("isIntrinsic", &Function::isIntrinsic),
-                                                InstanceMethod("isTargetIntrinsic", &Function::isTargetIntrinsic),
-                                                InstanceMethod("isConstrainedFPIntrinsic", &Function::isConstrainedFPIntrinsic),
+                                                InstanceMethod("arg_size", &Function::guarded<&Function::argSize>),
+                                                InstanceMethod("getArg", &Function::guarded<&Function::getArg>),
+                                                InstanceMethod("getArguments", &Function::guarded<&Function::getArguments>),
+                                                InstanceMethod("getReturnType", &Function::guarded<&Function::getReturnType>),
+                                                InstanceMethod("addBasicBlock", &Function::guardedVoid<&Function::addBasicBlock>),
+                                                InstanceMethod("getEntryBlock", &Function::guarded<&Function::getEntryBlock>),
+                                                InstanceMethod("getBasicBlocks", &Function::guarded<&Function::getBasicBlocks>),
+                                                InstanceMethod("getExitBlock", &Function::guarded<&Function::getExitBlock>),
+                                                InstanceMethod("insertAfter", &Function::guardedVoid<&Function::insertAfter>),
+                                                InstanceMethod("deleteBody", &Function::guardedVoid<&Function::deleteBody>),
+                                                InstanceMethod("removeFromParent", &Function::guardedVoid<&Function::removeFromParent>),
+                                                InstanceMethod("eraseFromParent", &Function::guardedVoid<&Function::eraseFromParent>),
+                                                InstanceMethod("use_empty", &Function::guarded<&Function::useEmpty>),
+                                                InstanceMethod("user_empty", &Function::guarded<&Function::userEmpty>),
+                                                InstanceMethod("getNumUses", &Function::guarded<&Function::getNumUses>),
+                                                InstanceMethod("removeDeadConstantUsers", &Function::guardedVoid<&Function::removeDeadConstantUsers>),
+                                                InstanceMethod("hasPersonalityFn", &Function::guarded<&Function::hasPersonalityFn>),
+                                                InstanceMethod("setPersonalityFn", &Function::guardedVoid<&Function::setPersonalityFn>),
+                                                InstanceMethod("setDoesNotThrow", &Function::guardedVoid<&Function::setDoesNotThrow>),
+                                                InstanceMethod("setSubprogram", &Function::guardedVoid<&Function::setSubprogram>),
+                                                InstanceMethod("getSubprogram", &Function::guarded<&Function::getSubprogram>),
+                                                InstanceMethod("getType", &Function::guarded<&Function::getType>),
+                                                InstanceMethod("addFnAttr", &Function::guardedVoid<&Function::addFnAttr>),
+                                                InstanceMethod("addParamAttr", &Function::guardedVoid<&Function::addParamAttr>),
+                                                InstanceMethod("addRetAttr", &Function::guardedVoid<&Function::addRetAttr>),
+                                                InstanceMethod("hasLazyArguments", &Function::guarded<&Function::hasLazyArguments>),
+                                                InstanceMethod("isMaterializable", &Function::guarded<&Function::isMaterializable>),
+                                                InstanceMethod("setIsMaterializable", &Function::guardedVoid<&Function::setIsMaterializable>),
+                                                InstanceMethod("getIntrinsicID", &Function::guarded<&Function::getIntrinsicID>),
+                                                InstanceMethod("isIntrinsic", &Function::guarded<&Function::isIntrinsic>),
+                                                InstanceMethod("isTargetIntrinsic", &Function::guarded<&Function::isTargetIntrinsic>),
+                                                InstanceMethod("isConstrainedFPIntrinsic", &Function::guarded<&Function::isConstrainedFPIntrinsic>),
                                             });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), GlobalObject::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), GlobalObject::constructor.Value(env));
     exports.Set("Function", func);
 }
 
 Napi::Object Function::New(Napi::Env env, llvm::Function *function) {
-    return constructor.New({Napi::External<llvm::Function>::New(env, function)});
+    return wrapCached<Function>(env, function);
 }
 
 bool Function::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::Function, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::Function *Function::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::Function, llvm::Value>(value);
 }
 
 Function::Function(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::Function::Create);
@@ -176,6 +178,16 @@ Napi::Value Function::getArg(const Napi::CallbackInfo &info) {
     throw Napi::TypeError::New(env, ErrMsg::Class::Function::getArg);
 }
 
+Napi::Value Function::getArguments(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    Napi::Array args = Napi::Array::New(env, function->arg_size());
+    uint32_t i = 0;
+    for (llvm::Argument &arg: function->args()) {
+        args.Set(i++, Argument::New(env, &arg));
+    }
+    return args;
+}
+
 Napi::Value Function::getReturnType(const Napi::CallbackInfo &info) {
     return Type::New(info.Env(), function->getReturnType());
 }
@@ -193,6 +205,16 @@ Napi::Value Function::getEntryBlock(const Napi::CallbackInfo &info) {
     return BasicBlock::New(info.Env(), &(function->getEntryBlock()));
 }
 
+Napi::Value Function::getBasicBlocks(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    Napi::Array basicBlocks = Napi::Array::New(env, function->size());
+    uint32_t i = 0;
+    for (llvm::BasicBlock &basicBlock: *function) {
+        basicBlocks.Set(i++, BasicBlock::New(env, &basicBlock));
+    }
+    return basicBlocks;
+}
+
 Napi::Value Function::getExitBlock(const Napi::CallbackInfo &info) {
     return BasicBlock::New(info.Env(), &(function->back()));
 }
@@ -208,6 +230,9 @@ void Function::insertAfter(const Napi::CallbackInfo &info) {
 }
 
 void Function::deleteBody(const Napi::CallbackInfo &info) {
+    for (const llvm::BasicBlock &basicBlock : *function) {
+        invalidateTree(&basicBlock);
+    }
     function->deleteBody();
 }
 
@@ -216,6 +241,7 @@ void Function::removeFromParent(const Napi::CallbackInfo &info) {
 }
 
 void Function::eraseFromParent(const Napi::CallbackInfo &info) {
+    invalidateTree(function);
     function->eraseFromParent();
 }
 
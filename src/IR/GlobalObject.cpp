@@ -4,36 +4,31 @@
 void GlobalObject::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "GlobalObject", {
-            InstanceMethod("getType", &GlobalObject::getType),
-            InstanceMethod("getValueType", &GlobalObject::getValueType)
+            InstanceMethod("getType", &GlobalObject::guarded<&GlobalObject::getType>),
+            InstanceMethod("getValueType", &GlobalObject::guarded<&GlobalObject::getValueType>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), GlobalValue::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), GlobalValue::constructor.Value(env));
     exports.Set("GlobalObject", func);
 }
 
 Napi::Object GlobalObject::New(Napi::Env env, llvm::GlobalObject *globalObject) {
-    if (llvm::isa<llvm::Function>(globalObject)) {
-        return Function::New(env, llvm::cast<llvm::Function>(globalObject));
-    } else if (llvm::isa<llvm::GlobalVariable>(globalObject)) {
-        return GlobalVariable::New(env, llvm::cast<llvm::GlobalVariable>(globalObject));
-    }
-    return constructor.New({Napi::External<llvm::GlobalObject>::New(env, globalObject)});
+    return Value::New(env, globalObject).As<Napi::Object>();
 }
 
 bool GlobalObject::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::GlobalObject, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::GlobalObject *GlobalObject::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::GlobalObject, llvm::Value>(value);
 }
 
 GlobalObject::GlobalObject(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::GlobalObject::constructor);
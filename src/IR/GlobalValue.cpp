@@ -22,34 +22,31 @@ void GlobalValue::Init(Napi::Env env, Napi::Object &exports) {
     const Napi::Function func = DefineClass(env, "GlobalValue", {
             StaticValue("LinkageTypes", linkageTypes),
             StaticValue("VisibilityTypes", visibilityTypes),
-            InstanceMethod("getType", &GlobalValue::getType),
-            InstanceMethod("getValueType", &GlobalValue::getValueType)
+            InstanceMethod("getType", &GlobalValue::guarded<&GlobalValue::getType>),
+            InstanceMethod("getValueType", &GlobalValue::guarded<&GlobalValue::getValueType>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Constant::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Constant::constructor.Value(env));
     exports.Set("GlobalValue", func);
 }
 
 Napi::Object GlobalValue::New(Napi::Env env, llvm::GlobalValue *globalValue) {
-    if (llvm::isa<llvm::GlobalObject>(globalValue)) {
-        return GlobalObject::New(env, llvm::cast<llvm::GlobalObject>(globalValue));
-    }
-    return constructor.New({Napi::External<llvm::GlobalValue>::New(env, globalValue)});
+    return Value::New(env, globalValue).As<Napi::Object>();
 }
 
 bool GlobalValue::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::GlobalValue, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::GlobalValue *GlobalValue::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::GlobalValue, llvm::Value>(value);
 }
 
 GlobalValue::GlobalValue(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::GlobalValue::constructor);
@@ -4,35 +4,35 @@
 void GlobalVariable::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "GlobalVariable", {
-            InstanceMethod("getType", &GlobalVariable::getType),
-            InstanceMethod("getValueType", &GlobalVariable::getValueType),
-            InstanceMethod("setInitializer", &GlobalVariable::setInitializer),
-            InstanceMethod("removeFromParent", &GlobalVariable::removeFromParent),
-            InstanceMethod("eraseFromParent", &GlobalVariable::eraseFromParent),
-            InstanceMethod("addDebugInfo", &GlobalVariable::addDebugInfo)
+            InstanceMethod("getType", &GlobalVariable::guarded<&GlobalVariable::getType>),
+            InstanceMethod("getValueType", &GlobalVariable::guarded<&GlobalVariable::getValueType>),
+            InstanceMethod("setInitializer", &GlobalVariable::guardedVoid<&GlobalVariable::setInitializer>),
+            InstanceMethod("removeFromParent", &GlobalVariable::guardedVoid<&GlobalVariable::removeFromParent>),
+            InstanceMethod("eraseFromParent", &GlobalVariable::guardedVoid<&GlobalVariable::eraseFromParent>),
+            InstanceMethod("addDebugInfo", &GlobalVariable::guardedVoid<&GlobalVariable::addDebugInfo>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), GlobalObject::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), GlobalObject::constructor.Value(env));
     exports.Set("GlobalVariable", func);
 }
 
 Napi::Object GlobalVariable::New(Napi::Env env, llvm::GlobalVariable *variable) {
-    return constructor.New({Napi::External<llvm::GlobalVariable>::New(env, variable)});
+    return wrapCached<GlobalVariable>(env, variable);
 }
 
 bool GlobalVariable::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::GlobalVariable, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::GlobalVariable *GlobalVariable::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::GlobalVariable, llvm::Value>(value);
 }
 
 GlobalVariable::GlobalVariable(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::GlobalVariable::constructor);
@@ -55,6 +55,7 @@ GlobalVariable::GlobalVariable(const Napi::CallbackInfo &info) : ObjectWrap(info
             llvm::Constant *initializer = argsLen >= 4 ? Constant::Extract(info[3]) : nullptr;
             const std::string name = argsLen >= 5 ? std::string(info[4].As<Napi::String>()) : "";
             globalVariable = new llvm::GlobalVariable(type, isConstant, linkage, initializer, name);
+            registerCached(*this, info.This().As<Napi::Object>(), globalVariable);
             return;
         }
     } else if (argsLen >= 5 &&
@@ -71,6 +72,7 @@ GlobalVariable::GlobalVariable(const Napi::CallbackInfo &info) : ObjectWrap(info
             llvm::Constant *initializer = Constant::Extract(info[4]);
             const std::string name = argsLen >= 6 ? std::string(info[5].As<Napi::String>()) : "";
             globalVariable = new llvm::GlobalVariable(*module, type, isConstant, linkage, initializer, name);
+            registerCached(*this, info.This().As<Napi::Object>(), globalVariable);
             return;
         }
     }
@@ -108,6 +110,7 @@ void GlobalVariable::removeFromParent(const Napi::CallbackInfo &info) {
 }
 
 void GlobalVariable::eraseFromParent(const Napi::CallbackInfo &info) {
+    invalidateTree(globalVariable);
     globalVariable->eraseFromParent();
 }
 
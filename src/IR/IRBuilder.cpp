@@ -1,3 +1,4 @@
+#include <optional>
 #include "IR/index.h"
 #include "ADT/APInt.h"
 #include "Util/index.h"
@@ -6,186 +7,249 @@ using WrappedValue = Value;
 
 void IRBuilder::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
+    const Napi::Object batchOpNS = Napi::Object::New(env);
+    batchOpNS.Set("SetInsertPoint", Napi::Number::New(env, BatchOp::SetInsertPoint));
+    batchOpNS.Set("ConstInt", Napi::Number::New(env, BatchOp::ConstInt));
+    batchOpNS.Set("Add", Napi::Number::New(env, BatchOp::Add));
+    batchOpNS.Set("FAdd", Napi::Number::New(env, BatchOp::FAdd));
+    batchOpNS.Set("Sub", Napi::Number::New(env, BatchOp::Sub));
+    batchOpNS.Set("FSub", Napi::Number::New(env, BatchOp::FSub));
+    batchOpNS.Set("Mul", Napi::Number::New(env, BatchOp::Mul));
+    batchOpNS.Set("FMul", Napi::Number::New(env, BatchOp::FMul));
+    batchOpNS.Set("UDiv", Napi::Number::New(env, BatchOp::UDiv));
+    batchOpNS.Set("SDiv", Napi::Number::New(env, BatchOp::SDiv));
+    batchOpNS.Set("FDiv", Napi::Number::New(env, BatchOp::FDiv));
+    batchOpNS.Set("URem", Napi::Number::New(env, BatchOp::URem));
+    batchOpNS.Set("SRem", Napi::Number::New(env, BatchOp::SRem));
+    batchOpNS.Set("FRem", Napi::Number::New(env, BatchOp::FRem));
+    batchOpNS.Set("Shl", Napi::Number::New(env, BatchOp::Shl));
+    batchOpNS.Set("LShr", Napi::Number::New(env, BatchOp::LShr));
+    batchOpNS.Set("AShr", Napi::Number::New(env, BatchOp::AShr));
+    batchOpNS.Set("And", Napi::Number::New(env, BatchOp::And));
+    batchOpNS.Set("Or", Napi::Number::New(env, BatchOp::Or));
+    batchOpNS.Set("Xor", Napi::Number::New(env, BatchOp::Xor));
+    batchOpNS.Set("Neg", Napi::Number::New(env, BatchOp::Neg));
+    batchOpNS.Set("FNeg", Napi::Number::New(env, BatchOp::FNeg));
+    batchOpNS.Set("Not", Napi::Number::New(env, BatchOp::Not));
+    batchOpNS.Set("ICmp", Napi::Number::New(env, BatchOp::ICmp));
+    batchOpNS.Set("FCmp", Napi::Number::New(env, BatchOp::FCmp));
+    batchOpNS.Set("Trunc", Napi::Number::New(env, BatchOp::Trunc));
+    batchOpNS.Set("ZExt", Napi::Number::New(env, BatchOp::ZExt));
+    batchOpNS.Set("SExt", Napi::Number::New(env, BatchOp::SExt));
+    batchOpNS.Set("FPToUI", Napi::Number::New(env, BatchOp::FPToUI));
+    batchOpNS.Set("FPToSI", Napi::Number::New(env, BatchOp::FPToSI));
+    batchOpNS.Set("UIToFP", Napi::Number::New(env, BatchOp::UIToFP));
+    batchOpNS.Set("SIToFP", Napi::Number::New(env, BatchOp::SIToFP));
+    batchOpNS.Set("FPTrunc", Napi::Number::New(env, BatchOp::FPTrunc));
+    batchOpNS.Set("FPExt", Napi::Number::New(env, BatchOp::FPExt));
+    batchOpNS.Set("PtrToInt", Napi::Number::New(env, BatchOp::PtrToInt));
+    batchOpNS.Set("IntToPtr", Napi::Number::New(env, BatchOp::IntToPtr));
+    batchOpNS.Set("BitCast", Napi::Number::New(env, BatchOp::BitCast));
+    batchOpNS.Set("Alloca", Napi::Number::New(env, BatchOp::Alloca));
+    batchOpNS.Set("Load", Napi::Number::New(env, BatchOp::Load));
+    batchOpNS.Set("Store", Napi::Number::New(env, BatchOp::Store));
+    batchOpNS.Set("GEP", Napi::Number::New(env, BatchOp::GEP));
+    batchOpNS.Set("InBoundsGEP", Napi::Number::New(env, BatchOp::InBoundsGEP));
+    batchOpNS.Set("Call", Napi::Number::New(env, BatchOp::Call));
+    batchOpNS.Set("Select", Napi::Number::New(env, BatchOp::Select));
+    batchOpNS.Set("PHI", Napi::Number::New(env, BatchOp::PHI));
+    batchOpNS.Set("AddIncoming", Napi::Number::New(env, BatchOp::AddIncoming));
+    batchOpNS.Set("Ret", Napi::Number::New(env, BatchOp::Ret));
+    batchOpNS.Set("RetVoid", Napi::Number::New(env, BatchOp::RetVoid));
+    batchOpNS.Set("Br", Napi::Number::New(env, BatchOp::Br));
+    batchOpNS.Set("CondBr", Napi::Number::New(env, BatchOp::CondBr));
+    batchOpNS.Set("Unreachable", Napi::Number::New(env, BatchOp::Unreachable));
+    batchOpNS.Set("ConstInt64", Napi::Number::New(env, BatchOp::ConstInt64));
+
     const Napi::Function func = DefineClass(env, "IRBuilder", {
             //===--------------------------------------------------------------------===//
             // Builder configuration methods
             //===--------------------------------------------------------------------===//
 
-            InstanceMethod("ClearInsertionPoint", &IRBuilder::ClearInsertionPoint),
-            InstanceMethod("GetInsertBlock", &IRBuilder::GetInsertBlock),
-            InstanceMethod("SetInsertPoint", &IRBuilder::SetInsertPoint),
-            InstanceMethod("SetCurrentDebugLocation", &IRBuilder::SetCurrentDebugLocation),
+            InstanceMethod("ClearInsertionPoint", &IRBuilder::guardedVoid<&IRBuilder::ClearInsertionPoint>),
+            InstanceMethod("GetInsertBlock", &IRBuilder::guarded<&IRBuilder::GetInsertBlock>),
+            InstanceMethod("SetInsertPoint", &IRBuilder::guardedVoid<&IRBuilder::SetInsertPoint>),
+            InstanceMethod("SetCurrentDebugLocation", &IRBuilder::guardedVoid<&IRBuilder::SetCurrentDebugLocation>),
 
             StaticValue("InsertPoint", InsertPoint::Init(env, exports)),
-            InstanceMethod("saveIP", &IRBuilder::saveIP),
-            InstanceMethod("saveAndClearIP", &IRBuilder::saveAndClearIP),
-            InstanceMethod("restoreIP", &IRBuilder::restoreIP),
+            InstanceMethod("saveIP", &IRBuilder::guarded<&IRBuilder::saveIP>),
+            InstanceMethod("saveAndClearIP", &IRBuilder::guarded<&IRBuilder::saveAndClearIP>),
+            InstanceMethod("restoreIP", &IRBuilder::guardedVoid<&IRBuilder::restoreIP>),
 
             //===--------------------------------------------------------------------===//
             // Miscellaneous creation methods.
             //===--------------------------------------------------------------------===//
 
-            InstanceMethod("CreateGlobalString", &IRBuilder::CreateGlobalString),
-            InstanceMethod("getInt1", &IRBuilder::getInt1),
-            InstanceMethod("getTrue", &IRBuilder::getBoolFactory<&LLVMIRBuilder::getTrue>),
-            InstanceMethod("getFalse", &IRBuilder::getBoolFactory<&LLVMIRBuilder::getFalse>),
-            InstanceMethod("getInt8", &IRBuilder::getIntFactory<&LLVMIRBuilder::getInt8>),
-            InstanceMethod("getInt16", &IRBuilder::getIntFactory<&LLVMIRBuilder::getInt16>),
-            InstanceMethod("getInt32", &IRBuilder::getIntFactory<&LLVMIRBuilder::getInt32>),
-            InstanceMethod("getInt64", &IRBuilder::getIntFactory<&LLVMIRBuilder::getInt64>),
-            InstanceMethod("getIntN", &IRBuilder::getIntN),
-            InstanceMethod("getInt", &IRBuilder::getInt),
+            InstanceMethod("CreateGlobalString", &IRBuilder::guarded<&IRBuilder::CreateGlobalString>),
+            InstanceMethod("getInt1", &IRBuilder::guarded<&IRBuilder::getInt1>),
+            InstanceMethod("getTrue", &IRBuilder::guarded<&IRBuilder::getBoolFactory<&LLVMIRBuilder::getTrue>>),
+            InstanceMethod("getFalse", &IRBuilder::guarded<&IRBuilder::getBoolFactory<&LLVMIRBuilder::getFalse>>),
+            InstanceMethod("getInt8", &IRBuilder::guarded<&IRBuilder::getIntFactory<&LLVMIRBuilder::getInt8>>),
+            InstanceMethod("getInt16", &IRBuilder::guarded<&IRBuilder::getIntFactory<&LLVMIRBuilder::getInt16>>),
+            InstanceMethod("getInt32", &IRBuilder::guarded<&IRBuilder::getIntFactory<&LLVMIRBuilder::getInt32>>),
+            InstanceMethod("getInt64", &IRBuilder::guarded<&IRBuilder::getIntFactory<&LLVMIRBuilder::getInt64>>),
+            InstanceMethod("getIntN", &IRBuilder::guarded<&IRBuilder::getIntN>),
+            InstanceMethod("getInt", &IRBuilder::guarded<&IRBuilder::getInt>),
 
             //===--------------------------------------------------------------------===//
             // Type creation methods
             //===--------------------------------------------------------------------===//
 
-            InstanceMethod("getInt1Ty", &IRBuilder::getIntTypeFactory<&LLVMIRBuilder::getInt1Ty>),
-            InstanceMethod("getInt8Ty", &IRBuilder::getIntTypeFactory<&LLVMIRBuilder::getInt8Ty>),
-            InstanceMethod("getInt16Ty", &IRBuilder::getIntTypeFactory<&LLVMIRBuilder::getInt16Ty>),
-            InstanceMethod("getInt32Ty", &IRBuilder::getIntTypeFactory<&LLVMIRBuilder::getInt32Ty>),
-            InstanceMethod("getInt64Ty", &IRBuilder::getIntTypeFactory<&LLVMIRBuilder::getInt64Ty>),
-            InstanceMethod("getInt128Ty", &IRBuilder::getIntTypeFactory<&LLVMIRBuilder::getInt128Ty>),
-            InstanceMethod("getIntNTy", &IRBuilder::getIntNTy),
-            InstanceMethod("getHalfTy", &IRBuilder::getTypeFactory<&LLVMIRBuilder::getHalfTy>),
-            InstanceMethod("getBFloatTy", &IRBuilder::getTypeFactory<&LLVMIRBuilder::getBFloatTy>),
-            InstanceMethod("getFloatTy", &IRBuilder::getTypeFactory<&LLVMIRBuilder::getFloatTy>),
-            InstanceMethod("getDoubleTy", &IRBuilder::getTypeFactory<&LLVMIRBuilder::getDoubleTy>),
-            InstanceMethod("getVoidTy", &IRBuilder::getTypeFactory<&LLVMIRBuilder::getVoidTy>),
-            InstanceMethod("getInt8PtrTy", &IRBuilder::getInt8PtrTy),
-            InstanceMethod("getIntPtrTy", &IRBuilder::getIntPtrTy),
+            InstanceMethod("getInt1Ty", &IRBuilder::guarded<&IRBuilder::getIntTypeFactory<&LLVMIRBuilder::getInt1Ty>>),
+            InstanceMethod("getInt8Ty", &IRBuilder::guarded<&IRBuilder::getIntTypeFactory<&LLVMIRBuilder::getInt8Ty>>),
+            InstanceMethod("getInt16Ty", &IRBuilder::guarded<&IRBuilder::getIntTypeFactory<&LLVMIRBuilder::getInt16Ty>>),
+            InstanceMethod("getInt32Ty", &IRBuilder::guarded<&IRBuilder::getIntTypeFactory<&LLVMIRBuilder::getInt32Ty>>),
+            InstanceMethod("getInt64Ty", &IRBuilder::guarded<&IRBuilder::getIntTypeFactory<&LLVMIRBuilder::getInt64Ty>>),
+            InstanceMethod("getInt128Ty", &IRBuilder::guarded<&IRBuilder::getIntTypeFactory<&LLVMIRBuilder::getInt128Ty>>),
+            InstanceMethod("getIntNTy", &IRBuilder::guarded<&IRBuilder::getIntNTy>),
+            InstanceMethod("getHalfTy", &IRBuilder::guarded<&IRBuilder::getTypeFactory<&LLVMIRBuilder::getHalfTy>>),
+            InstanceMethod("getBFloatTy", &IRBuilder::guarded<&IRBuilder::getTypeFactory<&LLVMIRBuilder::getBFloatTy>>),
+            InstanceMethod("getFloatTy", &IRBuilder::guarded<&IRBuilder::getTypeFactory<&LLVMIRBuilder::getFloatTy>>),
+            InstanceMethod("getDoubleTy", &IRBuilder::guarded<&IRBuilder::getTypeFactory<&LLVMIRBuilder::getDoubleTy>>),
+            InstanceMethod("getVoidTy", &IRBuilder::guarded<&IRBuilder::getTypeFactory<&LLVMIRBuilder::getVoidTy>>),
+            InstanceMethod("getInt8PtrTy", &IRBuilder::guarded<&IRBuilder::getInt8PtrTy>),
+            InstanceMethod("getIntPtrTy", &IRBuilder::guarded<&IRBuilder::getIntPtrTy>),
 
             //===--------------------------------------------------------------------===//
             // Instruction creation methods: Terminators
             //===--------------------------------------------------------------------===//
 
-            InstanceMethod("CreateRetVoid", &IRBuilder::CreateRetVoid),
-            InstanceMethod("CreateRet", &IRBuilder::CreateRet),
-            InstanceMethod("CreateBr", &IRBuilder::CreateBr),
-            InstanceMethod("CreateCondBr", &IRBuilder::CreateCondBr),
-            InstanceMethod("CreateSwitch", &IRBuilder::CreateSwitch),
-            InstanceMethod("CreateIndirectBr", &IRBuilder::CreateIndirectBr),
-            InstanceMethod("CreateInvoke", &IRBuilder::CreateInvoke),
-            InstanceMethod("CreateResume", &IRBuilder::CreateResume),
-            InstanceMethod("CreateUnreachable", &IRBuilder::CreateUnreachable),
+            InstanceMethod("CreateRetVoid", &IRBuilder::guarded<&IRBuilder::CreateRetVoid>),
+            InstanceMethod("CreateRet", &IRBuilder::guarded<&IRBuilder::CreateRet>),
+            InstanceMethod("CreateBr", &IRBuilder::guarded<&IRBuilder::CreateBr>),
+            InstanceMethod("CreateCondBr", &IRBuilder::guarded<&IRBuilder::CreateCondBr>),
+            InstanceMethod("CreateSwitch", &IRBuilder::guarded<&IRBuilder::CreateSwitch>),
+            InstanceMethod("CreateIndirectBr", &IRBuilder::guarded<&IRBuilder::CreateIndirectBr>),
+            InstanceMethod("CreateInvoke", &IRBuilder::guarded<&IRBuilder::CreateInvoke>),
+            InstanceMethod("CreateResume", &IRBuilder::guarded<&IRBuilder::CreateResume>),
+            InstanceMethod("CreateUnreachable", &IRBuilder::guarded<&IRBuilder::CreateUnreachable>),
 
             //===--------------------------------------------------------------------===//
             // Instruction creation methods: Binary Operators
             //===--------------------------------------------------------------------===//
 
-            InstanceMethod("CreateAdd", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateAdd>),
-            InstanceMethod("CreateFAdd", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateFAdd>),
-            InstanceMethod("CreateSub", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateSub>),
-            InstanceMethod("CreateFSub", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateFSub>),
-            InstanceMethod("CreateMul", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateMul>),
-            InstanceMethod("CreateFMul", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateFMul>),
-            InstanceMethod("CreateSDiv", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateSDiv>),
-            InstanceMethod("CreateUDiv", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateUDiv>),
-            InstanceMethod("CreateFDiv", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateFDiv>),
-            InstanceMethod("CreateSRem", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateSRem>),
-            InstanceMethod("CreateURem", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateURem>),
-            InstanceMethod("CreateFRem", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateFRem>),
-            InstanceMethod("CreateAnd", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateAnd>),
-            InstanceMethod("CreateOr", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateOr>),
-            InstanceMethod("CreateXor", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateXor>),
-            InstanceMethod("CreateShl", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateShl>),
-            InstanceMethod("CreateAShr", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateAShr>),
-            InstanceMethod("CreateLShr", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateLShr>),
-            InstanceMethod("CreateNeg", &IRBuilder::unOpFactory<&LLVMIRBuilder::CreateNeg>),
-            InstanceMethod("CreateFNeg", &IRBuilder::unOpFactory<&LLVMIRBuilder::CreateFNeg>),
-            InstanceMethod("CreateNot", &IRBuilder::unOpFactory<&LLVMIRBuilder::CreateNot>),
+            InstanceMethod("CreateAdd", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateAdd>>),
+            InstanceMethod("CreateFAdd", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateFAdd>>),
+            InstanceMethod("CreateSub", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateSub>>),
+            InstanceMethod("CreateFSub", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateFSub>>),
+            InstanceMethod("CreateMul", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateMul>>),
+            InstanceMethod("CreateFMul", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateFMul>>),
+            InstanceMethod("CreateSDiv", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateSDiv>>),
+            InstanceMethod("CreateUDiv", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateUDiv>>),
+            InstanceMethod("CreateFDiv", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateFDiv>>),
+            InstanceMethod("CreateSRem", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateSRem>>),
+            InstanceMethod("CreateURem", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateURem>>),
+            InstanceMethod("CreateFRem", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateFRem>>),
+            InstanceMethod("CreateAnd", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateAnd>>),
+            InstanceMethod("CreateOr", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateOr>>),
+            InstanceMethod("CreateXor", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateXor>>),
+            InstanceMethod("CreateShl", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateShl>>),
+            InstanceMethod("CreateAShr", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateAShr>>),
+            InstanceMethod("CreateLShr", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateLShr>>),
+            InstanceMethod("CreateNeg", &IRBuilder::guarded<&IRBuilder::unOpFactory<&LLVMIRBuilder::CreateNeg>>),
+            InstanceMethod("CreateFNeg", &IRBuilder::guarded<&IRBuilder::unOpFactory<&LLVMIRBuilder::CreateFNeg>>),
+            InstanceMethod("CreateNot", &IRBuilder::guarded<&IRBuilder::unOpFactory<&LLVMIRBuilder::CreateNot>>),
 
             //===--------------------------------------------------------------------===//
             // Instruction creation methods: Memory Instructions
             //===--------------------------------------------------------------------===//
 
-            InstanceMethod("CreateAlloca", &IRBuilder::CreateAlloca),
-            InstanceMethod("CreateLoad", &IRBuilder::CreateLoad),
-            InstanceMethod("CreateStore", &IRBuilder::CreateStore),
-            InstanceMethod("CreateGEP", &IRBuilder::CreateGEP),
-            InstanceMethod("CreateInBoundsGEP", &IRBuilder::CreateInBoundsGEP),
-            InstanceMethod("CreateGlobalStringPtr", &IRBuilder::CreateGlobalStringPtr),
+            InstanceMethod("CreateAlloca", &IRBuilder::guarded<&IRBuilder::CreateAlloca>),
+            InstanceMethod("CreateLoad", &IRBuilder::guarded<&IRBuilder::CreateLoad>),
+            InstanceMethod("CreateStore", &IRBuilder::guarded<&IRBuilder::CreateStore>),
+            InstanceMethod("CreateGEP", &IRBuilder::guarded<&IRBuilder::CreateGEP>),
+            InstanceMethod("CreateInBoundsGEP", &IRBuilder::guarded<&IRBuilder::CreateInBoundsGEP>),
+            InstanceMethod("CreateGlobalStringPtr", &IRBuilder::guarded<&IRBuilder::CreateGlobalStringPtr>),
 
             //===--------------------------------------------------------------------===//
             // Instruction creation methods: Cast/Conversion Operators
             //===--------------------------------------------------------------------===//
 
-            InstanceMethod("CreateTrunc", &IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateTrunc>),
-            InstanceMethod("CreateZExt", &IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateZExt>),
-            InstanceMethod("CreateSExt", &IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateSExt>),
-            InstanceMethod("CreateZExtOrTrunc", &IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateZExtOrTrunc>),
-            InstanceMethod("CreateSExtOrTrunc", &IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateSExtOrTrunc>),
-            InstanceMethod("CreateFPToUI", &IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateFPToUI>),
-            InstanceMethod("CreateFPToSI", &IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateFPToSI>),
-            InstanceMethod("CreateUIToFP", &IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateUIToFP>),
-            InstanceMethod("CreateSIToFP", &IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateSIToFP>),
-            InstanceMethod("CreateFPTrunc", &IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateFPTrunc>),
-            InstanceMethod("CreateFPExt", &IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateFPExt>),
-            InstanceMethod("CreatePtrToInt", &IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreatePtrToInt>),
-            InstanceMethod("CreateIntToPtr", &IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateIntToPtr>),
-            InstanceMethod("CreateBitCast", &IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateBitCast>),
-            InstanceMethod("CreateAddrSpaceCast", &IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateAddrSpaceCast>),
-            InstanceMethod("CreateZExtOrBitCast", &IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateZExtOrBitCast>),
-            InstanceMethod("CreateSExtOrBitCast", &IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateSExtOrBitCast>),
-            InstanceMethod("CreateTruncOrBitCast", &IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateTruncOrBitCast>),
-            InstanceMethod("CreatePointerCast", &IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreatePointerCast>),
-            InstanceMethod("CreatePointerBitCastOrAddrSpaceCast", &IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreatePointerBitCastOrAddrSpaceCast>),
-            InstanceMethod("CreateIntCast", &IRBuilder::CreateIntCast),
-            InstanceMethod("CreateBitOrPointerCast", &IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateBitOrPointerCast>),
-            InstanceMethod("CreateFPCast", &IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateFPCast>),
+            InstanceMethod("CreateTrunc", &IRBuilder::guarded<&IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateTrunc>>),
+            InstanceMethod("CreateZExt", &IRBuilder::guarded<&IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateZExt>>),
+            InstanceMethod("CreateSExt", &IRBuilder::guarded<&IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateSExt>>),
+            InstanceMethod("CreateZExtOrTrunc", &IRBuilder::guarded<&IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateZExtOrTrunc>>),
+            InstanceMethod("CreateSExtOrTrunc", &IRBuilder::guarded<&IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateSExtOrTrunc>>),
+            InstanceMethod("CreateFPToUI", &IRBuilder::guarded<&IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateFPToUI>>),
+            InstanceMethod("CreateFPToSI", &IRBuilder::guarded<&IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateFPToSI>>),
+            InstanceMethod("CreateUIToFP", &IRBuilder::guarded<&IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateUIToFP>>),
+            InstanceMethod("CreateSIToFP", &IRBuilder::guarded<&IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateSIToFP>>),
+            InstanceMethod("CreateFPTrunc", &IRBuilder::guarded<&IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateFPTrunc>>),
+            InstanceMethod("CreateFPExt", &IRBuilder::guarded<&IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateFPExt>>),
+            InstanceMethod("CreatePtrToInt", &IRBuilder::guarded<&IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreatePtrToInt>>),
+            InstanceMethod("CreateIntToPtr", &IRBuilder::guarded<&IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateIntToPtr>>),
+            InstanceMethod("CreateBitCast", &IRBuilder::guarded<&IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateBitCast>>),
+            InstanceMethod("CreateAddrSpaceCast", &IRBuilder::guarded<&IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateAddrSpaceCast>>),
+            InstanceMethod("CreateZExtOrBitCast", &IRBuilder::guarded<&IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateZExtOrBitCast>>),
+            InstanceMethod("CreateSExtOrBitCast", &IRBuilder::guarded<&IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateSExtOrBitCast>>),
+            InstanceMethod("CreateTruncOrBitCast", &IRBuilder::guarded<&IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateTruncOrBitCast>>),
+            InstanceMethod("CreatePointerCast", &IRBuilder::guarded<&IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreatePointerCast>>),
+            InstanceMethod("CreatePointerBitCastOrAddrSpaceCast", &IRBuilder::guarded<&IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreatePointerBitCastOrAddrSpaceCast>>),
+            InstanceMethod("CreateIntCast", &IRBuilder::guarded<&IRBuilder::CreateIntCast>),
+            InstanceMethod("CreateBitOrPointerCast", &IRBuilder::guarded<&IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateBitOrPointerCast>>),
+            InstanceMethod("CreateFPCast", &IRBuilder::guarded<&IRBuilder::CreateCastFactory<&LLVMIRBuilder::CreateFPCast>>),
 
             //===--------------------------------------------------------------------===//
             // Instruction creation methods: Compare Instructions
             //===--------------------------------------------------------------------===//
 
-            InstanceMethod("CreateICmpEQ", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateICmpEQ>),
-            InstanceMethod("CreateICmpNE", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateICmpNE>),
-            InstanceMethod("CreateICmpSGE", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateICmpSGE>),
-            InstanceMethod("CreateICmpSGT", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateICmpSGT>),
-            InstanceMethod("CreateICmpSLE", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateICmpSLE>),
-            InstanceMethod("CreateICmpSLT", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateICmpSLT>),
-            InstanceMethod("CreateICmpUGE", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateICmpUGE>),
-            InstanceMethod("CreateICmpUGT", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateICmpUGT>),
-            InstanceMethod("CreateICmpULE", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateICmpULE>),
-            InstanceMethod("CreateICmpULT", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateICmpULT>),
-            InstanceMethod("CreateFCmpOEQ", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateFCmpOEQ>),
-            InstanceMethod("CreateFCmpONE", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateFCmpONE>),
-            InstanceMethod("CreateFCmpOGE", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateFCmpOGE>),
-            InstanceMethod("CreateFCmpOGT", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateFCmpOGT>),
-            InstanceMethod("CreateFCmpOLE", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateFCmpOLE>),
-            InstanceMethod("CreateFCmpOLT", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateFCmpOLT>),
-            InstanceMethod("CreateFCmpUEQ", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateFCmpUEQ>),
-            InstanceMethod("CreateFCmpUNE", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateFCmpUNE>),
-            InstanceMethod("CreateFCmpUGE", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateFCmpUGE>),
-            InstanceMethod("CreateFCmpUGT", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateFCmpUGT>),
-            InstanceMethod("CreateFCmpULE", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateFCmpULE>),
-            InstanceMethod("CreateFCmpULT", &IRBuilder::binOpFactory<&LLVMIRBuilder::CreateFCmpULT>),
+            InstanceMethod("CreateICmpEQ", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateICmpEQ>>),
+            InstanceMethod("CreateICmpNE", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateICmpNE>>),
+            InstanceMethod("CreateICmpSGE", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateICmpSGE>>),
+            InstanceMethod("CreateICmpSGT", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateICmpSGT>>),
+            InstanceMethod("CreateICmpSLE", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateICmpSLE>>),
+            InstanceMethod("CreateICmpSLT", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateICmpSLT>>),
+            InstanceMethod("CreateICmpUGE", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateICmpUGE>>),
+            InstanceMethod("CreateICmpUGT", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateICmpUGT>>),
+            InstanceMethod("CreateICmpULE", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateICmpULE>>),
+            InstanceMethod("CreateICmpULT", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateICmpULT>>),
+            InstanceMethod("CreateFCmpOEQ", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateFCmpOEQ>>),
+            InstanceMethod("CreateFCmpONE", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateFCmpONE>>),
+            InstanceMethod("CreateFCmpOGE", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateFCmpOGE>>),
+            InstanceMethod("CreateFCmpOGT", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateFCmpOGT>>),
+            InstanceMethod("CreateFCmpOLE", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateFCmpOLE>>),
+            InstanceMethod("CreateFCmpOLT", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateFCmpOLT>>),
+            InstanceMethod("CreateFCmpUEQ", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateFCmpUEQ>>),
+            InstanceMethod("CreateFCmpUNE", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateFCmpUNE>>),
+            InstanceMethod("CreateFCmpUGE", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateFCmpUGE>>),
+            InstanceMethod("CreateFCmpUGT", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateFCmpUGT>>),
+            InstanceMethod("CreateFCmpULE", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateFCmpULE>>),
+            InstanceMethod("CreateFCmpULT", &IRBuilder::guarded<&IRBuilder::binOpFactory<&LLVMIRBuilder::CreateFCmpULT>>),
 
             //===--------------------------------------------------------------------===//
             // Instruction creation methods: Other Instructions
             //===--------------------------------------------------------------------===//
 
-            InstanceMethod("CreatePHI", &IRBuilder::CreatePHI),
-            InstanceMethod("CreateCall", &IRBuilder::CreateCall),
-            InstanceMethod("CreateSelect", &IRBuilder::CreateSelect),
-            InstanceMethod("CreateExtractValue", &IRBuilder::CreateExtractValue),
-            InstanceMethod("CreateInsertValue", &IRBuilder::CreateInsertValue),
-            InstanceMethod("CreateLandingPad", &IRBuilder::CreateLandingPad),
+            InstanceMethod("CreatePHI", &IRBuilder::guarded<&IRBuilder::CreatePHI>),
+            InstanceMethod("CreateCall", &IRBuilder::guarded<&IRBuilder::CreateCall>),
+            InstanceMethod("CreateSelect", &IRBuilder::guarded<&IRBuilder::CreateSelect>),
+            InstanceMethod("CreateExtractValue", &IRBuilder::guarded<&IRBuilder::CreateExtractValue>),
+            InstanceMethod("CreateInsertValue", &IRBuilder::guarded<&IRBuilder::CreateInsertValue>),
+            InstanceMethod("CreateLandingPad", &IRBuilder::guarded<&IRBuilder::CreateLandingPad>),
 
             //===--------------------------------------------------------------------===//
             // Utility creation methods
             //===--------------------------------------------------------------------===//
 
-            InstanceMethod("CreateIsNull", &IRBuilder::unOpFactory<&LLVMIRBuilder::CreateIsNull>),
-            InstanceMethod("CreateIsNotNull", &IRBuilder::unOpFactory<&LLVMIRBuilder::CreateIsNotNull>)
+            InstanceMethod("CreateIsNull", &IRBuilder::guarded<&IRBuilder::unOpFactory<&LLVMIRBuilder::CreateIsNull>>),
+            InstanceMethod("CreateIsNotNull", &IRBuilder::guarded<&IRBuilder::unOpFactory<&LLVMIRBuilder::CreateIsNotNull>>),
+
+            //===--------------------------------------------------------------------===//
+            // Batched emission
+            //===--------------------------------------------------------------------===//
+
+            StaticValue("BatchOp", batchOpNS),
+            InstanceMethod("emitBatch", &IRBuilder::guarded<&IRBuilder::emitBatch>),
+
+            InstanceMethod("dispose", &IRBuilder::dispose)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
+    DefineSymbolDispose(env, func);
+    constructor.Reset(env, func);
     exports.Set("IRBuilder", func);
 }
 
 bool IRBuilder::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || hasTypeTag(value, TypeTag::IRBuilder);
 }
 
 LLVMIRBuilder *IRBuilder::Extract(const Napi::Value &value) {
@@ -196,21 +260,29 @@ LLVMIRBuilder *IRBuilder::Extract(const Napi::Value &value) {
 }
 
 IRBuilder::IRBuilder(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::IRBuilder);
     const Napi::Env env = info.Env();
     if (info.IsConstructCall()) {
         const unsigned argsLen = info.Length();
         if (argsLen == 1) {
             if (LLVMContext::IsClassOf(info[0])) {
-                llvm::LLVMContext &context = LLVMContext::Extract(info[0]);
-                builder = new llvm::IRBuilder(context);
-                return;
+                builder = createBuilder(LLVMContext::Extract(info[0]));
             } else if (BasicBlock::IsClassOf(info[0])) {
                 llvm::BasicBlock *theBB = BasicBlock::Extract(info[0]);
-                builder = new llvm::IRBuilder(theBB);
-                return;
+                builder = createBuilder(theBB->getContext());
+                builder->SetInsertPoint(theBB);
             } else if (Instruction::IsClassOf(info[0])) {
                 llvm::Instruction *ip = Instruction::Extract(info[0]);
-                builder = new llvm::IRBuilder(ip);
+                builder = createBuilder(ip->getContext());
+                builder->SetInsertPoint(ip);
+            }
+            if (builder) {
+                // the context, or the block/instruction whose wrapper keeps its module alive
+                ownerRef = Napi::Persistent(info[0].As<Napi::Object>());
+                context = LLVMContext::Lookup(env, builder->getContext());
+                if (context) {
+                    contextRef = Napi::Persistent(context->Value());
+                }
                 return;
             }
         }
@@ -218,10 +290,68 @@ IRBuilder::IRBuilder(const Napi::CallbackInfo &info) : ObjectWrap(info) {
     throw Napi::TypeError::New(env, ErrMsg::Class::IRBuilder::constructor);
 }
 
+IRBuilder::~IRBuilder() {
+    delete builder;
+}
+
 LLVMIRBuilder *IRBuilder::getLLVMPrimitive() {
+    if (builder == nullptr) {
+        throw Napi::Error::New(Env(), ErrMsg::Class::IRBuilder::disposed);
+    }
     return builder;
 }
 
+bool IRBuilder::isDisposed() {
+    return builder == nullptr;
+}
+
+bool IRBuilder::isLocked() {
+    return context != nullptr && context->isLocked();
+}
+
+LLVMIRBuilder *IRBuilder::createBuilder(llvm::LLVMContext &llvmContext) {
+    return new LLVMIRBuilder(llvmContext, llvm::ConstantFolder(),
+                             llvm::IRBuilderCallbackInserter([this](llvm::Instruction *inst) { noteInserted(inst); }));
+}
+
+// report to the module wrapper by chunks, a lookup per instruction would cost more than the instruction itself
+static constexpr int64_t GrowthChunk = 16 * 1024;
+
+void IRBuilder::noteInserted(llvm::Instruction *inst) {
+    if (batchInserted != nullptr) {
+        batchInserted->push_back(inst);
+    }
+    const llvm::Module *module = inst->getModule();
+    if (module == nullptr) {
+        return;
+    }
+    if (module != growingModule) {
+        flushGrowth();
+        growingModule = module;
+    }
+    // the same rough size as the footprint estimated by the module wrapper
+    pendingGrowth += int64_t(sizeof(llvm::Instruction) + inst->getNumOperands() * sizeof(llvm::Use));
+    if (pendingGrowth >= GrowthChunk) {
+        flushGrowth();
+    }
+}
+
+void IRBuilder::flushGrowth() {
+    if (growingModule != nullptr && pendingGrowth != 0) {
+        Module::NoteGrowth(Env(), growingModule, pendingGrowth);
+    }
+    pendingGrowth = 0;
+}
+
+void IRBuilder::dispose(const Napi::CallbackInfo &info) {
+    flushGrowth();
+    growingModule = nullptr;
+    delete builder;
+    builder = nullptr;
+    ownerRef.Reset();
+    contextRef.Reset();
+}
+
 //===--------------------------------------------------------------------===//
 // Builder configuration methods
 //===--------------------------------------------------------------------===//
@@ -274,18 +404,16 @@ Napi::Function IRBuilder::InsertPoint::Init(Napi::Env env, Napi::Object &exports
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "InsertPoint", {
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
+    constructor.Reset(env, func);
     return func;
 }
 
 Napi::Object IRBuilder::InsertPoint::New(Napi::Env env, llvm::IRBuilderBase::InsertPoint insertPoint) {
-    tmpInsertPoint = insertPoint;
-    return constructor.New({});
+    return constructor.New(env, {Napi::External<llvm::IRBuilderBase::InsertPoint>::New(env, &insertPoint)});
 }
 
 bool IRBuilder::InsertPoint::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || hasTypeTag(value, TypeTag::IRBuilderInsertPoint);
 }
 
 llvm::IRBuilderBase::InsertPoint IRBuilder::InsertPoint::Extract(const Napi::Value &value) {
@@ -293,13 +421,13 @@ llvm::IRBuilderBase::InsertPoint IRBuilder::InsertPoint::Extract(const Napi::Val
 }
 
 IRBuilder::InsertPoint::InsertPoint(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::IRBuilderInsertPoint);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::IRBuilder::InsertPoint::constructor);
     }
-    if (tmpInsertPoint.isSet()) {
-        insertPoint = tmpInsertPoint;
-        tmpInsertPoint = llvm::IRBuilderBase::InsertPoint();
+    if (info.Length() >= 1 && info[0].IsExternal()) {
+        insertPoint = *info[0].As<Napi::External<llvm::IRBuilderBase::InsertPoint>>().Data();
     }
 }
 
@@ -841,3 +969,517 @@ Napi::Value IRBuilder::CreatePtrDiff(const Napi::CallbackInfo &info) {
     }
     throw Napi::TypeError::New(env, ErrMsg::Class::IRBuilder::CreatePtrDiff);
 }
+
+//===--------------------------------------------------------------------===//
+// Batched emission
+//===--------------------------------------------------------------------===//
+
+class BatchProgram {
+public:
+    BatchProgram(Napi::Env env, const int32_t *data, std::size_t length,
+                 std::vector<llvm::Value *> &slots, const std::vector<llvm::Type *> &types) :
+            env(env), data(data), length(length), slots(slots), types(types) {}
+
+    bool done() const {
+        return offset == length;
+    }
+
+    int32_t opcode() {
+        start = offset;
+        return imm();
+    }
+
+    int32_t imm() {
+        if (offset >= length) {
+            fail();
+        }
+        return data[offset++];
+    }
+
+    uint32_t count() {
+        const int32_t n = imm();
+        if (n < 0 || std::size_t(n) > length - offset) {
+            fail();
+        }
+        return n;
+    }
+
+    llvm::Value *value() {
+        const int32_t slot = imm();
+        if (slot < 0 || std::size_t(slot) >= slots.size() || slots[slot] == nullptr) {
+            fail();
+        }
+        return slots[slot];
+    }
+
+    template<typename T>
+    T *valueOf() {
+        auto *result = llvm::dyn_cast<T>(value());
+        if (result == nullptr) {
+            fail();
+        }
+        return result;
+    }
+
+    llvm::Type *type() {
+        const int32_t index = imm();
+        if (index < 0 || std::size_t(index) >= types.size()) {
+            fail();
+        }
+        return types[index];
+    }
+
+    // a 64-bit immediate, as its low then high 32 bits
+    int64_t imm64() {
+        const auto low = uint32_t(imm());
+        const auto high = uint32_t(imm());
+        return int64_t(uint64_t(high) << 32 | low);
+    }
+
+    template<typename T>
+    T *typeOf() {
+        auto *result = llvm::dyn_cast<T>(type());
+        if (result == nullptr) {
+            fail();
+        }
+        return result;
+    }
+
+    std::vector<llvm::Value *> values(uint32_t n) {
+        std::vector<llvm::Value *> result(n);
+        for (uint32_t i = 0; i < n; ++i) {
+            result[i] = value();
+        }
+        return result;
+    }
+
+    [[noreturn]] void fail() const {
+        throw Napi::TypeError::New(env, ErrMsg::Class::IRBuilder::emitBatchOperation + std::to_string(start));
+    }
+
+    // to be called before adding an incoming value to a PHI node, which may exist before the program
+    void noteIncoming(llvm::PHINode *phi) {
+        extendedPHIs.emplace_back(phi, phi->getNumIncomingValues());
+    }
+
+    // undo what the program has done when it fails: the inserted instructions are erased, and the PHI nodes that
+    // existed before get their incoming values back
+    void rollback(const std::vector<llvm::Instruction *> &inserted) {
+        for (auto iter = extendedPHIs.rbegin(); iter != extendedPHIs.rend(); ++iter) {
+            llvm::PHINode *phi = iter->first;
+            while (phi->getNumIncomingValues() > iter->second) {
+                phi->removeIncomingValue(phi->getNumIncomingValues() - 1, false);
+            }
+        }
+        // PHI nodes may use instructions inserted after them
+        for (llvm::Instruction *inst : inserted) {
+            inst->dropAllReferences();
+        }
+        for (auto iter = inserted.rbegin(); iter != inserted.rend(); ++iter) {
+            (*iter)->eraseFromParent();
+        }
+    }
+
+private:
+    Napi::Env env;
+    const int32_t *data;
+    std::size_t length;
+    std::size_t offset = 0;
+    std::size_t start = 0;
+    std::vector<llvm::Value *> &slots;
+    const std::vector<llvm::Type *> &types;
+    std::vector<std::pair<llvm::PHINode *, unsigned>> extendedPHIs;
+};
+
+static bool getBatchProgram(const Napi::Value &value, const int32_t *&data, std::size_t &length) {
+    if (value.IsTypedArray() && value.As<Napi::TypedArray>().TypedArrayType() == napi_int32_array) {
+        const auto program = value.As<Napi::Int32Array>();
+        data = program.Data();
+        length = program.ElementLength();
+        return true;
+    } else if (value.IsArrayBuffer()) {
+        // ArrayBuffer::Data() and ByteLength() are not const
+        auto program = value.As<Napi::ArrayBuffer>();
+        data = static_cast<const int32_t *>(program.Data());
+        length = program.ByteLength() / sizeof(int32_t);
+        return true;
+    }
+    return false;
+}
+
+static llvm::Instruction::BinaryOps getBatchBinaryOp(int32_t opcode) {
+    switch (opcode) {
+        case BatchOp::Add:
+            return llvm::Instruction::Add;
+        case BatchOp::FAdd:
+            return llvm::Instruction::FAdd;
+        case BatchOp::Sub:
+            return llvm::Instruction::Sub;
+        case BatchOp::FSub:
+            return llvm::Instruction::FSub;
+        case BatchOp::Mul:
+            return llvm::Instruction::Mul;
+        case BatchOp::FMul:
+            return llvm::Instruction::FMul;
+        case BatchOp::UDiv:
+            return llvm::Instruction::UDiv;
+        case BatchOp::SDiv:
+            return llvm::Instruction::SDiv;
+        case BatchOp::FDiv:
+            return llvm::Instruction::FDiv;
+        case BatchOp::URem:
+            return llvm::Instruction::URem;
+        case BatchOp::SRem:
+            return llvm::Instruction::SRem;
+        case BatchOp::FRem:
+            return llvm::Instruction::FRem;
+        case BatchOp::Shl:
+            return llvm::Instruction::Shl;
+        case BatchOp::LShr:
+            return llvm::Instruction::LShr;
+        case BatchOp::AShr:
+            return llvm::Instruction::AShr;
+        case BatchOp::And:
+            return llvm::Instruction::And;
+        case BatchOp::Or:
+            return llvm::Instruction::Or;
+        default:
+            return llvm::Instruction::Xor;
+    }
+}
+
+static llvm::Instruction::CastOps getBatchCastOp(int32_t opcode) {
+    switch (opcode) {
+        case BatchOp::Trunc:
+            return llvm::Instruction::Trunc;
+        case BatchOp::ZExt:
+            return llvm::Instruction::ZExt;
+        case BatchOp::SExt:
+            return llvm::Instruction::SExt;
+        case BatchOp::FPToUI:
+            return llvm::Instruction::FPToUI;
+        case BatchOp::FPToSI:
+            return llvm::Instruction::FPToSI;
+        case BatchOp::UIToFP:
+            return llvm::Instruction::UIToFP;
+        case BatchOp::SIToFP:
+            return llvm::Instruction::SIToFP;
+        case BatchOp::FPTrunc:
+            return llvm::Instruction::FPTrunc;
+        case BatchOp::FPExt:
+            return llvm::Instruction::FPExt;
+        case BatchOp::PtrToInt:
+            return llvm::Instruction::PtrToInt;
+        case BatchOp::IntToPtr:
+            return llvm::Instruction::IntToPtr;
+        default:
+            return llvm::Instruction::BitCast;
+    }
+}
+
+static bool isBatchFloatOp(int32_t opcode) {
+    return opcode == BatchOp::FAdd || opcode == BatchOp::FSub || opcode == BatchOp::FMul ||
+           opcode == BatchOp::FDiv || opcode == BatchOp::FRem;
+}
+
+// whether the value can be stored to or loaded as type through the pointer
+static bool isPointerTo(llvm::Value *ptr, llvm::Type *type) {
+    auto *ptrType = llvm::dyn_cast<llvm::PointerType>(ptr->getType());
+    return ptrType != nullptr && ptrType->isOpaqueOrPointeeTypeMatches(type);
+}
+
+// whether the indices of a GEP are integers, with constant and in range struct indices, and vectors of the same
+// length as the vector of pointers
+static bool isValidGEP(llvm::Type *type, llvm::Value *ptr, const std::vector<llvm::Value *> &indices) {
+    std::optional<llvm::ElementCount> vectorLength;
+    auto hasVectorLength = [&vectorLength](llvm::Type *operandType) {
+        auto *vectorType = llvm::dyn_cast<llvm::VectorType>(operandType);
+        if (vectorType == nullptr) {
+            return true;
+        }
+        if (!vectorLength) {
+            vectorLength = vectorType->getElementCount();
+        }
+        return *vectorLength == vectorType->getElementCount();
+    };
+    auto *ptrType = llvm::dyn_cast<llvm::PointerType>(ptr->getType()->getScalarType());
+    if (ptrType == nullptr || !ptrType->isOpaqueOrPointeeTypeMatches(type) || !type->isSized() ||
+        !hasVectorLength(ptr->getType())) {
+        return false;
+    }
+    for (llvm::Value *index : indices) {
+        if (!index->getType()->isIntOrIntVectorTy() || !hasVectorLength(index->getType())) {
+            return false;
+        }
+    }
+    return llvm::GetElementPtrInst::getIndexedType(type, indices) != nullptr;
+}
+
+// the return type of the function the builder inserts into
+static llvm::Type *getInsertReturnType(LLVMIRBuilder *builder, BatchProgram &program) {
+    llvm::BasicBlock *block = builder->GetInsertBlock();
+    if (block == nullptr || block->getParent() == nullptr) {
+        program.fail();
+    }
+    return block->getParent()->getReturnType();
+}
+
+static llvm::Value *emitBatchOperation(LLVMIRBuilder *builder, BatchProgram &program) {
+    const int32_t opcode = program.opcode();
+    switch (opcode) {
+        case BatchOp::SetInsertPoint:
+            builder->SetInsertPoint(program.valueOf<llvm::BasicBlock>());
+            return nullptr;
+        case BatchOp::ConstInt: {
+            auto *type = program.typeOf<llvm::IntegerType>();
+            return llvm::ConstantInt::get(type, uint64_t(int64_t(program.imm())), true);
+        }
+        case BatchOp::ConstInt64: {
+            auto *type = program.typeOf<llvm::IntegerType>();
+            return llvm::ConstantInt::get(type, uint64_t(program.imm64()), true);
+        }
+        case BatchOp::Add:
+        case BatchOp::FAdd:
+        case BatchOp::Sub:
+        case BatchOp::FSub:
+        case BatchOp::Mul:
+        case BatchOp::FMul:
+        case BatchOp::UDiv:
+        case BatchOp::SDiv:
+        case BatchOp::FDiv:
+        case BatchOp::URem:
+        case BatchOp::SRem:
+        case BatchOp::FRem:
+        case BatchOp::Shl:
+        case BatchOp::LShr:
+        case BatchOp::AShr:
+        case BatchOp::And:
+        case BatchOp::Or:
+        case BatchOp::Xor: {
+            llvm::Value *lhs = program.value();
+            llvm::Value *rhs = program.value();
+            const bool typeMatches = isBatchFloatOp(opcode) ? lhs->getType()->isFPOrFPVectorTy() : lhs->getType()->isIntOrIntVectorTy();
+            if (lhs->getType() != rhs->getType() || !typeMatches) {
+                program.fail();
+            }
+            return builder->CreateBinOp(getBatchBinaryOp(opcode), lhs, rhs);
+        }
+        case BatchOp::Neg:
+        case BatchOp::Not: {
+            llvm::Value *value = program.value();
+            if (!value->getType()->isIntOrIntVectorTy()) {
+                program.fail();
+            }
+            return opcode == BatchOp::Neg ? builder->CreateNeg(value) : builder->CreateNot(value);
+        }
+        case BatchOp::FNeg: {
+            llvm::Value *value = program.value();
+            if (!value->getType()->isFPOrFPVectorTy()) {
+                program.fail();
+            }
+            return builder->CreateFNeg(value);
+        }
+        case BatchOp::ICmp:
+        case BatchOp::FCmp: {
+            const auto predicate = llvm::CmpInst::Predicate(program.imm());
+            const bool valid = opcode == BatchOp::ICmp ? llvm::CmpInst::isIntPredicate(predicate) : llvm::CmpInst::isFPPredicate(predicate);
+            llvm::Value *lhs = program.value();
+            llvm::Value *rhs = program.value();
+            llvm::Type *type = lhs->getType();
+            const bool typeMatches = opcode == BatchOp::ICmp ? type->isIntOrIntVectorTy() || type->isPtrOrPtrVectorTy()
+                                                             : type->isFPOrFPVectorTy();
+            if (!valid || !typeMatches || rhs->getType() != type) {
+                program.fail();
+            }
+            return opcode == BatchOp::ICmp ? builder->CreateICmp(predicate, lhs, rhs) : builder->CreateFCmp(predicate, lhs, rhs);
+        }
+        case BatchOp::Trunc:
+        case BatchOp::ZExt:
+        case BatchOp::SExt:
+        case BatchOp::FPToUI:
+        case BatchOp::FPToSI:
+        case BatchOp::UIToFP:
+        case BatchOp::SIToFP:
+        case BatchOp::FPTrunc:
+        case BatchOp::FPExt:
+        case BatchOp::PtrToInt:
+        case BatchOp::IntToPtr:
+        case BatchOp::BitCast: {
+            llvm::Value *value = program.value();
+            llvm::Type *destType = program.type();
+            const llvm::Instruction::CastOps castOp = getBatchCastOp(opcode);
+            if (!llvm::CastInst::castIsValid(castOp, value->getType(), destType)) {
+                program.fail();
+            }
+            return builder->CreateCast(castOp, value, destType);
+        }
+        case BatchOp::Alloca: {
+            llvm::Type *type = program.type();
+            if (!type->isSized()) {
+                program.fail();
+            }
+            return builder->CreateAlloca(type);
+        }
+        case BatchOp::Load: {
+            llvm::Type *type = program.type();
+            llvm::Value *ptr = program.value();
+            if (!type->isSized() || !isPointerTo(ptr, type)) {
+                program.fail();
+            }
+            return builder->CreateLoad(type, ptr);
+        }
+        case BatchOp::Store: {
+            llvm::Value *value = program.value();
+            llvm::Value *ptr = program.value();
+            if (!value->getType()->isSized() || !isPointerTo(ptr, value->getType())) {
+                program.fail();
+            }
+            builder->CreateStore(value, ptr);
+            return nullptr;
+        }
+        case BatchOp::GEP:
+        case BatchOp::InBoundsGEP: {
+            llvm::Type *type = program.type();
+            llvm::Value *ptr = program.value();
+            const std::vector<llvm::Value *> indices = program.values(program.count());
+            if (!isValidGEP(type, ptr, indices)) {
+                program.fail();
+            }
+            return opcode == BatchOp::GEP ? builder->CreateGEP(type, ptr, indices) : builder->CreateInBoundsGEP(type, ptr, indices);
+        }
+        case BatchOp::Call: {
+            auto *funcType = program.typeOf<llvm::FunctionType>();
+            llvm::Value *callee = program.value();
+            const std::vector<llvm::Value *> args = program.values(program.count());
+            const unsigned numParams = funcType->getNumParams();
+            if (!isPointerTo(callee, funcType) || args.size() < numParams || (args.size() > numParams && !funcType->isVarArg())) {
+                program.fail();
+            }
+            for (unsigned i = 0; i < numParams; ++i) {
+                if (args[i]->getType() != funcType->getParamType(i)) {
+                    program.fail();
+                }
+            }
+            llvm::CallInst *call = builder->CreateCall(funcType, callee, args);
+            return funcType->getReturnType()->isVoidTy() ? nullptr : call;
+        }
+        case BatchOp::Select: {
+            llvm::Value *cond = program.value();
+            llvm::Value *trueValue = program.value();
+            llvm::Value *falseValue = program.value();
+            if (!cond->getType()->isIntegerTy(1) || !trueValue->getType()->isSized() ||
+                trueValue->getType() != falseValue->getType()) {
+                program.fail();
+            }
+            return builder->CreateSelect(cond, trueValue, falseValue);
+        }
+        case BatchOp::PHI: {
+            llvm::Type *type = program.type();
+            const uint32_t numIncoming = program.count();
+            if (!type->isSized()) {
+                program.fail();
+            }
+            std::vector<std::pair<llvm::Value *, llvm::BasicBlock *>> incoming(numIncoming);
+            for (auto &[value, block] : incoming) {
+                value = program.value();
+                if (value->getType() != type) {
+                    program.fail();
+                }
+                block = program.valueOf<llvm::BasicBlock>();
+            }
+            llvm::PHINode *phi = builder->CreatePHI(type, numIncoming);
+            for (const auto &[value, block] : incoming) {
+                phi->addIncoming(value, block);
+            }
+            return phi;
+        }
+        case BatchOp::AddIncoming: {
+            auto *phi = program.valueOf<llvm::PHINode>();
+            llvm::Value *value = program.value();
+            auto *block = program.valueOf<llvm::BasicBlock>();
+            if (value->getType() != phi->getType()) {
+                program.fail();
+            }
+            program.noteIncoming(phi);
+            phi->addIncoming(value, block);
+            return nullptr;
+        }
+        case BatchOp::Ret: {
+            llvm::Value *value = program.value();
+            if (value->getType() != getInsertReturnType(builder, program)) {
+                program.fail();
+            }
+            builder->CreateRet(value);
+            return nullptr;
+        }
+        case BatchOp::RetVoid:
+            if (!getInsertReturnType(builder, program)->isVoidTy()) {
+                program.fail();
+            }
+            builder->CreateRetVoid();
+            return nullptr;
+        case BatchOp::Br:
+            builder->CreateBr(program.valueOf<llvm::BasicBlock>());
+            return nullptr;
+        case BatchOp::CondBr: {
+            llvm::Value *cond = program.value();
+            auto *trueBlock = program.valueOf<llvm::BasicBlock>();
+            auto *falseBlock = program.valueOf<llvm::BasicBlock>();
+            if (!cond->getType()->isIntegerTy(1)) {
+                program.fail();
+            }
+            builder->CreateCondBr(cond, trueBlock, falseBlock);
+            return nullptr;
+        }
+        case BatchOp::Unreachable:
+            builder->CreateUnreachable();
+            return nullptr;
+        default:
+            program.fail();
+    }
+}
+
+Napi::Value IRBuilder::emitBatch(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    const unsigned argsLen = info.Length();
+    const int32_t *data = nullptr;
+    std::size_t length = 0;
+    std::vector<llvm::Value *> slots;
+    std::vector<llvm::Type *> types;
+    std::vector<int64_t> results;
+    if (argsLen < 2 || !getBatchProgram(info[0], data, length) ||
+        !info[1].IsArray() || !assembleArray<WrappedValue>(info[1].As<Napi::Array>(), slots) ||
+        argsLen >= 3 && !info[2].IsUndefined() && (!info[2].IsArray() || !assembleArray<Type>(info[2].As<Napi::Array>(), types)) ||
+        argsLen >= 4 && !info[3].IsUndefined() && (!info[3].IsArray() || !assembleArray(info[3].As<Napi::Array>(), results))) {
+        throw Napi::TypeError::New(env, ErrMsg::Class::IRBuilder::emitBatch);
+    }
+    // worst case: every operation is a single int32 defining one slot
+    slots.reserve(slots.size() + length);
+    BatchProgram program(env, data, length, slots, types);
+    // a failing program leaves the IR and the insertion point as they were
+    const llvm::IRBuilderBase::InsertPoint insertPoint = builder->saveIP();
+    std::vector<llvm::Instruction *> inserted;
+    batchInserted = &inserted;
+    try {
+        while (!program.done()) {
+            slots.push_back(emitBatchOperation(builder, program));
+        }
+    } catch (const Napi::Error &) {
+        batchInserted = nullptr;
+        program.rollback(inserted);
+        builder->restoreIP(insertPoint);
+        throw;
+    }
+    batchInserted = nullptr;
+    flushGrowth();
+    Napi::Array handles = Napi::Array::New(env, results.size());
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const int64_t slot = results[i];
+        if (slot >= 0 && std::size_t(slot) < slots.size() && slots[slot] != nullptr) {
+            handles.Set(uint32_t(i), Value::New(env, slots[slot]));
+        } else {
+            handles.Set(uint32_t(i), env.Null());
+        }
+    }
+    return handles;
+}
@@ -0,0 +1,187 @@
+#include "IR/index.h"
+#include "Util/index.h"
+
+void IRCursor::Init(Napi::Env env, Napi::Object &exports) {
+    Napi::HandleScope scope(env);
+    const Napi::Function func = DefineClass(env, "IRCursor", {
+            InstanceMethod("next", &IRCursor::guarded<&IRCursor::next>),
+            InstanceMethod("nextFunction", &IRCursor::guarded<&IRCursor::nextFunction>),
+            InstanceMethod("nextBasicBlock", &IRCursor::guarded<&IRCursor::nextBasicBlock>),
+            InstanceMethod("nextInstruction", &IRCursor::guarded<&IRCursor::nextInstruction>),
+            InstanceMethod("reset", &IRCursor::guardedVoid<&IRCursor::reset>),
+            InstanceMethod("getOpcode", &IRCursor::guarded<&IRCursor::getOpcode>),
+            InstanceMethod("getOpcodeName", &IRCursor::guarded<&IRCursor::getOpcodeName>),
+            InstanceMethod("getNumOperands", &IRCursor::guarded<&IRCursor::getNumOperands>),
+            InstanceMethod("getTypeID", &IRCursor::guarded<&IRCursor::getTypeID>),
+            InstanceMethod("getName", &IRCursor::guarded<&IRCursor::getName>),
+            InstanceMethod("getFunction", &IRCursor::guarded<&IRCursor::getFunction>),
+            InstanceMethod("getBasicBlock", &IRCursor::guarded<&IRCursor::getBasicBlock>),
+            InstanceMethod("getInstruction", &IRCursor::guarded<&IRCursor::getInstruction>)
+    });
+    constructor.Reset(env, func);
+    exports.Set("IRCursor", func);
+}
+
+Napi::Object IRCursor::New(Napi::Env env, const Napi::Object &module) {
+    return constructor.New(env, {module});
+}
+
+bool IRCursor::IsClassOf(const Napi::Value &value) {
+    return hasTypeTag(value, TypeTag::IRCursor);
+}
+
+IRCursor::IRCursor(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::IRCursor);
+    const Napi::Env env = info.Env();
+    if (!info.IsConstructCall() || info.Length() == 0 || !Module::IsClassOf(info[0]) || info[0].IsNull()) {
+        throw Napi::TypeError::New(env, ErrMsg::Class::IRCursor::constructor);
+    }
+    const auto moduleObj = info[0].As<Napi::Object>();
+    wrapper = Module::Unwrap(moduleObj);
+    if (wrapper->isDisposed()) {
+        throw Napi::Error::New(env, ErrMsg::Class::IRCursor::disposed);
+    }
+    moduleRef = Napi::Persistent(moduleObj);
+}
+
+bool IRCursor::isDisposed() {
+    return wrapper->isDisposed();
+}
+
+bool IRCursor::isLocked() {
+    return wrapper->isLocked();
+}
+
+//===----------------------------------------------------------------------===//
+// Each level starts at the first element of its parent and stays exhausted
+// once it has run past the last one, until the parent moves on
+//===----------------------------------------------------------------------===//
+
+bool IRCursor::stepFunction() {
+    if (functionsDone) {
+        return false;
+    }
+    // functions are not ilist_node_with_parent, so there is no getNextNode to step with
+    llvm::Module *module = wrapper->getLLVMPrimitive();
+    llvm::Module::iterator next = function ? std::next(function->getIterator()) : module->begin();
+    function = next == module->end() ? nullptr : &*next;
+    basicBlock = nullptr;
+    instruction = nullptr;
+    basicBlocksDone = false;
+    instructionsDone = false;
+    functionsDone = function == nullptr;
+    return function != nullptr;
+}
+
+bool IRCursor::stepBasicBlock() {
+    if (function == nullptr || basicBlocksDone) {
+        return false;
+    }
+    if (basicBlock) {
+        basicBlock = basicBlock->getNextNode();
+    } else {
+        basicBlock = function->empty() ? nullptr : &function->front();
+    }
+    instruction = nullptr;
+    instructionsDone = false;
+    basicBlocksDone = basicBlock == nullptr;
+    return basicBlock != nullptr;
+}
+
+bool IRCursor::stepInstruction() {
+    if (basicBlock == nullptr || instructionsDone) {
+        return false;
+    }
+    if (instruction) {
+        instruction = instruction->getNextNode();
+    } else {
+        instruction = basicBlock->empty() ? nullptr : &basicBlock->front();
+    }
+    instructionsDone = instruction == nullptr;
+    return instruction != nullptr;
+}
+
+llvm::Value *IRCursor::current(Napi::Env env) {
+    if (instruction) {
+        return instruction;
+    } else if (basicBlock) {
+        return basicBlock;
+    } else if (function) {
+        return function;
+    }
+    throw Napi::Error::New(env, ErrMsg::Class::IRCursor::noPosition);
+}
+
+Napi::Value IRCursor::next(const Napi::CallbackInfo &info) {
+    while (!stepInstruction()) {
+        if (!stepBasicBlock() && !stepFunction()) {
+            return Napi::Boolean::New(info.Env(), false);
+        }
+    }
+    return Napi::Boolean::New(info.Env(), true);
+}
+
+Napi::Value IRCursor::nextFunction(const Napi::CallbackInfo &info) {
+    return Napi::Boolean::New(info.Env(), stepFunction());
+}
+
+Napi::Value IRCursor::nextBasicBlock(const Napi::CallbackInfo &info) {
+    return Napi::Boolean::New(info.Env(), stepBasicBlock());
+}
+
+Napi::Value IRCursor::nextInstruction(const Napi::CallbackInfo &info) {
+    return Napi::Boolean::New(info.Env(), stepInstruction());
+}
+
+void IRCursor::reset(const Napi::CallbackInfo &info) {
+    function = nullptr;
+    basicBlock = nullptr;
+    instruction = nullptr;
+    functionsDone = false;
+    basicBlocksDone = false;
+    instructionsDone = false;
+}
+
+Napi::Value IRCursor::getOpcode(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    current(env);
+    return Napi::Number::New(env, instruction ? instruction->getOpcode() : 0);
+}
+
+Napi::Value IRCursor::getOpcodeName(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    current(env);
+    return Napi::String::New(env, instruction ? instruction->getOpcodeName() : "");
+}
+
+Napi::Value IRCursor::getNumOperands(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    const auto *user = llvm::dyn_cast<llvm::User>(current(env));
+    return Napi::Number::New(env, user ? user->getNumOperands() : 0);
+}
+
+Napi::Value IRCursor::getTypeID(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    return Napi::Number::New(env, current(env)->getType()->getTypeID());
+}
+
+Napi::Value IRCursor::getName(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    const llvm::StringRef name = current(env)->getName();
+    return Napi::String::New(env, name.data(), name.size());
+}
+
+Napi::Value IRCursor::getFunction(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    return function ? Function::New(env, function) : env.Null();
+}
+
+Napi::Value IRCursor::getBasicBlock(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    return basicBlock ? BasicBlock::New(env, basicBlock) : env.Null();
+}
+
+Napi::Value IRCursor::getInstruction(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    return instruction ? Instruction::New(env, instruction) : env.Null();
+}
@@ -8,33 +8,33 @@
 void AllocaInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "AllocaInst", {
-            InstanceMethod("getAllocatedType", &AllocaInst::getAllocatedType),
-            InstanceMethod("getArraySize", &AllocaInst::getArraySize),
-            InstanceMethod("getType", &AllocaInst::getType),
-            InstanceMethod("setDebugLoc", &AllocaInst::setDebugLoc)
+            InstanceMethod("getAllocatedType", &AllocaInst::guarded<&AllocaInst::getAllocatedType>),
+            InstanceMethod("getArraySize", &AllocaInst::guarded<&AllocaInst::getArraySize>),
+            InstanceMethod("getType", &AllocaInst::guarded<&AllocaInst::getType>),
+            InstanceMethod("setDebugLoc", &AllocaInst::guardedVoid<&AllocaInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("AllocaInst", func);
 }
 
 Napi::Object AllocaInst::New(Napi::Env env, llvm::AllocaInst *allocaInst) {
-    return constructor.New({Napi::External<llvm::AllocaInst>::New(env, allocaInst)});
+    return wrapCached<AllocaInst>(env, allocaInst);
 }
 
 bool AllocaInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::AllocaInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::AllocaInst *AllocaInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::AllocaInst, llvm::Value>(value);
 }
 
 AllocaInst::AllocaInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::AllocaInst::constructor);
@@ -77,31 +77,31 @@ void AllocaInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void LoadInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "LoadInst", {
-            InstanceMethod("getType", &LoadInst::getType),
-            InstanceMethod("setDebugLoc", &LoadInst::setDebugLoc)
+            InstanceMethod("getType", &LoadInst::guarded<&LoadInst::getType>),
+            InstanceMethod("setDebugLoc", &LoadInst::guardedVoid<&LoadInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("LoadInst", func);
 }
 
 Napi::Object LoadInst::New(Napi::Env env, llvm::LoadInst *loadInst) {
-    return constructor.New({Napi::External<llvm::LoadInst>::New(env, loadInst)});
+    return wrapCached<LoadInst>(env, loadInst);
 }
 
 bool LoadInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::LoadInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::LoadInst *LoadInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::LoadInst, llvm::Value>(value);
 }
 
 LoadInst::LoadInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::LoadInst::constructor);
@@ -136,34 +136,34 @@ void LoadInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void StoreInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "StoreInst", {
-            InstanceMethod("getValueOperand", &StoreInst::getValueOperand),
-            InstanceMethod("getPointerOperand", &StoreInst::getPointerOperand),
-            InstanceMethod("getPointerOperandType", &StoreInst::getPointerOperandType),
-            InstanceMethod("getType", &StoreInst::getType),
-            InstanceMethod("setDebugLoc", &StoreInst::setDebugLoc)
+            InstanceMethod("getValueOperand", &StoreInst::guarded<&StoreInst::getValueOperand>),
+            InstanceMethod("getPointerOperand", &StoreInst::guarded<&StoreInst::getPointerOperand>),
+            InstanceMethod("getPointerOperandType", &StoreInst::guarded<&StoreInst::getPointerOperandType>),
+            InstanceMethod("getType", &StoreInst::guarded<&StoreInst::getType>),
+            InstanceMethod("setDebugLoc", &StoreInst::guardedVoid<&StoreInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("StoreInst", func);
 }
 
 Napi::Object StoreInst::New(Napi::Env env, llvm::StoreInst *branchInst) {
-    return constructor.New({Napi::External<llvm::StoreInst>::New(env, branchInst)});
+    return wrapCached<StoreInst>(env, branchInst);
 }
 
 bool StoreInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::StoreInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::StoreInst *StoreInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::StoreInst, llvm::Value>(value);
 }
 
 StoreInst::StoreInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::StoreInst::constructor);
@@ -210,31 +210,31 @@ void StoreInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void FenceInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "FenceInst", {
-            InstanceMethod("getType", &FenceInst::getType),
-            InstanceMethod("setDebugLoc", &FenceInst::setDebugLoc)
+            InstanceMethod("getType", &FenceInst::guarded<&FenceInst::getType>),
+            InstanceMethod("setDebugLoc", &FenceInst::guardedVoid<&FenceInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("FenceInst", func);
 }
 
 Napi::Object FenceInst::New(Napi::Env env, llvm::FenceInst *fenceInst) {
-    return constructor.New({Napi::External<llvm::FenceInst>::New(env, fenceInst)});
+    return wrapCached<FenceInst>(env, fenceInst);
 }
 
 bool FenceInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::FenceInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::FenceInst *FenceInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::FenceInst, llvm::Value>(value);
 }
 
 FenceInst::FenceInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::FenceInst::constructor);
@@ -269,31 +269,31 @@ void FenceInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void AtomicCmpXchgInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "AtomicCmpXchgInst", {
-            InstanceMethod("getType", &AtomicCmpXchgInst::getType),
-            InstanceMethod("setDebugLoc", &AtomicCmpXchgInst::setDebugLoc)
+            InstanceMethod("getType", &AtomicCmpXchgInst::guarded<&AtomicCmpXchgInst::getType>),
+            InstanceMethod("setDebugLoc", &AtomicCmpXchgInst::guardedVoid<&AtomicCmpXchgInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("AtomicCmpXchgInst", func);
 }
 
 Napi::Object AtomicCmpXchgInst::New(Napi::Env env, llvm::AtomicCmpXchgInst *atomicCmpXchgInst) {
-    return constructor.New({Napi::External<llvm::AtomicCmpXchgInst>::New(env, atomicCmpXchgInst)});
+    return wrapCached<AtomicCmpXchgInst>(env, atomicCmpXchgInst);
 }
 
 bool AtomicCmpXchgInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::AtomicCmpXchgInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::AtomicCmpXchgInst *AtomicCmpXchgInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::AtomicCmpXchgInst, llvm::Value>(value);
 }
 
 AtomicCmpXchgInst::AtomicCmpXchgInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::AtomicCmpXchgInst::constructor);
@@ -328,31 +328,31 @@ void AtomicCmpXchgInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void AtomicRMWInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "AtomicRMWInst", {
-            InstanceMethod("getType", &AtomicRMWInst::getType),
-            InstanceMethod("setDebugLoc", &AtomicRMWInst::setDebugLoc)
+            InstanceMethod("getType", &AtomicRMWInst::guarded<&AtomicRMWInst::getType>),
+            InstanceMethod("setDebugLoc", &AtomicRMWInst::guardedVoid<&AtomicRMWInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("AtomicRMWInst", func);
 }
 
 Napi::Object AtomicRMWInst::New(Napi::Env env, llvm::AtomicRMWInst *atomicRMWInst) {
-    return constructor.New({Napi::External<llvm::AtomicRMWInst>::New(env, atomicRMWInst)});
+    return wrapCached<AtomicRMWInst>(env, atomicRMWInst);
 }
 
 bool AtomicRMWInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::AtomicRMWInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::AtomicRMWInst *AtomicRMWInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::AtomicRMWInst, llvm::Value>(value);
 }
 
 AtomicRMWInst::AtomicRMWInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::AtomicRMWInst::constructor);
@@ -387,31 +387,31 @@ void AtomicRMWInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void GetElementPtrInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "GetElementPtrInst", {
-            InstanceMethod("getType", &GetElementPtrInst::getType),
-            InstanceMethod("setDebugLoc", &GetElementPtrInst::setDebugLoc)
+            InstanceMethod("getType", &GetElementPtrInst::guarded<&GetElementPtrInst::getType>),
+            InstanceMethod("setDebugLoc", &GetElementPtrInst::guardedVoid<&GetElementPtrInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("GetElementPtrInst", func);
 }
 
 Napi::Object GetElementPtrInst::New(Napi::Env env, llvm::GetElementPtrInst *gepInst) {
-    return constructor.New({Napi::External<llvm::GetElementPtrInst>::New(env, gepInst)});
+    return wrapCached<GetElementPtrInst>(env, gepInst);
 }
 
 bool GetElementPtrInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::GetElementPtrInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::GetElementPtrInst *GetElementPtrInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::GetElementPtrInst, llvm::Value>(value);
 }
 
 GetElementPtrInst::GetElementPtrInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::GetElementPtrInst::constructor);
@@ -445,32 +445,44 @@ void GetElementPtrInst::setDebugLoc(const Napi::CallbackInfo &info) {
 
 void ICmpInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
+    const Napi::Object predicateNS = Napi::Object::New(env);
+    predicateNS.Set("ICMP_EQ", Napi::Number::New(env, llvm::CmpInst::Predicate::ICMP_EQ));
+    predicateNS.Set("ICMP_NE", Napi::Number::New(env, llvm::CmpInst::Predicate::ICMP_NE));
+    predicateNS.Set("ICMP_UGT", Napi::Number::New(env, llvm::CmpInst::Predicate::ICMP_UGT));
+    predicateNS.Set("ICMP_UGE", Napi::Number::New(env, llvm::CmpInst::Predicate::ICMP_UGE));
+    predicateNS.Set("ICMP_ULT", Napi::Number::New(env, llvm::CmpInst::Predicate::ICMP_ULT));
+    predicateNS.Set("ICMP_ULE", Napi::Number::New(env, llvm::CmpInst::Predicate::ICMP_ULE));
+    predicateNS.Set("ICMP_SGT", Napi::Number::New(env, llvm::CmpInst::Predicate::ICMP_SGT));
+    predicateNS.Set("ICMP_SGE", Napi::Number::New(env, llvm::CmpInst::Predicate::ICMP_SGE));
+    predicateNS.Set("ICMP_SLT", Napi::Number::New(env, llvm::CmpInst::Predicate::ICMP_SLT));
+    predicateNS.Set("ICMP_SLE", Napi::Number::New(env, llvm::CmpInst::Predicate::ICMP_SLE));
     const Napi::Function func = DefineClass(env, "ICmpInst", {
-            InstanceMethod("getType", &ICmpInst::getType),
-            InstanceMethod("setDebugLoc", &ICmpInst::setDebugLoc)
+            StaticValue("Predicate", predicateNS),
+            InstanceMethod("getType", &ICmpInst::guarded<&ICmpInst::getType>),
+            InstanceMethod("setDebugLoc", &ICmpInst::guardedVoid<&ICmpInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("ICmpInst", func);
 }
 
 Napi::Object ICmpInst::New(Napi::Env env, llvm::ICmpInst *icmpInst) {
-    return constructor.New({Napi::External<llvm::ICmpInst>::New(env, icmpInst)});
+    return wrapCached<ICmpInst>(env, icmpInst);
 }
 
 bool ICmpInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::ICmpInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::ICmpInst *ICmpInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::ICmpInst, llvm::Value>(value);
 }
 
 ICmpInst::ICmpInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::ICmpInst::constructor);
@@ -504,32 +516,50 @@ void ICmpInst::setDebugLoc(const Napi::CallbackInfo &info) {
 
 void FCmpInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
+    const Napi::Object predicateNS = Napi::Object::New(env);
+    predicateNS.Set("FCMP_FALSE", Napi::Number::New(env, llvm::CmpInst::Predicate::FCMP_FALSE));
+    predicateNS.Set("FCMP_OEQ", Napi::Number::New(env, llvm::CmpInst::Predicate::FCMP_OEQ));
+    predicateNS.Set("FCMP_OGT", Napi::Number::New(env, llvm::CmpInst::Predicate::FCMP_OGT));
+    predicateNS.Set("FCMP_OGE", Napi::Number::New(env, llvm::CmpInst::Predicate::FCMP_OGE));
+    predicateNS.Set("FCMP_OLT", Napi::Number::New(env, llvm::CmpInst::Predicate::FCMP_OLT));
+    predicateNS.Set("FCMP_OLE", Napi::Number::New(env, llvm::CmpInst::Predicate::FCMP_OLE));
+    predicateNS.Set("FCMP_ONE", Napi::Number::New(env, llvm::CmpInst::Predicate::FCMP_ONE));
+    predicateNS.Set("FCMP_ORD", Napi::Number::New(env, llvm::CmpInst::Predicate::FCMP_ORD));
+    predicateNS.Set("FCMP_UNO", Napi::Number::New(env, llvm::CmpInst::Predicate::FCMP_UNO));
+    predicateNS.Set("FCMP_UEQ", Napi::Number::New(env, llvm::CmpInst::Predicate::FCMP_UEQ));
+    predicateNS.Set("FCMP_UGT", Napi::Number::New(env, llvm::CmpInst::Predicate::FCMP_UGT));
+    predicateNS.Set("FCMP_UGE", Napi::Number::New(env, llvm::CmpInst::Predicate::FCMP_UGE));
+    predicateNS.Set("FCMP_ULT", Napi::Number::New(env, llvm::CmpInst::Predicate::FCMP_ULT));
+    predicateNS.Set("FCMP_ULE", Napi::Number::New(env, llvm::CmpInst::Predicate::FCMP_ULE));
+    predicateNS.Set("FCMP_UNE", Napi::Number::New(env, llvm::CmpInst::Predicate::FCMP_UNE));
+    predicateNS.Set("FCMP_TRUE", Napi::Number::New(env, llvm::CmpInst::Predicate::FCMP_TRUE));
     const Napi::Function func = DefineClass(env, "FCmpInst", {
-            InstanceMethod("getType", &FCmpInst::getType),
-            InstanceMethod("setDebugLoc", &FCmpInst::setDebugLoc)
+            StaticValue("Predicate", predicateNS),
+            InstanceMethod("getType", &FCmpInst::guarded<&FCmpInst::getType>),
+            InstanceMethod("setDebugLoc", &FCmpInst::guardedVoid<&FCmpInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("FCmpInst", func);
 }
 
 Napi::Object FCmpInst::New(Napi::Env env, llvm::FCmpInst *fcmpInst) {
-    return constructor.New({Napi::External<llvm::FCmpInst>::New(env, fcmpInst)});
+    return wrapCached<FCmpInst>(env, fcmpInst);
 }
 
 bool FCmpInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::FCmpInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::FCmpInst *FCmpInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::FCmpInst, llvm::Value>(value);
 }
 
 FCmpInst::FCmpInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::FCmpInst::constructor);
@@ -564,31 +594,31 @@ void FCmpInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void CallInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "CallInst", {
-            InstanceMethod("getType", &CallInst::getType),
-            InstanceMethod("setDebugLoc", &CallInst::setDebugLoc)
+            InstanceMethod("getType", &CallInst::guarded<&CallInst::getType>),
+            InstanceMethod("setDebugLoc", &CallInst::guardedVoid<&CallInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("CallInst", func);
 }
 
 Napi::Object CallInst::New(Napi::Env env, llvm::CallInst *callInst) {
-    return constructor.New({Napi::External<llvm::CallInst>::New(env, callInst)});
+    return wrapCached<CallInst>(env, callInst);
 }
 
 bool CallInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::CallInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::CallInst *CallInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::CallInst, llvm::Value>(value);
 }
 
 CallInst::CallInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::CallInst::constructor);
@@ -623,37 +653,37 @@ void CallInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void SelectInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "SelectInst", {
-            InstanceMethod("getType", &SelectInst::getType),
-            InstanceMethod("getCondition", &SelectInst::getCondition),
-            InstanceMethod("getTrueValue", &SelectInst::getTrueValue),
-            InstanceMethod("getFalseValue", &SelectInst::getFalseValue),
-            InstanceMethod("setCondition", &SelectInst::setCondition),
-            InstanceMethod("setTrueValue", &SelectInst::setTrueValue),
-            InstanceMethod("setFalseValue", &SelectInst::setFalseValue),
-            InstanceMethod("setDebugLoc", &SelectInst::setDebugLoc)
+            InstanceMethod("getType", &SelectInst::guarded<&SelectInst::getType>),
+            InstanceMethod("getCondition", &SelectInst::guarded<&SelectInst::getCondition>),
+            InstanceMethod("getTrueValue", &SelectInst::guarded<&SelectInst::getTrueValue>),
+            InstanceMethod("getFalseValue", &SelectInst::guarded<&SelectInst::getFalseValue>),
+            InstanceMethod("setCondition", &SelectInst::guardedVoid<&SelectInst::setCondition>),
+            InstanceMethod("setTrueValue", &SelectInst::guardedVoid<&SelectInst::setTrueValue>),
+            InstanceMethod("setFalseValue", &SelectInst::guardedVoid<&SelectInst::setFalseValue>),
+            InstanceMethod("setDebugLoc", &SelectInst::guardedVoid<&SelectInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("SelectInst", func);
 }
 
 Napi::Object SelectInst::New(Napi::Env env, llvm::SelectInst *selectInst) {
-    return constructor.New({Napi::External<llvm::SelectInst>::New(env, selectInst)});
+    return wrapCached<SelectInst>(env, selectInst);
 }
 
 bool SelectInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::SelectInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::SelectInst *SelectInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::SelectInst, llvm::Value>(value);
 }
 
 SelectInst::SelectInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::SelectInst::constructor);
@@ -727,31 +757,31 @@ void SelectInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void VAArgInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "VAArgInst", {
-            InstanceMethod("getType", &VAArgInst::getType),
-            InstanceMethod("setDebugLoc", &VAArgInst::setDebugLoc)
+            InstanceMethod("getType", &VAArgInst::guarded<&VAArgInst::getType>),
+            InstanceMethod("setDebugLoc", &VAArgInst::guardedVoid<&VAArgInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("VAArgInst", func);
 }
 
 Napi::Object VAArgInst::New(Napi::Env env, llvm::VAArgInst *vaArgInst) {
-    return constructor.New({Napi::External<llvm::VAArgInst>::New(env, vaArgInst)});
+    return wrapCached<VAArgInst>(env, vaArgInst);
 }
 
 bool VAArgInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::VAArgInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::VAArgInst *VAArgInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::VAArgInst, llvm::Value>(value);
 }
 
 VAArgInst::VAArgInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::VAArgInst::constructor);
@@ -786,31 +816,31 @@ void VAArgInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void ExtractElementInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "ExtractElementInst", {
-            InstanceMethod("getType", &ExtractElementInst::getType),
-            InstanceMethod("setDebugLoc", &ExtractElementInst::setDebugLoc)
+            InstanceMethod("getType", &ExtractElementInst::guarded<&ExtractElementInst::getType>),
+            InstanceMethod("setDebugLoc", &ExtractElementInst::guardedVoid<&ExtractElementInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("ExtractElementInst", func);
 }
 
 Napi::Object ExtractElementInst::New(Napi::Env env, llvm::ExtractElementInst *extractElementInst) {
-    return constructor.New({Napi::External<llvm::ExtractElementInst>::New(env, extractElementInst)});
+    return wrapCached<ExtractElementInst>(env, extractElementInst);
 }
 
 bool ExtractElementInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::ExtractElementInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::ExtractElementInst *ExtractElementInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::ExtractElementInst, llvm::Value>(value);
 }
 
 ExtractElementInst::ExtractElementInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::ExtractElementInst::constructor);
@@ -845,31 +875,31 @@ void ExtractElementInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void InsertElementInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "InsertElementInst", {
-            InstanceMethod("getType", &InsertElementInst::getType),
-            InstanceMethod("setDebugLoc", &InsertElementInst::setDebugLoc)
+            InstanceMethod("getType", &InsertElementInst::guarded<&InsertElementInst::getType>),
+            InstanceMethod("setDebugLoc", &InsertElementInst::guardedVoid<&InsertElementInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("InsertElementInst", func);
 }
 
 Napi::Object InsertElementInst::New(Napi::Env env, llvm::InsertElementInst *insertElementInst) {
-    return constructor.New({Napi::External<llvm::InsertElementInst>::New(env, insertElementInst)});
+    return wrapCached<InsertElementInst>(env, insertElementInst);
 }
 
 bool InsertElementInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::InsertElementInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::InsertElementInst *InsertElementInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::InsertElementInst, llvm::Value>(value);
 }
 
 InsertElementInst::InsertElementInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::InsertElementInst::constructor);
@@ -904,31 +934,31 @@ void InsertElementInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void ShuffleVectorInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "ShuffleVectorInst", {
-            InstanceMethod("getType", &ShuffleVectorInst::getType),
-            InstanceMethod("setDebugLoc", &ShuffleVectorInst::setDebugLoc)
+            InstanceMethod("getType", &ShuffleVectorInst::guarded<&ShuffleVectorInst::getType>),
+            InstanceMethod("setDebugLoc", &ShuffleVectorInst::guardedVoid<&ShuffleVectorInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("ShuffleVectorInst", func);
 }
 
 Napi::Object ShuffleVectorInst::New(Napi::Env env, llvm::ShuffleVectorInst *shuffleVectorInst) {
-    return constructor.New({Napi::External<llvm::ShuffleVectorInst>::New(env, shuffleVectorInst)});
+    return wrapCached<ShuffleVectorInst>(env, shuffleVectorInst);
 }
 
 bool ShuffleVectorInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::ShuffleVectorInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::ShuffleVectorInst *ShuffleVectorInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::ShuffleVectorInst, llvm::Value>(value);
 }
 
 ShuffleVectorInst::ShuffleVectorInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::ShuffleVectorInst::constructor);
@@ -963,31 +993,31 @@ void ShuffleVectorInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void ExtractValueInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "ExtractValueInst", {
-            InstanceMethod("getType", &ExtractValueInst::getType),
-            InstanceMethod("setDebugLoc", &ExtractValueInst::setDebugLoc)
+            InstanceMethod("getType", &ExtractValueInst::guarded<&ExtractValueInst::getType>),
+            InstanceMethod("setDebugLoc", &ExtractValueInst::guardedVoid<&ExtractValueInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("ExtractValueInst", func);
 }
 
 Napi::Object ExtractValueInst::New(Napi::Env env, llvm::ExtractValueInst *extractValueInst) {
-    return constructor.New({Napi::External<llvm::ExtractValueInst>::New(env, extractValueInst)});
+    return wrapCached<ExtractValueInst>(env, extractValueInst);
 }
 
 bool ExtractValueInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::ExtractValueInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::ExtractValueInst *ExtractValueInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::ExtractValueInst, llvm::Value>(value);
 }
 
 ExtractValueInst::ExtractValueInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::ExtractValueInst::constructor);
@@ -1022,31 +1052,31 @@ void ExtractValueInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void InsertValueInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "InsertValueInst", {
-            InstanceMethod("getType", &InsertValueInst::getType),
-            InstanceMethod("setDebugLoc", &InsertValueInst::setDebugLoc)
+            InstanceMethod("getType", &InsertValueInst::guarded<&InsertValueInst::getType>),
+            InstanceMethod("setDebugLoc", &InsertValueInst::guardedVoid<&InsertValueInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("InsertValueInst", func);
 }
 
 Napi::Object InsertValueInst::New(Napi::Env env, llvm::InsertValueInst *insertValueInst) {
-    return constructor.New({Napi::External<llvm::InsertValueInst>::New(env, insertValueInst)});
+    return wrapCached<InsertValueInst>(env, insertValueInst);
 }
 
 bool InsertValueInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::InsertValueInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::InsertValueInst *InsertValueInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::InsertValueInst, llvm::Value>(value);
 }
 
 InsertValueInst::InsertValueInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::InsertValueInst::constructor);
@@ -1081,32 +1111,32 @@ void InsertValueInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void PHINode::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "PHINode", {
-            InstanceMethod("addIncoming", &PHINode::addIncoming),
-            InstanceMethod("getType", &PHINode::getType),
-            InstanceMethod("setDebugLoc", &PHINode::setDebugLoc)
+            InstanceMethod("addIncoming", &PHINode::guardedVoid<&PHINode::addIncoming>),
+            InstanceMethod("getType", &PHINode::guarded<&PHINode::getType>),
+            InstanceMethod("setDebugLoc", &PHINode::guardedVoid<&PHINode::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("PHINode", func);
 }
 
 Napi::Object PHINode::New(Napi::Env env, llvm::PHINode *phiNode) {
-    return constructor.New({Napi::External<llvm::PHINode>::New(env, phiNode)});
+    return wrapCached<PHINode>(env, phiNode);
 }
 
 bool PHINode::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::PHINode, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::PHINode *PHINode::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::PHINode, llvm::Value>(value);
 }
 
 PHINode::PHINode(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::PHINode::constructor);
@@ -1151,33 +1181,33 @@ void PHINode::setDebugLoc(const Napi::CallbackInfo &info) {
 void LandingPadInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "LandingPadInst", {
-            InstanceMethod("setCleanup", &LandingPadInst::setCleanup),
-            InstanceMethod("addClause", &LandingPadInst::addClause),
-            InstanceMethod("getType", &LandingPadInst::getType),
-            InstanceMethod("setDebugLoc", &LandingPadInst::setDebugLoc)
+            InstanceMethod("setCleanup", &LandingPadInst::guardedVoid<&LandingPadInst::setCleanup>),
+            InstanceMethod("addClause", &LandingPadInst::guardedVoid<&LandingPadInst::addClause>),
+            InstanceMethod("getType", &LandingPadInst::guarded<&LandingPadInst::getType>),
+            InstanceMethod("setDebugLoc", &LandingPadInst::guardedVoid<&LandingPadInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("LandingPadInst", func);
 }
 
 Napi::Object LandingPadInst::New(Napi::Env env, llvm::LandingPadInst *lpInst) {
-    return constructor.New({Napi::External<llvm::LandingPadInst>::New(env, lpInst)});
+    return wrapCached<LandingPadInst>(env, lpInst);
 }
 
 bool LandingPadInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::LandingPadInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::LandingPadInst *LandingPadInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::LandingPadInst, llvm::Value>(value);
 }
 
 LandingPadInst::LandingPadInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::LandingPadInst::constructor);
@@ -1230,32 +1260,32 @@ void LandingPadInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void ReturnInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "ReturnInst", {
-            InstanceMethod("getReturnValue", &ReturnInst::getReturnValue),
-            InstanceMethod("getType", &ReturnInst::getType),
-            InstanceMethod("setDebugLoc", &ReturnInst::setDebugLoc)
+            InstanceMethod("getReturnValue", &ReturnInst::guarded<&ReturnInst::getReturnValue>),
+            InstanceMethod("getType", &ReturnInst::guarded<&ReturnInst::getType>),
+            InstanceMethod("setDebugLoc", &ReturnInst::guardedVoid<&ReturnInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("ReturnInst", func);
 }
 
 Napi::Object ReturnInst::New(Napi::Env env, llvm::ReturnInst *returnInst) {
-    return constructor.New({Napi::External<llvm::ReturnInst>::New(env, returnInst)});
+    return wrapCached<ReturnInst>(env, returnInst);
 }
 
 bool ReturnInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::ReturnInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::ReturnInst *ReturnInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::ReturnInst, llvm::Value>(value);
 }
 
 ReturnInst::ReturnInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::ReturnInst::constructor);
@@ -1294,36 +1324,36 @@ void ReturnInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void BranchInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "BranchInst", {
-            InstanceMethod("isUnconditional", &BranchInst::isUnconditional),
-            InstanceMethod("isConditional", &BranchInst::isConditional),
-            InstanceMethod("getCondition", &BranchInst::getCondition),
-            InstanceMethod("getNumSuccessors", &BranchInst::getNumSuccessors),
-            InstanceMethod("getSuccessor", &BranchInst::getSuccessor),
-            InstanceMethod("getType", &BranchInst::getType),
-            InstanceMethod("setDebugLoc", &BranchInst::setDebugLoc)
+            InstanceMethod("isUnconditional", &BranchInst::guarded<&BranchInst::isUnconditional>),
+            InstanceMethod("isConditional", &BranchInst::guarded<&BranchInst::isConditional>),
+            InstanceMethod("getCondition", &BranchInst::guarded<&BranchInst::getCondition>),
+            InstanceMethod("getNumSuccessors", &BranchInst::guarded<&BranchInst::getNumSuccessors>),
+            InstanceMethod("getSuccessor", &BranchInst::guarded<&BranchInst::getSuccessor>),
+            InstanceMethod("getType", &BranchInst::guarded<&BranchInst::getType>),
+            InstanceMethod("setDebugLoc", &BranchInst::guardedVoid<&BranchInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("BranchInst", func);
 }
 
 Napi::Object BranchInst::New(Napi::Env env, llvm::BranchInst *branchInst) {
-    return constructor.New({Napi::External<llvm::BranchInst>::New(env, branchInst)});
+    return wrapCached<BranchInst>(env, branchInst);
 }
 
 bool BranchInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::BranchInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::BranchInst *BranchInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::BranchInst, llvm::Value>(value);
 }
 
 BranchInst::BranchInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::BranchInst::constructor);
@@ -1384,32 +1414,32 @@ void BranchInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void SwitchInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "SwitchInst", {
-            InstanceMethod("addCase", &SwitchInst::addCase),
-            InstanceMethod("getType", &SwitchInst::getType),
-            InstanceMethod("setDebugLoc", &SwitchInst::setDebugLoc)
+            InstanceMethod("addCase", &SwitchInst::guardedVoid<&SwitchInst::addCase>),
+            InstanceMethod("getType", &SwitchInst::guarded<&SwitchInst::getType>),
+            InstanceMethod("setDebugLoc", &SwitchInst::guardedVoid<&SwitchInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("SwitchInst", func);
 }
 
 Napi::Object SwitchInst::New(Napi::Env env, llvm::SwitchInst *switchInst) {
-    return constructor.New({Napi::External<llvm::SwitchInst>::New(env, switchInst)});
+    return wrapCached<SwitchInst>(env, switchInst);
 }
 
 bool SwitchInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::SwitchInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::SwitchInst *SwitchInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::SwitchInst, llvm::Value>(value);
 }
 
 SwitchInst::SwitchInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::SwitchInst::constructor);
@@ -1456,31 +1486,31 @@ void SwitchInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void IndirectBrInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "IndirectBrInst", {
-            InstanceMethod("getType", &IndirectBrInst::getType),
-            InstanceMethod("setDebugLoc", &IndirectBrInst::setDebugLoc)
+            InstanceMethod("getType", &IndirectBrInst::guarded<&IndirectBrInst::getType>),
+            InstanceMethod("setDebugLoc", &IndirectBrInst::guardedVoid<&IndirectBrInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("IndirectBrInst", func);
 }
 
 Napi::Object IndirectBrInst::New(Napi::Env env, llvm::IndirectBrInst *indirectBrInst) {
-    return constructor.New({Napi::External<llvm::IndirectBrInst>::New(env, indirectBrInst)});
+    return wrapCached<IndirectBrInst>(env, indirectBrInst);
 }
 
 bool IndirectBrInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::IndirectBrInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::IndirectBrInst *IndirectBrInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::IndirectBrInst, llvm::Value>(value);
 }
 
 IndirectBrInst::IndirectBrInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::IndirectBrInst::constructor);
@@ -1515,31 +1545,31 @@ void IndirectBrInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void InvokeInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "InvokeInst", {
-            InstanceMethod("getType", &InvokeInst::getType),
-            InstanceMethod("setDebugLoc", &InvokeInst::setDebugLoc)
+            InstanceMethod("getType", &InvokeInst::guarded<&InvokeInst::getType>),
+            InstanceMethod("setDebugLoc", &InvokeInst::guardedVoid<&InvokeInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("InvokeInst", func);
 }
 
 Napi::Object InvokeInst::New(Napi::Env env, llvm::InvokeInst *invokeInst) {
-    return constructor.New({Napi::External<llvm::InvokeInst>::New(env, invokeInst)});
+    return wrapCached<InvokeInst>(env, invokeInst);
 }
 
 bool InvokeInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::InvokeInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::InvokeInst *InvokeInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::InvokeInst, llvm::Value>(value);
 }
 
 InvokeInst::InvokeInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::InvokeInst::constructor);
@@ -1574,31 +1604,31 @@ void InvokeInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void CallBrInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "CallBrInst", {
-            InstanceMethod("getType", &CallBrInst::getType),
-            InstanceMethod("setDebugLoc", &CallBrInst::setDebugLoc)
+            InstanceMethod("getType", &CallBrInst::guarded<&CallBrInst::getType>),
+            InstanceMethod("setDebugLoc", &CallBrInst::guardedVoid<&CallBrInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("CallBrInst", func);
 }
 
 Napi::Object CallBrInst::New(Napi::Env env, llvm::CallBrInst *callBrInst) {
-    return constructor.New({Napi::External<llvm::CallBrInst>::New(env, callBrInst)});
+    return wrapCached<CallBrInst>(env, callBrInst);
 }
 
 bool CallBrInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::CallBrInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::CallBrInst *CallBrInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::CallBrInst, llvm::Value>(value);
 }
 
 CallBrInst::CallBrInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::CallBrInst::constructor);
@@ -1633,31 +1663,31 @@ void CallBrInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void ResumeInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "ResumeInst", {
-            InstanceMethod("getType", &ResumeInst::getType),
-            InstanceMethod("setDebugLoc", &ResumeInst::setDebugLoc)
+            InstanceMethod("getType", &ResumeInst::guarded<&ResumeInst::getType>),
+            InstanceMethod("setDebugLoc", &ResumeInst::guardedVoid<&ResumeInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("ResumeInst", func);
 }
 
 Napi::Object ResumeInst::New(Napi::Env env, llvm::ResumeInst *resumeInst) {
-    return constructor.New({Napi::External<llvm::ResumeInst>::New(env, resumeInst)});
+    return wrapCached<ResumeInst>(env, resumeInst);
 }
 
 bool ResumeInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::ResumeInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::ResumeInst *ResumeInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::ResumeInst, llvm::Value>(value);
 }
 
 ResumeInst::ResumeInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::ResumeInst::constructor);
@@ -1692,31 +1722,31 @@ void ResumeInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void CatchSwitchInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "CatchSwitchInst", {
-            InstanceMethod("getType", &CatchSwitchInst::getType),
-            InstanceMethod("setDebugLoc", &CatchSwitchInst::setDebugLoc)
+            InstanceMethod("getType", &CatchSwitchInst::guarded<&CatchSwitchInst::getType>),
+            InstanceMethod("setDebugLoc", &CatchSwitchInst::guardedVoid<&CatchSwitchInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("CatchSwitchInst", func);
 }
 
 Napi::Object CatchSwitchInst::New(Napi::Env env, llvm::CatchSwitchInst *catchSwitchInst) {
-    return constructor.New({Napi::External<llvm::CatchSwitchInst>::New(env, catchSwitchInst)});
+    return wrapCached<CatchSwitchInst>(env, catchSwitchInst);
 }
 
 bool CatchSwitchInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::CatchSwitchInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::CatchSwitchInst *CatchSwitchInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::CatchSwitchInst, llvm::Value>(value);
 }
 
 CatchSwitchInst::CatchSwitchInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::CatchSwitchInst::constructor);
@@ -1751,31 +1781,31 @@ void CatchSwitchInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void CleanupPadInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "CleanupPadInst", {
-            InstanceMethod("getType", &CleanupPadInst::getType),
-            InstanceMethod("setDebugLoc", &CleanupPadInst::setDebugLoc)
+            InstanceMethod("getType", &CleanupPadInst::guarded<&CleanupPadInst::getType>),
+            InstanceMethod("setDebugLoc", &CleanupPadInst::guardedVoid<&CleanupPadInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("CleanupPadInst", func);
 }
 
 Napi::Object CleanupPadInst::New(Napi::Env env, llvm::CleanupPadInst *cleanupPadInst) {
-    return constructor.New({Napi::External<llvm::CleanupPadInst>::New(env, cleanupPadInst)});
+    return wrapCached<CleanupPadInst>(env, cleanupPadInst);
 }
 
 bool CleanupPadInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::CleanupPadInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::CleanupPadInst *CleanupPadInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::CleanupPadInst, llvm::Value>(value);
 }
 
 CleanupPadInst::CleanupPadInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::CleanupPadInst::constructor);
@@ -1810,31 +1840,31 @@ void CleanupPadInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void CatchPadInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "CatchPadInst", {
-            InstanceMethod("getType", &CatchPadInst::getType),
-            InstanceMethod("setDebugLoc", &CatchPadInst::setDebugLoc)
+            InstanceMethod("getType", &CatchPadInst::guarded<&CatchPadInst::getType>),
+            InstanceMethod("setDebugLoc", &CatchPadInst::guardedVoid<&CatchPadInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("CatchPadInst", func);
 }
 
 Napi::Object CatchPadInst::New(Napi::Env env, llvm::CatchPadInst *catchPadInst) {
-    return constructor.New({Napi::External<llvm::CatchPadInst>::New(env, catchPadInst)});
+    return wrapCached<CatchPadInst>(env, catchPadInst);
 }
 
 bool CatchPadInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::CatchPadInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::CatchPadInst *CatchPadInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::CatchPadInst, llvm::Value>(value);
 }
 
 CatchPadInst::CatchPadInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::CatchPadInst::constructor);
@@ -1869,31 +1899,31 @@ void CatchPadInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void CatchReturnInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "CatchReturnInst", {
-            InstanceMethod("getType", &CatchReturnInst::getType),
-            InstanceMethod("setDebugLoc", &CatchReturnInst::setDebugLoc)
+            InstanceMethod("getType", &CatchReturnInst::guarded<&CatchReturnInst::getType>),
+            InstanceMethod("setDebugLoc", &CatchReturnInst::guardedVoid<&CatchReturnInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("CatchReturnInst", func);
 }
 
 Napi::Object CatchReturnInst::New(Napi::Env env, llvm::CatchReturnInst *catchReturnInst) {
-    return constructor.New({Napi::External<llvm::CatchReturnInst>::New(env, catchReturnInst)});
+    return wrapCached<CatchReturnInst>(env, catchReturnInst);
 }
 
 bool CatchReturnInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::CatchReturnInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::CatchReturnInst *CatchReturnInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::CatchReturnInst, llvm::Value>(value);
 }
 
 CatchReturnInst::CatchReturnInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::CatchReturnInst::constructor);
@@ -1928,31 +1958,31 @@ void CatchReturnInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void CleanupReturnInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "CleanupReturnInst", {
-            InstanceMethod("getType", &CleanupReturnInst::getType),
-            InstanceMethod("setDebugLoc", &CleanupReturnInst::setDebugLoc)
+            InstanceMethod("getType", &CleanupReturnInst::guarded<&CleanupReturnInst::getType>),
+            InstanceMethod("setDebugLoc", &CleanupReturnInst::guardedVoid<&CleanupReturnInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("CleanupReturnInst", func);
 }
 
 Napi::Object CleanupReturnInst::New(Napi::Env env, llvm::CleanupReturnInst *cleanupReturnInst) {
-    return constructor.New({Napi::External<llvm::CleanupReturnInst>::New(env, cleanupReturnInst)});
+    return wrapCached<CleanupReturnInst>(env, cleanupReturnInst);
 }
 
 bool CleanupReturnInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::CleanupReturnInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::CleanupReturnInst *CleanupReturnInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::CleanupReturnInst, llvm::Value>(value);
 }
 
 CleanupReturnInst::CleanupReturnInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::CleanupReturnInst::constructor);
@@ -1987,31 +2017,31 @@ void CleanupReturnInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void UnreachableInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "UnreachableInst", {
-            InstanceMethod("getType", &UnreachableInst::getType),
-            InstanceMethod("setDebugLoc", &UnreachableInst::setDebugLoc)
+            InstanceMethod("getType", &UnreachableInst::guarded<&UnreachableInst::getType>),
+            InstanceMethod("setDebugLoc", &UnreachableInst::guardedVoid<&UnreachableInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("UnreachableInst", func);
 }
 
 Napi::Object UnreachableInst::New(Napi::Env env, llvm::UnreachableInst *unreachableInst) {
-    return constructor.New({Napi::External<llvm::UnreachableInst>::New(env, unreachableInst)});
+    return wrapCached<UnreachableInst>(env, unreachableInst);
 }
 
 bool UnreachableInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::UnreachableInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::UnreachableInst *UnreachableInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::UnreachableInst, llvm::Value>(value);
 }
 
 UnreachableInst::UnreachableInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::UnreachableInst::constructor);
@@ -2046,31 +2076,31 @@ void UnreachableInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void TruncInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "TruncInst", {
-            InstanceMethod("getType", &TruncInst::getType),
-            InstanceMethod("setDebugLoc", &TruncInst::setDebugLoc)
+            InstanceMethod("getType", &TruncInst::guarded<&TruncInst::getType>),
+            InstanceMethod("setDebugLoc", &TruncInst::guardedVoid<&TruncInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("TruncInst", func);
 }
 
 Napi::Object TruncInst::New(Napi::Env env, llvm::TruncInst *truncInst) {
-    return constructor.New({Napi::External<llvm::TruncInst>::New(env, truncInst)});
+    return wrapCached<TruncInst>(env, truncInst);
 }
 
 bool TruncInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::TruncInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::TruncInst *TruncInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::TruncInst, llvm::Value>(value);
 }
 
 TruncInst::TruncInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::TruncInst::constructor);
@@ -2105,31 +2135,31 @@ void TruncInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void ZExtInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "ZExtInst", {
-            InstanceMethod("getType", &ZExtInst::getType),
-            InstanceMethod("setDebugLoc", &ZExtInst::setDebugLoc)
+            InstanceMethod("getType", &ZExtInst::guarded<&ZExtInst::getType>),
+            InstanceMethod("setDebugLoc", &ZExtInst::guardedVoid<&ZExtInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("ZExtInst", func);
 }
 
 Napi::Object ZExtInst::New(Napi::Env env, llvm::ZExtInst *zExtInst) {
-    return constructor.New({Napi::External<llvm::ZExtInst>::New(env, zExtInst)});
+    return wrapCached<ZExtInst>(env, zExtInst);
 }
 
 bool ZExtInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::ZExtInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::ZExtInst *ZExtInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::ZExtInst, llvm::Value>(value);
 }
 
 ZExtInst::ZExtInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::ZExtInst::constructor);
@@ -2164,31 +2194,31 @@ void ZExtInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void SExtInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "SExtInst", {
-            InstanceMethod("getType", &SExtInst::getType),
-            InstanceMethod("setDebugLoc", &SExtInst::setDebugLoc)
+            InstanceMethod("getType", &SExtInst::guarded<&SExtInst::getType>),
+            InstanceMethod("setDebugLoc", &SExtInst::guardedVoid<&SExtInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("SExtInst", func);
 }
 
 Napi::Object SExtInst::New(Napi::Env env, llvm::SExtInst *sExtInst) {
-    return constructor.New({Napi::External<llvm::SExtInst>::New(env, sExtInst)});
+    return wrapCached<SExtInst>(env, sExtInst);
 }
 
 bool SExtInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::SExtInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::SExtInst *SExtInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::SExtInst, llvm::Value>(value);
 }
 
 SExtInst::SExtInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::SExtInst::constructor);
@@ -2223,31 +2253,31 @@ void SExtInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void FPTruncInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "FPTruncInst", {
-            InstanceMethod("getType", &FPTruncInst::getType),
-            InstanceMethod("setDebugLoc", &FPTruncInst::setDebugLoc)
+            InstanceMethod("getType", &FPTruncInst::guarded<&FPTruncInst::getType>),
+            InstanceMethod("setDebugLoc", &FPTruncInst::guardedVoid<&FPTruncInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("FPTruncInst", func);
 }
 
 Napi::Object FPTruncInst::New(Napi::Env env, llvm::FPTruncInst *fpTruncInst) {
-    return constructor.New({Napi::External<llvm::FPTruncInst>::New(env, fpTruncInst)});
+    return wrapCached<FPTruncInst>(env, fpTruncInst);
 }
 
 bool FPTruncInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::FPTruncInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::FPTruncInst *FPTruncInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::FPTruncInst, llvm::Value>(value);
 }
 
 FPTruncInst::FPTruncInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::FPTruncInst::constructor);
@@ -2282,31 +2312,31 @@ void FPTruncInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void FPExtInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "FPExtInst", {
-            InstanceMethod("getType", &FPExtInst::getType),
-            InstanceMethod("setDebugLoc", &FPExtInst::setDebugLoc)
+            InstanceMethod("getType", &FPExtInst::guarded<&FPExtInst::getType>),
+            InstanceMethod("setDebugLoc", &FPExtInst::guardedVoid<&FPExtInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("FPExtInst", func);
 }
 
 Napi::Object FPExtInst::New(Napi::Env env, llvm::FPExtInst *fpExtInst) {
-    return constructor.New({Napi::External<llvm::FPExtInst>::New(env, fpExtInst)});
+    return wrapCached<FPExtInst>(env, fpExtInst);
 }
 
 bool FPExtInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::FPExtInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::FPExtInst *FPExtInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::FPExtInst, llvm::Value>(value);
 }
 
 FPExtInst::FPExtInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::FPExtInst::constructor);
@@ -2341,31 +2371,31 @@ void FPExtInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void UIToFPInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "UIToFPInst", {
-            InstanceMethod("getType", &UIToFPInst::getType),
-            InstanceMethod("setDebugLoc", &UIToFPInst::setDebugLoc)
+            InstanceMethod("getType", &UIToFPInst::guarded<&UIToFPInst::getType>),
+            InstanceMethod("setDebugLoc", &UIToFPInst::guardedVoid<&UIToFPInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("UIToFPInst", func);
 }
 
 Napi::Object UIToFPInst::New(Napi::Env env, llvm::UIToFPInst *uiToFPInst) {
-    return constructor.New({Napi::External<llvm::UIToFPInst>::New(env, uiToFPInst)});
+    return wrapCached<UIToFPInst>(env, uiToFPInst);
 }
 
 bool UIToFPInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::UIToFPInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::UIToFPInst *UIToFPInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::UIToFPInst, llvm::Value>(value);
 }
 
 UIToFPInst::UIToFPInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::UIToFPInst::constructor);
@@ -2400,31 +2430,31 @@ void UIToFPInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void SIToFPInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "SIToFPInst", {
-            InstanceMethod("getType", &SIToFPInst::getType),
-            InstanceMethod("setDebugLoc", &SIToFPInst::setDebugLoc)
+            InstanceMethod("getType", &SIToFPInst::guarded<&SIToFPInst::getType>),
+            InstanceMethod("setDebugLoc", &SIToFPInst::guardedVoid<&SIToFPInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("SIToFPInst", func);
 }
 
 Napi::Object SIToFPInst::New(Napi::Env env, llvm::SIToFPInst *siToFPInst) {
-    return constructor.New({Napi::External<llvm::SIToFPInst>::New(env, siToFPInst)});
+    return wrapCached<SIToFPInst>(env, siToFPInst);
 }
 
 bool SIToFPInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::SIToFPInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::SIToFPInst *SIToFPInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::SIToFPInst, llvm::Value>(value);
 }
 
 SIToFPInst::SIToFPInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::SIToFPInst::constructor);
@@ -2459,31 +2489,31 @@ void SIToFPInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void FPToUIInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "FPToUIInst", {
-            InstanceMethod("getType", &FPToUIInst::getType),
-            InstanceMethod("setDebugLoc", &FPToUIInst::setDebugLoc)
+            InstanceMethod("getType", &FPToUIInst::guarded<&FPToUIInst::getType>),
+            InstanceMethod("setDebugLoc", &FPToUIInst::guardedVoid<&FPToUIInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("FPToUIInst", func);
 }
 
 Napi::Object FPToUIInst::New(Napi::Env env, llvm::FPToUIInst *fpToUIInst) {
-    return constructor.New({Napi::External<llvm::FPToUIInst>::New(env, fpToUIInst)});
+    return wrapCached<FPToUIInst>(env, fpToUIInst);
 }
 
 bool FPToUIInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::FPToUIInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::FPToUIInst *FPToUIInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::FPToUIInst, llvm::Value>(value);
 }
 
 FPToUIInst::FPToUIInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::FPToUIInst::constructor);
@@ -2518,31 +2548,31 @@ void FPToUIInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void FPToSIInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "FPToSIInst", {
-            InstanceMethod("getType", &FPToSIInst::getType),
-            InstanceMethod("setDebugLoc", &FPToSIInst::setDebugLoc)
+            InstanceMethod("getType", &FPToSIInst::guarded<&FPToSIInst::getType>),
+            InstanceMethod("setDebugLoc", &FPToSIInst::guardedVoid<&FPToSIInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("FPToSIInst", func);
 }
 
 Napi::Object FPToSIInst::New(Napi::Env env, llvm::FPToSIInst *fpToSIInst) {
-    return constructor.New({Napi::External<llvm::FPToSIInst>::New(env, fpToSIInst)});
+    return wrapCached<FPToSIInst>(env, fpToSIInst);
 }
 
 bool FPToSIInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::FPToSIInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::FPToSIInst *FPToSIInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::FPToSIInst, llvm::Value>(value);
 }
 
 FPToSIInst::FPToSIInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::FPToSIInst::constructor);
@@ -2577,31 +2607,31 @@ void FPToSIInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void IntToPtrInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "IntToPtrInst", {
-            InstanceMethod("getType", &IntToPtrInst::getType),
-            InstanceMethod("setDebugLoc", &IntToPtrInst::setDebugLoc)
+            InstanceMethod("getType", &IntToPtrInst::guarded<&IntToPtrInst::getType>),
+            InstanceMethod("setDebugLoc", &IntToPtrInst::guardedVoid<&IntToPtrInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("IntToPtrInst", func);
 }
 
 Napi::Object IntToPtrInst::New(Napi::Env env, llvm::IntToPtrInst *intToPtrInst) {
-    return constructor.New({Napi::External<llvm::IntToPtrInst>::New(env, intToPtrInst)});
+    return wrapCached<IntToPtrInst>(env, intToPtrInst);
 }
 
 bool IntToPtrInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::IntToPtrInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::IntToPtrInst *IntToPtrInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::IntToPtrInst, llvm::Value>(value);
 }
 
 IntToPtrInst::IntToPtrInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::IntToPtrInst::constructor);
@@ -2636,31 +2666,31 @@ void IntToPtrInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void PtrToIntInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "PtrToIntInst", {
-            InstanceMethod("getType", &PtrToIntInst::getType),
-            InstanceMethod("setDebugLoc", &PtrToIntInst::setDebugLoc)
+            InstanceMethod("getType", &PtrToIntInst::guarded<&PtrToIntInst::getType>),
+            InstanceMethod("setDebugLoc", &PtrToIntInst::guardedVoid<&PtrToIntInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("PtrToIntInst", func);
 }
 
 Napi::Object PtrToIntInst::New(Napi::Env env, llvm::PtrToIntInst *ptrToIntInst) {
-    return constructor.New({Napi::External<llvm::PtrToIntInst>::New(env, ptrToIntInst)});
+    return wrapCached<PtrToIntInst>(env, ptrToIntInst);
 }
 
 bool PtrToIntInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::PtrToIntInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::PtrToIntInst *PtrToIntInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::PtrToIntInst, llvm::Value>(value);
 }
 
 PtrToIntInst::PtrToIntInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::PtrToIntInst::constructor);
@@ -2695,31 +2725,31 @@ void PtrToIntInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void BitCastInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "BitCastInst", {
-            InstanceMethod("getType", &BitCastInst::getType),
-            InstanceMethod("setDebugLoc", &BitCastInst::setDebugLoc)
+            InstanceMethod("getType", &BitCastInst::guarded<&BitCastInst::getType>),
+            InstanceMethod("setDebugLoc", &BitCastInst::guardedVoid<&BitCastInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("BitCastInst", func);
 }
 
 Napi::Object BitCastInst::New(Napi::Env env, llvm::BitCastInst *bitCastInst) {
-    return constructor.New({Napi::External<llvm::BitCastInst>::New(env, bitCastInst)});
+    return wrapCached<BitCastInst>(env, bitCastInst);
 }
 
 bool BitCastInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::BitCastInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::BitCastInst *BitCastInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::BitCastInst, llvm::Value>(value);
 }
 
 BitCastInst::BitCastInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::BitCastInst::constructor);
@@ -2754,31 +2784,31 @@ void BitCastInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void AddrSpaceCastInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "AddrSpaceCastInst", {
-            InstanceMethod("getType", &AddrSpaceCastInst::getType),
-            InstanceMethod("setDebugLoc", &AddrSpaceCastInst::setDebugLoc)
+            InstanceMethod("getType", &AddrSpaceCastInst::guarded<&AddrSpaceCastInst::getType>),
+            InstanceMethod("setDebugLoc", &AddrSpaceCastInst::guardedVoid<&AddrSpaceCastInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("AddrSpaceCastInst", func);
 }
 
 Napi::Object AddrSpaceCastInst::New(Napi::Env env, llvm::AddrSpaceCastInst *addrSpaceCastInst) {
-    return constructor.New({Napi::External<llvm::AddrSpaceCastInst>::New(env, addrSpaceCastInst)});
+    return wrapCached<AddrSpaceCastInst>(env, addrSpaceCastInst);
 }
 
 bool AddrSpaceCastInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::AddrSpaceCastInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::AddrSpaceCastInst *AddrSpaceCastInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::AddrSpaceCastInst, llvm::Value>(value);
 }
 
 AddrSpaceCastInst::AddrSpaceCastInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::AddrSpaceCastInst::constructor);
@@ -2813,31 +2843,31 @@ void AddrSpaceCastInst::setDebugLoc(const Napi::CallbackInfo &info) {
 void FreezeInst::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "FreezeInst", {
-            InstanceMethod("getType", &FreezeInst::getType),
-            InstanceMethod("setDebugLoc", &FreezeInst::setDebugLoc)
+            InstanceMethod("getType", &FreezeInst::guarded<&FreezeInst::getType>),
+            InstanceMethod("setDebugLoc", &FreezeInst::guardedVoid<&FreezeInst::setDebugLoc>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Instruction::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Instruction::constructor.Value(env));
     exports.Set("FreezeInst", func);
 }
 
 Napi::Object FreezeInst::New(Napi::Env env, llvm::FreezeInst *freezeInst) {
-    return constructor.New({Napi::External<llvm::FreezeInst>::New(env, freezeInst)});
+    return wrapCached<FreezeInst>(env, freezeInst);
 }
 
 bool FreezeInst::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::FreezeInst, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::FreezeInst *FreezeInst::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::FreezeInst, llvm::Value>(value);
 }
 
 FreezeInst::FreezeInst(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::FreezeInst::constructor);
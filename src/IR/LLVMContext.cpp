@@ -1,30 +1,118 @@
 #include "IR/index.h"
 #include "Util/index.h"
 
+// an empty context already allocates its type and constant tables, this is the order of magnitude reported to V8
+static constexpr int64_t ContextFootprint = 256 * 1024;
+
 void LLVMContext::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
-    const Napi::Function func = DefineClass(env, "LLVMContext", {});
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
+    const Napi::Function func = DefineClass(env, "LLVMContext", {
+            InstanceMethod("dispose", &LLVMContext::dispose)
+    });
+    DefineSymbolDispose(env, func);
+    constructor.Reset(env, func);
     exports.Set("LLVMContext", func);
 }
 
 bool LLVMContext::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || hasTypeTag(value, TypeTag::LLVMContext);
 }
 
 llvm::LLVMContext &LLVMContext::Extract(const Napi::Value &value) {
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    LLVMContext *wrapper = Unwrap(value.As<Napi::Object>());
+    if (wrapper->isLocked()) {
+        throw Napi::Error::New(value.Env(), ErrMsg::Class::LLVMContext::locked);
+    }
+    return wrapper->getLLVMPrimitive();
+}
+
+LLVMContext *LLVMContext::Lookup(Napi::Env env, llvm::LLVMContext &context) {
+    const Napi::Object wrapper = WrapperCache::Get(env, context).getContext();
+    return wrapper.IsEmpty() ? nullptr : Unwrap(wrapper);
 }
 
 LLVMContext::LLVMContext(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::LLVMContext);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::LLVMContext::constructor);
     }
     context = new llvm::LLVMContext();
+    WrapperCache &cache = WrapperCache::Get(env, *context);
+    cache.setContext(info.This().As<Napi::Object>());
+    state = cache.getState();
+    Napi::MemoryManagement::AdjustExternalMemory(env, ContextFootprint);
+}
+
+LLVMContext::~LLVMContext() {
+    free();
 }
 
 llvm::LLVMContext &LLVMContext::getLLVMPrimitive() {
+    if (context == nullptr) {
+        throw Napi::Error::New(Env(), ErrMsg::Class::LLVMContext::disposed);
+    }
     return *context;
 }
+
+void LLVMContext::addModule(Module *module) {
+    modules.insert(module);
+}
+
+void LLVMContext::removeModule(Module *module) {
+    modules.erase(module);
+}
+
+void LLVMContext::lock() {
+    state->locked = true;
+}
+
+void LLVMContext::unlock() {
+    state->locked = false;
+}
+
+bool LLVMContext::isLocked() const {
+    return state->locked;
+}
+
+unsigned LLVMContext::getModuleCount() const {
+    return modules.size();
+}
+
+std::unique_ptr<llvm::LLVMContext> LLVMContext::release() {
+    if (context == nullptr) {
+        throw Napi::Error::New(Env(), ErrMsg::Class::LLVMContext::disposed);
+    }
+    if (isLocked()) {
+        throw Napi::Error::New(Env(), ErrMsg::Class::LLVMContext::locked);
+    }
+    if (!modules.empty()) {
+        throw Napi::Error::New(Env(), ErrMsg::Class::LLVMContext::release);
+    }
+    llvm::LLVMContext *released = context;
+    WrapperCache::Drop(Env(), *released);
+    context = nullptr;
+    Napi::MemoryManagement::AdjustExternalMemory(Env(), -ContextFootprint);
+    return std::unique_ptr<llvm::LLVMContext>(released);
+}
+
+void LLVMContext::free() {
+    if (context == nullptr) {
+        return;
+    }
+    // every module must be destroyed before the context they live in
+    while (!modules.empty()) {
+        (*modules.begin())->free();
+    }
+    WrapperCache::Drop(Env(), *context);
+    delete context;
+    context = nullptr;
+    Napi::MemoryManagement::AdjustExternalMemory(Env(), -ContextFootprint);
+}
+
+void LLVMContext::dispose(const Napi::CallbackInfo &info) {
+    if (isLocked()) {
+        throw Napi::Error::New(info.Env(), ErrMsg::Class::LLVMContext::locked);
+    }
+    free();
+}
@@ -9,8 +9,7 @@ void Metadata::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "Metadata", {
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
+    constructor.Reset(env, func);
     exports.Set("Metadata", func);
 }
 
@@ -18,27 +17,29 @@ Napi::Value Metadata::New(Napi::Env env, llvm::Metadata *metadata) {
     if (llvm::isa<llvm::MDNode>(metadata)) {
         return MDNode::New(env, llvm::cast<llvm::MDNode>(metadata));
     }
-    return constructor.New({Napi::External<llvm::Metadata>::New(env, metadata)});
+    return constructor.New(env, {Napi::External<llvm::Metadata>::New(env, metadata)});
 }
 
 bool Metadata::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || hasTypeTag(value, TypeTag::Metadata);
 }
 
 llvm::Metadata *Metadata::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::Metadata, llvm::Metadata>(value);
 }
 
 Metadata::Metadata(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Metadata, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::Metadata::constructor);
     }
     const auto external = info[0].As<Napi::External<llvm::Metadata>>();
     metadata = external.Data();
+    setRoot(metadata);
 }
 
 llvm::Metadata *Metadata::getLLVMPrimitive() {
@@ -53,9 +54,8 @@ void MDNode::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "MDNode", {
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Metadata::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Metadata::constructor.Value(env));
     exports.Set("MDNode", func);
 }
 
@@ -69,27 +69,29 @@ Napi::Value MDNode::New(Napi::Env env, llvm::MDNode *node) {
     } else if (llvm::isa<llvm::DINode>(node)) {
         return DINode::New(env, llvm::cast<llvm::DINode>(node));
     }
-    return constructor.New({Napi::External<llvm::MDNode>::New(env, node)});
+    return constructor.New(env, {Napi::External<llvm::MDNode>::New(env, node)});
 }
 
 bool MDNode::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::MDNode, llvm::Metadata>(value, TypeTag::Metadata);
 }
 
 llvm::MDNode *MDNode::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::MDNode, llvm::Metadata>(value);
 }
 
 MDNode::MDNode(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Metadata, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::MDNode::constructor);
     }
     const auto external = info[0].As<Napi::External<llvm::MDNode>>();
     node = external.Data();
+    setRoot(node);
 }
 
 llvm::MDNode *MDNode::getLLVMPrimitive() {
@@ -1,7 +1,38 @@
+#include <algorithm>
+#include <optional>
+#include <thread>
+#include <llvm/IR/InstrTypes.h>
 #include <llvm/Support/FileSystem.h>
 #include "IR/index.h"
 #include "Util/index.h"
 
+// rough size in bytes of the IR held by a module, metadata and uniqued types are not counted
+static int64_t estimateFootprint(const llvm::Module &module) {
+    int64_t size = sizeof(llvm::Module);
+    for (const llvm::GlobalVariable &global : module.globals()) {
+        size += int64_t(sizeof(llvm::GlobalVariable) + global.getName().size());
+        if (!global.hasInitializer()) {
+            continue;
+        }
+        if (const auto *data = llvm::dyn_cast<llvm::ConstantDataSequential>(global.getInitializer())) {
+            size += int64_t(data->getRawDataValues().size());
+        }
+    }
+    for (const llvm::Function &function : module) {
+        size += int64_t(sizeof(llvm::Function) + function.getName().size() + function.arg_size() * sizeof(llvm::Argument));
+        for (const llvm::BasicBlock &block : function) {
+            size += int64_t(sizeof(llvm::BasicBlock));
+            for (const llvm::Instruction &inst : block) {
+                size += int64_t(sizeof(llvm::Instruction) + inst.getNumOperands() * sizeof(llvm::Use) + inst.getName().size());
+            }
+        }
+    }
+    return size;
+}
+
+// growth below which the footprint of a module is not re-estimated
+static constexpr int64_t MinRefreshGrowth = 64 * 1024;
+
 void Module::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
 
@@ -18,65 +49,198 @@ void Module::Init(Napi::Env env, Napi::Object &exports) {
 
     const Napi::Function func = DefineClass(env, "Module", {
             StaticValue("ModFlagBehavior", flagBehaviorNS),
-            InstanceMethod("getModuleIdentifier", &Module::getModuleIdentifier),
-            InstanceMethod("getSourceFileName", &Module::getSourceFileName),
-            InstanceMethod("getName", &Module::getName),
-            InstanceMethod("getDataLayoutStr", &Module::getDataLayoutStr),
-            InstanceMethod("getDataLayout", &Module::getDataLayout),
-            InstanceMethod("getTargetTriple", &Module::getTargetTriple),
-            InstanceMethod("setModuleIdentifier", &Module::setModuleIdentifier),
-            InstanceMethod("setSourceFileName", &Module::setSourceFileName),
-            InstanceMethod("setDataLayout", &Module::setDataLayout),
-            InstanceMethod("setTargetTriple", &Module::setTargetTriple),
-            InstanceMethod("getFunction", &Module::getFunction),
-            InstanceMethod("getOrInsertFunction", &Module::getOrInsertFunction),
-            InstanceMethod("getGlobalVariable", &Module::getGlobalVariable),
-            InstanceMethod("addModuleFlag", &Module::addModuleFlag),
-            InstanceMethod("empty", &Module::empty),
-            InstanceMethod("print", &Module::print)
+            InstanceMethod("getModuleIdentifier", &Module::guarded<&Module::getModuleIdentifier>),
+            InstanceMethod("getSourceFileName", &Module::guarded<&Module::getSourceFileName>),
+            InstanceMethod("getName", &Module::guarded<&Module::getName>),
+            InstanceMethod("getDataLayoutStr", &Module::guarded<&Module::getDataLayoutStr>),
+            InstanceMethod("getDataLayout", &Module::guarded<&Module::getDataLayout>),
+            InstanceMethod("getTargetTriple", &Module::guarded<&Module::getTargetTriple>),
+            InstanceMethod("setModuleIdentifier", &Module::guardedVoid<&Module::setModuleIdentifier>),
+            InstanceMethod("setSourceFileName", &Module::guardedVoid<&Module::setSourceFileName>),
+            InstanceMethod("setDataLayout", &Module::guardedVoid<&Module::setDataLayout>),
+            InstanceMethod("setTargetTriple", &Module::guardedVoid<&Module::setTargetTriple>),
+            InstanceMethod("getFunction", &Module::guarded<&Module::getFunction>),
+            InstanceMethod("getOrInsertFunction", &Module::guarded<&Module::getOrInsertFunction>),
+            InstanceMethod("getGlobalVariable", &Module::guarded<&Module::getGlobalVariable>),
+            InstanceMethod("getFunctions", &Module::guarded<&Module::getFunctions>),
+            InstanceMethod("getGlobalVariables", &Module::guarded<&Module::getGlobalVariables>),
+            InstanceMethod("addModuleFlag", &Module::guardedVoid<&Module::addModuleFlag>),
+            InstanceMethod("empty", &Module::guarded<&Module::empty>),
+            InstanceMethod("print", &Module::guarded<&Module::print>),
+            InstanceMethod("printAsync", &Module::guarded<&Module::printAsync>),
+            InstanceMethod("cursor", &Module::guarded<&Module::cursor>),
+            InstanceMethod("findInstructions", &Module::guarded<&Module::findInstructions>),
+            InstanceMethod("dispose", &Module::dispose)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
+    DefineSymbolDispose(env, func);
+    constructor.Reset(env, func);
     exports.Set("Module", func);
 }
 
 bool Module::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || hasTypeTag(value, TypeTag::Module);
 }
 
 Napi::Object Module::New(Napi::Env env, llvm::Module *module) {
-    return constructor.New({Napi::External<llvm::Module>::New(env, module)});
+    if (module) {
+        Napi::Object owning = WrapperCache::Get(env, module->getContext()).lookupModule(module);
+        if (!owning.IsEmpty()) {
+            return owning;
+        }
+    }
+    return constructor.New(env, {Napi::External<llvm::Module>::New(env, module)});
+}
+
+Napi::Object Module::New(Napi::Env env, std::unique_ptr<llvm::Module> module, const Napi::Object &context) {
+    return constructor.New(env, {Napi::External<llvm::Module>::New(env, module.release()), context});
 }
 
 llvm::Module *Module::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    Module *wrapper = Unwrap(value.As<Napi::Object>());
+    llvm::Module *module = wrapper->getLLVMPrimitive();
+    if (wrapper->isLocked()) {
+        throw Napi::Error::New(value.Env(), ErrMsg::Class::LLVMContext::locked);
+    }
+    return module;
+}
+
+void Module::UpdateExternalMemory(const Napi::Value &value) {
+    if (value.IsObject()) {
+        Unwrap(value.As<Napi::Object>())->updateExternalMemory();
+    }
+}
+
+void Module::NoteGrowth(Napi::Env env, const llvm::Module *module, int64_t bytes) {
+    const Napi::Object moduleObj = WrapperCache::Get(env, module->getContext()).lookupModule(module);
+    if (!moduleObj.IsEmpty()) {
+        Unwrap(moduleObj)->noteGrowth(bytes);
+    }
+}
+
+std::unique_ptr<llvm::Module> Module::Release(const Napi::Value &value) {
+    Module *wrapper = Unwrap(value.As<Napi::Object>());
+    if (wrapper->owner == nullptr) {
+        throw Napi::Error::New(value.Env(), ErrMsg::Class::Module::release);
+    }
+    if (wrapper->isLocked()) {
+        throw Napi::Error::New(value.Env(), ErrMsg::Class::LLVMContext::locked);
+    }
+    llvm::Module *module = wrapper->module;
+    wrapper->detach();
+    return std::unique_ptr<llvm::Module>(module);
 }
 
 Module::Module(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Module);
     const Napi::Env env = info.Env();
     if (info.IsConstructCall()) {
         const unsigned argsLen = info.Length();
         if (argsLen >= 1 && info[0].IsExternal()) {
             const auto external = info[0].As<Napi::External<llvm::Module>>();
             module = external.Data();
+            if (argsLen >= 2 && LLVMContext::IsClassOf(info[1])) {
+                adopt(info[1].As<Napi::Object>());
+            }
             return;
         } else if (argsLen >= 2 && info[0].IsString() && LLVMContext::IsClassOf(info[1])) {
             const std::string &moduleID = info[0].As<Napi::String>();
             llvm::LLVMContext &context = LLVMContext::Extract(info[1]);
             module = new llvm::Module(moduleID, context);
+            adopt(info[1].As<Napi::Object>());
             return;
         }
     }
     throw Napi::TypeError::New(env, ErrMsg::Class::Module::constructor);
 }
 
+Module::~Module() {
+    free();
+}
+
 llvm::Module *Module::getLLVMPrimitive() {
+    if (module == nullptr) {
+        throw Napi::Error::New(Env(), ErrMsg::Class::Module::disposed);
+    }
     return module;
 }
 
+bool Module::isDisposed() {
+    return module == nullptr;
+}
+
+LLVMContext *Module::getContextWrapper() {
+    if (owner) {
+        return owner;
+    }
+    return module ? LLVMContext::Lookup(Env(), module->getContext()) : nullptr;
+}
+
+bool Module::isLocked() {
+    LLVMContext *context = getContextWrapper();
+    return context != nullptr && context->isLocked();
+}
+
+void Module::adopt(const Napi::Object &context) {
+    owner = LLVMContext::Unwrap(context);
+    ownerRef = Napi::Persistent(context);
+    owner->addModule(this);
+    WrapperCache::Get(Env(), module->getContext()).registerModule(module, Value());
+    updateExternalMemory();
+}
+
+void Module::updateExternalMemory() {
+    if (owner == nullptr) {
+        return;
+    }
+    pendingGrowth = 0;
+    const int64_t footprint = estimateFootprint(*module);
+    if (footprint != externalMemory) {
+        Napi::MemoryManagement::AdjustExternalMemory(Env(), footprint - externalMemory);
+        externalMemory = footprint;
+    }
+}
+
+void Module::noteGrowth(int64_t bytes) {
+    pendingGrowth += bytes;
+    // the estimate walks the whole module, waiting for a geometric growth keeps its cost amortized
+    if (pendingGrowth >= std::max(MinRefreshGrowth, externalMemory / 4)) {
+        updateExternalMemory();
+    }
+}
+
+void Module::detach() {
+    if (owner) {
+        if (externalMemory != 0) {
+            Napi::MemoryManagement::AdjustExternalMemory(Env(), -externalMemory);
+            externalMemory = 0;
+        }
+        WrapperCache &cache = WrapperCache::Get(Env(), module->getContext());
+        // whether it is freed or moved away, what the module contains can no longer be used from its wrappers
+        cache.getState()->invalidate(module);
+        cache.unregisterModule(module);
+        owner->removeModule(this);
+        owner = nullptr;
+        ownerRef.Reset();
+    }
+    module = nullptr;
+}
+
+void Module::free() {
+    llvm::Module *owned = owner ? module : nullptr;
+    detach();
+    delete owned;
+}
+
+void Module::dispose(const Napi::CallbackInfo &info) {
+    if (isLocked()) {
+        throw Napi::Error::New(info.Env(), ErrMsg::Class::LLVMContext::locked);
+    }
+    free();
+}
+
 Napi::Value Module::getModuleIdentifier(const Napi::CallbackInfo &info) {
     const Napi::Env env = info.Env();
     return Napi::String::New(env, module->getModuleIdentifier());
@@ -198,6 +362,26 @@ Napi::Value Module::getGlobalVariable(const Napi::CallbackInfo &info) {
     throw Napi::TypeError::New(env, ErrMsg::Class::Module::getGlobalVariable);
 }
 
+Napi::Value Module::getFunctions(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    Napi::Array functions = Napi::Array::New(env, module->size());
+    uint32_t i = 0;
+    for (llvm::Function &function: *module) {
+        functions.Set(i++, Function::New(env, &function));
+    }
+    return functions;
+}
+
+Napi::Value Module::getGlobalVariables(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    Napi::Array globals = Napi::Array::New(env, module->global_size());
+    uint32_t i = 0;
+    for (llvm::GlobalVariable &global: module->globals()) {
+        globals.Set(i++, GlobalVariable::New(env, &global));
+    }
+    return globals;
+}
+
 void Module::addModuleFlag(const Napi::CallbackInfo &info) {
     const Napi::Env env = info.Env();
     if (info.Length() == 3 && info[0].IsNumber() && info[1].IsString() && info[2].IsNumber()) {
@@ -224,5 +408,236 @@ Napi::Value Module::print(const Napi::CallbackInfo &info) {
     llvm::raw_string_ostream ostream(text);
     module->print(ostream, nullptr);
     ostream.flush();
+    updateExternalMemory();
     return Napi::String::New(env, text);
 }
+
+class PrintModuleWorker : public ContextWorker {
+public:
+    PrintModuleWorker(Napi::Env env, const Napi::Object &moduleObj, llvm::Module *module, LLVMContext *context) :
+            ContextWorker(env, "llvm.Module.printAsync", context), moduleObj(Napi::Persistent(moduleObj)), module(module) {
+    }
+
+protected:
+    void Execute() override {
+        if (isCancelled()) {
+            return;
+        }
+        llvm::raw_string_ostream ostream(text);
+        module->print(ostream, nullptr);
+        ostream.flush();
+    }
+
+    Napi::Value Resolve(Napi::Env env) override {
+        Module::UpdateExternalMemory(moduleObj.Value());
+        return Napi::String::New(env, text);
+    }
+
+private:
+    Napi::ObjectReference moduleObj;
+    const llvm::Module *module;
+    std::string text;
+};
+
+Napi::Value Module::printAsync(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    auto worker = std::make_unique<PrintModuleWorker>(env, Value(), module, getContextWrapper());
+    worker->setCancellation(CancellationToken::FromOptions(env, info[0], ErrMsg::Class::Module::printAsync));
+    return ContextWorker::Start(std::move(worker));
+}
+
+Napi::Value Module::cursor(const Napi::CallbackInfo &info) {
+    return IRCursor::New(info.Env(), Value());
+}
+
+//===----------------------------------------------------------------------===//
+// Criteria of Module.findInstructions, resolved on the JS thread so that
+// matching only reads the IR and may run on several threads at once
+//===----------------------------------------------------------------------===//
+
+struct InstructionQuery {
+    std::optional<unsigned> opcode;
+    std::optional<std::string> calleeName;
+    std::optional<unsigned> typeID;
+    std::optional<unsigned> addressSpace;
+    std::optional<bool> hasMetadata;
+    std::optional<unsigned> metadataKind;
+    std::optional<bool> inEntryBlock;
+    std::optional<std::string> functionName;
+    bool parallel = false;
+
+    bool matches(const llvm::Instruction &inst) const;
+};
+
+static std::optional<unsigned> getOpcodeByName(const std::string &name) {
+    for (unsigned opcode = 1; opcode < llvm::Instruction::OtherOpsEnd; ++opcode) {
+        if (name == llvm::Instruction::getOpcodeName(opcode)) {
+            return opcode;
+        }
+    }
+    return std::nullopt;
+}
+
+static std::optional<unsigned> getPointerAddressSpace(const llvm::Instruction &inst) {
+    if (const auto *load = llvm::dyn_cast<llvm::LoadInst>(&inst)) {
+        return load->getPointerAddressSpace();
+    } else if (const auto *store = llvm::dyn_cast<llvm::StoreInst>(&inst)) {
+        return store->getPointerAddressSpace();
+    } else if (const auto *rmw = llvm::dyn_cast<llvm::AtomicRMWInst>(&inst)) {
+        return rmw->getPointerAddressSpace();
+    } else if (const auto *cmpXchg = llvm::dyn_cast<llvm::AtomicCmpXchgInst>(&inst)) {
+        return cmpXchg->getPointerAddressSpace();
+    } else if (const auto *gep = llvm::dyn_cast<llvm::GetElementPtrInst>(&inst)) {
+        return gep->getPointerAddressSpace();
+    } else if (const auto *alloca = llvm::dyn_cast<llvm::AllocaInst>(&inst)) {
+        return alloca->getAddressSpace();
+    }
+    return std::nullopt;
+}
+
+bool InstructionQuery::matches(const llvm::Instruction &inst) const {
+    if (opcode && inst.getOpcode() != *opcode) {
+        return false;
+    }
+    if (typeID && inst.getType()->getTypeID() != *typeID) {
+        return false;
+    }
+    if (inEntryBlock && inst.getParent()->isEntryBlock() != *inEntryBlock) {
+        return false;
+    }
+    if (calleeName) {
+        const auto *call = llvm::dyn_cast<llvm::CallBase>(&inst);
+        const llvm::Function *callee = call ? call->getCalledFunction() : nullptr;
+        if (callee == nullptr || callee->getName() != *calleeName) {
+            return false;
+        }
+    }
+    if (addressSpace && getPointerAddressSpace(inst) != addressSpace) {
+        return false;
+    }
+    if (hasMetadata && inst.hasMetadata() != *hasMetadata) {
+        return false;
+    }
+    if (metadataKind && inst.getMetadata(*metadataKind) == nullptr) {
+        return false;
+    }
+    return true;
+}
+
+static bool parseInstructionQuery(llvm::LLVMContext &context, const Napi::Object &object, InstructionQuery &query) {
+    const Napi::Value opcode = object.Get("opcode");
+    if (opcode.IsNumber()) {
+        query.opcode = opcode.As<Napi::Number>().Uint32Value();
+    } else if (opcode.IsString()) {
+        query.opcode = getOpcodeByName(opcode.As<Napi::String>());
+        if (!query.opcode) {
+            return false;
+        }
+    } else if (!opcode.IsUndefined()) {
+        return false;
+    }
+    const Napi::Value calleeName = object.Get("calleeName");
+    if (calleeName.IsString()) {
+        query.calleeName = calleeName.As<Napi::String>().Utf8Value();
+    } else if (!calleeName.IsUndefined()) {
+        return false;
+    }
+    const Napi::Value typeID = object.Get("typeID");
+    if (typeID.IsNumber()) {
+        query.typeID = typeID.As<Napi::Number>().Uint32Value();
+    } else if (!typeID.IsUndefined()) {
+        return false;
+    }
+    const Napi::Value addressSpace = object.Get("addressSpace");
+    if (addressSpace.IsNumber()) {
+        query.addressSpace = addressSpace.As<Napi::Number>().Uint32Value();
+    } else if (!addressSpace.IsUndefined()) {
+        return false;
+    }
+    // a metadata kind is looked up here, as registering a new kind would modify the context while matching
+    const Napi::Value hasMetadata = object.Get("hasMetadata");
+    if (hasMetadata.IsBoolean()) {
+        query.hasMetadata = hasMetadata.As<Napi::Boolean>().Value();
+    } else if (hasMetadata.IsString()) {
+        query.metadataKind = context.getMDKindID(hasMetadata.As<Napi::String>().Utf8Value());
+    } else if (!hasMetadata.IsUndefined()) {
+        return false;
+    }
+    const Napi::Value inEntryBlock = object.Get("inEntryBlock");
+    if (inEntryBlock.IsBoolean()) {
+        query.inEntryBlock = inEntryBlock.As<Napi::Boolean>().Value();
+    } else if (!inEntryBlock.IsUndefined()) {
+        return false;
+    }
+    const Napi::Value functionName = object.Get("function");
+    if (functionName.IsString()) {
+        query.functionName = functionName.As<Napi::String>().Utf8Value();
+    } else if (!functionName.IsUndefined()) {
+        return false;
+    }
+    const Napi::Value parallel = object.Get("parallel");
+    if (parallel.IsBoolean()) {
+        query.parallel = parallel.As<Napi::Boolean>().Value();
+    } else if (!parallel.IsUndefined()) {
+        return false;
+    }
+    return true;
+}
+
+static void findInstructionsIn(const llvm::Function &function, const InstructionQuery &query, std::vector<llvm::Instruction *> &found) {
+    for (const llvm::BasicBlock &block : function) {
+        for (const llvm::Instruction &inst : block) {
+            if (query.matches(inst)) {
+                found.push_back(const_cast<llvm::Instruction *>(&inst));
+            }
+        }
+    }
+}
+
+Napi::Value Module::findInstructions(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    InstructionQuery query;
+    if (info.Length() == 0 || !info[0].IsObject() ||
+        !parseInstructionQuery(module->getContext(), info[0].As<Napi::Object>(), query)) {
+        throw Napi::TypeError::New(env, ErrMsg::Class::Module::findInstructions);
+    }
+    std::vector<const llvm::Function *> functions;
+    for (const llvm::Function &function : *module) {
+        if (!function.isDeclaration() && (!query.functionName || function.getName() == *query.functionName)) {
+            functions.push_back(&function);
+        }
+    }
+    // one result list per function, concatenated in module order once all of them are done
+    std::vector<std::vector<llvm::Instruction *>> found(functions.size());
+    const std::size_t numThreads = query.parallel ? std::min<std::size_t>(std::thread::hardware_concurrency(), functions.size()) : 1;
+    if (numThreads > 1) {
+        std::vector<std::thread> threads;
+        threads.reserve(numThreads);
+        for (std::size_t t = 0; t < numThreads; ++t) {
+            threads.emplace_back([&, t]() {
+                for (std::size_t i = t; i < functions.size(); i += numThreads) {
+                    findInstructionsIn(*functions[i], query, found[i]);
+                }
+            });
+        }
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+    } else {
+        for (std::size_t i = 0; i < functions.size(); ++i) {
+            findInstructionsIn(*functions[i], query, found[i]);
+        }
+    }
+    std::size_t numFound = 0;
+    for (const std::vector<llvm::Instruction *> &list : found) {
+        numFound += list.size();
+    }
+    Napi::Array result = Napi::Array::New(env, numFound);
+    uint32_t index = 0;
+    for (const std::vector<llvm::Instruction *> &list : found) {
+        for (llvm::Instruction *inst : list) {
+            result.Set(index++, Instruction::New(env, inst));
+        }
+    }
+    return result;
+}
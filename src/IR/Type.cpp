@@ -103,68 +103,71 @@ void Type::Init(Napi::Env env, Napi::Object &exports) {
             StaticMethod("getInt16PtrTy", &getPointerTypeFactory<&llvm::Type::getInt16PtrTy>),
             StaticMethod("getInt32PtrTy", &getPointerTypeFactory<&llvm::Type::getInt32PtrTy>),
             StaticMethod("getInt64PtrTy", &getPointerTypeFactory<&llvm::Type::getInt64PtrTy>),
-            InstanceMethod("getTypeID", &Type::getTypeID),
-            InstanceMethod("isVoidTy", &Type::isTypeFactory<&llvm::Type::isVoidTy>),
-            InstanceMethod("isHalfTy", &Type::isTypeFactory<&llvm::Type::isHalfTy>),
-            InstanceMethod("isBFloatTy", &Type::isTypeFactory<&llvm::Type::isBFloatTy>),
-            InstanceMethod("isFloatTy", &Type::isTypeFactory<&llvm::Type::isFloatTy>),
-            InstanceMethod("isDoubleTy", &Type::isTypeFactory<&llvm::Type::isDoubleTy>),
-            InstanceMethod("isX86_FP80Ty", &Type::isTypeFactory<&llvm::Type::isX86_FP80Ty>),
-            InstanceMethod("isFP128Ty", &Type::isTypeFactory<&llvm::Type::isFP128Ty>),
-            InstanceMethod("isPPC_FP128Ty", &Type::isTypeFactory<&llvm::Type::isPPC_FP128Ty>),
-            InstanceMethod("isFloatingPointTy", &Type::isTypeFactory<&llvm::Type::isFloatingPointTy>),
-            InstanceMethod("isX86_MMXTy", &Type::isTypeFactory<&llvm::Type::isX86_MMXTy>),
-            InstanceMethod("isLabelTy", &Type::isTypeFactory<&llvm::Type::isLabelTy>),
-            InstanceMethod("isMetadataTy", &Type::isTypeFactory<&llvm::Type::isMetadataTy>),
-            InstanceMethod("isTokenTy", &Type::isTypeFactory<&llvm::Type::isTokenTy>),
-            InstanceMethod("isIntegerTy", &Type::isIntegerTy),
-            InstanceMethod("isFunctionTy", &Type::isTypeFactory<&llvm::Type::isFunctionTy>),
-            InstanceMethod("isStructTy", &Type::isTypeFactory<&llvm::Type::isStructTy>),
-            InstanceMethod("isArrayTy", &Type::isTypeFactory<&llvm::Type::isArrayTy>),
-            InstanceMethod("isPointerTy", &Type::isTypeFactory<&llvm::Type::isPointerTy>),
-            InstanceMethod("isVectorTy", &Type::isTypeFactory<&llvm::Type::isVectorTy>),
-            InstanceMethod("isEmptyTy", &Type::isTypeFactory<&llvm::Type::isEmptyTy>),
-            InstanceMethod("isFirstClassType", &Type::isTypeFactory<&llvm::Type::isFirstClassType>),
-            InstanceMethod("isSingleValueType", &Type::isTypeFactory<&llvm::Type::isSingleValueType>),
-            InstanceMethod("isAggregateType", &Type::isTypeFactory<&llvm::Type::isAggregateType>),
-            InstanceMethod("getPointerTo", &Type::getPointerTo),
-            InstanceMethod("getPrimitiveSizeInBits", &Type::getPrimitiveSizeInBits),
+            InstanceMethod("getTypeID", &Type::guarded<&Type::getTypeID>),
+            InstanceMethod("isVoidTy", &Type::guarded<&Type::isTypeFactory<&llvm::Type::isVoidTy>>),
+            InstanceMethod("isHalfTy", &Type::guarded<&Type::isTypeFactory<&llvm::Type::isHalfTy>>),
+            InstanceMethod("isBFloatTy", &Type::guarded<&Type::isTypeFactory<&llvm::Type::isBFloatTy>>),
+            InstanceMethod("isFloatTy", &Type::guarded<&Type::isTypeFactory<&llvm::Type::isFloatTy>>),
+            InstanceMethod("isDoubleTy", &Type::guarded<&Type::isTypeFactory<&llvm::Type::isDoubleTy>>),
+            InstanceMethod("isX86_FP80Ty", &Type::guarded<&Type::isTypeFactory<&llvm::Type::isX86_FP80Ty>>),
+            InstanceMethod("isFP128Ty", &Type::guarded<&Type::isTypeFactory<&llvm::Type::isFP128Ty>>),
+            InstanceMethod("isPPC_FP128Ty", &Type::guarded<&Type::isTypeFactory<&llvm::Type::isPPC_FP128Ty>>),
+            InstanceMethod("isFloatingPointTy", &Type::guarded<&Type::isTypeFactory<&llvm::Type::isFloatingPointTy>>),
+            InstanceMethod("isX86_MMXTy", &Type::guarded<&Type::isTypeFactory<&llvm::Type::isX86_MMXTy>>),
+            InstanceMethod("isLabelTy", &Type::guarded<&Type::isTypeFactory<&llvm::Type::isLabelTy>>),
+            InstanceMethod("isMetadataTy", &Type::guarded<&Type::isTypeFactory<&llvm::Type::isMetadataTy>>),
+            InstanceMethod("isTokenTy", &Type::guarded<&Type::isTypeFactory<&llvm::Type::isTokenTy>>),
+            InstanceMethod("isIntegerTy", &Type::guarded<&Type::isIntegerTy>),
+            InstanceMethod("isFunctionTy", &Type::guarded<&Type::isTypeFactory<&llvm::Type::isFunctionTy>>),
+            InstanceMethod("isStructTy", &Type::guarded<&Type::isTypeFactory<&llvm::Type::isStructTy>>),
+            InstanceMethod("isArrayTy", &Type::guarded<&Type::isTypeFactory<&llvm::Type::isArrayTy>>),
+            InstanceMethod("isPointerTy", &Type::guarded<&Type::isTypeFactory<&llvm::Type::isPointerTy>>),
+            InstanceMethod("isVectorTy", &Type::guarded<&Type::isTypeFactory<&llvm::Type::isVectorTy>>),
+            InstanceMethod("isEmptyTy", &Type::guarded<&Type::isTypeFactory<&llvm::Type::isEmptyTy>>),
+            InstanceMethod("isFirstClassType", &Type::guarded<&Type::isTypeFactory<&llvm::Type::isFirstClassType>>),
+            InstanceMethod("isSingleValueType", &Type::guarded<&Type::isTypeFactory<&llvm::Type::isSingleValueType>>),
+            InstanceMethod("isAggregateType", &Type::guarded<&Type::isTypeFactory<&llvm::Type::isAggregateType>>),
+            InstanceMethod("getPointerTo", &Type::guarded<&Type::getPointerTo>),
+            InstanceMethod("getPrimitiveSizeInBits", &Type::guarded<&Type::getPrimitiveSizeInBits>),
             StaticMethod("isSameType", &Type::isSameType)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
+    constructor.Reset(env, func);
     exports.Set("Type", func);
 }
 
 Napi::Object Type::New(Napi::Env env, llvm::Type *type) {
-    if (type->isIntegerTy()) {
-        return IntegerType::New(env, llvm::cast<llvm::IntegerType>(type));
-    } else if (type->isFunctionTy()) {
-        return FunctionType::New(env, llvm::cast<llvm::FunctionType>(type));
-    } else if (type->isStructTy()) {
-        return StructType::New(env, llvm::cast<llvm::StructType>(type));
-    } else if (type->isArrayTy()) {
-        return ArrayType::New(env, llvm::cast<llvm::ArrayType>(type));
-    } else if (type->isVectorTy()) {
-        return VectorType::New(env, llvm::cast<llvm::VectorType>(type));
-    } else if (type->isPointerTy()) {
-        return PointerType::New(env, llvm::cast<llvm::PointerType>(type));
+    switch (type->getTypeID()) {
+        case llvm::Type::IntegerTyID:
+            return IntegerType::New(env, llvm::cast<llvm::IntegerType>(type));
+        case llvm::Type::FunctionTyID:
+            return FunctionType::New(env, llvm::cast<llvm::FunctionType>(type));
+        case llvm::Type::StructTyID:
+            return StructType::New(env, llvm::cast<llvm::StructType>(type));
+        case llvm::Type::ArrayTyID:
+            return ArrayType::New(env, llvm::cast<llvm::ArrayType>(type));
+        case llvm::Type::FixedVectorTyID:
+        case llvm::Type::ScalableVectorTyID:
+            return VectorType::New(env, llvm::cast<llvm::VectorType>(type));
+        case llvm::Type::PointerTyID:
+            return PointerType::New(env, llvm::cast<llvm::PointerType>(type));
+        default:
+            return wrapCached<Type>(env, type);
     }
-    return constructor.New({Napi::External<llvm::Type>::New(env, type)});
 }
 
 bool Type::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || hasTypeTag(value, TypeTag::Type);
 }
 
 llvm::Type *Type::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::Type, llvm::Type>(value);
 }
 
 Type::Type(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Type, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::Type::constructor);
@@ -4,38 +4,34 @@
 void User::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "User", {
-            InstanceMethod("getOperand", &User::getOperand),
-            InstanceMethod("setOperand", &User::setOperand),
-            InstanceMethod("getNumOperands", &User::getNumOperands),
-            InstanceMethod("getType", &User::getType)
+            InstanceMethod("getOperand", &User::guarded<&User::getOperand>),
+            InstanceMethod("setOperand", &User::guardedVoid<&User::setOperand>),
+            InstanceMethod("getNumOperands", &User::guarded<&User::getNumOperands>),
+            InstanceMethod("getOperands", &User::guarded<&User::getOperands>),
+            InstanceMethod("getType", &User::guarded<&User::getType>)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    Inherit(env, constructor.Value(), Value::constructor.Value());
+    constructor.Reset(env, func);
+    Inherit(env, constructor.Value(env), Value::constructor.Value(env));
     exports.Set("User", func);
 }
 
 Napi::Value User::New(Napi::Env env, llvm::User *user) {
-    if (llvm::isa<llvm::Constant>(user)) {
-        return Constant::New(env, llvm::cast<llvm::Constant>(user));
-    } else if (llvm::isa<llvm::Instruction>(user)) {
-        return Instruction::New(env, llvm::cast<llvm::Instruction>(user));
-    }
-    return constructor.New({Napi::External<llvm::User>::New(env, user)});
+    return Value::New(env, user);
 }
 
 bool User::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || isKindOf<llvm::User, llvm::Value>(value, TypeTag::Value);
 }
 
 llvm::User *User::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::User, llvm::Value>(value);
 }
 
 User::User(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::User::constructor);
@@ -74,6 +70,16 @@ Napi::Value User::getNumOperands(const Napi::CallbackInfo &info) {
     return Napi::Number::New(env, num);
 }
 
+Napi::Value User::getOperands(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    Napi::Array operands = Napi::Array::New(env, user->getNumOperands());
+    uint32_t i = 0;
+    for (llvm::Value *operand: user->operand_values()) {
+        operands.Set(i++, operand ? Value::New(env, operand) : env.Null());
+    }
+    return operands;
+}
+
 Napi::Value User::getType(const Napi::CallbackInfo &info) {
     const Napi::Env env = info.Env();
     llvm::Type *type = user->getType();
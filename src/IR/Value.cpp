@@ -4,46 +4,174 @@
 void Value::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "Value", {
-            InstanceMethod("hasName", &Value::hasName),
-            InstanceMethod("getType", &Value::getType),
-            InstanceMethod("getName", &Value::getName),
-            InstanceMethod("setName", &Value::setName),
-            InstanceMethod("release", &Value::deleteValue),
-            InstanceMethod("deleteValue", &Value::deleteValue),
-            InstanceMethod("replaceAllUsesWith", &Value::replaceAllUsesWith),
-            InstanceMethod("use_empty", &Value::useEmpty),
-            InstanceMethod("user_empty", &Value::userEmpty),
+            InstanceMethod("hasName", &Value::guarded<&Value::hasName>),
+            InstanceMethod("getType", &Value::guarded<&Value::getType>),
+            InstanceMethod("getName", &Value::guarded<&Value::getName>),
+            InstanceMethod("setName", &Value::guardedVoid<&Value::setName>),
+            InstanceMethod("release", &Value::guardedVoid<&Value::deleteValue>),
+            InstanceMethod("deleteValue", &Value::guardedVoid<&Value::deleteValue>),
+            InstanceMethod("replaceAllUsesWith", &Value::guardedVoid<&Value::replaceAllUsesWith>),
+            InstanceMethod("use_empty", &Value::guarded<&Value::useEmpty>),
+            InstanceMethod("user_empty", &Value::guarded<&Value::userEmpty>),
+            InstanceMethod("getUsers", &Value::guarded<&Value::getUsers>),
             StaticValue("MaxAlignmentExponent", Napi::Number::New(env, llvm::Value::MaxAlignmentExponent)),
             StaticValue("MaximumAlignment", Napi::Number::New(env, llvm::Value::MaximumAlignment))
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
+    constructor.Reset(env, func);
     exports.Set("Value", func);
 }
 
 Napi::Value Value::New(Napi::Env env, llvm::Value *value) {
-    if (llvm::isa<llvm::Argument>(value)) {
-        return Argument::New(env, llvm::cast<llvm::Argument>(value));
-    } else if (llvm::isa<llvm::BasicBlock>(value)) {
-        return BasicBlock::New(env, llvm::cast<llvm::BasicBlock>(value));
+    switch (value->getValueID()) {
+        case llvm::Value::ArgumentVal:
+            return Argument::New(env, llvm::cast<llvm::Argument>(value));
+        case llvm::Value::BasicBlockVal:
+            return BasicBlock::New(env, llvm::cast<llvm::BasicBlock>(value));
+        case llvm::Value::FunctionVal:
+            return Function::New(env, llvm::cast<llvm::Function>(value));
+        case llvm::Value::GlobalVariableVal:
+            return GlobalVariable::New(env, llvm::cast<llvm::GlobalVariable>(value));
+        case llvm::Value::GlobalIFuncVal:
+            return wrapCached<GlobalObject>(env, llvm::cast<llvm::GlobalObject>(value));
+        case llvm::Value::GlobalAliasVal:
+            return wrapCached<GlobalValue>(env, llvm::cast<llvm::GlobalValue>(value));
+        case llvm::Value::ConstantIntVal:
+            return ConstantInt::New(env, llvm::cast<llvm::ConstantInt>(value));
+        case llvm::Value::ConstantFPVal:
+            return ConstantFP::New(env, llvm::cast<llvm::ConstantFP>(value));
+        case llvm::Value::ConstantArrayVal:
+            return ConstantArray::New(env, llvm::cast<llvm::ConstantArray>(value));
+        case llvm::Value::ConstantStructVal:
+            return ConstantStruct::New(env, llvm::cast<llvm::ConstantStruct>(value));
+        case llvm::Value::ConstantPointerNullVal:
+            return ConstantPointerNull::New(env, llvm::cast<llvm::ConstantPointerNull>(value));
+        case llvm::Value::ConstantDataArrayVal:
+            return ConstantDataArray::New(env, llvm::cast<llvm::ConstantDataArray>(value));
+        case llvm::Value::ConstantDataVectorVal:
+            return ConstantDataVector::New(env, llvm::cast<llvm::ConstantDataVector>(value));
+        case llvm::Value::ConstantExprVal:
+            return ConstantExpr::New(env, llvm::cast<llvm::ConstantExpr>(value));
+        case llvm::Value::UndefValueVal:
+        case llvm::Value::PoisonValueVal:
+            return UndefValue::New(env, llvm::cast<llvm::UndefValue>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::Ret:
+            return ReturnInst::New(env, llvm::cast<llvm::ReturnInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::Br:
+            return BranchInst::New(env, llvm::cast<llvm::BranchInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::Switch:
+            return SwitchInst::New(env, llvm::cast<llvm::SwitchInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::IndirectBr:
+            return IndirectBrInst::New(env, llvm::cast<llvm::IndirectBrInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::Invoke:
+            return InvokeInst::New(env, llvm::cast<llvm::InvokeInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::Resume:
+            return ResumeInst::New(env, llvm::cast<llvm::ResumeInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::Unreachable:
+            return UnreachableInst::New(env, llvm::cast<llvm::UnreachableInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::CleanupRet:
+            return CleanupReturnInst::New(env, llvm::cast<llvm::CleanupReturnInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::CatchRet:
+            return CatchReturnInst::New(env, llvm::cast<llvm::CatchReturnInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::CatchSwitch:
+            return CatchSwitchInst::New(env, llvm::cast<llvm::CatchSwitchInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::CallBr:
+            return CallBrInst::New(env, llvm::cast<llvm::CallBrInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::Alloca:
+            return AllocaInst::New(env, llvm::cast<llvm::AllocaInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::Load:
+            return LoadInst::New(env, llvm::cast<llvm::LoadInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::Store:
+            return StoreInst::New(env, llvm::cast<llvm::StoreInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::GetElementPtr:
+            return GetElementPtrInst::New(env, llvm::cast<llvm::GetElementPtrInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::Fence:
+            return FenceInst::New(env, llvm::cast<llvm::FenceInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::AtomicCmpXchg:
+            return AtomicCmpXchgInst::New(env, llvm::cast<llvm::AtomicCmpXchgInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::AtomicRMW:
+            return AtomicRMWInst::New(env, llvm::cast<llvm::AtomicRMWInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::Trunc:
+            return TruncInst::New(env, llvm::cast<llvm::TruncInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::ZExt:
+            return ZExtInst::New(env, llvm::cast<llvm::ZExtInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::SExt:
+            return SExtInst::New(env, llvm::cast<llvm::SExtInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::FPToUI:
+            return FPToUIInst::New(env, llvm::cast<llvm::FPToUIInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::FPToSI:
+            return FPToSIInst::New(env, llvm::cast<llvm::FPToSIInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::UIToFP:
+            return UIToFPInst::New(env, llvm::cast<llvm::UIToFPInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::SIToFP:
+            return SIToFPInst::New(env, llvm::cast<llvm::SIToFPInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::FPTrunc:
+            return FPTruncInst::New(env, llvm::cast<llvm::FPTruncInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::FPExt:
+            return FPExtInst::New(env, llvm::cast<llvm::FPExtInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::PtrToInt:
+            return PtrToIntInst::New(env, llvm::cast<llvm::PtrToIntInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::IntToPtr:
+            return IntToPtrInst::New(env, llvm::cast<llvm::IntToPtrInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::BitCast:
+            return BitCastInst::New(env, llvm::cast<llvm::BitCastInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::AddrSpaceCast:
+            return AddrSpaceCastInst::New(env, llvm::cast<llvm::AddrSpaceCastInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::CleanupPad:
+            return CleanupPadInst::New(env, llvm::cast<llvm::CleanupPadInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::CatchPad:
+            return CatchPadInst::New(env, llvm::cast<llvm::CatchPadInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::ICmp:
+            return ICmpInst::New(env, llvm::cast<llvm::ICmpInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::FCmp:
+            return FCmpInst::New(env, llvm::cast<llvm::FCmpInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::PHI:
+            return PHINode::New(env, llvm::cast<llvm::PHINode>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::Call:
+            return CallInst::New(env, llvm::cast<llvm::CallInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::Select:
+            return SelectInst::New(env, llvm::cast<llvm::SelectInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::VAArg:
+            return VAArgInst::New(env, llvm::cast<llvm::VAArgInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::ExtractElement:
+            return ExtractElementInst::New(env, llvm::cast<llvm::ExtractElementInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::InsertElement:
+            return InsertElementInst::New(env, llvm::cast<llvm::InsertElementInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::ShuffleVector:
+            return ShuffleVectorInst::New(env, llvm::cast<llvm::ShuffleVectorInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::ExtractValue:
+            return ExtractValueInst::New(env, llvm::cast<llvm::ExtractValueInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::InsertValue:
+            return InsertValueInst::New(env, llvm::cast<llvm::InsertValueInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::LandingPad:
+            return LandingPadInst::New(env, llvm::cast<llvm::LandingPadInst>(value));
+        case llvm::Value::InstructionVal + llvm::Instruction::Freeze:
+            return FreezeInst::New(env, llvm::cast<llvm::FreezeInst>(value));
+        default:
+            break;
+    }
+    if (llvm::isa<llvm::Instruction>(value)) {
+        return wrapCached<Instruction>(env, llvm::cast<llvm::Instruction>(value));
+    } else if (llvm::isa<llvm::Constant>(value)) {
+        return wrapCached<Constant>(env, llvm::cast<llvm::Constant>(value));
     } else if (llvm::isa<llvm::User>(value)) {
-        return User::New(env, llvm::cast<llvm::User>(value));
+        return wrapCached<User>(env, llvm::cast<llvm::User>(value));
     }
-    return constructor.New({Napi::External<llvm::Value>::New(env, value)});
+    return wrapCached<Value>(env, value);
 }
 
 bool Value::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || hasTypeTag(value, TypeTag::Value);
 }
 
 llvm::Value *Value::Extract(const Napi::Value &value) {
     if (value.IsNull()) {
         return nullptr;
     }
-    return Unwrap(value.As<Napi::Object>())->getLLVMPrimitive();
+    return extractKind<llvm::Value, llvm::Value>(value);
 }
 
 Value::Value(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::Value, this);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall() || info.Length() == 0 || !info[0].IsExternal()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::Value::constructor);
@@ -82,6 +210,7 @@ void Value::setName(const Napi::CallbackInfo &info) {
 }
 
 void Value::deleteValue(const Napi::CallbackInfo &info) {
+    invalidateTree(value);
     value->deleteValue();
 }
 
@@ -101,3 +230,13 @@ Napi::Value Value::useEmpty(const Napi::CallbackInfo &info) {
 Napi::Value Value::userEmpty(const Napi::CallbackInfo &info) {
     return Napi::Boolean::New(info.Env(), value->user_empty());
 }
+
+Napi::Value Value::getUsers(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    Napi::Array users = Napi::Array::New(env, value->getNumUses());
+    uint32_t i = 0;
+    for (llvm::User *user: value->users()) {
+        users.Set(i++, Value::New(env, user));
+    }
+    return users;
+}
@@ -18,11 +18,66 @@ static Napi::Value verifyModule(const Napi::CallbackInfo &info) {
     }
     const llvm::Module *module = Module::Extract(info[0]);
     const bool result = llvm::verifyModule(*module, &llvm::errs());
+    Module::UpdateExternalMemory(info[0]);
     return Napi::Boolean::New(env, result);
 }
 
+bool Verifier::verifyModuleCancellable(const llvm::Module &module, llvm::raw_ostream *stream,
+                                       const CancellationToken &token) {
+    if (!token.isActive()) {
+        return llvm::verifyModule(module, stream);
+    }
+    for (const llvm::Function &func: module) {
+        if (token.isCancelled()) {
+            return false;
+        }
+        if (!func.isDeclaration() && llvm::verifyFunction(func, stream)) {
+            return true;
+        }
+    }
+    // LLVM has no entry point for the module-level checks alone, the function bodies are checked a second time
+    return !token.isCancelled() && llvm::verifyModule(module, stream);
+}
+
+class VerifyModuleWorker : public ContextWorker {
+public:
+    VerifyModuleWorker(Napi::Env env, const Napi::Object &moduleObj, Module *wrapper) :
+            ContextWorker(env, "llvm.verifyModuleAsync", wrapper->getContextWrapper()),
+            moduleObj(Napi::Persistent(moduleObj)),
+            module(wrapper->getLLVMPrimitive()) {
+    }
+
+protected:
+    void Execute() override {
+        broken = Verifier::verifyModuleCancellable(*module, &llvm::errs(), getCancellation());
+        // the result of an interrupted verification is discarded
+        isCancelled();
+    }
+
+    Napi::Value Resolve(Napi::Env env) override {
+        Module::UpdateExternalMemory(moduleObj.Value());
+        return Napi::Boolean::New(env, broken);
+    }
+
+private:
+    Napi::ObjectReference moduleObj;
+    const llvm::Module *module;
+    bool broken = false;
+};
+
+static Napi::Value verifyModuleAsync(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    if (info.Length() == 0 || !info[0].IsObject() || !Module::IsClassOf(info[0])) {
+        throw Napi::TypeError::New(env, ErrMsg::Function::verifyModuleAsync);
+    }
+    const auto moduleObj = info[0].As<Napi::Object>();
+    auto worker = std::make_unique<VerifyModuleWorker>(env, moduleObj, Module::Unwrap(moduleObj));
+    worker->setCancellation(CancellationToken::FromOptions(env, info[1], ErrMsg::Function::verifyModuleAsync));
+    return ContextWorker::Start(std::move(worker));
+}
 
 void Verifier::Init(Napi::Env env, Napi::Object &exports) {
     exports.Set("verifyFunction", Napi::Function::New(env, verifyFunction));
     exports.Set("verifyModule", Napi::Function::New(env, verifyModule));
+    exports.Set("verifyModuleAsync", Napi::Function::New(env, verifyModuleAsync));
 }
@@ -22,6 +22,7 @@ void InitIR(Napi::Env env, Napi::Object &exports) {
     ConstantStruct::Init(env, exports);
     ConstantPointerNull::Init(env, exports);
     ConstantDataArray::Init(env, exports);
+    ConstantDataVector::Init(env, exports);
     ConstantExpr::Init(env, exports);
     UndefValue::Init(env, exports);
     GlobalValue::Init(env, exports);
@@ -77,6 +78,7 @@ void InitIR(Napi::Env env, Napi::Object &exports) {
     AddrSpaceCastInst::Init(env, exports);
     FreezeInst::Init(env, exports);
     IRBuilder::Init(env, exports);
+    IRCursor::Init(env, exports);
     Metadata::Init(env, exports);
     MDNode::Init(env, exports);
     LLVMConstants::Init(env, exports);
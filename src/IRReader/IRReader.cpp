@@ -5,15 +5,64 @@
 
 Napi::Value parseIRFile(const Napi::CallbackInfo &info) {
     const Napi::Env env = info.Env();
-    if (info.Length() < 3 ||
-        !info[0].IsString() ||
-        !SMDiagnostic::IsClassOf(info[2]) ||
-        !LLVMContext::IsClassOf(info[2])) {
+    if (info.Length() >= 3 &&
+        info[0].IsString() &&
+        SMDiagnostic::IsClassOf(info[1]) &&
+        LLVMContext::IsClassOf(info[2])) {
         const std::string filename = info[0].As<Napi::String>();
         llvm::SMDiagnostic &err = SMDiagnostic::Extract(info[1]);
         llvm::LLVMContext &context = LLVMContext::Extract(info[2]);
-        llvm::Module *module = llvm::parseIRFile(filename, err, context).release();
-        return Module::New(env, module);
+        std::unique_ptr<llvm::Module> module = llvm::parseIRFile(filename, err, context);
+        if (!module) {
+            return env.Null();
+        }
+        return Module::New(env, std::move(module), info[2].As<Napi::Object>());
     }
     throw Napi::TypeError::New(env, ErrMsg::Function::parseIRFile);
 }
+
+class ParseIRFileWorker : public ContextWorker {
+public:
+    ParseIRFileWorker(const Napi::CallbackInfo &info, LLVMContext *context) :
+            ContextWorker(info.Env(), "llvm.parseIRFileAsync", context),
+            filename(info[0].As<Napi::String>()),
+            err(SMDiagnostic::Extract(info[1])),
+            llvmContext(context->getLLVMPrimitive()),
+            contextObj(Napi::Persistent(info[2].As<Napi::Object>())) {
+        keepAlive(info[1]);
+    }
+
+protected:
+    void Execute() override {
+        if (isCancelled()) {
+            return;
+        }
+        module = llvm::parseIRFile(filename, err, llvmContext);
+    }
+
+    Napi::Value Resolve(Napi::Env env) override {
+        if (!module) {
+            return env.Null();
+        }
+        return Module::New(env, std::move(module), contextObj.Value());
+    }
+
+private:
+    std::string filename;
+    llvm::SMDiagnostic &err;
+    llvm::LLVMContext &llvmContext;
+    Napi::ObjectReference contextObj;
+    std::unique_ptr<llvm::Module> module;
+};
+
+Napi::Value parseIRFileAsync(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    if (info.Length() < 3 || !info[0].IsString() || !info[1].IsObject() || !SMDiagnostic::IsClassOf(info[1]) ||
+        !info[2].IsObject() || !LLVMContext::IsClassOf(info[2])) {
+        throw Napi::TypeError::New(env, ErrMsg::Function::parseIRFileAsync);
+    }
+    LLVMContext *context = LLVMContext::Unwrap(info[2].As<Napi::Object>());
+    auto worker = std::make_unique<ParseIRFileWorker>(info, context);
+    worker->setCancellation(CancellationToken::FromOptions(env, info[3], ErrMsg::Function::parseIRFileAsync));
+    return ContextWorker::Start(std::move(worker));
+}
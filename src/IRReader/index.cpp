@@ -2,4 +2,5 @@
 
 void InitIRReader(Napi::Env env, Napi::Object &exports) {
     exports.Set("parseIRFile", Napi::Function::New(env, parseIRFile));
+    exports.Set("parseIRFileAsync", Napi::Function::New(env, parseIRFileAsync));
 }
@@ -8,26 +8,39 @@ void Linker::Init(Napi::Env env, Napi::Object &exports) {
             InstanceMethod("linkInModule", &Linker::linkInModule),
             StaticMethod("linkModules", &Linker::linkModules),
     });
-    constructor = Persistent(func);
-    constructor.SuppressDestruct();
+    constructor.Reset(env, func);
     exports.Set("Linker", func);
 }
 
 Linker::Linker(const Napi::CallbackInfo &info) : ObjectWrap(info) {
     const Napi::Env env = info.Env();
-    if (info.IsConstructCall() && info.Length() == 1 && Module::IsClassOf(info[0])) {
+    if (info.IsConstructCall() && info.Length() == 1 && Module::IsClassOf(info[0]) && info[0].IsObject()) {
+        if (Module::Unwrap(info[0].As<Napi::Object>())->isDisposed()) {
+            throw Napi::Error::New(env, ErrMsg::Class::Module::disposed);
+        }
         llvm::Module &module = *Module::Extract(info[0]);
         linker = new llvm::Linker(module);
+        destRef = Napi::Persistent(info[0].As<Napi::Object>());
         return;
     }
     throw Napi::TypeError::New(env, ErrMsg::Class::Linker::constructor);
 }
 
+Linker::~Linker() {
+    delete linker;
+}
+
 Napi::Value Linker::linkInModule(const Napi::CallbackInfo &info) {
     const Napi::Env env = info.Env();
-    if (info.Length() == 2 && Module::IsClassOf(info[0])) {
-        llvm::Module *srcModule = Module::Extract(info[0]);
-        const bool failed = linker->linkInModule(std::unique_ptr<llvm::Module>(srcModule));
+    if (info.Length() == 1 && Module::IsClassOf(info[0]) && info[0].IsObject()) {
+        // the linker refers to the destination module, which may have been disposed since
+        if (Module::Unwrap(destRef.Value())->isDisposed()) {
+            throw Napi::Error::New(env, ErrMsg::Class::Module::disposed);
+        }
+        // the source module is consumed by the linker
+        std::unique_ptr<llvm::Module> srcModule = Module::Release(info[0]);
+        const bool failed = linker->linkInModule(std::move(srcModule));
+        Module::UpdateExternalMemory(destRef.Value());
         return Napi::Boolean::New(env, failed);
     }
     throw Napi::TypeError::New(env, ErrMsg::Class::Linker::linkInModule);
@@ -35,10 +48,12 @@ Napi::Value Linker::linkInModule(const Napi::CallbackInfo &info) {
 
 Napi::Value Linker::linkModules(const Napi::CallbackInfo &info) {
     const Napi::Env env = info.Env();
-    if (info.Length() == 2 && Module::IsClassOf(info[0]) && Module::IsClassOf(info[1])) {
+    if (info.Length() == 2 && Module::IsClassOf(info[0]) && info[0].IsObject() &&
+        Module::IsClassOf(info[1]) && info[1].IsObject()) {
         llvm::Module &destModule = *Module::Extract(info[0]);
-        llvm::Module *srcModule = Module::Extract(info[1]);
-        const bool failed = llvm::Linker::linkModules(destModule, std::unique_ptr<llvm::Module>(srcModule));
+        std::unique_ptr<llvm::Module> srcModule = Module::Release(info[1]);
+        const bool failed = llvm::Linker::linkModules(destModule, std::move(srcModule));
+        Module::UpdateExternalMemory(info[0]);
         return Napi::Boolean::New(env, failed);
     }
     throw Napi::TypeError::New(env, ErrMsg::Class::Linker::linkModules);
@@ -1,5 +1,6 @@
 #include "MC/index.h"
 #include "Target/index.h"
+#include "Support/index.h"
 #include "Util/index.h"
 
 //===----------------------------------------------------------------------===//
@@ -13,13 +14,12 @@ void Target::Init(Napi::Env env, Napi::Object &exports) {
             InstanceMethod("getName", &Target::getName),
             InstanceMethod("getShortDescription", &Target::getShortDescription)
     });
-    constructor = Persistent(func);
-    constructor.SuppressDestruct();
+    constructor.Reset(env, func);
     exports.Set("Target", func);
 }
 
 Napi::Object Target::New(Napi::Env env, llvm::Target *target) {
-    return constructor.New({Napi::External<llvm::Target>::New(env, target)});
+    return constructor.New(env, {Napi::External<llvm::Target>::New(env, target)});
 }
 
 Target::Target(const Napi::CallbackInfo &info) : Napi::ObjectWrap<Target>{info} {
@@ -35,17 +35,20 @@ Target::Target(const Napi::CallbackInfo &info) : Napi::ObjectWrap<Target>{info}
 Napi::Value Target::createTargetMachine(const Napi::CallbackInfo &info) {
     const Napi::Env env = info.Env();
     const unsigned argsLen = info.Length();
-    if (argsLen < 2 || !info[0].IsString() || !info[1].IsString() || argsLen >= 3 && !info[2].IsString()) {
+    TargetMachineOptions machineOptions;
+    if (argsLen < 2 || !info[0].IsString() || !info[1].IsString() ||
+        (argsLen >= 3 && !info[2].IsString() && !info[2].IsUndefined()) || !machineOptions.parse(info[3])) {
         throw Napi::TypeError::New(env, ErrMsg::Class::Target::createTargetMachine);
     }
     const std::string targetTriple = info[0].As<Napi::String>();
     const std::string cpu = info[1].As<Napi::String>();
     std::string features;
-    if (argsLen >= 3) {
+    if (argsLen >= 3 && info[2].IsString()) {
         features = info[2].As<Napi::String>();
     }
-    const llvm::TargetOptions options{};
-    llvm::TargetMachine *targetMachinePtr = target->createTargetMachine(targetTriple, cpu, features, options, llvm::Optional<llvm::Reloc::Model>{});
+    llvm::TargetMachine *targetMachinePtr = target->createTargetMachine(
+            targetTriple, cpu, features, machineOptions.options, machineOptions.relocModel, machineOptions.codeModel,
+            machineOptions.optLevel, machineOptions.jit);
     return TargetMachine::New(env, targetMachinePtr);
 }
 
@@ -81,8 +84,31 @@ static Napi::Value lookupTarget(const Napi::CallbackInfo &info) {
     throw Napi::TypeError::New(env, ErrMsg::Class::TargetRegistry::lookupTarget);
 }
 
+// a machine for the running process, with the CPU and the features detected on the host
+static Napi::Value createNativeTargetMachine(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    TargetMachineOptions machineOptions;
+    if (info.Length() > 1 || !machineOptions.parse(info[0])) {
+        throw Napi::TypeError::New(env, ErrMsg::Function::createNativeTargetMachine);
+    }
+    const std::string triple = llvm::sys::getProcessTriple();
+    if (!InitializeNativeCodeGen()) {
+        throw Napi::Error::New(env, ErrMsg::Function::nativeTargetUnavailable + triple);
+    }
+    std::string error;
+    const llvm::Target *target = llvm::TargetRegistry::lookupTarget(triple, error);
+    if (!target) {
+        throw Napi::Error::New(env, ErrMsg::Function::nativeTargetUnavailable + error);
+    }
+    llvm::TargetMachine *targetMachinePtr = target->createTargetMachine(
+            triple, llvm::sys::getHostCPUName(), sys::getHostCPUFeatureString(), machineOptions.options,
+            machineOptions.relocModel, machineOptions.codeModel, machineOptions.optLevel, machineOptions.jit);
+    return TargetMachine::New(env, targetMachinePtr);
+}
+
 void InitTargetRegistry(Napi::Env env, Napi::Object &exports) {
     const Napi::Object targetRegistryNS = Napi::Object::New(env);
     targetRegistryNS.Set("lookupTarget", Napi::Function::New(env, lookupTarget));
     exports.Set("TargetRegistry", targetRegistryNS);
+    exports.Set("createNativeTargetMachine", Napi::Function::New(env, createNativeTargetMachine));
 }
@@ -0,0 +1,188 @@
+#include <optional>
+#include <unordered_map>
+#include <llvm/Analysis/CGSCCPassManager.h>
+#include <llvm/Analysis/LoopAnalysisManager.h>
+#include <llvm/IR/PassManager.h>
+#include <llvm/IR/ValueHandle.h>
+#include "Passes/index.h"
+#include "IR/index.h"
+#include "Target/index.h"
+#include "Util/index.h"
+
+// drops the cached results of a function once it is deleted, so that a function later allocated at the same
+// address does not inherit them
+class CachedFunctionHandle final : public llvm::CallbackVH {
+public:
+    CachedFunctionHandle(llvm::Function *function, llvm::FunctionAnalysisManager &analyses)
+            : CallbackVH(function), analyses(analyses) {
+    }
+
+    void deleted() override {
+        auto *function = llvm::cast<llvm::Function>(getValPtr());
+        analyses.clear(*function, function->getName());
+        setValPtr(nullptr);
+    }
+
+    bool isDeleted() const {
+        return getValPtr() == nullptr;
+    }
+
+private:
+    llvm::FunctionAnalysisManager &analyses;
+};
+
+struct FunctionPassManager::State {
+    // registered once with the analysis managers, and forwarded to the recorder of the current run if any
+    llvm::PassInstrumentationCallbacks callbacks;
+    PassRecorder *recorder = nullptr;
+    const CancellationToken *cancellation = nullptr;
+
+    // registered analyses refer to the builder, so it is destroyed after them
+    llvm::PassBuilder builder;
+
+    // declared in this order so that they are destroyed in the reverse one
+    llvm::LoopAnalysisManager loopAnalyses;
+    llvm::FunctionAnalysisManager functionAnalyses;
+    llvm::CGSCCAnalysisManager cgsccAnalyses;
+    llvm::ModuleAnalysisManager moduleAnalyses;
+
+    llvm::FunctionPassManager passManager;
+
+    std::unordered_map<const llvm::Function *, std::unique_ptr<CachedFunctionHandle>> handles;
+
+    State(llvm::TargetMachine *machine, const llvm::PipelineTuningOptions &tuningOptions)
+            : builder(machine, tuningOptions, llvm::None, &callbacks) {
+        PassRecorder::Register(callbacks, &recorder);
+        PassCancellation::Register(callbacks, &cancellation);
+        builder.registerModuleAnalyses(moduleAnalyses);
+        builder.registerCGSCCAnalyses(cgsccAnalyses);
+        builder.registerFunctionAnalyses(functionAnalyses);
+        builder.registerLoopAnalyses(loopAnalyses);
+        builder.crossRegisterProxies(loopAnalyses, functionAnalyses, cgsccAnalyses, moduleAnalyses);
+    }
+
+    void track(llvm::Function *function) {
+        std::unique_ptr<CachedFunctionHandle> &handle = handles[function];
+        // a null handle belongs to a deleted function which lived at the same address
+        if (!handle || handle->isDeleted()) {
+            handle = std::make_unique<CachedFunctionHandle>(function, functionAnalyses);
+        }
+    }
+};
+
+void FunctionPassManager::Init(Napi::Env env, Napi::Object &exports) {
+    Napi::HandleScope scope(env);
+    const Napi::Function func = DefineClass(env, "FunctionPassManager", {
+            InstanceMethod("run", &FunctionPassManager::guarded<&FunctionPassManager::run>),
+            InstanceMethod("invalidate", &FunctionPassManager::guardedVoid<&FunctionPassManager::invalidate>),
+            InstanceMethod("clear", &FunctionPassManager::guardedVoid<&FunctionPassManager::clear>),
+            InstanceMethod("dispose", &FunctionPassManager::dispose)
+    });
+    DefineSymbolDispose(env, func);
+    constructor.Reset(env, func);
+    exports.Set("FunctionPassManager", func);
+}
+
+FunctionPassManager::FunctionPassManager(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    const Napi::Env env = info.Env();
+    const unsigned argsLen = info.Length();
+    if (!info.IsConstructCall() || argsLen < 1 || argsLen > 2 || !info[0].IsString() ||
+        (argsLen == 2 && !info[1].IsUndefined() && !PassBuilder::IsClassOf(info[1]))) {
+        throw Napi::TypeError::New(env, ErrMsg::Class::FunctionPassManager::constructor);
+    }
+    llvm::TargetMachine *machine = nullptr;
+    llvm::PipelineTuningOptions tuningOptions;
+    if (argsLen == 2 && info[1].IsObject()) {
+        passBuilderRef = Napi::Persistent(info[1].As<Napi::Object>());
+        passBuilder = PassBuilder::Extract(info[1]);
+        machine = passBuilder->getTargetMachine(env);
+        tuningOptions = passBuilder->getTuningOptions();
+    }
+    state = std::make_unique<State>(machine, tuningOptions);
+    const std::string pipeline = info[0].As<Napi::String>();
+    if (llvm::Error error = state->builder.parsePassPipeline(state->passManager, pipeline)) {
+        throw Napi::Error::New(env, llvm::toString(std::move(error)));
+    }
+}
+
+FunctionPassManager::~FunctionPassManager() = default;
+
+bool FunctionPassManager::isDisposed() {
+    return state == nullptr;
+}
+
+// a function inside a module, in a context which no asynchronous operation holds
+static llvm::Function &extractFunction(const Napi::Value &value, const char *errMsg) {
+    const Napi::Env env = value.Env();
+    if (!Function::IsClassOf(value) || !value.IsObject()) {
+        throw Napi::TypeError::New(env, errMsg);
+    }
+    llvm::Function *function = Function::Extract(value);
+    if (function->getParent() == nullptr) {
+        throw Napi::TypeError::New(env, errMsg);
+    }
+    LLVMContext *context = LLVMContext::Lookup(env, function->getContext());
+    if (context != nullptr && context->isLocked()) {
+        throw Napi::Error::New(env, ErrMsg::Class::LLVMContext::locked);
+    }
+    return *function;
+}
+
+Napi::Value FunctionPassManager::run(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    PassRecorder::Options recordOptions;
+    if (info.Length() < 1 || info.Length() > 2 || !recordOptions.parse(info[1])) {
+        throw Napi::TypeError::New(env, ErrMsg::Class::FunctionPassManager::run);
+    }
+    llvm::Function &function = extractFunction(info[0], ErrMsg::Class::FunctionPassManager::run);
+    if (passBuilder != nullptr) {
+        // the target analyses use the machine, which must still be there and idle
+        passBuilder->getTargetMachine(env);
+    }
+    // last, since it registers a listener on the signal
+    CancellationToken cancellation = CancellationToken::FromOptions(env, info[1], ErrMsg::Class::FunctionPassManager::run);
+    std::optional<PassRecorder> recorder;
+    if (recordOptions.enabled()) {
+        state->recorder = &recorder.emplace(recordOptions, state->callbacks);
+    }
+    state->cancellation = &cancellation;
+    if (!function.isDeclaration()) {
+        state->track(&function);
+        state->passManager.run(function, state->functionAnalyses);
+    }
+    state->recorder = nullptr;
+    state->cancellation = nullptr;
+    const bool cancelled = cancellation.isCancelled();
+    const Napi::Value reason = cancelled ? cancellation.getReason(env) : Napi::Value();
+    cancellation.detach();
+    if (cancelled) {
+        throw Napi::Error(env, reason);
+    }
+    if (!recorder) {
+        return env.Undefined();
+    }
+    recorder->finish();
+    return recorder->toObject(env);
+}
+
+void FunctionPassManager::invalidate(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    if (info.Length() != 1) {
+        throw Napi::TypeError::New(env, ErrMsg::Class::FunctionPassManager::invalidate);
+    }
+    llvm::Function &function = extractFunction(info[0], ErrMsg::Class::FunctionPassManager::invalidate);
+    state->functionAnalyses.invalidate(function, llvm::PreservedAnalyses::none());
+}
+
+void FunctionPassManager::clear(const Napi::CallbackInfo &info) {
+    state->handles.clear();
+    state->functionAnalyses.clear();
+    state->loopAnalyses.clear();
+    state->moduleAnalyses.clear();
+}
+
+void FunctionPassManager::dispose(const Napi::CallbackInfo &info) {
+    state.reset();
+    passBuilderRef.Reset();
+    passBuilder = nullptr;
+}
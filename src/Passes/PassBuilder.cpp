@@ -0,0 +1,324 @@
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <llvm/Analysis/CGSCCPassManager.h>
+#include <llvm/Analysis/LoopAnalysisManager.h>
+#include <llvm/IR/PassManager.h>
+#include "Passes/index.h"
+#include "IR/index.h"
+#include "Target/index.h"
+#include "Util/index.h"
+
+void OptimizationLevel::Init(Napi::Env env, Napi::Object &exports) {
+    const Napi::Object optimizationLevelNS = Napi::Object::New(env);
+    const char *names[] = {"O0", "O1", "O2", "O3", "Os", "Oz"};
+    for (unsigned i = 0; i < std::size(names); ++i) {
+        optimizationLevelNS.Set(names[i], Napi::Number::New(env, i));
+    }
+    exports.Set("OptimizationLevel", optimizationLevelNS);
+}
+
+bool PassBuilder::ParseOptimizationLevel(const Napi::Value &value, llvm::OptimizationLevel &level) {
+    if (!value.IsNumber()) {
+        return false;
+    }
+    switch (value.As<Napi::Number>().Int32Value()) {
+        case 0:
+            level = llvm::OptimizationLevel::O0;
+            return true;
+        case 1:
+            level = llvm::OptimizationLevel::O1;
+            return true;
+        case 2:
+            level = llvm::OptimizationLevel::O2;
+            return true;
+        case 3:
+            level = llvm::OptimizationLevel::O3;
+            return true;
+        case 4:
+            level = llvm::OptimizationLevel::Os;
+            return true;
+        case 5:
+            level = llvm::OptimizationLevel::Oz;
+            return true;
+        default:
+            return false;
+    }
+}
+
+// the plain bool fields of llvm::PipelineTuningOptions
+static const std::pair<const char *, bool llvm::PipelineTuningOptions::*> tuningFlags[] = {
+        {"loopInterleaving", &llvm::PipelineTuningOptions::LoopInterleaving},
+        {"loopVectorization", &llvm::PipelineTuningOptions::LoopVectorization},
+        {"slpVectorization", &llvm::PipelineTuningOptions::SLPVectorization},
+        {"loopUnrolling", &llvm::PipelineTuningOptions::LoopUnrolling},
+        {"forgetAllSCEVInLoopUnroll", &llvm::PipelineTuningOptions::ForgetAllSCEVInLoopUnroll},
+        {"callGraphProfile", &llvm::PipelineTuningOptions::CallGraphProfile},
+        {"mergeFunctions", &llvm::PipelineTuningOptions::MergeFunctions}
+};
+
+static bool parseTuningOptions(const Napi::Value &value, llvm::PipelineTuningOptions &options) {
+    if (value.IsUndefined()) {
+        return true;
+    }
+    if (!value.IsObject()) {
+        return false;
+    }
+    const auto object = value.As<Napi::Object>();
+    for (const auto &[name, field]: tuningFlags) {
+        const Napi::Value flag = object.Get(name);
+        if (flag.IsUndefined()) {
+            continue;
+        }
+        if (!flag.IsBoolean()) {
+            return false;
+        }
+        options.*field = flag.As<Napi::Boolean>();
+    }
+    return true;
+}
+
+void PassBuilder::Init(Napi::Env env, Napi::Object &exports) {
+    Napi::HandleScope scope(env);
+    const Napi::Function func = DefineClass(env, "PassBuilder", {
+            InstanceMethod("runDefaultPipeline", &PassBuilder::runDefaultPipeline),
+            InstanceMethod("runPassPipeline", &PassBuilder::runPassPipeline),
+            InstanceMethod("runAsync", &PassBuilder::runAsync)
+    });
+    constructor.Reset(env, func);
+    exports.Set("PassBuilder", func);
+}
+
+bool PassBuilder::IsClassOf(const Napi::Value &value) {
+    return hasTypeTag(value, TypeTag::PassBuilder);
+}
+
+PassBuilder *PassBuilder::Extract(const Napi::Value &value) {
+    return Unwrap(value.As<Napi::Object>());
+}
+
+PassBuilder::PassBuilder(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::PassBuilder);
+    const Napi::Env env = info.Env();
+    const unsigned argsLen = info.Length();
+    if (!info.IsConstructCall() || argsLen > 2 ||
+        (argsLen >= 1 && !info[0].IsUndefined() && !TargetMachine::IsClassOf(info[0])) ||
+        !parseTuningOptions(info[1], tuningOptions)) {
+        throw Napi::TypeError::New(env, ErrMsg::Class::PassBuilder::constructor);
+    }
+    if (argsLen >= 1 && info[0].IsObject()) {
+        targetMachineRef = Napi::Persistent(info[0].As<Napi::Object>());
+        targetMachine = TargetMachine::Unwrap(info[0].As<Napi::Object>());
+    }
+}
+
+llvm::TargetMachine *PassBuilder::getTargetMachine(Napi::Env env) {
+    if (targetMachine == nullptr) {
+        return nullptr;
+    }
+    if (targetMachine->isDisposed()) {
+        throw Napi::Error::New(env, ErrMsg::Class::TargetMachine::disposed);
+    }
+    // the cost models query the subtargets of the machine, which an emission on another thread may be creating
+    if (targetMachine->isBusy()) {
+        throw Napi::Error::New(env, ErrMsg::Class::TargetMachine::busy);
+    }
+    return targetMachine->getLLVMPrimitive();
+}
+
+const llvm::PipelineTuningOptions &PassBuilder::getTuningOptions() {
+    return tuningOptions;
+}
+
+static llvm::Module &extractModule(const Napi::Value &value) {
+    llvm::Module *module = Module::Extract(value);
+    if (module == nullptr) {
+        throw Napi::Error::New(value.Env(), ErrMsg::Class::Module::disposed);
+    }
+    return *module;
+}
+
+llvm::Error PassBuilder::RunModulePipeline(llvm::Module &module, llvm::TargetMachine *machine,
+                                           const llvm::PipelineTuningOptions &tuningOptions,
+                                           const PassRecorder::Options &recordOptions,
+                                           std::optional<PassRecorder> &recorder,
+                                           const CancellationToken &cancellation, const BuildPipeline &build) {
+    llvm::PassInstrumentationCallbacks callbacks;
+    PassRecorder *current = nullptr;
+    if (recordOptions.enabled()) {
+        current = &recorder.emplace(recordOptions, callbacks);
+        PassRecorder::Register(callbacks, &current);
+    }
+    const CancellationToken *token = &cancellation;
+    PassCancellation::Register(callbacks, &token);
+    // declared in this order so that they are destroyed in the reverse one
+    llvm::LoopAnalysisManager loopAnalyses;
+    llvm::FunctionAnalysisManager functionAnalyses;
+    llvm::CGSCCAnalysisManager cgsccAnalyses;
+    llvm::ModuleAnalysisManager moduleAnalyses;
+    // without callbacks, the builder skips naming every pass class for them
+    const bool instrumented = recordOptions.instrument || cancellation.isActive();
+    llvm::PassBuilder builder(machine, tuningOptions, llvm::None, instrumented ? &callbacks : nullptr);
+    builder.registerModuleAnalyses(moduleAnalyses);
+    builder.registerCGSCCAnalyses(cgsccAnalyses);
+    builder.registerFunctionAnalyses(functionAnalyses);
+    builder.registerLoopAnalyses(loopAnalyses);
+    builder.crossRegisterProxies(loopAnalyses, functionAnalyses, cgsccAnalyses, moduleAnalyses);
+    llvm::ModulePassManager passManager;
+    if (llvm::Error error = build(builder, passManager)) {
+        return error;
+    }
+    passManager.run(module, moduleAnalyses);
+    if (recorder) {
+        recorder->finish();
+    }
+    return llvm::Error::success();
+}
+
+PassBuilder::BuildPipeline PassBuilder::DefaultPipeline(llvm::OptimizationLevel level) {
+    return [level](llvm::PassBuilder &builder, llvm::ModulePassManager &passManager) {
+        passManager = level == llvm::OptimizationLevel::O0
+                      ? builder.buildO0DefaultPipeline(level)
+                      : builder.buildPerModuleDefaultPipeline(level);
+        return llvm::Error::success();
+    };
+}
+
+PassBuilder::BuildPipeline PassBuilder::TextualPipeline(std::string pipeline) {
+    return [pipeline = std::move(pipeline)](llvm::PassBuilder &builder, llvm::ModulePassManager &passManager) {
+        return builder.parsePassPipeline(passManager, pipeline);
+    };
+}
+
+// run the pipeline on the JS thread, the report of the recorder is returned when one was asked for; the token is
+// detached once the run is over, and its reason thrown if it has been cancelled
+static Napi::Value runModulePasses(Napi::Env env, llvm::Module &module, llvm::TargetMachine *machine,
+                                   const llvm::PipelineTuningOptions &tuningOptions,
+                                   const PassRecorder::Options &recordOptions, CancellationToken &cancellation,
+                                   const PassBuilder::BuildPipeline &build) {
+    std::optional<PassRecorder> recorder;
+    llvm::Error error = PassBuilder::RunModulePipeline(module, machine, tuningOptions, recordOptions, recorder,
+                                                       cancellation, build);
+    const bool cancelled = !error && cancellation.isCancelled();
+    const Napi::Value reason = cancelled ? cancellation.getReason(env) : Napi::Value();
+    cancellation.detach();
+    if (error) {
+        throw Napi::Error::New(env, llvm::toString(std::move(error)));
+    }
+    if (cancelled) {
+        throw Napi::Error(env, reason);
+    }
+    if (!recorder) {
+        return env.Undefined();
+    }
+    return recorder->toObject(env);
+}
+
+Napi::Value PassBuilder::runDefaultPipeline(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    const unsigned argsLen = info.Length();
+    llvm::OptimizationLevel level;
+    PassRecorder::Options recordOptions;
+    if (argsLen < 2 || argsLen > 3 || !Module::IsClassOf(info[0]) || !info[0].IsObject() ||
+        !ParseOptimizationLevel(info[1], level) || !recordOptions.parse(info[2])) {
+        throw Napi::TypeError::New(env, ErrMsg::Class::PassBuilder::runDefaultPipeline);
+    }
+    llvm::Module &module = extractModule(info[0]);
+    llvm::TargetMachine *machine = getTargetMachine(env);
+    // last, since it registers a listener on the signal
+    CancellationToken cancellation = CancellationToken::FromOptions(env, info[2], ErrMsg::Class::PassBuilder::runDefaultPipeline);
+    return runModulePasses(env, module, machine, tuningOptions, recordOptions, cancellation, DefaultPipeline(level));
+}
+
+Napi::Value PassBuilder::runPassPipeline(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    const unsigned argsLen = info.Length();
+    PassRecorder::Options recordOptions;
+    if (argsLen < 2 || argsLen > 3 || !Module::IsClassOf(info[0]) || !info[0].IsObject() || !info[1].IsString() ||
+        !recordOptions.parse(info[2])) {
+        throw Napi::TypeError::New(env, ErrMsg::Class::PassBuilder::runPassPipeline);
+    }
+    llvm::Module &module = extractModule(info[0]);
+    llvm::TargetMachine *machine = getTargetMachine(env);
+    // last, since it registers a listener on the signal
+    CancellationToken cancellation = CancellationToken::FromOptions(env, info[2], ErrMsg::Class::PassBuilder::runPassPipeline);
+    return runModulePasses(env, module, machine, tuningOptions, recordOptions, cancellation,
+                           TextualPipeline(info[1].As<Napi::String>()));
+}
+
+class RunPassesWorker : public ContextWorker {
+public:
+    RunPassesWorker(Napi::Env env, const Napi::Object &moduleObj, TargetMachine *machine,
+                    const llvm::PipelineTuningOptions &tuningOptions, const PassRecorder::Options &recordOptions,
+                    PassBuilder::BuildPipeline build) :
+            ContextWorker(env, "llvm.PassBuilder.runAsync", Module::Unwrap(moduleObj)->getContextWrapper()),
+            moduleObj(Napi::Persistent(moduleObj)),
+            module(Module::Unwrap(moduleObj)->getLLVMPrimitive()),
+            machine(machine),
+            tuningOptions(tuningOptions),
+            recordOptions(recordOptions),
+            build(std::move(build)) {
+        if (machine != nullptr) {
+            keepAlive(machine->Value());
+            machine->setBusy(true);
+        }
+    }
+
+    ~RunPassesWorker() override {
+        if (machine != nullptr) {
+            machine->setBusy(false);
+        }
+    }
+
+protected:
+    void Execute() override {
+        if (isCancelled()) {
+            return;
+        }
+        llvm::TargetMachine *targetMachine = machine != nullptr ? machine->getLLVMPrimitive() : nullptr;
+        if (llvm::Error error = PassBuilder::RunModulePipeline(*module, targetMachine, tuningOptions, recordOptions,
+                                                               recorder, getCancellation(), build)) {
+            SetError(llvm::toString(std::move(error)));
+            return;
+        }
+        // the module of an interrupted run is valid, but only partly optimized
+        isCancelled();
+    }
+
+    Napi::Value Resolve(Napi::Env env) override {
+        Module::UpdateExternalMemory(moduleObj.Value());
+        if (!recorder) {
+            return env.Undefined();
+        }
+        return recorder->toObject(env);
+    }
+
+private:
+    Napi::ObjectReference moduleObj;
+    llvm::Module *module;
+    TargetMachine *machine;
+    llvm::PipelineTuningOptions tuningOptions;
+    PassRecorder::Options recordOptions;
+    PassBuilder::BuildPipeline build;
+    std::optional<PassRecorder> recorder;
+};
+
+Napi::Value PassBuilder::runAsync(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    const unsigned argsLen = info.Length();
+    llvm::OptimizationLevel level;
+    PassRecorder::Options recordOptions;
+    if (argsLen < 2 || argsLen > 3 || !Module::IsClassOf(info[0]) || !info[0].IsObject() ||
+        (!info[1].IsString() && !ParseOptimizationLevel(info[1], level)) || !recordOptions.parse(info[2])) {
+        throw Napi::TypeError::New(env, ErrMsg::Class::PassBuilder::runAsync);
+    }
+    extractModule(info[0]);
+    // throws if the machine is disposed or busy, the worker keeps it busy until the promise settles
+    getTargetMachine(env);
+    BuildPipeline build = info[1].IsString() ? TextualPipeline(info[1].As<Napi::String>()) : DefaultPipeline(level);
+    CancellationToken cancellation = CancellationToken::FromOptions(env, info[2], ErrMsg::Class::PassBuilder::runAsync);
+    auto worker = std::make_unique<RunPassesWorker>(env, info[0].As<Napi::Object>(), targetMachine, tuningOptions,
+                                                    recordOptions, std::move(build));
+    worker->setCancellation(std::move(cancellation));
+    return ContextWorker::Start(std::move(worker));
+}
@@ -0,0 +1,199 @@
+#include <mutex>
+#include <llvm/ADT/Statistic.h>
+#include <llvm/Analysis/LazyCallGraph.h>
+#include <llvm/Analysis/LoopInfo.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/Module.h>
+#include "Passes/PassInstrumentation.h"
+
+bool PassRecorder::Options::parse(const Napi::Value &value) {
+    if (value.IsUndefined()) {
+        return true;
+    }
+    if (!value.IsObject()) {
+        return false;
+    }
+    const auto object = value.As<Napi::Object>();
+    const Napi::Value instrumentValue = object.Get("instrument");
+    const Napi::Value statisticsValue = object.Get("statistics");
+    if ((!instrumentValue.IsUndefined() && !instrumentValue.IsBoolean()) ||
+        (!statisticsValue.IsUndefined() && !statisticsValue.IsBoolean())) {
+        return false;
+    }
+    instrument = instrumentValue.ToBoolean();
+    statistics = statisticsValue.ToBoolean();
+    requested = true;
+    return true;
+}
+
+bool PassRecorder::Options::enabled() const {
+    return requested;
+}
+
+PassRecorder::PassRecorder(const Options &options, llvm::PassInstrumentationCallbacks &callbacks)
+        : options(options), callbacks(callbacks) {
+    if (options.statistics) {
+        static std::once_flag enableOnce;
+        std::call_once(enableOnce, [] { llvm::EnableStatistics(false); });
+        statisticsBefore = takeStatistics();
+    }
+}
+
+void PassRecorder::Register(llvm::PassInstrumentationCallbacks &callbacks, PassRecorder *const *current) {
+    callbacks.registerBeforeNonSkippedPassCallback([current](llvm::StringRef pass, llvm::Any unit) {
+        if (*current) {
+            (*current)->beforePass(pass, unit);
+        }
+    });
+    callbacks.registerAfterPassCallback(
+            [current](llvm::StringRef pass, llvm::Any unit, const llvm::PreservedAnalyses &preserved) {
+                if (*current) {
+                    (*current)->afterPass(pass, unit, !preserved.areAllPreserved());
+                }
+            });
+    callbacks.registerAfterPassInvalidatedCallback([current](llvm::StringRef pass, const llvm::PreservedAnalyses &) {
+        if (*current) {
+            (*current)->afterPassInvalidated(pass);
+        }
+    });
+}
+
+// managers and adaptors only run other passes, which get records of their own
+static bool isWrapperPass(llvm::StringRef pass) {
+    return llvm::isSpecialPass(pass, {"PassManager", "PassAdaptor", "AnalysisManagerProxy", "DevirtSCCRepeatedPass",
+                                      "ModuleInlinerWrapperPass"});
+}
+
+static unsigned countInstructions(const llvm::Loop &loop) {
+    unsigned count = 0;
+    for (const llvm::BasicBlock *block: loop.blocks()) {
+        count += block->size();
+    }
+    return count;
+}
+
+static unsigned countInstructions(const llvm::Any &unit) {
+    if (llvm::any_isa<const llvm::Module *>(unit)) {
+        return llvm::any_cast<const llvm::Module *>(unit)->getInstructionCount();
+    }
+    if (llvm::any_isa<const llvm::Function *>(unit)) {
+        return llvm::any_cast<const llvm::Function *>(unit)->getInstructionCount();
+    }
+    if (llvm::any_isa<const llvm::LazyCallGraph::SCC *>(unit)) {
+        unsigned count = 0;
+        for (const llvm::LazyCallGraph::Node &node: *llvm::any_cast<const llvm::LazyCallGraph::SCC *>(unit)) {
+            count += node.getFunction().getInstructionCount();
+        }
+        return count;
+    }
+    if (llvm::any_isa<const llvm::Loop *>(unit)) {
+        return countInstructions(*llvm::any_cast<const llvm::Loop *>(unit));
+    }
+    return 0;
+}
+
+void PassRecorder::beforePass(llvm::StringRef pass, const llvm::Any &unit) {
+    if (!options.instrument || isWrapperPass(pass)) {
+        return;
+    }
+    Record record;
+    record.pass = pass.str();
+    record.passName = callbacks.getPassNameForClassName(pass).str();
+    if (llvm::any_isa<const llvm::Module *>(unit)) {
+        record.unit = "module";
+        record.name = llvm::any_cast<const llvm::Module *>(unit)->getModuleIdentifier();
+    } else if (llvm::any_isa<const llvm::Function *>(unit)) {
+        record.unit = "function";
+        record.name = llvm::any_cast<const llvm::Function *>(unit)->getName().str();
+    } else if (llvm::any_isa<const llvm::LazyCallGraph::SCC *>(unit)) {
+        record.unit = "cgscc";
+        record.name = llvm::any_cast<const llvm::LazyCallGraph::SCC *>(unit)->getName();
+    } else if (llvm::any_isa<const llvm::Loop *>(unit)) {
+        record.unit = "loop";
+        record.name = llvm::any_cast<const llvm::Loop *>(unit)->getName().str();
+    } else {
+        record.unit = "unknown";
+    }
+    record.instructionsBefore = countInstructions(unit);
+    records.push_back(std::move(record));
+    running.push_back({records.size() - 1, std::chrono::steady_clock::now()});
+}
+
+void PassRecorder::afterPass(llvm::StringRef pass, const llvm::Any &unit, bool changed) {
+    if (!options.instrument || isWrapperPass(pass) || running.empty()) {
+        return;
+    }
+    const Running current = running.back();
+    running.pop_back();
+    Record &record = records[current.record];
+    record.elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - current.start).count();
+    record.instructionsAfter = countInstructions(unit);
+    record.changed = changed;
+}
+
+void PassRecorder::afterPassInvalidated(llvm::StringRef pass) {
+    if (!options.instrument || isWrapperPass(pass) || running.empty()) {
+        return;
+    }
+    const Running current = running.back();
+    running.pop_back();
+    Record &record = records[current.record];
+    record.elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - current.start).count();
+    record.changed = true;
+    record.invalidated = true;
+}
+
+std::map<std::string, uint64_t> PassRecorder::takeStatistics() {
+    std::map<std::string, uint64_t> result;
+    for (const auto &[name, value]: llvm::GetStatistics()) {
+        // the names are not qualified by the debug type, so counters sharing one are added up
+        result[name.str()] += value;
+    }
+    return result;
+}
+
+void PassRecorder::finish() {
+    if (!options.statistics) {
+        return;
+    }
+    for (const auto &[name, value]: takeStatistics()) {
+        const auto before = statisticsBefore.find(name);
+        const uint64_t previous = before == statisticsBefore.end() ? 0 : before->second;
+        if (value != previous) {
+            statistics[name] = value - previous;
+        }
+    }
+}
+
+Napi::Object PassRecorder::toObject(Napi::Env env) const {
+    Napi::Array passes = Napi::Array::New(env, records.size());
+    for (uint32_t i = 0; i < records.size(); ++i) {
+        const Record &record = records[i];
+        Napi::Object object = Napi::Object::New(env);
+        object.Set("pass", Napi::String::New(env, record.pass));
+        object.Set("passName", Napi::String::New(env, record.passName));
+        object.Set("unit", Napi::String::New(env, record.unit));
+        object.Set("name", Napi::String::New(env, record.name));
+        object.Set("elapsed", Napi::Number::New(env, record.elapsed));
+        object.Set("instructionsBefore", Napi::Number::New(env, record.instructionsBefore));
+        object.Set("instructionsAfter", Napi::Number::New(env, record.instructionsAfter));
+        object.Set("changed", Napi::Boolean::New(env, record.changed));
+        object.Set("invalidated", Napi::Boolean::New(env, record.invalidated));
+        passes.Set(i, object);
+    }
+    Napi::Object statisticsObject = Napi::Object::New(env);
+    for (const auto &[name, value]: statistics) {
+        statisticsObject.Set(name, Napi::Number::New(env, static_cast<double>(value)));
+    }
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("passes", passes);
+    result.Set("statistics", statisticsObject);
+    return result;
+}
+
+void PassCancellation::Register(llvm::PassInstrumentationCallbacks &callbacks,
+                                const CancellationToken *const *current) {
+    callbacks.registerShouldRunOptionalPassCallback([current](llvm::StringRef, llvm::Any) {
+        return *current == nullptr || !(*current)->isCancelled();
+    });
+}
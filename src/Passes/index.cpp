@@ -0,0 +1,7 @@
+#include "Passes/index.h"
+
+void InitPasses(Napi::Env env, Napi::Object &exports) {
+    OptimizationLevel::Init(env, exports);
+    PassBuilder::Init(env, exports);
+    FunctionPassManager::Init(env, exports);
+}
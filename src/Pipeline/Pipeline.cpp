@@ -0,0 +1,602 @@
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/IR/DiagnosticInfo.h>
+#include <llvm/IR/DiagnosticPrinter.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Verifier.h>
+#include <llvm/IRReader/IRReader.h>
+#include <llvm/Linker/Linker.h>
+#include <llvm/Support/Host.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/SourceMgr.h>
+#include <llvm/Support/Threading.h>
+#include <llvm/Support/raw_ostream.h>
+#include "IR/Verifier.h"
+#include "Passes/PassBuilder.h"
+#include "Pipeline/index.h"
+#include "Target/TargetMachine.h"
+#include "Target/TargetMachineCache.h"
+#include "Target/TargetOptions.h"
+#include "Util/index.h"
+
+// a module in memory takes several times the size of its text or bitcode
+static constexpr std::uint64_t MemoryPerInputByte = 8;
+
+struct PipelineStage {
+    enum Kind {
+        Verify,
+        Print,
+        Link,
+        Optimize,
+        WriteBitcode,
+        WriteIR,
+        Emit
+    };
+
+    Kind kind;
+    std::string file;
+
+    // of an optimize stage, the textual pipeline if any, else the default one of the level
+    std::string pipeline;
+    llvm::OptimizationLevel level = llvm::OptimizationLevel::O2;
+
+    // of an emit stage, the target defaults to the triple of the module or else the host; an optimize stage only
+    // uses a target when the stage or the module has a triple
+    llvm::CodeGenFileType fileType = llvm::CGFT_ObjectFile;
+    std::string triple;
+    std::string cpu;
+    std::string features;
+    TargetMachineOptions machineOptions;
+};
+
+struct PipelineJob {
+    explicit PipelineJob(Napi::Env env) : deferred(Napi::Promise::Deferred::New(env)) {
+    }
+
+    Napi::Promise::Deferred deferred;
+
+    std::string name;
+    std::vector<std::string> after;
+    std::string inputFile;
+    std::string inputIR;
+    std::vector<PipelineStage> stages;
+    std::uint64_t memoryEstimate = 0;
+    CancellationToken cancellation;
+
+    // the jobs running after this one, and the number of jobs this one still waits for
+    std::vector<PipelineJob *> dependents;
+    unsigned pendingDependencies = 0;
+
+    bool failed = false;
+    bool cancelled = false;
+    std::string error;
+    std::string output;
+};
+
+//===--------------------------------------------------------------------===//
+// Reading a job description on the JS thread
+//===--------------------------------------------------------------------===//
+
+static bool getOptionalString(const Napi::Object &object, const char *key, std::string &result) {
+    const Napi::Value value = object.Get(key);
+    if (value.IsUndefined()) {
+        return true;
+    }
+    if (!value.IsString()) {
+        return false;
+    }
+    result = value.As<Napi::String>();
+    return true;
+}
+
+static std::uint64_t getFileSize(const std::string &file) {
+    std::uint64_t size = 0;
+    if (llvm::sys::fs::file_size(file, size)) {
+        // reported by the job itself when it fails to read the file
+        return 0;
+    }
+    return size;
+}
+
+static PipelineStage parseStage(Napi::Env env, const Napi::Value &value) {
+    if (!value.IsObject()) {
+        throw Napi::TypeError::New(env, ErrMsg::Class::Pipeline::submit);
+    }
+    const auto object = value.As<Napi::Object>();
+    std::string kind;
+    PipelineStage stage{PipelineStage::Verify};
+    if (!getOptionalString(object, "kind", kind) || !getOptionalString(object, "file", stage.file) ||
+        !getOptionalString(object, "triple", stage.triple) || !getOptionalString(object, "cpu", stage.cpu) ||
+        !getOptionalString(object, "features", stage.features)) {
+        throw Napi::TypeError::New(env, ErrMsg::Class::Pipeline::submit);
+    }
+    if (kind == "verify") {
+        stage.kind = PipelineStage::Verify;
+    } else if (kind == "print") {
+        stage.kind = PipelineStage::Print;
+    } else if (kind == "link") {
+        stage.kind = PipelineStage::Link;
+    } else if (kind == "optimize") {
+        stage.kind = PipelineStage::Optimize;
+        const Napi::Value level = object.Get("level");
+        if ((!level.IsUndefined() && !PassBuilder::ParseOptimizationLevel(level, stage.level)) ||
+            !getOptionalString(object, "pipeline", stage.pipeline) || !stage.machineOptions.parse(object.Get("options"))) {
+            throw Napi::TypeError::New(env, ErrMsg::Class::Pipeline::submit);
+        }
+    } else if (kind == "writeBitcode") {
+        stage.kind = PipelineStage::WriteBitcode;
+    } else if (kind == "writeIR") {
+        stage.kind = PipelineStage::WriteIR;
+    } else if (kind == "emit") {
+        stage.kind = PipelineStage::Emit;
+        const Napi::Value fileType = object.Get("fileType");
+        if ((!fileType.IsUndefined() && !TargetMachine::ParseFileType(fileType, stage.fileType)) ||
+            !stage.machineOptions.parse(object.Get("options"))) {
+            throw Napi::TypeError::New(env, ErrMsg::Class::Pipeline::submit);
+        }
+    } else {
+        throw Napi::TypeError::New(env, ErrMsg::Class::Pipeline::unknownStage + kind);
+    }
+    const bool needsFile = stage.kind != PipelineStage::Verify && stage.kind != PipelineStage::Print &&
+                           stage.kind != PipelineStage::Optimize;
+    if (needsFile && stage.file.empty()) {
+        throw Napi::TypeError::New(env, ErrMsg::Class::Pipeline::submit);
+    }
+    return stage;
+}
+
+static std::unique_ptr<PipelineJob> parseJob(Napi::Env env, const Napi::Object &object) {
+    auto job = std::make_unique<PipelineJob>(env);
+    if (!getOptionalString(object, "name", job->name) ||
+        !getOptionalString(object, "file", job->inputFile) ||
+        !getOptionalString(object, "ir", job->inputIR) ||
+        job->inputFile.empty() == !object.Has("ir")) {
+        throw Napi::TypeError::New(env, ErrMsg::Class::Pipeline::submit);
+    }
+    const Napi::Value after = object.Get("after");
+    if (!after.IsUndefined()) {
+        if (!after.IsArray()) {
+            throw Napi::TypeError::New(env, ErrMsg::Class::Pipeline::submit);
+        }
+        const auto names = after.As<Napi::Array>();
+        for (uint32_t i = 0; i < names.Length(); ++i) {
+            const Napi::Value name = names.Get(i);
+            if (!name.IsString()) {
+                throw Napi::TypeError::New(env, ErrMsg::Class::Pipeline::submit);
+            }
+            job->after.push_back(name.As<Napi::String>());
+        }
+    }
+    const Napi::Value stages = object.Get("stages");
+    if (!stages.IsUndefined()) {
+        if (!stages.IsArray()) {
+            throw Napi::TypeError::New(env, ErrMsg::Class::Pipeline::submit);
+        }
+        const auto stageArray = stages.As<Napi::Array>();
+        for (uint32_t i = 0; i < stageArray.Length(); ++i) {
+            job->stages.push_back(parseStage(env, stageArray.Get(i)));
+        }
+    }
+    const Napi::Value memoryEstimate = object.Get("memoryEstimate");
+    if (memoryEstimate.IsNumber() && memoryEstimate.As<Napi::Number>().Int64Value() >= 0) {
+        job->memoryEstimate = memoryEstimate.As<Napi::Number>().Int64Value();
+    } else if (memoryEstimate.IsUndefined()) {
+        std::uint64_t inputSize = job->inputFile.empty() ? job->inputIR.size() : getFileSize(job->inputFile);
+        for (const PipelineStage &stage: job->stages) {
+            if (stage.kind == PipelineStage::Link) {
+                inputSize += getFileSize(stage.file);
+            }
+        }
+        job->memoryEstimate = inputSize * MemoryPerInputByte;
+    } else {
+        throw Napi::TypeError::New(env, ErrMsg::Class::Pipeline::submit);
+    }
+    // last, since it registers a listener on the signal
+    job->cancellation = CancellationToken::FromOptions(env, object, ErrMsg::Class::Pipeline::submit);
+    return job;
+}
+
+//===--------------------------------------------------------------------===//
+// Running a job on a pool thread
+//===--------------------------------------------------------------------===//
+
+// polled before each stage, between the steps of a link, between the functions of a verification and between the
+// passes of an optimization or an emission
+static bool isCancelled(PipelineJob &job) {
+    if (!job.cancelled && job.cancellation.isCancelled()) {
+        job.cancelled = true;
+        job.failed = true;
+    }
+    return job.cancelled;
+}
+
+static void appendError(PipelineJob &job, const std::string &message) {
+    if (!job.error.empty()) {
+        job.error += '\n';
+    }
+    job.error += message;
+    job.failed = true;
+}
+
+// without a handler, LLVMContext::diagnose exits the process on an error
+static void collectDiagnostic(const llvm::DiagnosticInfo &info, void *data) {
+    if (info.getSeverity() != llvm::DS_Error) {
+        return;
+    }
+    std::string message;
+    llvm::raw_string_ostream stream(message);
+    llvm::DiagnosticPrinterRawOStream printer(stream);
+    info.print(printer);
+    appendError(*static_cast<PipelineJob *>(data), stream.str());
+}
+
+static std::string formatDiagnostic(const llvm::SMDiagnostic &diagnostic) {
+    std::string message;
+    llvm::raw_string_ostream stream(message);
+    diagnostic.print(nullptr, stream, false);
+    return stream.str();
+}
+
+static bool writeModule(PipelineJob &job, const llvm::Module &module, const PipelineStage &stage) {
+    std::error_code errorCode;
+    const auto flags = stage.kind == PipelineStage::WriteIR ? llvm::sys::fs::OF_Text : llvm::sys::fs::OF_None;
+    llvm::raw_fd_ostream stream(stage.file, errorCode, flags);
+    if (errorCode) {
+        appendError(job, errorCode.message() + ": " + stage.file);
+        return false;
+    }
+    if (stage.kind == PipelineStage::WriteIR) {
+        module.print(stream, nullptr);
+    } else {
+        llvm::WriteBitcodeToFile(module, stream);
+    }
+    stream.close();
+    if (stream.has_error()) {
+        appendError(job, stream.error().message() + ": " + stage.file);
+        stream.clear_error();
+        return false;
+    }
+    return true;
+}
+
+// leased for the job alone, since TargetMachine is not shared between threads; the module gets the triple and the
+// data layout of the machine where it has none, and fails the job where they differ
+static TargetMachineCache::Lease acquireMachine(PipelineJob &job, llvm::Module &module, const PipelineStage &stage) {
+    std::string triple = stage.triple;
+    if (triple.empty()) {
+        triple = module.getTargetTriple().empty() ? llvm::sys::getDefaultTargetTriple() : module.getTargetTriple();
+    }
+    std::string error;
+    TargetMachineCache::Lease machine = TargetMachineCache::Global().acquire(
+            triple, stage.cpu.empty() ? "generic" : stage.cpu, stage.features, stage.machineOptions, error);
+    if (!machine) {
+        appendError(job, error);
+        return machine;
+    }
+    if (const char *mismatch = TargetMachine::MatchModule(*machine, module)) {
+        appendError(job, mismatch);
+        return {};
+    }
+    return machine;
+}
+
+static bool optimizeModule(PipelineJob &job, llvm::Module &module, const PipelineStage &stage) {
+    TargetMachineCache::Lease machine;
+    if (!stage.triple.empty() || !module.getTargetTriple().empty()) {
+        machine = acquireMachine(job, module, stage);
+        if (!machine) {
+            return false;
+        }
+    }
+    std::optional<PassRecorder> recorder;
+    const PassBuilder::BuildPipeline build = stage.pipeline.empty() ? PassBuilder::DefaultPipeline(stage.level)
+                                                                    : PassBuilder::TextualPipeline(stage.pipeline);
+    if (llvm::Error error = PassBuilder::RunModulePipeline(module, machine.get(), llvm::PipelineTuningOptions(),
+                                                           PassRecorder::Options(), recorder, job.cancellation,
+                                                           build)) {
+        appendError(job, llvm::toString(std::move(error)));
+        return false;
+    }
+    return !isCancelled(job) && !job.failed;
+}
+
+static bool emitModule(PipelineJob &job, llvm::Module &module, const PipelineStage &stage) {
+    TargetMachineCache::Lease machine = acquireMachine(job, module, stage);
+    if (!machine) {
+        return false;
+    }
+    std::error_code errorCode;
+    const auto flags = stage.fileType == llvm::CGFT_AssemblyFile ? llvm::sys::fs::OF_Text : llvm::sys::fs::OF_None;
+    llvm::raw_fd_ostream stream(stage.file, errorCode, flags);
+    if (errorCode) {
+        appendError(job, errorCode.message() + ": " + stage.file);
+        return false;
+    }
+    if (const char *error = TargetMachine::Emit(*machine, module, stream, stage.fileType, &job.cancellation)) {
+        appendError(job, error);
+        return false;
+    }
+    if (isCancelled(job)) {
+        return false;
+    }
+    stream.close();
+    if (stream.has_error()) {
+        appendError(job, stream.error().message() + ": " + stage.file);
+        stream.clear_error();
+        return false;
+    }
+    return !job.failed;
+}
+
+static bool runStage(PipelineJob &job, llvm::Module &module, const PipelineStage &stage) {
+    switch (stage.kind) {
+        case PipelineStage::Verify: {
+            std::string message;
+            llvm::raw_string_ostream stream(message);
+            const bool broken = Verifier::verifyModuleCancellable(module, &stream, job.cancellation);
+            if (isCancelled(job)) {
+                return false;
+            }
+            if (broken) {
+                appendError(job, stream.str());
+                return false;
+            }
+            return true;
+        }
+        case PipelineStage::Print: {
+            llvm::raw_string_ostream stream(job.output);
+            module.print(stream, nullptr);
+            return true;
+        }
+        case PipelineStage::Link: {
+            llvm::SMDiagnostic diagnostic;
+            std::unique_ptr<llvm::Module> source = llvm::parseIRFile(stage.file, diagnostic, module.getContext());
+            if (!source) {
+                appendError(job, formatDiagnostic(diagnostic));
+                return false;
+            }
+            if (isCancelled(job)) {
+                return false;
+            }
+            // the reasons are reported to collectDiagnostic
+            if (llvm::Linker::linkModules(module, std::move(source)) && !job.failed) {
+                appendError(job, "failed to link " + stage.file);
+            }
+            return !job.failed;
+        }
+        case PipelineStage::Optimize:
+            return optimizeModule(job, module, stage);
+        case PipelineStage::WriteBitcode:
+        case PipelineStage::WriteIR:
+            return writeModule(job, module, stage);
+        case PipelineStage::Emit:
+            return emitModule(job, module, stage);
+    }
+    return false;
+}
+
+static void execute(PipelineJob &job) {
+    if (isCancelled(job)) {
+        return;
+    }
+    llvm::LLVMContext context;
+    context.setDiagnosticHandlerCallBack(collectDiagnostic, &job);
+    llvm::SMDiagnostic diagnostic;
+    std::unique_ptr<llvm::Module> module;
+    if (job.inputFile.empty()) {
+        const llvm::MemoryBufferRef buffer(job.inputIR, job.name.empty() ? "<pipeline>" : job.name);
+        module = llvm::parseIR(buffer, diagnostic, context);
+    } else {
+        module = llvm::parseIRFile(job.inputFile, diagnostic, context);
+    }
+    if (!module) {
+        appendError(job, formatDiagnostic(diagnostic));
+        return;
+    }
+    for (const PipelineStage &stage: job.stages) {
+        if (isCancelled(job) || !runStage(job, *module, stage)) {
+            return;
+        }
+    }
+}
+
+//===--------------------------------------------------------------------===//
+// Pipeline
+//===--------------------------------------------------------------------===//
+
+void Pipeline::Init(Napi::Env env, Napi::Object &exports) {
+    Napi::HandleScope scope(env);
+    const Napi::Function func = DefineClass(env, "Pipeline", {
+            InstanceMethod("submit", &Pipeline::submit),
+            InstanceMethod("getConcurrency", &Pipeline::getConcurrency),
+            InstanceMethod("getMemoryBudget", &Pipeline::getMemoryBudget),
+    });
+    constructor.Reset(env, func);
+    exports.Set("Pipeline", func);
+}
+
+Pipeline::Pipeline(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    const Napi::Env env = info.Env();
+    if (!info.IsConstructCall() || (info.Length() >= 1 && !info[0].IsObject() && !info[0].IsUndefined())) {
+        throw Napi::TypeError::New(env, ErrMsg::Class::Pipeline::constructor);
+    }
+    unsigned concurrency = llvm::hardware_concurrency().compute_thread_count();
+    if (info.Length() >= 1 && info[0].IsObject()) {
+        const auto options = info[0].As<Napi::Object>();
+        const Napi::Value concurrencyValue = options.Get("concurrency");
+        const Napi::Value memoryBudgetValue = options.Get("memoryBudget");
+        if ((!concurrencyValue.IsUndefined() && !concurrencyValue.IsNumber()) ||
+            (!memoryBudgetValue.IsUndefined() && !memoryBudgetValue.IsNumber())) {
+            throw Napi::TypeError::New(env, ErrMsg::Class::Pipeline::constructor);
+        }
+        if (concurrencyValue.IsNumber()) {
+            const int64_t value = concurrencyValue.As<Napi::Number>().Int64Value();
+            if (value < 1) {
+                throw Napi::TypeError::New(env, ErrMsg::Class::Pipeline::constructor);
+            }
+            concurrency = value;
+        }
+        if (memoryBudgetValue.IsNumber()) {
+            const int64_t value = memoryBudgetValue.As<Napi::Number>().Int64Value();
+            memoryBudget = value > 0 ? value : 0;
+        }
+    }
+    pool = std::make_unique<ThreadPool>(concurrency);
+    completions = Completions::New(env, "llvm.Pipeline", 0, 1, this);
+    // an idle pipeline does not keep the process alive
+    completions.Unref(env);
+}
+
+Pipeline::~Pipeline() {
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        stopping = true;
+        ready.clear();
+    }
+    // wait for the running jobs, which still report to the completions; pool is null while it is destroyed, so
+    // they must not dispatch anymore
+    pool.reset();
+    completions.Release();
+}
+
+Napi::Value Pipeline::submit(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    if (info.Length() < 1 || !info[0].IsObject()) {
+        throw Napi::TypeError::New(env, ErrMsg::Class::Pipeline::submit);
+    }
+    std::unique_ptr<PipelineJob> job = parseJob(env, info[0].As<Napi::Object>());
+    PipelineJob *pending = job.get();
+    const Napi::Promise promise = job->deferred.Promise();
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        if (!job->name.empty()) {
+            auto iter = named.find(job->name);
+            if (iter != named.end() && iter->second.pending) {
+                job->cancellation.detach();
+                throw Napi::TypeError::New(env, ErrMsg::Class::Pipeline::duplicateJob + job->name);
+            }
+        }
+        for (const std::string &name: job->after) {
+            if (named.find(name) == named.end()) {
+                job->cancellation.detach();
+                throw Napi::TypeError::New(env, ErrMsg::Class::Pipeline::unknownJob + name);
+            }
+        }
+        for (const std::string &name: job->after) {
+            const NamedJob &dependency = named[name];
+            if (dependency.pending) {
+                dependency.pending->dependents.push_back(pending);
+                ++pending->pendingDependencies;
+            } else if (dependency.failed) {
+                pending->failed = true;
+                pending->error = ErrMsg::Class::Pipeline::dependencyFailed + name;
+            }
+        }
+        if (!job->name.empty()) {
+            named[job->name] = NamedJob{pending, false};
+        }
+        jobs.emplace(pending, std::move(job));
+        if (pending->pendingDependencies == 0) {
+            if (pending->failed) {
+                finish(pending);
+            } else {
+                ready.push_back(pending);
+                dispatch();
+            }
+        }
+    }
+    if (outstanding++ == 0) {
+        // keep the process and this pipeline alive until every promise has settled
+        completions.Ref(env);
+        Ref();
+    }
+    return promise;
+}
+
+Napi::Value Pipeline::getConcurrency(const Napi::CallbackInfo &info) {
+    return Napi::Number::New(info.Env(), pool->getThreadCount());
+}
+
+Napi::Value Pipeline::getMemoryBudget(const Napi::CallbackInfo &info) {
+    return Napi::Number::New(info.Env(), static_cast<double>(memoryBudget));
+}
+
+void Pipeline::dispatch() {
+    if (stopping) {
+        return;
+    }
+    while (!ready.empty() && running < pool->getThreadCount()) {
+        PipelineJob *job = ready.front();
+        // a job larger than the whole budget still runs, but alone
+        if (memoryBudget != 0 && running != 0 && memoryInFlight + job->memoryEstimate > memoryBudget) {
+            break;
+        }
+        ready.pop_front();
+        ++running;
+        memoryInFlight += job->memoryEstimate;
+        pool->async([this, job] { run(job); });
+    }
+}
+
+void Pipeline::run(PipelineJob *job) {
+    execute(*job);
+    std::lock_guard<std::mutex> guard(mutex);
+    --running;
+    memoryInFlight -= job->memoryEstimate;
+    finish(job);
+    // dependents made ready above are queued on this thread first
+    dispatch();
+}
+
+void Pipeline::finish(PipelineJob *job) {
+    if (!job->name.empty()) {
+        named[job->name] = NamedJob{nullptr, job->failed};
+    }
+    for (PipelineJob *dependent: job->dependents) {
+        if (job->failed && !dependent->failed) {
+            dependent->failed = true;
+            dependent->error = ErrMsg::Class::Pipeline::dependencyFailed + job->name;
+        }
+        if (--dependent->pendingDependencies == 0) {
+            if (dependent->failed) {
+                finish(dependent);
+            } else {
+                ready.push_back(dependent);
+            }
+        }
+    }
+    job->dependents.clear();
+    completions.NonBlockingCall(job);
+}
+
+void Pipeline::Settle(Napi::Env env, Napi::Function, Pipeline *pipeline, PipelineJob *job) {
+    // the environment is being torn down, the jobs are freed with the pipeline
+    if (env == nullptr) {
+        return;
+    }
+    std::unique_ptr<PipelineJob> settled;
+    {
+        std::lock_guard<std::mutex> guard(pipeline->mutex);
+        auto iter = pipeline->jobs.find(job);
+        settled = std::move(iter->second);
+        pipeline->jobs.erase(iter);
+    }
+    if (settled->cancelled) {
+        settled->deferred.Reject(settled->cancellation.getReason(env));
+    } else if (settled->failed) {
+        settled->deferred.Reject(Napi::Error::New(env, settled->error).Value());
+    } else {
+        Napi::Object result = Napi::Object::New(env);
+        result.Set("name", Napi::String::New(env, settled->name));
+        if (!settled->output.empty()) {
+            result.Set("ir", Napi::String::New(env, settled->output));
+        }
+        settled->deferred.Resolve(result);
+    }
+    settled->cancellation.detach();
+    if (--pipeline->outstanding == 0) {
+        pipeline->completions.Unref(env);
+        pipeline->Unref();
+    }
+}
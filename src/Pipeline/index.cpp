@@ -0,0 +1,5 @@
+#include "Pipeline/index.h"
+
+void InitPipeline(Napi::Env env, Napi::Object &exports) {
+    Pipeline::Init(env, exports);
+}
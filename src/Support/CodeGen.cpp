@@ -0,0 +1,28 @@
+#include "Support/CodeGen.h"
+
+void CodeGen::Init(Napi::Env env, Napi::Object &exports) {
+    const Napi::Object relocNS = Napi::Object::New(env);
+    relocNS.Set("Static", Napi::Number::New(env, llvm::Reloc::Static));
+    relocNS.Set("PIC_", Napi::Number::New(env, llvm::Reloc::PIC_));
+    relocNS.Set("DynamicNoPIC", Napi::Number::New(env, llvm::Reloc::DynamicNoPIC));
+    relocNS.Set("ROPI", Napi::Number::New(env, llvm::Reloc::ROPI));
+    relocNS.Set("RWPI", Napi::Number::New(env, llvm::Reloc::RWPI));
+    relocNS.Set("ROPI_RWPI", Napi::Number::New(env, llvm::Reloc::ROPI_RWPI));
+
+    const Napi::Object codeModelNS = Napi::Object::New(env);
+    codeModelNS.Set("Tiny", Napi::Number::New(env, llvm::CodeModel::Tiny));
+    codeModelNS.Set("Small", Napi::Number::New(env, llvm::CodeModel::Small));
+    codeModelNS.Set("Kernel", Napi::Number::New(env, llvm::CodeModel::Kernel));
+    codeModelNS.Set("Medium", Napi::Number::New(env, llvm::CodeModel::Medium));
+    codeModelNS.Set("Large", Napi::Number::New(env, llvm::CodeModel::Large));
+
+    const Napi::Object codeGenOptNS = Napi::Object::New(env);
+    codeGenOptNS.Set("None", Napi::Number::New(env, llvm::CodeGenOpt::None));
+    codeGenOptNS.Set("Less", Napi::Number::New(env, llvm::CodeGenOpt::Less));
+    codeGenOptNS.Set("Default", Napi::Number::New(env, llvm::CodeGenOpt::Default));
+    codeGenOptNS.Set("Aggressive", Napi::Number::New(env, llvm::CodeGenOpt::Aggressive));
+
+    exports.Set("Reloc", relocNS);
+    exports.Set("CodeModel", codeModelNS);
+    exports.Set("CodeGenOpt", codeGenOptNS);
+}
@@ -0,0 +1,50 @@
+#include <algorithm>
+#include <vector>
+#include <llvm/ADT/StringMap.h>
+#include "Support/Host.h"
+
+std::string sys::getHostCPUFeatureString() {
+    llvm::StringMap<bool> features;
+    if (!llvm::sys::getHostCPUFeatures(features)) {
+        return "";
+    }
+    std::vector<std::string> entries;
+    entries.reserve(features.size());
+    for (const auto &feature: features) {
+        entries.push_back((feature.second ? "+" : "-") + feature.first().str());
+    }
+    std::sort(entries.begin(), entries.end());
+    std::string result;
+    for (const std::string &entry: entries) {
+        if (!result.empty()) {
+            result += ',';
+        }
+        result += entry;
+    }
+    return result;
+}
+
+static Napi::Value getHostCPUName(const Napi::CallbackInfo &info) {
+    return Napi::String::New(info.Env(), llvm::sys::getHostCPUName().str());
+}
+
+static Napi::Value getHostCPUFeatures(const Napi::CallbackInfo &info) {
+    return Napi::String::New(info.Env(), sys::getHostCPUFeatureString());
+}
+
+static Napi::Value getProcessTriple(const Napi::CallbackInfo &info) {
+    return Napi::String::New(info.Env(), llvm::sys::getProcessTriple());
+}
+
+static Napi::Value getDefaultTargetTriple(const Napi::CallbackInfo &info) {
+    return Napi::String::New(info.Env(), llvm::sys::getDefaultTargetTriple());
+}
+
+void sys::Init(Napi::Env env, Napi::Object &exports) {
+    const Napi::Object sysNS = Napi::Object::New(env);
+    sysNS.Set("getHostCPUName", Napi::Function::New(env, getHostCPUName));
+    sysNS.Set("getHostCPUFeatures", Napi::Function::New(env, getHostCPUFeatures));
+    sysNS.Set("getProcessTriple", Napi::Function::New(env, getProcessTriple));
+    sysNS.Set("getDefaultTargetTriple", Napi::Function::New(env, getDefaultTargetTriple));
+    exports.Set("sys", sysNS);
+}
@@ -5,13 +5,12 @@ void SMDiagnostic::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "SMDiagnostic", {
     });
-    constructor = Persistent(func);
-    constructor.SuppressDestruct();
+    constructor.Reset(env, func);
     exports.Set("SMDiagnostic", func);
 }
 
 bool SMDiagnostic::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || hasTypeTag(value, TypeTag::SMDiagnostic);
 }
 
 llvm::SMDiagnostic &SMDiagnostic::Extract(const Napi::Value &value) {
@@ -19,6 +18,7 @@ llvm::SMDiagnostic &SMDiagnostic::Extract(const Napi::Value &value) {
 }
 
 SMDiagnostic::SMDiagnostic(const Napi::CallbackInfo &info) : Napi::ObjectWrap<SMDiagnostic>{info} {
+    tagWrapper(info, TypeTag::SMDiagnostic);
     const Napi::Env env = info.Env();
     if (!info.IsConstructCall()) {
         throw Napi::TypeError::New(env, ErrMsg::Class::SMDiagnostic::constructor);
@@ -26,6 +26,10 @@ SMDiagnostic::SMDiagnostic(const Napi::CallbackInfo &info) : Napi::ObjectWrap<SM
     diagnostic = new llvm::SMDiagnostic();
 }
 
+SMDiagnostic::~SMDiagnostic() {
+    delete diagnostic;
+}
+
 llvm::SMDiagnostic &SMDiagnostic::getLLVMPrimitive() {
     return *diagnostic;
 }
@@ -1,45 +1,65 @@
+#include <mutex>
 #include "Support/index.h"
 
+// the target registry is process-wide, workers may initialize it concurrently
+static std::mutex initMutex; // NOLINT
+
 static void InitializeAllTargetInfos(const Napi::CallbackInfo &info) {
+    std::lock_guard<std::mutex> lock(initMutex);
     llvm::InitializeAllTargetInfos();
 }
 
 static void InitializeAllTargets(const Napi::CallbackInfo &info) {
+    std::lock_guard<std::mutex> lock(initMutex);
     llvm::InitializeAllTargets();
 }
 
 static void InitializeAllTargetMCs(const Napi::CallbackInfo &info) {
+    std::lock_guard<std::mutex> lock(initMutex);
     llvm::InitializeAllTargetMCs();
 }
 
 static void InitializeAllAsmPrinters(const Napi::CallbackInfo &info) {
+    std::lock_guard<std::mutex> lock(initMutex);
     llvm::InitializeAllAsmPrinters();
 }
 
 static void InitializeAllAsmParsers(const Napi::CallbackInfo &info) {
+    std::lock_guard<std::mutex> lock(initMutex);
     llvm::InitializeAllAsmParsers();
 }
 
 static void InitializeAllDisassemblers(const Napi::CallbackInfo &info) {
+    std::lock_guard<std::mutex> lock(initMutex);
     llvm::InitializeAllDisassemblers();
 }
 
 static Napi::Value InitializeNativeTarget(const Napi::CallbackInfo &info) {
+    std::lock_guard<std::mutex> lock(initMutex);
     return Napi::Boolean::New(info.Env(), llvm::InitializeNativeTarget());
 }
 
 static Napi::Value InitializeNativeTargetAsmPrinter(const Napi::CallbackInfo &info) {
+    std::lock_guard<std::mutex> lock(initMutex);
     return Napi::Boolean::New(info.Env(), llvm::InitializeNativeTargetAsmPrinter());
 }
 
 static Napi::Value InitializeNativeTargetAsmParser(const Napi::CallbackInfo &info) {
+    std::lock_guard<std::mutex> lock(initMutex);
     return Napi::Boolean::New(info.Env(), llvm::InitializeNativeTargetAsmParser());
 }
 
 static Napi::Value InitializeNativeTargetDisassembler(const Napi::CallbackInfo &info) {
+    std::lock_guard<std::mutex> lock(initMutex);
     return Napi::Boolean::New(info.Env(), llvm::InitializeNativeTargetDisassembler());
 }
 
+bool InitializeNativeCodeGen() {
+    std::lock_guard<std::mutex> lock(initMutex);
+    // both return true on failure
+    return !llvm::InitializeNativeTarget() && !llvm::InitializeNativeTargetAsmPrinter();
+}
+
 void InitTargetSelect(Napi::Env env, Napi::Object &exports) {
     exports.Set(Napi::String::New(env, "InitializeAllTargetInfos"), Napi::Function::New(env, InitializeAllTargetInfos));
     exports.Set(Napi::String::New(env, "InitializeAllTargets"), Napi::Function::New(env, InitializeAllTargets));
@@ -1,6 +1,8 @@
 #include "Support/index.h"
 
 void InitSupport(Napi::Env env, Napi::Object &exports) {
+    CodeGen::Init(env, exports);
     SMDiagnostic::Init(env, exports);
+    sys::Init(env, exports);
     InitTargetSelect(env, exports);
 }
@@ -1,3 +1,11 @@
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/Triple.h>
+#include <optional>
+#include <vector>
+#include <llvm/IR/LegacyPassManager.h>
+#include <llvm/IR/OptBisect.h>
+#include <llvm/Pass.h>
+#include <llvm/Support/FileSystem.h>
 #include "Target/index.h"
 #include "IR/index.h"
 #include "Util/index.h"
@@ -5,33 +13,390 @@
 void TargetMachine::Init(Napi::Env env, Napi::Object &exports) {
     Napi::HandleScope scope(env);
     const Napi::Function func = DefineClass(env, "TargetMachine", {
-            InstanceMethod("createDataLayout", &TargetMachine::createDataLayout)
+            InstanceMethod("createDataLayout", &TargetMachine::guarded<&TargetMachine::createDataLayout>),
+            InstanceMethod("emitToFile", &TargetMachine::guardedVoid<&TargetMachine::emitToFile>),
+            InstanceMethod("emitToBuffer", &TargetMachine::guarded<&TargetMachine::emitToBuffer>),
+            InstanceMethod("emitToFileAsync", &TargetMachine::guarded<&TargetMachine::emitToFileAsync>),
+            InstanceMethod("emitToBufferAsync", &TargetMachine::guarded<&TargetMachine::emitToBufferAsync>),
+            InstanceMethod("dispose", &TargetMachine::dispose)
     });
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
+    DefineSymbolDispose(env, func);
+    constructor.Reset(env, func);
     exports.Set("TargetMachine", func);
 }
 
 Napi::Object TargetMachine::New(Napi::Env env, llvm::TargetMachine *machine) {
-    return constructor.New({Napi::External<llvm::TargetMachine>::New(env, machine)});
+    return constructor.New(env, {Napi::External<llvm::TargetMachine>::New(env, machine)});
+}
+
+Napi::Object TargetMachine::New(Napi::Env env, TargetMachineCache::Lease machine) {
+    Napi::Object object = constructor.New(env, {Napi::External<llvm::TargetMachine>::New(env, machine.get())});
+    // the constructor adopted the bare pointer, swap in the lease
+    TargetMachine *wrapper = Unwrap(object);
+    (void) wrapper->targetMachine.release();
+    wrapper->targetMachine = std::move(machine);
+    return object;
 }
 
 bool TargetMachine::IsClassOf(const Napi::Value &value) {
-    return value.IsNull() || value.As<Napi::Object>().InstanceOf(constructor.Value());
+    return value.IsNull() || hasTypeTag(value, TypeTag::TargetMachine);
 }
 
 TargetMachine::TargetMachine(const Napi::CallbackInfo &info) : ObjectWrap(info) {
+    tagWrapper(info, TypeTag::TargetMachine);
     const Napi::Env env = info.Env();
     if (info.IsConstructCall() && info.Length() == 1 && info[0].IsExternal()) {
         const auto external = info[0].As<Napi::External<llvm::TargetMachine>>();
-        targetMachine = external.Data();
+        targetMachine.reset(external.Data());
         return;
     }
     throw Napi::TypeError::New(env, ErrMsg::Class::TargetMachine::constructor);
 }
 
+TargetMachine::~TargetMachine() = default;
+
+bool TargetMachine::isDisposed() {
+    return targetMachine == nullptr;
+}
+
+bool TargetMachine::isBusy() {
+    return busy;
+}
+
+void TargetMachine::setBusy(bool value) {
+    busy = value;
+}
+
+llvm::TargetMachine *TargetMachine::getLLVMPrimitive() {
+    return targetMachine.get();
+}
+
+bool TargetMachine::ParseFileType(const Napi::Value &value, llvm::CodeGenFileType &fileType) {
+    if (!value.IsString()) {
+        return false;
+    }
+    const std::string kind = value.As<Napi::String>();
+    if (kind == "obj") {
+        fileType = llvm::CGFT_ObjectFile;
+    } else if (kind == "asm") {
+        fileType = llvm::CGFT_AssemblyFile;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// the code generator runs on the legacy pass manager, which has no instrumentation callbacks: its passes ask the
+// gate of the context whether to run, like for opt-bisect, before every function they could skip
+class CancellationGate : public llvm::OptPassGate {
+public:
+    CancellationGate(const CancellationToken &token, llvm::OptPassGate &previous) : token(token), previous(previous) {
+    }
+
+    bool shouldRunPass(const llvm::Pass *pass, llvm::StringRef description) override {
+        if (token.isCancelled()) {
+            return false;
+        }
+        return !previous.isEnabled() || previous.shouldRunPass(pass, description);
+    }
+
+    bool isEnabled() const override {
+        return true;
+    }
+
+private:
+    const CancellationToken &token;
+    llvm::OptPassGate &previous;
+};
+
+// the gate only skips the optional passes, instruction selection, register allocation and the printer still run. All
+// the passes of the code generator run over a function before the next one is started, so this pass, added after
+// them, checks the token between functions: once it is cancelled, the functions left are made available_externally,
+// which the machine passes do not generate code for. Their linkages are restored by Emit after the run
+class CancellationCheckpoint : public llvm::FunctionPass {
+public:
+    using SkippedFunctions = std::vector<std::pair<llvm::Function *, llvm::GlobalValue::LinkageTypes>>;
+
+    static char ID; // NOLINT
+
+    CancellationCheckpoint(const CancellationToken &token, SkippedFunctions &skipped) :
+            llvm::FunctionPass(ID), token(token), skipped(skipped) {
+    }
+
+    bool runOnFunction(llvm::Function &function) override {
+        if (cancelled || !token.isCancelled()) {
+            return false;
+        }
+        cancelled = true;
+        llvm::Module &module = *function.getParent();
+        for (llvm::Function &next: llvm::make_range(std::next(function.getIterator()), module.end())) {
+            if (!next.isDeclaration()) {
+                skipped.emplace_back(&next, next.getLinkage());
+                next.setLinkage(llvm::GlobalValue::AvailableExternallyLinkage);
+            }
+        }
+        return false;
+    }
+
+    void getAnalysisUsage(llvm::AnalysisUsage &usage) const override {
+        usage.setPreservesAll();
+    }
+
+    llvm::StringRef getPassName() const override {
+        return "Cancellation checkpoint";
+    }
+
+private:
+    const CancellationToken &token;
+    SkippedFunctions &skipped;
+    bool cancelled = false;
+};
+
+char CancellationCheckpoint::ID = 0;
+
+// the vendor is left out, 'x86_64-unknown-linux-gnu' and 'x86_64-pc-linux-gnu' name the same platform
+static bool isSamePlatform(const llvm::Triple &triple, const llvm::Triple &other) {
+    return triple.getArch() == other.getArch() && triple.getSubArch() == other.getSubArch() &&
+           triple.getOS() == other.getOS() && triple.getEnvironment() == other.getEnvironment() &&
+           triple.getObjectFormat() == other.getObjectFormat();
+}
+
+const char *TargetMachine::MatchModule(llvm::TargetMachine &machine, llvm::Module &module) {
+    if (module.getTargetTriple().empty()) {
+        module.setTargetTriple(machine.getTargetTriple().str());
+    } else if (!isSamePlatform(llvm::Triple(module.getTargetTriple()), machine.getTargetTriple())) {
+        return ErrMsg::Class::TargetMachine::tripleMismatch;
+    }
+    const llvm::DataLayout dataLayout = machine.createDataLayout();
+    if (module.getDataLayout().isDefault()) {
+        module.setDataLayout(dataLayout);
+    } else if (module.getDataLayout() != dataLayout) {
+        return ErrMsg::Class::TargetMachine::dataLayoutMismatch;
+    }
+    return nullptr;
+}
+
+const char *TargetMachine::Emit(llvm::TargetMachine &machine, llvm::Module &module, llvm::raw_pwrite_stream &stream,
+                                llvm::CodeGenFileType fileType, const CancellationToken *cancellation) {
+    if (const char *mismatch = MatchModule(machine, module)) {
+        return mismatch;
+    }
+    llvm::legacy::PassManager passManager;
+    if (machine.addPassesToEmitFile(passManager, stream, nullptr, fileType)) {
+        return ErrMsg::Class::TargetMachine::cannotEmit;
+    }
+    llvm::LLVMContext &context = module.getContext();
+    llvm::OptPassGate &previous = context.getOptPassGate();
+    std::optional<CancellationGate> gate;
+    CancellationCheckpoint::SkippedFunctions skipped;
+    if (cancellation != nullptr && cancellation->isActive()) {
+        context.setOptPassGate(gate.emplace(*cancellation, previous));
+        // the pass manager owns and deletes the pass
+        passManager.add(new CancellationCheckpoint(*cancellation, skipped));
+    }
+    passManager.run(module);
+    if (gate) {
+        context.setOptPassGate(previous);
+    }
+    for (const auto &[function, linkage]: skipped) {
+        function->setLinkage(linkage);
+    }
+    return nullptr;
+}
+
+//===----------------------------------------------------------------------===//
+// Emission into a file or into memory handed to a Buffer without a copy
+//===----------------------------------------------------------------------===//
+
+using EmitBuffer = llvm::SmallVector<char, 0>;
+
+static Napi::Buffer<char> toBuffer(Napi::Env env, std::unique_ptr<EmitBuffer> emitted) {
+    EmitBuffer *data = emitted.release();
+    // NewOrCopy finalizes right away when it has to copy, where external buffers are not allowed
+    return Napi::Buffer<char>::NewOrCopy(env, data->data(), data->size(), [](Napi::Env, char *, EmitBuffer *buffer) {
+        delete buffer;
+    }, data);
+}
+
+// also throws if the module is locked, and if it has been disposed where Module.Extract would return null
+static llvm::Module &extractModule(const Napi::Value &value) {
+    llvm::Module *module = Module::Extract(value);
+    if (module == nullptr) {
+        throw Napi::Error::New(value.Env(), ErrMsg::Class::Module::disposed);
+    }
+    return *module;
+}
+
+static void emitToStream(Napi::Env env, llvm::TargetMachine &machine, llvm::Module &module,
+                         llvm::raw_pwrite_stream &stream, llvm::CodeGenFileType fileType) {
+    if (const char *error = TargetMachine::Emit(machine, module, stream, fileType)) {
+        throw Napi::Error::New(env, error);
+    }
+}
+
+void TargetMachine::emitToFile(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    llvm::CodeGenFileType fileType;
+    if (info.Length() < 3 || !info[0].IsObject() || !Module::IsClassOf(info[0]) || !info[1].IsString() ||
+        !ParseFileType(info[2], fileType)) {
+        throw Napi::TypeError::New(env, ErrMsg::Class::TargetMachine::emitToFile);
+    }
+    if (busy) {
+        throw Napi::Error::New(env, ErrMsg::Class::TargetMachine::busy);
+    }
+    llvm::Module &module = extractModule(info[0]);
+    const std::string fileName = info[1].As<Napi::String>();
+    std::error_code errorCode;
+    llvm::raw_fd_ostream stream(fileName, errorCode,
+                                fileType == llvm::CGFT_AssemblyFile ? llvm::sys::fs::OF_Text : llvm::sys::fs::OF_None);
+    if (errorCode) {
+        throw Napi::Error::New(env, errorCode.message() + ": " + fileName);
+    }
+    emitToStream(env, *targetMachine, module, stream, fileType);
+    stream.close();
+    Module::UpdateExternalMemory(info[0]);
+    if (stream.has_error()) {
+        const std::string message = stream.error().message() + ": " + fileName;
+        stream.clear_error();
+        throw Napi::Error::New(env, message);
+    }
+}
+
+Napi::Value TargetMachine::emitToBuffer(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    llvm::CodeGenFileType fileType;
+    if (info.Length() < 2 || !info[0].IsObject() || !Module::IsClassOf(info[0]) ||
+        !ParseFileType(info[1], fileType)) {
+        throw Napi::TypeError::New(env, ErrMsg::Class::TargetMachine::emitToBuffer);
+    }
+    if (busy) {
+        throw Napi::Error::New(env, ErrMsg::Class::TargetMachine::busy);
+    }
+    llvm::Module &module = extractModule(info[0]);
+    auto emitted = std::make_unique<EmitBuffer>();
+    {
+        llvm::raw_svector_ostream stream(*emitted);
+        emitToStream(env, *targetMachine, module, stream, fileType);
+    }
+    Module::UpdateExternalMemory(info[0]);
+    return toBuffer(env, std::move(emitted));
+}
+
+class EmitWorker : public ContextWorker {
+public:
+    EmitWorker(Napi::Env env, TargetMachine *machine, const Napi::Object &moduleObj, llvm::CodeGenFileType fileType,
+               std::string fileName) :
+            ContextWorker(env, "llvm.TargetMachine.emitAsync", Module::Unwrap(moduleObj)->getContextWrapper()),
+            machine(machine),
+            moduleObj(Napi::Persistent(moduleObj)),
+            module(Module::Unwrap(moduleObj)->getLLVMPrimitive()),
+            fileType(fileType),
+            fileName(std::move(fileName)) {
+        keepAlive(machine->Value());
+        machine->setBusy(true);
+    }
+
+    ~EmitWorker() override {
+        machine->setBusy(false);
+    }
+
+protected:
+    void Execute() override {
+        if (isCancelled()) {
+            return;
+        }
+        if (fileName.empty()) {
+            emitted = std::make_unique<EmitBuffer>();
+            llvm::raw_svector_ostream stream(*emitted);
+            if (const char *error = TargetMachine::Emit(*machine->getLLVMPrimitive(), *module, stream, fileType,
+                                                        &getCancellation())) {
+                SetError(error);
+            }
+            // the output of an interrupted emission is discarded
+            isCancelled();
+            return;
+        }
+        std::error_code errorCode;
+        llvm::raw_fd_ostream stream(fileName, errorCode,
+                                    fileType == llvm::CGFT_AssemblyFile ? llvm::sys::fs::OF_Text : llvm::sys::fs::OF_None);
+        if (errorCode) {
+            SetError(errorCode.message() + ": " + fileName);
+            return;
+        }
+        if (const char *error = TargetMachine::Emit(*machine->getLLVMPrimitive(), *module, stream, fileType,
+                                                    &getCancellation())) {
+            SetError(error);
+        }
+        isCancelled();
+        stream.close();
+        if (stream.has_error()) {
+            SetError(stream.error().message() + ": " + fileName);
+            stream.clear_error();
+        }
+    }
+
+    Napi::Value Resolve(Napi::Env env) override {
+        Module::UpdateExternalMemory(moduleObj.Value());
+        if (emitted) {
+            return toBuffer(env, std::move(emitted));
+        }
+        return env.Undefined();
+    }
+
+private:
+    TargetMachine *machine;
+    Napi::ObjectReference moduleObj;
+    llvm::Module *module;
+    llvm::CodeGenFileType fileType;
+    // empty when emitting into memory
+    std::string fileName;
+    std::unique_ptr<EmitBuffer> emitted;
+};
+
+Napi::Value TargetMachine::emitToFileAsync(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    llvm::CodeGenFileType fileType;
+    if (info.Length() < 3 || !info[0].IsObject() || !Module::IsClassOf(info[0]) || !info[1].IsString() ||
+        info[1].As<Napi::String>().Utf8Value().empty() || !ParseFileType(info[2], fileType)) {
+        throw Napi::TypeError::New(env, ErrMsg::Class::TargetMachine::emitToFileAsync);
+    }
+    if (busy) {
+        throw Napi::Error::New(env, ErrMsg::Class::TargetMachine::busy);
+    }
+    extractModule(info[0]);
+    CancellationToken cancellation = CancellationToken::FromOptions(env, info[3], ErrMsg::Class::TargetMachine::emitToFileAsync);
+    auto worker = std::make_unique<EmitWorker>(env, this, info[0].As<Napi::Object>(), fileType, info[1].As<Napi::String>());
+    worker->setCancellation(std::move(cancellation));
+    return ContextWorker::Start(std::move(worker));
+}
+
+Napi::Value TargetMachine::emitToBufferAsync(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    llvm::CodeGenFileType fileType;
+    if (info.Length() < 2 || !info[0].IsObject() || !Module::IsClassOf(info[0]) ||
+        !ParseFileType(info[1], fileType)) {
+        throw Napi::TypeError::New(env, ErrMsg::Class::TargetMachine::emitToBufferAsync);
+    }
+    if (busy) {
+        throw Napi::Error::New(env, ErrMsg::Class::TargetMachine::busy);
+    }
+    extractModule(info[0]);
+    CancellationToken cancellation = CancellationToken::FromOptions(env, info[2], ErrMsg::Class::TargetMachine::emitToBufferAsync);
+    auto worker = std::make_unique<EmitWorker>(env, this, info[0].As<Napi::Object>(), fileType, "");
+    worker->setCancellation(std::move(cancellation));
+    return ContextWorker::Start(std::move(worker));
+}
+
 Napi::Value TargetMachine::createDataLayout(const Napi::CallbackInfo &info) {
     const Napi::Env env = info.Env();
-    const llvm::DataLayout &dataLayout = targetMachine->createDataLayout();
-    return DataLayout::New(env, const_cast<llvm::DataLayout *>(&dataLayout));
+    // the layout is returned by value, so hand out a wrapper owning its own copy
+    const llvm::DataLayout dataLayout = targetMachine->createDataLayout();
+    return DataLayout::constructor.New(env, {Napi::String::New(env, dataLayout.getStringRepresentation())});
+}
+
+void TargetMachine::dispose(const Napi::CallbackInfo &info) {
+    if (busy) {
+        throw Napi::Error::New(info.Env(), ErrMsg::Class::TargetMachine::busy);
+    }
+    targetMachine.reset();
 }
@@ -0,0 +1,157 @@
+#include <llvm/ADT/Triple.h>
+#include <llvm/MC/TargetRegistry.h>
+#include "Target/index.h"
+#include "Util/index.h"
+
+void TargetMachineCache::Release::operator()(llvm::TargetMachine *machine) const {
+    if (cache) {
+        cache->release(key, std::unique_ptr<llvm::TargetMachine>(machine));
+    } else {
+        delete machine;
+    }
+}
+
+TargetMachineCache &TargetMachineCache::Global() {
+    static auto *cache = new TargetMachineCache();
+    return *cache;
+}
+
+TargetMachineCache::Lease TargetMachineCache::acquire(const std::string &triple, const std::string &cpu,
+                                                      const std::string &features, const TargetMachineOptions &options,
+                                                      std::string &error) {
+    const std::string normalized = llvm::Triple::normalize(triple);
+    std::string key = normalized + '\0' + cpu + '\0' + features + '\0' + options.key;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto found = index.find(key);
+        if (found != index.end()) {
+            ++hits;
+            std::unique_ptr<llvm::TargetMachine> machine = std::move(found->second->second);
+            idle.erase(found->second);
+            index.erase(found);
+            return Lease(machine.release(), Release{this, std::move(key)});
+        }
+        ++misses;
+    }
+    // building the subtarget tables is the cost being saved, so it does not hold the lock
+    const llvm::Target *target = llvm::TargetRegistry::lookupTarget(normalized, error);
+    if (target == nullptr) {
+        return Lease(nullptr, Release{});
+    }
+    llvm::TargetMachine *machine = target->createTargetMachine(
+            normalized, cpu, features, options.options, options.relocModel, options.codeModel, options.optLevel,
+            options.jit);
+    if (machine == nullptr) {
+        error = "failed to create a TargetMachine for " + normalized;
+        return Lease(nullptr, Release{});
+    }
+    return Lease(machine, Release{this, std::move(key)});
+}
+
+void TargetMachineCache::release(const std::string &key, std::unique_ptr<llvm::TargetMachine> machine) {
+    std::list<Entry> evicted;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (capacity == 0) {
+            ++evictions;
+            return;
+        }
+        idle.emplace_front(key, std::move(machine));
+        index.emplace(key, idle.begin());
+        evicted = trim(capacity);
+    }
+}
+
+std::list<TargetMachineCache::Entry> TargetMachineCache::trim(size_t limit) {
+    std::list<Entry> evicted;
+    while (idle.size() > limit) {
+        auto last = std::prev(idle.end());
+        auto range = index.equal_range(last->first);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == last) {
+                index.erase(it);
+                break;
+            }
+        }
+        evicted.splice(evicted.begin(), idle, last);
+        ++evictions;
+    }
+    return evicted;
+}
+
+void TargetMachineCache::setCapacity(size_t value) {
+    std::list<Entry> evicted;
+    std::lock_guard<std::mutex> lock(mutex);
+    capacity = value;
+    evicted = trim(capacity);
+}
+
+void TargetMachineCache::clear() {
+    std::list<Entry> evicted;
+    std::lock_guard<std::mutex> lock(mutex);
+    evicted = trim(0);
+}
+
+TargetMachineCache::Stats TargetMachineCache::getStats() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return {hits, misses, evictions, idle.size(), capacity};
+}
+
+//===----------------------------------------------------------------------===//
+//                        TargetMachineCache Namespace
+//===----------------------------------------------------------------------===//
+
+static Napi::Value get(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    const unsigned argsLen = info.Length();
+    TargetMachineOptions machineOptions;
+    if (argsLen < 2 || !info[0].IsString() || !info[1].IsString() ||
+        (argsLen >= 3 && !info[2].IsString() && !info[2].IsUndefined()) || !machineOptions.parse(info[3])) {
+        throw Napi::TypeError::New(env, ErrMsg::Namespace::TargetMachineCache::get);
+    }
+    std::string features;
+    if (argsLen >= 3 && info[2].IsString()) {
+        features = info[2].As<Napi::String>();
+    }
+    std::string error;
+    TargetMachineCache::Lease machine = TargetMachineCache::Global().acquire(
+            info[0].As<Napi::String>(), info[1].As<Napi::String>(), features, machineOptions, error);
+    if (!machine) {
+        throw Napi::Error::New(env, error);
+    }
+    return TargetMachine::New(env, std::move(machine));
+}
+
+static Napi::Value getStats(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    const TargetMachineCache::Stats stats = TargetMachineCache::Global().getStats();
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("hits", Napi::Number::New(env, static_cast<double>(stats.hits)));
+    result.Set("misses", Napi::Number::New(env, static_cast<double>(stats.misses)));
+    result.Set("evictions", Napi::Number::New(env, static_cast<double>(stats.evictions)));
+    result.Set("size", Napi::Number::New(env, static_cast<double>(stats.size)));
+    result.Set("capacity", Napi::Number::New(env, static_cast<double>(stats.capacity)));
+    return result;
+}
+
+static void setCapacity(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+    if (info.Length() != 1 || !info[0].IsNumber() || info[0].As<Napi::Number>().DoubleValue() < 0) {
+        throw Napi::TypeError::New(env, ErrMsg::Namespace::TargetMachineCache::setCapacity);
+    }
+    TargetMachineCache::Global().setCapacity(info[0].As<Napi::Number>().Int64Value());
+}
+
+static void clear(const Napi::CallbackInfo &info) {
+    TargetMachineCache::Global().clear();
+}
+
+void TargetMachineCache::Init(Napi::Env env, Napi::Object &exports) {
+    const Napi::Object cacheNS = Napi::Object::New(env);
+    // qualified, since the members of the same names would hide these functions
+    cacheNS.Set("get", Napi::Function::New(env, ::get));
+    cacheNS.Set("getStats", Napi::Function::New(env, ::getStats));
+    cacheNS.Set("setCapacity", Napi::Function::New(env, ::setCapacity));
+    cacheNS.Set("clear", Napi::Function::New(env, ::clear));
+    exports.Set("TargetMachineCache", cacheNS);
+}
@@ -0,0 +1,129 @@
+#include <utility>
+#include "Target/TargetOptions.h"
+
+void TargetOptions::Init(Napi::Env env, Napi::Object &exports) {
+    const Napi::Object floatABINS = Napi::Object::New(env);
+    floatABINS.Set("Default", Napi::Number::New(env, llvm::FloatABI::Default));
+    floatABINS.Set("Soft", Napi::Number::New(env, llvm::FloatABI::Soft));
+    floatABINS.Set("Hard", Napi::Number::New(env, llvm::FloatABI::Hard));
+
+    const Napi::Object fpOpFusionNS = Napi::Object::New(env);
+    fpOpFusionNS.Set("Fast", Napi::Number::New(env, llvm::FPOpFusion::Fast));
+    fpOpFusionNS.Set("Standard", Napi::Number::New(env, llvm::FPOpFusion::Standard));
+    fpOpFusionNS.Set("Strict", Napi::Number::New(env, llvm::FPOpFusion::Strict));
+
+    exports.Set("FloatABI", floatABINS);
+    exports.Set("FPOpFusion", fpOpFusionNS);
+}
+
+// the flags of llvm::TargetOptions are bit-fields, so they are set through a function each
+struct FlagOption {
+    const char *name;
+
+    void (*set)(llvm::TargetOptions &options, bool value);
+};
+
+static const FlagOption flagOptions[] = {
+        {"unsafeFPMath", [](llvm::TargetOptions &options, bool value) { options.UnsafeFPMath = value; }},
+        {"noInfsFPMath", [](llvm::TargetOptions &options, bool value) { options.NoInfsFPMath = value; }},
+        {"noNaNsFPMath", [](llvm::TargetOptions &options, bool value) { options.NoNaNsFPMath = value; }},
+        {"noTrappingFPMath", [](llvm::TargetOptions &options, bool value) { options.NoTrappingFPMath = value; }},
+        {"noSignedZerosFPMath", [](llvm::TargetOptions &options, bool value) { options.NoSignedZerosFPMath = value; }},
+        {"approxFuncFPMath", [](llvm::TargetOptions &options, bool value) { options.ApproxFuncFPMath = value; }},
+        {"enableFastISel", [](llvm::TargetOptions &options, bool value) { options.EnableFastISel = value; }},
+        {"enableGlobalISel", [](llvm::TargetOptions &options, bool value) { options.EnableGlobalISel = value; }},
+        {"guaranteedTailCallOpt", [](llvm::TargetOptions &options, bool value) { options.GuaranteedTailCallOpt = value; }},
+        {"functionSections", [](llvm::TargetOptions &options, bool value) { options.FunctionSections = value; }},
+        {"dataSections", [](llvm::TargetOptions &options, bool value) { options.DataSections = value; }},
+        {"uniqueSectionNames", [](llvm::TargetOptions &options, bool value) { options.UniqueSectionNames = value; }},
+        {"trapUnreachable", [](llvm::TargetOptions &options, bool value) { options.TrapUnreachable = value; }},
+        {"enableIPRA", [](llvm::TargetOptions &options, bool value) { options.EnableIPRA = value; }},
+        {"enableMachineOutliner", [](llvm::TargetOptions &options, bool value) { options.EnableMachineOutliner = value; }},
+        {"emitStackSizeSection", [](llvm::TargetOptions &options, bool value) { options.EmitStackSizeSection = value; }},
+        {"emitAddrsig", [](llvm::TargetOptions &options, bool value) { options.EmitAddrsig = value; }},
+        // otherwise the default of the triple wins over the flag
+        {"emulatedTLS", [](llvm::TargetOptions &options, bool value) {
+            options.EmulatedTLS = value;
+            options.ExplicitEmulatedTLS = true;
+        }},
+};
+
+// an enumerator in [0, last], or undefined
+static bool getEnumOption(const Napi::Object &object, const char *key, int last, llvm::Optional<int> &result) {
+    const Napi::Value value = object.Get(key);
+    if (value.IsUndefined()) {
+        return true;
+    }
+    if (!value.IsNumber()) {
+        return false;
+    }
+    const int64_t number = value.As<Napi::Number>().Int64Value();
+    if (number < 0 || number > last || number != value.As<Napi::Number>().DoubleValue()) {
+        return false;
+    }
+    result = static_cast<int>(number);
+    return true;
+}
+
+bool TargetMachineOptions::parse(const Napi::Value &value) {
+    if (value.IsUndefined()) {
+        return true;
+    }
+    if (!value.IsObject()) {
+        return false;
+    }
+    const auto object = value.As<Napi::Object>();
+    for (const FlagOption &flag: flagOptions) {
+        const Napi::Value flagValue = object.Get(flag.name);
+        if (flagValue.IsUndefined()) {
+            continue;
+        }
+        if (!flagValue.IsBoolean()) {
+            return false;
+        }
+        const bool enabled = flagValue.As<Napi::Boolean>();
+        flag.set(options, enabled);
+        key += std::string(flag.name) + (enabled ? "=1;" : "=0;");
+    }
+    llvm::Optional<int> reloc, code, opt, floatABI, fpOpFusion;
+    if (!getEnumOption(object, "relocModel", llvm::Reloc::ROPI_RWPI, reloc) ||
+        !getEnumOption(object, "codeModel", llvm::CodeModel::Large, code) ||
+        !getEnumOption(object, "optLevel", llvm::CodeGenOpt::Aggressive, opt) ||
+        !getEnumOption(object, "floatABIType", llvm::FloatABI::Hard, floatABI) ||
+        !getEnumOption(object, "allowFPOpFusion", llvm::FPOpFusion::Strict, fpOpFusion)) {
+        return false;
+    }
+    const std::pair<const char *, llvm::Optional<int>> enumOptions[] = {
+            {"relocModel", reloc}, {"codeModel", code}, {"optLevel", opt}, {"floatABIType", floatABI},
+            {"allowFPOpFusion", fpOpFusion}
+    };
+    for (const auto &[name, enumerator]: enumOptions) {
+        if (enumerator) {
+            key += std::string(name) + '=' + std::to_string(*enumerator) + ';';
+        }
+    }
+    if (reloc) {
+        relocModel = static_cast<llvm::Reloc::Model>(*reloc);
+    }
+    if (code) {
+        codeModel = static_cast<llvm::CodeModel::Model>(*code);
+    }
+    if (opt) {
+        optLevel = static_cast<llvm::CodeGenOpt::Level>(*opt);
+    }
+    if (floatABI) {
+        options.FloatABIType = static_cast<llvm::FloatABI::ABIType>(*floatABI);
+    }
+    if (fpOpFusion) {
+        options.AllowFPOpFusion = static_cast<llvm::FPOpFusion::FPOpFusionMode>(*fpOpFusion);
+    }
+    const Napi::Value jitValue = object.Get("jit");
+    if (!jitValue.IsUndefined()) {
+        if (!jitValue.IsBoolean()) {
+            return false;
+        }
+        jit = jitValue.As<Napi::Boolean>();
+        key += jit ? "jit=1;" : "jit=0;";
+    }
+    return true;
+}
@@ -2,4 +2,6 @@
 
 void InitTarget(Napi::Env env, Napi::Object &exports) {
     TargetMachine::Init(env, exports);
+    TargetMachineCache::Init(env, exports);
+    TargetOptions::Init(env, exports);
 }
@@ -0,0 +1,30 @@
+#include <atomic>
+#include "Util/AddonData.h"
+
+AddonData &AddonData::Get(Napi::Env env) {
+    return *env.GetInstanceData<AddonData>();
+}
+
+std::size_t AddonData::NewConstructorSlot() {
+    static std::atomic<std::size_t> slotCount{0};
+    return slotCount++;
+}
+
+ConstructorReference::ConstructorReference() : slot(AddonData::NewConstructorSlot()) {
+}
+
+void ConstructorReference::Reset(Napi::Env env, const Napi::Function &func) {
+    std::vector<Napi::FunctionReference> &constructors = AddonData::Get(env).constructors;
+    if (constructors.size() <= slot) {
+        constructors.resize(slot + 1);
+    }
+    constructors[slot] = Napi::Persistent(func);
+}
+
+Napi::Function ConstructorReference::Value(Napi::Env env) const {
+    return AddonData::Get(env).constructors[slot].Value();
+}
+
+Napi::Object ConstructorReference::New(Napi::Env env, const std::initializer_list<napi_value> &args) const {
+    return AddonData::Get(env).constructors[slot].New(args);
+}
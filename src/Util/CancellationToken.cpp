@@ -0,0 +1,80 @@
+#include <algorithm>
+#include "Util/CancellationToken.h"
+
+CancellationToken CancellationToken::FromOptions(Napi::Env env, const Napi::Value &options, const char *errMsg) {
+    CancellationToken token;
+    if (options.IsUndefined()) {
+        return token;
+    }
+    if (!options.IsObject()) {
+        throw Napi::TypeError::New(env, errMsg);
+    }
+    const auto object = options.As<Napi::Object>();
+    const Napi::Value timeout = object.Get("timeout");
+    if (!timeout.IsUndefined()) {
+        if (!timeout.IsNumber()) {
+            throw Napi::TypeError::New(env, errMsg);
+        }
+        const int64_t milliseconds = std::max<int64_t>(timeout.As<Napi::Number>().Int64Value(), 0);
+        token.hasDeadline = true;
+        token.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(milliseconds);
+    }
+    const Napi::Value signal = object.Get("signal");
+    if (!signal.IsUndefined()) {
+        if (!signal.IsObject() || !signal.As<Napi::Object>().Get("addEventListener").IsFunction()) {
+            throw Napi::TypeError::New(env, errMsg);
+        }
+        const auto signalObj = signal.As<Napi::Object>();
+        token.aborted = std::make_shared<std::atomic<bool>>(signalObj.Get("aborted").ToBoolean().Value());
+        std::shared_ptr<std::atomic<bool>> flag = token.aborted;
+        const Napi::Function listener = Napi::Function::New(env, [flag](const Napi::CallbackInfo &) {
+            flag->store(true);
+        }, "onAbort");
+        Napi::Object listenerOptions = Napi::Object::New(env);
+        listenerOptions.Set("once", true);
+        signalObj.Get("addEventListener").As<Napi::Function>().Call(signalObj, {
+                Napi::String::New(env, "abort"), listener, listenerOptions
+        });
+        token.signal = Napi::Persistent(signalObj);
+        token.listener = Napi::Persistent(listener);
+    }
+    return token;
+}
+
+bool CancellationToken::isActive() const {
+    return aborted || hasDeadline;
+}
+
+bool CancellationToken::isCancelled() const {
+    if (aborted && aborted->load(std::memory_order_relaxed)) {
+        return true;
+    }
+    return hasDeadline && std::chrono::steady_clock::now() >= deadline;
+}
+
+Napi::Value CancellationToken::getReason(Napi::Env env) const {
+    const bool byAbort = aborted && aborted->load();
+    if (byAbort && !signal.IsEmpty()) {
+        const Napi::Value reason = signal.Value().Get("reason");
+        if (!reason.IsUndefined()) {
+            return reason;
+        }
+    }
+    Napi::Error error = Napi::Error::New(env, byAbort ? "The operation was aborted" : "The operation timed out");
+    error.Value().Set("name", Napi::String::New(env, byAbort ? "AbortError" : "TimeoutError"));
+    return error.Value();
+}
+
+void CancellationToken::detach() {
+    if (signal.IsEmpty()) {
+        return;
+    }
+    const Napi::Env env = signal.Env();
+    const Napi::Object signalObj = signal.Value();
+    const Napi::Value removeEventListener = signalObj.Get("removeEventListener");
+    if (removeEventListener.IsFunction()) {
+        removeEventListener.As<Napi::Function>().Call(signalObj, {Napi::String::New(env, "abort"), listener.Value()});
+    }
+    signal.Reset();
+    listener.Reset();
+}
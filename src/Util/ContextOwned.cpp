@@ -0,0 +1,98 @@
+#include <llvm/IR/Function.h>
+#include "Util/ContextOwned.h"
+#include "Util/ErrMsg.h"
+
+void ContextState::invalidate(const llvm::Value *value) {
+    if (wrappers.empty()) {
+        return;
+    }
+    if (const auto *function = llvm::dyn_cast<llvm::Function>(value)) {
+        if (!function->hasLazyArguments()) {
+            for (const llvm::Argument &argument : function->args()) {
+                invalidateOne(&argument);
+            }
+        }
+        for (const llvm::BasicBlock &basicBlock : *function) {
+            invalidate(&basicBlock);
+        }
+    } else if (const auto *basicBlock = llvm::dyn_cast<llvm::BasicBlock>(value)) {
+        for (const llvm::Instruction &inst : *basicBlock) {
+            invalidateOne(&inst);
+        }
+    }
+    invalidateOne(value);
+}
+
+void ContextState::invalidate(const llvm::Module *module) {
+    for (const llvm::Function &function : *module) {
+        invalidate(&function);
+    }
+    for (const llvm::GlobalVariable &global : module->globals()) {
+        invalidateOne(&global);
+    }
+    for (const llvm::GlobalAlias &alias : module->aliases()) {
+        invalidateOne(&alias);
+    }
+    for (const llvm::GlobalIFunc &ifunc : module->ifuncs()) {
+        invalidateOne(&ifunc);
+    }
+}
+
+void ContextState::invalidateOne(const void *primitive) {
+    auto iter = wrappers.find(primitive);
+    if (iter != wrappers.end()) {
+        iter->second->invalidate();
+        wrappers.erase(iter);
+    }
+}
+
+ContextOwned::~ContextOwned() {
+    if (state && !invalidated) {
+        auto iter = state->wrappers.find(getRootAddress());
+        if (iter != state->wrappers.end() && iter->second == this) {
+            state->wrappers.erase(iter);
+        }
+    }
+}
+
+void ContextOwned::bind(std::shared_ptr<ContextState> contextState, const llvm::Value *value) {
+    setRoot(value);
+    bindState(std::move(contextState));
+}
+
+void ContextOwned::bind(std::shared_ptr<ContextState> contextState, const llvm::Type *type) {
+    setRoot(type);
+    bindState(std::move(contextState));
+    isType = true;
+}
+
+void ContextOwned::bindState(std::shared_ptr<ContextState> contextState) {
+    state = std::move(contextState);
+    state->wrappers[getRootAddress()] = this;
+}
+
+void ContextOwned::retainOwner(const Napi::Object &object) {
+    owner = Napi::Persistent(object);
+}
+
+void ContextOwned::invalidate() {
+    invalidated = true;
+}
+
+void ContextOwned::checkUsable(Napi::Env env) const {
+    if (state == nullptr) {
+        return;
+    }
+    if (invalidated || state->released) {
+        throw Napi::Error::New(env, isType ? ErrMsg::Class::Type::disposed : ErrMsg::Class::Value::disposed);
+    }
+    if (state->locked) {
+        throw Napi::Error::New(env, ErrMsg::Class::LLVMContext::locked);
+    }
+}
+
+void ContextOwned::invalidateTree(const llvm::Value *value) {
+    if (state) {
+        state->invalidate(value);
+    }
+}
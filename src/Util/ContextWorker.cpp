@@ -0,0 +1,68 @@
+#include "Util/ContextWorker.h"
+#include "IR/LLVMContext.h"
+#include "Util/ErrMsg.h"
+
+ContextWorker::ContextWorker(Napi::Env env, const char *resourceName, LLVMContext *context) :
+        Napi::AsyncWorker(env, resourceName), deferred(Napi::Promise::Deferred::New(env)), context(context) {
+}
+
+Napi::Promise ContextWorker::Start(std::unique_ptr<ContextWorker> worker) {
+    if (worker->context) {
+        if (worker->context->isLocked()) {
+            worker->cancellation.detach();
+            throw Napi::Error::New(worker->Env(), ErrMsg::Class::LLVMContext::locked);
+        }
+        worker->context->lock();
+        worker->keepAlive(worker->context->Value());
+    }
+    const Napi::Promise promise = worker->deferred.Promise();
+    // the worker deletes itself once the promise is settled
+    worker.release()->Queue();
+    return promise;
+}
+
+void ContextWorker::keepAlive(const Napi::Value &value) {
+    refs.push_back(Napi::Persistent(value));
+}
+
+void ContextWorker::setCancellation(CancellationToken token) {
+    cancellation = std::move(token);
+}
+
+bool ContextWorker::isCancelled() {
+    if (!cancelled && cancellation.isCancelled()) {
+        cancelled = true;
+    }
+    return cancelled;
+}
+
+const CancellationToken &ContextWorker::getCancellation() const {
+    return cancellation;
+}
+
+void ContextWorker::OnOK() {
+    release();
+    if (cancelled) {
+        deferred.Reject(cancellation.getReason(Env()));
+        cancellation.detach();
+        return;
+    }
+    cancellation.detach();
+    try {
+        deferred.Resolve(Resolve(Env()));
+    } catch (const Napi::Error &error) {
+        deferred.Reject(error.Value());
+    }
+}
+
+void ContextWorker::OnError(const Napi::Error &error) {
+    release();
+    cancellation.detach();
+    deferred.Reject(error.Value());
+}
+
+void ContextWorker::release() {
+    if (context) {
+        context->unlock();
+    }
+}
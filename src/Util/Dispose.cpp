@@ -0,0 +1,12 @@
+#include "Util/Dispose.h"
+
+void DefineSymbolDispose(Napi::Env env, Napi::Function ctor) {
+    const Napi::Object global = env.Global();
+    Napi::Object Symbol = global.Get("Symbol").As<Napi::Object>(); // NOLINT
+    const Napi::Value symbolDispose = Symbol.Get("dispose");
+    if (!symbolDispose.IsSymbol()) {
+        return;
+    }
+    Napi::Object proto = ctor.Get("prototype").As<Napi::Object>();
+    proto.Set(symbolDispose, proto.Get("dispose"));
+}
@@ -0,0 +1,45 @@
+#include <unordered_map>
+#include "Util/HierarchyWrapper.h"
+
+// wrappers are only created and finalized on the thread of their environment, each thread has its own registry
+static thread_local std::unordered_map<const void *, HierarchyWrapper *> registry; // NOLINT
+
+HierarchyWrapper::~HierarchyWrapper() {
+    if (key == nullptr) {
+        return;
+    }
+    auto iter = registry.find(key);
+    if (iter != registry.end() && iter->second == this) {
+        registry.erase(iter);
+    }
+}
+
+HierarchyWrapper *HierarchyWrapper::Find(const Napi::Object &object) {
+    void *wrapper = nullptr;
+    if (napi_unwrap(object.Env(), object, &wrapper) != napi_ok || wrapper == nullptr) {
+        return nullptr;
+    }
+    auto iter = registry.find(wrapper);
+    return iter != registry.end() ? iter->second : nullptr;
+}
+
+void HierarchyWrapper::setRoot(const llvm::Value *value) {
+    root = value;
+}
+
+void HierarchyWrapper::setRoot(const llvm::Type *type) {
+    root = type;
+}
+
+void HierarchyWrapper::setRoot(const llvm::Metadata *metadata) {
+    root = metadata;
+}
+
+const void *HierarchyWrapper::getRootAddress() const {
+    return root;
+}
+
+void HierarchyWrapper::registerKey(const void *wrapperKey) {
+    key = wrapperKey;
+    registry[key] = this;
+}
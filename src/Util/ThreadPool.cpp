@@ -0,0 +1,91 @@
+#include <algorithm>
+#include "Util/ThreadPool.h"
+
+// the pool and the index of the worker running on the current thread
+static thread_local const ThreadPool *currentPool = nullptr;
+static thread_local unsigned currentWorker = 0;
+
+ThreadPool::ThreadPool(unsigned threadCount) {
+    threadCount = std::max(threadCount, 1u);
+    for (unsigned i = 0; i < threadCount; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    for (unsigned i = 0; i < threadCount; ++i) {
+        threads.emplace_back(&ThreadPool::run, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> guard(sleepMutex);
+        stopping = true;
+    }
+    wakeup.notify_all();
+    for (std::thread &thread: threads) {
+        thread.join();
+    }
+    // the threads take no task once stopping is set, what is left is dropped without running
+    for (std::unique_ptr<Worker> &worker: workers) {
+        worker->tasks.clear();
+    }
+    queued = 0;
+}
+
+void ThreadPool::async(std::function<void()> task) {
+    const unsigned index = currentPool == this ? currentWorker : nextWorker++ % workers.size();
+    {
+        std::lock_guard<std::mutex> guard(workers[index]->mutex);
+        workers[index]->tasks.push_back(std::move(task));
+        ++queued;
+    }
+    // taking the lock orders the increment before a sleeping thread checks it
+    {
+        std::lock_guard<std::mutex> guard(sleepMutex);
+    }
+    wakeup.notify_one();
+}
+
+unsigned ThreadPool::getThreadCount() const {
+    return threads.size();
+}
+
+bool ThreadPool::take(unsigned index, std::function<void()> &task) {
+    // newest task of the own deque first
+    {
+        Worker &own = *workers[index];
+        std::lock_guard<std::mutex> guard(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            --queued;
+            return true;
+        }
+    }
+    // then the oldest task of another one
+    for (std::size_t i = 1; i < workers.size(); ++i) {
+        Worker &victim = *workers[(index + i) % workers.size()];
+        std::lock_guard<std::mutex> guard(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            --queued;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::run(unsigned index) {
+    currentPool = this;
+    currentWorker = index;
+    std::function<void()> task;
+    while (!stopping) {
+        if (take(index, task)) {
+            task();
+            task = nullptr;
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeup.wait(lock, [this] { return stopping || queued > 0; });
+    }
+}
@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <llvm/IR/Argument.h>
+#include <llvm/IR/BasicBlock.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/GlobalValue.h>
+#include <llvm/IR/Instruction.h>
+#include "Util/WrapperCache.h"
+#include "Util/AddonData.h"
+
+static Napi::Symbol getOwnerKey(Napi::Env env) {
+    Napi::Reference<Napi::Symbol> &ownerKey = AddonData::Get(env).ownerKey;
+    if (ownerKey.IsEmpty()) {
+        ownerKey = Napi::Persistent(Napi::Symbol::New(env, "owner"));
+    }
+    return ownerKey.Value();
+}
+
+static const llvm::Module *getParentModule(const llvm::Value *value) {
+    const llvm::Function *function = nullptr;
+    if (const auto *global = llvm::dyn_cast<llvm::GlobalValue>(value)) {
+        return global->getParent();
+    } else if (const auto *argument = llvm::dyn_cast<llvm::Argument>(value)) {
+        function = argument->getParent();
+    } else if (const auto *basicBlock = llvm::dyn_cast<llvm::BasicBlock>(value)) {
+        function = basicBlock->getParent();
+    } else if (const auto *inst = llvm::dyn_cast<llvm::Instruction>(value)) {
+        function = inst->getParent() ? inst->getParent()->getParent() : nullptr;
+    }
+    return function ? function->getParent() : nullptr;
+}
+
+WrapperCache &WrapperCache::Get(Napi::Env env, llvm::LLVMContext &context) {
+    return AddonData::Get(env).wrapperCaches[&context];
+}
+
+void WrapperCache::Drop(Napi::Env env, llvm::LLVMContext &context) {
+    auto &caches = AddonData::Get(env).wrapperCaches;
+    auto iter = caches.find(&context);
+    if (iter == caches.end()) {
+        return;
+    }
+    // the wrappers still alive see the state they are bound to as released
+    ContextState &state = *iter->second.state;
+    state.released = true;
+    state.wrappers.clear();
+    caches.erase(iter);
+}
+
+Napi::Object WrapperCache::lookup(const void *primitive, unsigned kind) {
+    auto iter = entries.find(primitive);
+    if (iter == entries.end()) {
+        return {};
+    }
+    // a wrapper whose primitive has been freed is dropped from the state, a new primitive at the same address
+    // needs a new wrapper
+    if (iter->second.kind == kind && state->wrappers.count(primitive) != 0) {
+        Napi::Object wrapper = iter->second.ref.Value();
+        if (!wrapper.IsEmpty()) {
+            return wrapper;
+        }
+    }
+    entries.erase(iter);
+    return {};
+}
+
+void WrapperCache::insert(const void *primitive, unsigned kind, const Napi::Object &wrapper) {
+    if (entries.size() >= sweepThreshold) {
+        sweep();
+    }
+    entries[primitive] = Entry{kind, Napi::Weak(wrapper)};
+}
+
+void WrapperCache::setContext(const Napi::Object &object) {
+    context = Napi::Weak(object);
+}
+
+Napi::Object WrapperCache::getContext() {
+    return context.IsEmpty() ? Napi::Object() : context.Value();
+}
+
+void WrapperCache::registerModule(const llvm::Module *module, const Napi::Object &wrapper) {
+    modules[module] = Napi::Weak(wrapper);
+}
+
+void WrapperCache::unregisterModule(const llvm::Module *module) {
+    modules.erase(module);
+}
+
+Napi::Object WrapperCache::lookupModule(const llvm::Module *module) {
+    auto iter = modules.find(module);
+    if (iter == modules.end()) {
+        return {};
+    }
+    return iter->second.Value();
+}
+
+const std::shared_ptr<ContextState> &WrapperCache::getState() const {
+    return state;
+}
+
+void WrapperCache::retainOwner(ContextOwned &owned, const llvm::Value *value) {
+    Napi::Object owner;
+    if (const llvm::Module *module = getParentModule(value)) {
+        owner = lookupModule(module);
+    }
+    if (owner.IsEmpty()) {
+        owner = getContext();
+    }
+    if (!owner.IsEmpty()) {
+        owned.retainOwner(owner);
+    }
+}
+
+void WrapperCache::retainOwner(ContextOwned &owned, const llvm::Type *) {
+    const Napi::Object owner = getContext();
+    if (!owner.IsEmpty()) {
+        owned.retainOwner(owner);
+    }
+}
+
+void WrapperCache::RetainOwner(Napi::Object object, const Napi::Object &owner) {
+    object.DefineProperty(Napi::PropertyDescriptor::Value(getOwnerKey(object.Env()), owner, napi_default));
+}
+
+void WrapperCache::sweep() {
+    for (auto iter = entries.begin(); iter != entries.end();) {
+        if (iter->second.ref.Value().IsEmpty()) {
+            iter = entries.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+    sweepThreshold = std::max<std::size_t>(1024, entries.size() * 2);
+}
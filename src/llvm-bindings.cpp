@@ -2,22 +2,30 @@
 #include "BinaryFormat/index.h"
 #include "Bitcode/index.h"
 #include "Config/index.h"
+#include "ExecutionEngine/index.h"
 #include "IR/index.h"
 #include "IRReader/index.h"
 #include "Linker/index.h"
 #include "MC/index.h"
+#include "Passes/index.h"
+#include "Pipeline/index.h"
 #include "Support/index.h"
 #include "Target/index.h"
+#include "Util/index.h"
 
 Napi::Object Init(Napi::Env env, Napi::Object exports) {
+    env.SetInstanceData(new AddonData());
     InitADT(env, exports);
     InitBinaryFormat(env, exports);
     InitBitCode(env, exports);
     InitConfig(env, exports);
+    InitExecutionEngine(env, exports);
     InitIR(env, exports);
     InitIRReader(env, exports);
     InitLinker(env, exports);
     InitMC(env, exports);
+    InitPasses(env, exports);
+    InitPipeline(env, exports);
     InitSupport(env, exports);
     InitTarget(env, exports);
     return exports;
@@ -23,4 +23,36 @@ describe('Test BitcodeWriter', () => {
         llvm.WriteBitcodeToFile(module, outputBitcodeFileName);
         expect(fs.existsSync(outputBitcodeFileName)).toBe(true);
     });
+
+    test('Test llvm.WriteBitcodeToFileAsync and llvm.parseIRFileAsync', () => {
+        const context = new llvm.LLVMContext();
+        const module = new llvm.Module(path.basename(__filename), context);
+        const funcType = llvm.FunctionType.get(llvm.Type.getVoidTy(context), false);
+        llvm.Function.Create(funcType, llvm.Function.LinkageTypes.ExternalLinkage, 'func', module);
+        const written = llvm.WriteBitcodeToFileAsync(module, outputBitcodeFileName);
+        expect(() => module.getName()).toThrowError('LLVMContext is locked by a pending asynchronous operation');
+        expect(() => llvm.verifyModuleAsync(module)).toThrowError('LLVMContext is locked by a pending asynchronous operation');
+        return written.then(() => {
+            expect(module.getName()).toEqual(path.basename(__filename));
+            const otherContext = new llvm.LLVMContext();
+            return llvm.parseIRFileAsync(outputBitcodeFileName, new llvm.SMDiagnostic(), otherContext);
+        }).then(parsed => {
+            expect(parsed).toBeInstanceOf(llvm.Module);
+            expect(parsed!.getFunction('func')).toBeInstanceOf(llvm.Function);
+            return llvm.parseIRFileAsync('does-not-exist.bc', new llvm.SMDiagnostic(), new llvm.LLVMContext());
+        }).then(parsed => {
+            expect(parsed).toBeNull();
+        });
+    });
+
+    test('Test llvm.WriteBitcodeToFileAsync Failure', () => {
+        const context = new llvm.LLVMContext();
+        const module = new llvm.Module(path.basename(__filename), context);
+        return llvm.WriteBitcodeToFileAsync(module, path.join('no-such-directory', outputBitcodeFileName)).then(() => {
+            throw new Error('WriteBitcodeToFileAsync should have failed');
+        }, (error: Error) => {
+            expect(error.message).toContain('no-such-directory');
+            expect(module.empty()).toEqual(true);
+        });
+    });
 });
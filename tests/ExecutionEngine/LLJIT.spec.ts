@@ -0,0 +1,139 @@
+import llvm from '../..';
+
+function createModule(context: llvm.LLVMContext, jit: llvm.LLJIT): llvm.Module {
+    const module = new llvm.Module('jit', context);
+    module.setDataLayout(jit.getDataLayout());
+    module.setTargetTriple(jit.getTargetTriple());
+    const builder = new llvm.IRBuilder(context);
+    const funcType = llvm.FunctionType.get(builder.getInt32Ty(), [builder.getInt32Ty(), builder.getInt32Ty()], false);
+    const func = llvm.Function.Create(funcType, llvm.Function.LinkageTypes.ExternalLinkage, 'add', module);
+    builder.SetInsertPoint(llvm.BasicBlock.Create(context, 'entry', func));
+    builder.CreateRet(builder.CreateAdd(func.getArg(0), func.getArg(1)));
+    const doubleTy = builder.getDoubleTy();
+    const loadType = llvm.FunctionType.get(doubleTy, [builder.getInt8PtrTy()], false);
+    const load = llvm.Function.Create(loadType, llvm.Function.LinkageTypes.ExternalLinkage, 'load', module);
+    builder.SetInsertPoint(llvm.BasicBlock.Create(context, 'entry', load));
+    builder.CreateRet(builder.CreateLoad(doubleTy, builder.CreateBitCast(load.getArg(0), doubleTy.getPointerTo())));
+    return module;
+}
+
+describe('Test LLJIT', () => {
+    test('Test llvm.LLJIT.addModule and lookup', () => {
+        const jit = new llvm.LLJIT({ optLevel: llvm.CodeGenOpt.Less });
+        expect(jit.getTargetTriple()).toContain('-');
+        const context = new llvm.LLVMContext();
+        const module = createModule(context, jit);
+        const add = module.getFunction('add') as llvm.Function;
+        const int32Type = add.getReturnType();
+        jit.addModule(module);
+        expect(() => module.print()).toThrowError('Module has been disposed');
+        expect(() => context.dispose()).not.toThrow();
+        expect(() => add.getName()).toThrowError('Value has been erased, or freed along with its Module or LLVMContext');
+        expect(() => add.getArg(0)).toThrowError('Value has been erased');
+        expect(() => int32Type.isIntegerTy()).toThrowError('Type has been freed along with its LLVMContext');
+        const address = jit.lookup('add');
+        expect(typeof address).toEqual('bigint');
+        expect(address.toString()).not.toEqual('0');
+        expect(() => jit.lookup('missing')).toThrowError('missing');
+        jit.dispose();
+        expect(() => jit.lookup('add')).toThrowError('LLJIT has been disposed');
+    });
+
+    test('Test llvm.LLJIT with a shared context', () => {
+        const jit = new llvm.LLJIT();
+        const context = new llvm.LLVMContext();
+        const module = createModule(context, jit);
+        const other = new llvm.Module('other', context);
+        expect(() => jit.addModule(module)).toThrowError('must not own any other module');
+        other.dispose();
+        jit.addModule(module);
+        expect(jit.lookup('add').toString()).not.toEqual('0');
+        expect(() => new llvm.LLJIT({ optLevel: 9 })).toThrow(TypeError);
+    });
+
+    test('Test llvm.LLJIT.getFunction', () => {
+        const jit = new llvm.LLJIT();
+        jit.addModule(createModule(new llvm.LLVMContext(), jit));
+        const add = jit.getFunction('add', { result: 'i32', params: ['i32', 'i32'] });
+        expect(add(2, 3)).toEqual(5);
+        expect(add(-7, 2)).toEqual(-5);
+        expect(() => add(1)).toThrow(TypeError);
+        expect(() => add('1', 2)).toThrow(TypeError);
+        const load = jit.getFunction('load', { result: 'f64', params: ['ptr'] });
+        expect(load(new Float64Array([1.5, 2]))).toEqual(1.5);
+        expect(() => load(1.5)).toThrow(TypeError);
+        expect(() => jit.getFunction('add', { result: 'ptr' })).toThrow(TypeError);
+        expect(() => jit.getFunction('add', { params: ['void'] })).toThrow(TypeError);
+        expect(() => jit.getFunction('missing', {})).toThrow(TypeError);
+        expect(() => jit.getFunction('missing', { unchecked: true })).toThrowError('missing');
+        expect(() => jit.getFunction('add', { result: 'i32', params: ['i32', 'i32'], unchecked: 1 } as unknown as llvm.NativeSignature)).toThrow(TypeError);
+        expect(() => jit.getFunction('add', { result: 'f64', params: ['i32', 'i32'] })).toThrow(TypeError);
+        expect(() => jit.getFunction('add', { result: 'i32', params: ['i32'] })).toThrow(TypeError);
+        const addUnsigned = jit.getFunction('add', { result: 'u32', params: ['u32', 'u32'] });
+        expect(addUnsigned(2, 3)).toEqual(5);
+        expect(jit.getFunction('add', { result: 'i32', params: ['i32', 'i32'] })(1, 1)).toEqual(2);
+        jit.dispose();
+        expect(() => add(2, 3)).toThrowError('LLJIT has been disposed');
+    });
+
+    test('Test llvm.LLJIT.getFunction with types no signature matches', () => {
+        const jit = new llvm.LLJIT();
+        const context = new llvm.LLVMContext();
+        const module = new llvm.Module('jit', context);
+        module.setDataLayout(jit.getDataLayout());
+        module.setTargetTriple(jit.getTargetTriple());
+        const builder = new llvm.IRBuilder(context);
+        const firstType = llvm.FunctionType.get(builder.getInt32Ty(), [builder.getInt32Ty()], true);
+        const first = llvm.Function.Create(firstType, llvm.Function.LinkageTypes.ExternalLinkage, 'first', module);
+        builder.SetInsertPoint(llvm.BasicBlock.Create(context, 'entry', first));
+        builder.CreateRet(first.getArg(0));
+        const widenType = llvm.FunctionType.get(builder.getInt32Ty(), [builder.getInt16Ty()], false);
+        const widen = llvm.Function.Create(widenType, llvm.Function.LinkageTypes.ExternalLinkage, 'widen', module);
+        builder.SetInsertPoint(llvm.BasicBlock.Create(context, 'entry', widen));
+        builder.CreateRet(builder.CreateSExt(widen.getArg(0), builder.getInt32Ty()));
+        jit.addModule(module);
+        expect(() => jit.getFunction('first', { result: 'i32', params: ['i32'] })).toThrow(TypeError);
+        expect(() => jit.getFunction('first', { result: 'i32' })).toThrow(TypeError);
+        expect(() => jit.getFunction('widen', { result: 'i32', params: ['i32'] })).toThrow(TypeError);
+        expect(() => jit.getFunction('widen', { result: 'i32', params: ['u32'] })).toThrow(TypeError);
+        // the caller vouches for the fixed params of the vararg function
+        expect(jit.getFunction('first', { result: 'i32', params: ['i32'], unchecked: true })(7)).toEqual(7);
+        jit.dispose();
+    });
+
+    test('Test llvm.LLJIT lazy compilation', () => {
+        for (const options of [{ lazy: true }, { lazy: true, speculate: true, numCompileThreads: 2 }]) {
+            const jit = new llvm.LLJIT(options);
+            jit.addModule(createModule(new llvm.LLVMContext(), jit));
+            expect(jit.lookup('add').toString()).not.toEqual('0');
+            const add = jit.getFunction('add', { result: 'i32', params: ['i32', 'i32'] });
+            expect(add(40, 2)).toEqual(42);
+            expect(add(1, 2)).toEqual(3);
+            jit.dispose();
+        }
+        expect(() => new llvm.LLJIT({ speculate: true })).toThrow(TypeError);
+        expect(() => new llvm.LLJIT({ lazy: 1 } as unknown as llvm.LLJITOptions)).toThrow(TypeError);
+    });
+
+    test('Test llvm.LLJIT tiered compilation', () => {
+        const jit = new llvm.LLJIT({ tiered: true, tierUpThreshold: 10, tierUpLevel: llvm.OptimizationLevel.O2 });
+        jit.addModule(createModule(new llvm.LLVMContext(), jit));
+        const add = jit.getFunction('add', { result: 'i32', params: ['i32', 'i32'] });
+        expect(jit.getTier('add')).toEqual(0);
+        expect(jit.getTier('missing')).toEqual(-1);
+        for (let i = 0; i < 10; ++i) {
+            expect(add(i, 1)).toEqual(i + 1);
+        }
+        jit.waitForTierUps();
+        expect(jit.getTier('add')).toEqual(1);
+        expect(jit.getTier('load')).toEqual(0);
+        expect(add(40, 2)).toEqual(42);
+        expect(() => jit.addModule(createModule(new llvm.LLVMContext(), jit))).toThrowError("Duplicate definition of symbol 'add'");
+        expect(jit.getTier('add')).toEqual(1);
+        expect(add(40, 2)).toEqual(42);
+        jit.dispose();
+        expect(() => new llvm.LLJIT({ tiered: true, lazy: true })).toThrow(TypeError);
+        expect(() => new llvm.LLJIT({ tiered: true, tierUpLevel: llvm.OptimizationLevel.O0 })).toThrow(TypeError);
+        expect(new llvm.LLJIT().getTier('add')).toEqual(-1);
+    });
+});
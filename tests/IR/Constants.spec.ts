@@ -0,0 +1,48 @@
+import path from 'path';
+import llvm from '../..';
+
+const FileName = path.basename(__filename);
+
+describe('Test Constants', () => {
+    describe('Test llvm.ConstantDataArray.get', () => {
+        test('Test Number Array', () => {
+            const context = new llvm.LLVMContext();
+            const array = llvm.ConstantDataArray.get(context, [1, 2, 3]);
+            expect(array).toBeInstanceOf(llvm.ConstantDataArray);
+            expect((array.getType() as llvm.ArrayType).getElementType()).toBe(llvm.Type.getInt64Ty(context));
+        });
+
+        test('Test Typed Arrays', () => {
+            const context = new llvm.LLVMContext();
+            const module = new llvm.Module(FileName, context);
+            const elements: [string, llvm.Constant][] = [
+                ['[3 x i8] c"\\01\\02\\03"', llvm.ConstantDataArray.get(context, Buffer.from([1, 2, 3]))],
+                ['[2 x i16] [i16 -1, i16 2]', llvm.ConstantDataArray.get(context, new Int16Array([-1, 2]))],
+                ['[2 x i32] [i32 -1, i32 2]', llvm.ConstantDataArray.get(context, new Uint32Array([0xffffffff, 2]))],
+                ['[2 x float] [float 1.500000e+00, float 2.500000e+00]', llvm.ConstantDataArray.get(context, new Float32Array([1.5, 2.5]))],
+                ['[2 x double] [double 1.500000e+00, double 2.500000e+00]', llvm.ConstantDataArray.get(context, new Float64Array([1.5, 2.5]))]
+            ];
+            elements.forEach(([expected, initializer], i) => {
+                expect(initializer).toBeInstanceOf(llvm.ConstantDataArray);
+                new llvm.GlobalVariable(module, initializer.getType(), true, llvm.Function.LinkageTypes.ExternalLinkage, initializer, `g${i}`);
+                expect(module.print()).toContain(`@g${i} = constant ${expected}`);
+            });
+        });
+
+        test('Test Subarray', () => {
+            const context = new llvm.LLVMContext();
+            const array = llvm.ConstantDataArray.get(context, new Int32Array([1, 2, 3, 4]).subarray(1, 3));
+            expect((array.getType() as llvm.ArrayType).getNumElements()).toEqual(2);
+        });
+    });
+
+    test('Test llvm.ConstantDataVector.get', () => {
+        const context = new llvm.LLVMContext();
+        const module = new llvm.Module(FileName, context);
+        const vector = llvm.ConstantDataVector.get(context, new Float32Array([1, 2, 3, 4]));
+        expect(vector).toBeInstanceOf(llvm.ConstantDataVector);
+        new llvm.GlobalVariable(module, vector.getType(), true, llvm.Function.LinkageTypes.ExternalLinkage, vector, 'v');
+        expect(module.print()).toContain('@v = constant <4 x float> <float 1.000000e+00, float 2.000000e+00, float 3.000000e+00, float 4.000000e+00>');
+        expect(() => llvm.ConstantDataVector.get(context, new Float32Array(0))).toThrow();
+    });
+});
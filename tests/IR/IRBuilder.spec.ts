@@ -0,0 +1,188 @@
+import path from 'path';
+import llvm from '../..';
+
+const FileName = path.basename(__filename);
+
+describe('Test IRBuilder', () => {
+    describe('Test llvm.IRBuilder.emitBatch', () => {
+        const { ConstInt, ConstInt64, Add, FAdd, Neg, FNeg, Not, ICmp, FCmp, Alloca, Load, Store, GEP, Select, Ret, RetVoid, Call, Br, CondBr, PHI, AddIncoming, SetInsertPoint } = llvm.IRBuilder.BatchOp;
+
+        function createFunction(name: string) {
+            const context = new llvm.LLVMContext();
+            const module = new llvm.Module(FileName, context);
+            const builder = new llvm.IRBuilder(context);
+            const i32Ty = builder.getInt32Ty();
+            const funcType = llvm.FunctionType.get(i32Ty, [i32Ty, i32Ty], false);
+            const func = llvm.Function.Create(funcType, llvm.Function.LinkageTypes.ExternalLinkage, name, module);
+            const entry = llvm.BasicBlock.Create(context, 'entry', func);
+            return { context, module, builder, func, entry, i32Ty };
+        }
+
+        test('Test Straight-Line Code', () => {
+            const { builder, func, entry, i32Ty } = createFunction('max');
+            // slots: 0 = a, 1 = b, 2 = entry, then one slot per operation
+            const program = new Int32Array([
+                SetInsertPoint, 2,                              // 3
+                ICmp, llvm.ICmpInst.Predicate.ICMP_SGT, 0, 1,   // 4
+                Select, 4, 0, 1,                                // 5
+                ConstInt, 0, 1,                                 // 6
+                Add, 5, 6,                                      // 7
+                Ret, 7                                          // 8
+            ]);
+            const [cmp, result, ret] = builder.emitBatch(program, [func.getArg(0), func.getArg(1), entry], [i32Ty], [4, 7, 8]);
+            expect(cmp).toBeInstanceOf(llvm.ICmpInst);
+            expect(result).toBeInstanceOf(llvm.Instruction);
+            expect(ret).toBeNull();
+            expect(llvm.verifyFunction(func)).toEqual(false);
+        });
+
+        test('Test Control Flow', () => {
+            const { context, module, builder, func, entry, i32Ty } = createFunction('select');
+            const thenBB = llvm.BasicBlock.Create(context, 'then', func);
+            const elseBB = llvm.BasicBlock.Create(context, 'else', func);
+            const mergeBB = llvm.BasicBlock.Create(context, 'merge', func);
+            const calleeType = llvm.FunctionType.get(i32Ty, [i32Ty], false);
+            const callee = llvm.Function.Create(calleeType, llvm.Function.LinkageTypes.ExternalLinkage, 'callee', module);
+            // slots: 0 = a, 1 = b, 2 = entry, 3 = then, 4 = else, 5 = merge, 6 = callee
+            const program = new Int32Array([
+                SetInsertPoint, 2,                              // 7
+                ICmp, llvm.ICmpInst.Predicate.ICMP_EQ, 0, 1,    // 8
+                CondBr, 8, 3, 4,                                // 9
+                SetInsertPoint, 3,                              // 10
+                Call, 1, 6, 1, 0,                               // 11
+                Br, 5,                                          // 12
+                SetInsertPoint, 4,                              // 13
+                Br, 5,                                          // 14
+                SetInsertPoint, 5,                              // 15
+                PHI, 0, 2, 11, 3, 1, 4,                         // 16
+                Ret, 16                                         // 17
+            ]);
+            const values = [func.getArg(0), func.getArg(1), entry, thenBB, elseBB, mergeBB, callee];
+            const [call, phi] = builder.emitBatch(program.buffer, values, [i32Ty, calleeType], [11, 16]);
+            expect(call).toBeInstanceOf(llvm.CallInst);
+            expect(phi).toBeInstanceOf(llvm.PHINode);
+            expect(llvm.verifyFunction(func)).toEqual(false);
+        });
+
+        test('Test 64-bit Constants', () => {
+            const { builder, entry } = createFunction('constants');
+            const i64Ty = builder.getInt64Ty();
+            const program = new Int32Array([
+                ConstInt64, 0, 0x9abcdef0 | 0, 0x12,    // 1
+                ConstInt64, 0, -1, -1,                  // 2
+                ConstInt, 0, -1                         // 3
+            ]);
+            const [large, minusOne, extended] = builder.emitBatch(program, [entry], [i64Ty], [1, 2, 3]);
+            expect(large).toBe(llvm.ConstantInt.get(i64Ty, 0x129abcdef0, true));
+            expect(minusOne).toBe(llvm.ConstantInt.get(i64Ty, -1, true));
+            expect(extended).toBe(minusOne);
+            expect(() => builder.emitBatch(new Int32Array([ConstInt64, 0, 1]), [entry], [i64Ty])).toThrow(TypeError);
+        });
+
+        test('Test Mistyped Operands', () => {
+            const { context, module, builder, func, entry, i32Ty } = createFunction('mistyped');
+            const doubleTy = builder.getDoubleTy();
+            const calleeType = llvm.FunctionType.get(i32Ty, [i32Ty], false);
+            const callee = llvm.Function.Create(calleeType, llvm.Function.LinkageTypes.ExternalLinkage, 'callee', module);
+            const exit = llvm.BasicBlock.Create(context, 'exit');
+            builder.SetInsertPoint(entry);
+            const ptr = builder.CreateAlloca(doubleTy);
+            const cond = builder.getTrue();
+            // slots: 0 = a, 1 = b, 2 = 1.5, 3 = ptr to double, 4 = true, 5 = callee, 6 = exit
+            const values = [func.getArg(0), func.getArg(1), llvm.ConstantFP.get(doubleTy, 1.5), ptr, cond, callee, exit];
+            const emit = (program: number[]) => () => builder.emitBatch(new Int32Array(program), values, [calleeType]);
+            expect(emit([Select, 0, 0, 1])).toThrow(TypeError);
+            expect(emit([Select, 4, 0, 2])).toThrow(TypeError);
+            expect(emit([CondBr, 0, 6, 6])).toThrow(TypeError);
+            expect(emit([Ret, 2])).toThrow(TypeError);
+            expect(emit([RetVoid])).toThrow(TypeError);
+            expect(emit([Store, 0, 3])).toThrow(TypeError);
+            expect(emit([Call, 0, 5, 1, 2])).toThrow(TypeError);
+            expect(emit([Call, 0, 5, 2, 0, 1])).toThrow(TypeError);
+            expect(emit([Neg, 2])).toThrow(TypeError);
+            expect(emit([Not, 2])).toThrow(TypeError);
+            expect(emit([FNeg, 0])).toThrow(TypeError);
+            expect(emit([Add, 2, 2])).toThrow(TypeError);
+            expect(emit([FAdd, 0, 1])).toThrow(TypeError);
+            const [sum, negated, call] = builder.emitBatch(new Int32Array([
+                FAdd, 2, 2,         // 7
+                FNeg, 7,            // 8
+                Store, 8, 3,        // 9
+                Call, 0, 5, 1, 0,   // 10
+                Select, 4, 0, 10,   // 11
+                Ret, 11             // 12
+            ]), values, [calleeType], [7, 8, 10]);
+            expect(sum).toBeInstanceOf(llvm.Constant);
+            expect(negated).toBeInstanceOf(llvm.Constant);
+            expect(call).toBeInstanceOf(llvm.CallInst);
+            expect(llvm.verifyFunction(func)).toEqual(false);
+        });
+
+        test('Test Mistyped Types and Indices', () => {
+            const { context, builder, func, entry, i32Ty } = createFunction('types');
+            const doubleTy = builder.getDoubleTy();
+            const pairTy = llvm.StructType.get(context, [i32Ty, doubleTy]);
+            builder.SetInsertPoint(entry);
+            const ptr = builder.CreateAlloca(pairTy);
+            // slots: 0 = a, 1 = b, 2 = 1.5, 3 = ptr to the pair, 4 = i32 0, 5 = i32 1, 6 = i32 2
+            const values = [func.getArg(0), func.getArg(1), llvm.ConstantFP.get(doubleTy, 1.5), ptr,
+                builder.getInt32(0), builder.getInt32(1), builder.getInt32(2)];
+            // types: 0 = i32, 1 = void, 2 = function type, 3 = the pair
+            const types = [i32Ty, builder.getVoidTy(), llvm.FunctionType.get(i32Ty, false), pairTy];
+            const emit = (program: number[]) => () => builder.emitBatch(new Int32Array(program), values, types);
+            expect(emit([Alloca, 1])).toThrow(TypeError);
+            expect(emit([Alloca, 2])).toThrow(TypeError);
+            expect(emit([Load, 1, 3])).toThrow(TypeError);
+            expect(emit([PHI, 1, 0])).toThrow(TypeError);
+            expect(emit([ICmp, llvm.ICmpInst.Predicate.ICMP_EQ, 2, 2])).toThrow(TypeError);
+            expect(emit([FCmp, llvm.FCmpInst.Predicate.FCMP_OLT, 0, 1])).toThrow(TypeError);
+            expect(emit([GEP, 3, 3, 2, 4, 2])).toThrow(TypeError);
+            expect(emit([GEP, 3, 3, 2, 4, 0])).toThrow(TypeError);
+            expect(emit([GEP, 3, 3, 2, 4, 6])).toThrow(TypeError);
+            const [field] = builder.emitBatch(new Int32Array([
+                GEP, 3, 3, 2, 0, 5   // 7
+            ]), values, types, [7]);
+            expect(field).toBeInstanceOf(llvm.GetElementPtrInst);
+        });
+
+        test('Test Failing Programs Leave the Function Unchanged', () => {
+            const { context, module, builder, func, entry, i32Ty } = createFunction('unchanged');
+            const exit = llvm.BasicBlock.Create(context, 'exit', func);
+            builder.SetInsertPoint(entry);
+            builder.CreateBr(exit);
+            builder.SetInsertPoint(exit);
+            const phi = builder.CreatePHI(i32Ty, 2);
+            phi.addIncoming(func.getArg(0), entry);
+            builder.CreateRet(phi);
+            builder.SetInsertPoint(entry.getTerminator() as llvm.Instruction);
+            const before = module.print();
+            // slots: 0 = a, 1 = b, 2 = phi, 3 = entry, 4 = exit, 5 = 1.5
+            const values = [func.getArg(0), func.getArg(1), phi, entry, exit, llvm.ConstantFP.get(builder.getDoubleTy(), 1.5)];
+            expect(() => builder.emitBatch(new Int32Array([
+                Add, 0, 1,              // 6
+                PHI, 0, 1, 6, 3,        // 7
+                Add, 6, 0,              // 8
+                AddIncoming, 7, 8, 3,   // 9, the new PHI uses an instruction inserted after it
+                AddIncoming, 2, 8, 3,   // 10, and so does the PHI that existed before
+                SetInsertPoint, 4,      // 11
+                FAdd, 0, 1              // fails
+            ]), values, [i32Ty])).toThrow(TypeError);
+            expect(module.print()).toEqual(before);
+            expect(builder.GetInsertBlock()).toBe(entry);
+            expect(llvm.verifyFunction(func)).toEqual(false);
+        });
+
+        test('Test Invalid Programs', () => {
+            const { builder, func, entry, i32Ty } = createFunction('invalid');
+            const values = [func.getArg(0), func.getArg(1), entry];
+            const errMsg = 'IRBuilder.emitBatch found an invalid operation at offset ';
+            builder.SetInsertPoint(entry);
+            expect(() => builder.emitBatch(new Int32Array([Add, 0, 7]), values)).toThrowError(errMsg + '0');
+            expect(() => builder.emitBatch(new Int32Array([Add, 0, 1, Add, 0]), values)).toThrowError(errMsg + '3');
+            expect(() => builder.emitBatch(new Int32Array([ConstInt, 1, 0]), values, [i32Ty])).toThrowError(errMsg + '0');
+            expect(() => builder.emitBatch(new Int32Array([Br, 0]), values)).toThrowError(errMsg + '0');
+            expect(() => builder.emitBatch(new Int32Array([-1]), values)).toThrowError(errMsg + '0');
+            expect(() => (builder.emitBatch as any)([Add, 0, 1], values)).toThrowError('IRBuilder.emitBatch needs to be called with');
+        });
+    });
+});
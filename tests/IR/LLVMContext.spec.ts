@@ -1,3 +1,5 @@
+import path from 'path';
+import { Worker } from 'worker_threads';
 import llvm from '../..';
 
 describe('Test LLVMContext', () => {
@@ -5,4 +7,33 @@ describe('Test LLVMContext', () => {
         const context = new llvm.LLVMContext();
         expect(context).toBeInstanceOf(llvm.LLVMContext);
     });
+
+    test('Test llvm.LLVMContext in worker threads', (done) => {
+        const script = `
+            const { parentPort, workerData } = require('worker_threads');
+            const llvm = require(workerData);
+            const context = new llvm.LLVMContext();
+            const module = new llvm.Module('worker', context);
+            const funcType = llvm.FunctionType.get(llvm.Type.getInt32Ty(context), false);
+            const func = llvm.Function.Create(funcType, llvm.Function.LinkageTypes.ExternalLinkage, 'func', module);
+            const builder = new llvm.IRBuilder(llvm.BasicBlock.Create(context, 'entry', func));
+            builder.CreateRet(builder.getInt32(0));
+            parentPort.postMessage(llvm.verifyFunction(func) === false && module.getFunction('func') === func);
+        `;
+        const workerCount = 2;
+        let finished = 0;
+        for (let i = 0; i < workerCount; ++i) {
+            const worker = new Worker(script, { eval: true, workerData: path.resolve(__dirname, '../..') });
+            worker.once('error', done);
+            worker.once('message', (result: boolean) => {
+                expect(result).toEqual(true);
+                if (++finished === workerCount) {
+                    // the main environment keeps working after the workers have loaded the addon
+                    const context = new llvm.LLVMContext();
+                    expect(llvm.Type.getInt32Ty(context)).toBeInstanceOf(llvm.IntegerType);
+                    done();
+                }
+            });
+        }
+    });
 });
@@ -359,4 +359,258 @@ describe('Test Module', () => {
             expect(module.print()).toMatchSnapshot();
         });
     });
+
+    describe('Test llvm.Module.dispose', () => {
+        const disposedErrMsg = 'Module has been disposed or linked into another module';
+
+        test('Test Normally', () => {
+            const context = new llvm.LLVMContext();
+            const module = new llvm.Module(FileName, context);
+            module.dispose();
+            expect(() => module.getName()).toThrowError(disposedErrMsg);
+            expect(() => module.dispose()).not.toThrow();
+        });
+
+        test('Test Disposing The Context', () => {
+            const context = new llvm.LLVMContext();
+            const module = new llvm.Module(FileName, context);
+            context.dispose();
+            expect(() => module.empty()).toThrowError(disposedErrMsg);
+            expect(() => new llvm.Module(FileName, context)).toThrowError('LLVMContext has been disposed');
+        });
+
+        test('Test Linking Consumes The Source Module', () => {
+            const context = new llvm.LLVMContext();
+            const dest = new llvm.Module('dest', context);
+            const src = new llvm.Module('src', context);
+            const funcType = llvm.FunctionType.get(llvm.Type.getVoidTy(context), false);
+            llvm.Function.Create(funcType, llvm.Function.LinkageTypes.ExternalLinkage, 'func', src);
+            expect(llvm.Linker.linkModules(dest, src)).toEqual(false);
+            expect(dest.getFunction('func')).toBeInstanceOf(llvm.Function);
+            expect(() => src.empty()).toThrowError(disposedErrMsg);
+        });
+
+        test('Test The Values And Types Of A Disposed Module', () => {
+            const valueErrMsg = 'Value has been erased, or freed along with its Module or LLVMContext';
+            const typeErrMsg = 'Type has been freed along with its LLVMContext';
+            const context = new llvm.LLVMContext();
+            const module = new llvm.Module(FileName, context);
+            const int32Type = llvm.Type.getInt32Ty(context);
+            const funcType = llvm.FunctionType.get(llvm.Type.getVoidTy(context), [int32Type], false);
+            const func = llvm.Function.Create(funcType, llvm.Function.LinkageTypes.ExternalLinkage, 'func', module);
+            const arg = func.getArg(0);
+            const entry = llvm.BasicBlock.Create(context, 'entry', func);
+            const ret = new llvm.IRBuilder(entry).CreateRetVoid();
+            const constant = llvm.ConstantInt.get(int32Type, 1);
+            module.dispose();
+            expect(() => func.getName()).toThrowError(valueErrMsg);
+            expect(() => arg.getArgNo()).toThrowError(valueErrMsg);
+            expect(() => entry.getParent()).toThrowError(valueErrMsg);
+            expect(() => ret.getType()).toThrowError(valueErrMsg);
+            expect(() => new llvm.IRBuilder(entry)).toThrowError(valueErrMsg);
+            expect(constant.getType()).toBe(int32Type);
+            context.dispose();
+            expect(() => constant.getType()).toThrowError(valueErrMsg);
+            expect(() => int32Type.isIntegerTy()).toThrowError(typeErrMsg);
+            expect(() => llvm.PointerType.get(int32Type, 0)).toThrowError(typeErrMsg);
+        });
+
+        test('Test An Erased Value', () => {
+            const context = new llvm.LLVMContext();
+            const module = new llvm.Module(FileName, context);
+            const funcType = llvm.FunctionType.get(llvm.Type.getVoidTy(context), false);
+            const func = llvm.Function.Create(funcType, llvm.Function.LinkageTypes.ExternalLinkage, 'func', module);
+            const entry = llvm.BasicBlock.Create(context, 'entry', func);
+            func.eraseFromParent();
+            expect(() => func.getName()).toThrowError('Value has been erased');
+            expect(() => entry.getName()).toThrowError('Value has been erased');
+            const other = llvm.Function.Create(funcType, llvm.Function.LinkageTypes.ExternalLinkage, 'func', module);
+            expect(other.getName()).toEqual('func');
+            expect(module.getFunction('func')).toBe(other);
+        });
+
+        test('Test A Linker Whose Destination Has Been Disposed', () => {
+            const context = new llvm.LLVMContext();
+            const dest = new llvm.Module('dest', context);
+            const linker = new llvm.Linker(dest);
+            dest.dispose();
+            expect(() => linker.linkInModule(new llvm.Module('src', context))).toThrowError(disposedErrMsg);
+            expect(() => new llvm.Linker(dest)).toThrowError(disposedErrMsg);
+        });
+    });
+
+    test('Test llvm.Module.cursor', () => {
+        const context = new llvm.LLVMContext();
+        const module = new llvm.Module(FileName, context);
+        const builder = new llvm.IRBuilder(context);
+        const funcType = llvm.FunctionType.get(builder.getInt32Ty(), [builder.getInt32Ty()], false);
+        llvm.Function.Create(funcType, llvm.Function.LinkageTypes.ExternalLinkage, 'decl', module);
+        const func = llvm.Function.Create(funcType, llvm.Function.LinkageTypes.ExternalLinkage, 'func', module);
+        const entry = llvm.BasicBlock.Create(context, 'entry', func);
+        const exit = llvm.BasicBlock.Create(context, 'exit', func);
+        builder.SetInsertPoint(entry);
+        builder.CreateAdd(func.getArg(0), func.getArg(0), 'sum');
+        builder.CreateBr(exit);
+        builder.SetInsertPoint(exit);
+        const ret = builder.CreateRet(func.getArg(0));
+
+        const cursor = module.cursor();
+        expect(() => cursor.getName()).toThrow();
+        const opcodes: string[] = [];
+        while (cursor.next()) {
+            opcodes.push(cursor.getOpcodeName());
+        }
+        expect(opcodes).toEqual(['add', 'br', 'ret']);
+        expect(cursor.next()).toEqual(false);
+
+        cursor.reset();
+        expect(cursor.nextFunction()).toEqual(true);
+        expect(cursor.getName()).toEqual('decl');
+        expect(cursor.getOpcode()).toEqual(0);
+        expect(cursor.nextBasicBlock()).toEqual(false);
+        expect(cursor.nextFunction()).toEqual(true);
+        expect(cursor.getFunction()).toBe(func);
+        expect(cursor.nextBasicBlock()).toEqual(true);
+        expect(cursor.nextInstruction()).toEqual(true);
+        expect(cursor.getName()).toEqual('sum');
+        expect(cursor.getNumOperands()).toEqual(2);
+        expect(cursor.getTypeID()).toEqual(llvm.Type.TypeID.IntegerTyID);
+        expect(cursor.nextBasicBlock()).toEqual(true);
+        expect(cursor.getBasicBlock()).toBe(exit);
+        expect(cursor.getInstruction()).toBeNull();
+        expect(cursor.nextInstruction()).toEqual(true);
+        expect(cursor.getInstruction()).toBe(ret);
+        expect(cursor.nextInstruction()).toEqual(false);
+        expect(cursor.nextFunction()).toEqual(false);
+
+        module.dispose();
+        expect(() => cursor.next()).toThrowError('IRCursor walks a module which has been disposed');
+    });
+
+    describe('Test llvm.Module.findInstructions', () => {
+        function createModule() {
+            const context = new llvm.LLVMContext();
+            const module = new llvm.Module(FileName, context);
+            const builder = new llvm.IRBuilder(context);
+            const i32Ty = builder.getInt32Ty();
+            const mallocType = llvm.FunctionType.get(builder.getInt8PtrTy(), [builder.getInt64Ty()], false);
+            const malloc = llvm.Function.Create(mallocType, llvm.Function.LinkageTypes.ExternalLinkage, 'malloc', module);
+            const funcType = llvm.FunctionType.get(i32Ty, [builder.getInt8PtrTy(), builder.getInt8PtrTy(1)], false);
+            const calls: llvm.CallInst[] = [];
+            const loads: llvm.LoadInst[] = [];
+            const allocas: llvm.AllocaInst[] = [];
+            for (const name of ['f', 'g']) {
+                const func = llvm.Function.Create(funcType, llvm.Function.LinkageTypes.ExternalLinkage, name, module);
+                const entry = llvm.BasicBlock.Create(context, 'entry', func);
+                const body = llvm.BasicBlock.Create(context, 'body', func);
+                builder.SetInsertPoint(entry);
+                builder.CreateAlloca(i32Ty);
+                calls.push(builder.CreateCall(malloc, [builder.getInt64(4)]));
+                builder.CreateLoad(i32Ty, func.getArg(0));
+                builder.CreateBr(body);
+                builder.SetInsertPoint(body);
+                allocas.push(builder.CreateAlloca(i32Ty));
+                loads.push(builder.CreateLoad(i32Ty, func.getArg(1)));
+                builder.CreateRet(builder.getInt32(0));
+            }
+            return { module, calls, loads, allocas };
+        }
+
+        test('Test Queries', () => {
+            const { module, calls, loads, allocas } = createModule();
+            expect(module.findInstructions({ opcode: 'call', calleeName: 'malloc' })).toEqual(calls);
+            expect(module.findInstructions({ opcode: 'load', addressSpace: 1 })).toEqual(loads);
+            expect(module.findInstructions({ opcode: 'alloca', inEntryBlock: false })).toEqual(allocas);
+            expect(module.findInstructions({ opcode: 'alloca', function: 'g' }).length).toEqual(2);
+            expect(module.findInstructions({ typeID: llvm.Type.TypeID.VoidTyID }).length).toEqual(4);
+            expect(module.findInstructions({ hasMetadata: true })).toEqual([]);
+            expect(module.findInstructions({ hasMetadata: 'dbg' })).toEqual([]);
+            expect(module.findInstructions({}).length).toEqual(14);
+        });
+
+        test('Test Parallel', () => {
+            const { module, calls } = createModule();
+            expect(module.findInstructions({ calleeName: 'malloc', parallel: true })).toEqual(calls);
+            expect(module.findInstructions({ parallel: true })).toEqual(module.findInstructions({}));
+        });
+
+        test('Test Invalid Queries', () => {
+            const { module } = createModule();
+            const errMsg = 'Module.findInstructions needs to be called with';
+            expect(() => module.findInstructions({ opcode: 'nope' })).toThrowError(errMsg);
+            expect(() => (module.findInstructions as any)({ typeID: 'void' })).toThrowError(errMsg);
+            expect(() => (module.findInstructions as any)()).toThrowError(errMsg);
+        });
+    });
+
+    test('Test Mutating Values During llvm.verifyModuleAsync', () => {
+        const context = new llvm.LLVMContext();
+        const module = new llvm.Module(FileName, context);
+        const int32Type = llvm.Type.getInt32Ty(context);
+        const funcType = llvm.FunctionType.get(int32Type, [int32Type], false);
+        const func = llvm.Function.Create(funcType, llvm.Function.LinkageTypes.ExternalLinkage, 'func', module);
+        const arg = func.getArg(0);
+        const entry = llvm.BasicBlock.Create(context, 'entry', func);
+        new llvm.IRBuilder(entry).CreateRet(arg);
+        const lockedErrMsg = 'LLVMContext is locked by a pending asynchronous operation';
+        const verified = llvm.verifyModuleAsync(module);
+        expect(() => arg.setName('x')).toThrowError(lockedErrMsg);
+        expect(() => entry.eraseFromParent()).toThrowError(lockedErrMsg);
+        expect(() => func.getName()).toThrowError(lockedErrMsg);
+        expect(() => int32Type.getPointerTo()).toThrowError(lockedErrMsg);
+        expect(() => llvm.ConstantInt.get(int32Type, 1)).toThrowError(lockedErrMsg);
+        expect(() => llvm.PointerType.get(int32Type, 0)).toThrowError(lockedErrMsg);
+        expect(() => llvm.StructType.create(context, 'struct')).toThrowError(lockedErrMsg);
+        return verified.then(broken => {
+            expect(broken).toEqual(false);
+            arg.setName('x');
+            expect(arg.getName()).toEqual('x');
+        });
+    });
+
+    test('Test llvm.Module.printAsync', () => {
+        const context = new llvm.LLVMContext();
+        const module = new llvm.Module(FileName, context);
+        const builder = new llvm.IRBuilder(context);
+        const funcType = llvm.FunctionType.get(builder.getVoidTy(), false);
+        const func = llvm.Function.Create(funcType, llvm.Function.LinkageTypes.ExternalLinkage, 'func', module);
+        builder.SetInsertPoint(llvm.BasicBlock.Create(context, 'entry', func));
+        builder.CreateRetVoid();
+        const expected = module.print();
+        const lockedErrMsg = 'LLVMContext is locked by a pending asynchronous operation';
+        const printed = module.printAsync();
+        expect(() => builder.CreateRetVoid()).toThrowError(lockedErrMsg);
+        expect(() => llvm.Type.getInt32Ty(context)).toThrowError(lockedErrMsg);
+        expect(() => module.printAsync()).toThrowError(lockedErrMsg);
+        expect(() => context.dispose()).toThrowError(lockedErrMsg);
+        return Promise.all([printed, llvm.verifyModuleAsync(new llvm.Module('other', new llvm.LLVMContext()))]).then(([text, broken]) => {
+            expect(text).toEqual(expected);
+            expect(broken).toEqual(false);
+            expect(builder.getInt32Ty()).toBe(llvm.Type.getInt32Ty(context));
+        });
+    });
+
+    test('Test cancellation of asynchronous operations', () => {
+        const context = new llvm.LLVMContext();
+        const module = new llvm.Module(FileName, context);
+        const funcType = llvm.FunctionType.get(llvm.Type.getVoidTy(context), false);
+        llvm.Function.Create(funcType, llvm.Function.LinkageTypes.ExternalLinkage, 'func', module);
+        const controller = new AbortController();
+        controller.abort();
+        expect(() => llvm.verifyModuleAsync(module, { timeout: 'soon' as unknown as number })).toThrow(TypeError);
+        return llvm.verifyModuleAsync(module, { signal: controller.signal }).then(() => {
+            throw new Error('verifyModuleAsync should have been aborted');
+        }, (error: Error) => {
+            expect(error).toBe(controller.signal.reason);
+            return module.printAsync({ timeout: 0 });
+        }).then(() => {
+            throw new Error('printAsync should have timed out');
+        }, (error: Error) => {
+            expect(error.name).toEqual('TimeoutError');
+            return llvm.verifyModuleAsync(module, { signal: new AbortController().signal, timeout: 60000 });
+        }).then(broken => {
+            expect(broken).toEqual(false);
+            expect(module.getFunction('func')).toBeInstanceOf(llvm.Function);
+        });
+    });
 });
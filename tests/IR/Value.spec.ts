@@ -0,0 +1,100 @@
+import path from 'path';
+import llvm from '../..';
+
+const FileName = path.basename(__filename);
+
+describe('Test Value', () => {
+    describe('Test wrapper identity', () => {
+        test('Test Type', () => {
+            const context = new llvm.LLVMContext();
+            expect(llvm.Type.getInt32Ty(context)).toBe(llvm.Type.getInt32Ty(context));
+            expect(llvm.Type.getInt32Ty(context)).not.toBe(llvm.Type.getInt32Ty(new llvm.LLVMContext()));
+        });
+
+        test('Test Function and Argument', () => {
+            const context = new llvm.LLVMContext();
+            const module = new llvm.Module(FileName, context);
+            const funcType = llvm.FunctionType.get(llvm.Type.getVoidTy(context), [llvm.Type.getInt32Ty(context)], false);
+            const func = llvm.Function.Create(funcType, llvm.Function.LinkageTypes.ExternalLinkage, 'func', module);
+            expect(module.getFunction('func')).toBe(func);
+            expect(func.getArg(0)).toBe(func.getArg(0));
+            expect(func.getArg(0).getType()).toBe(llvm.Type.getInt32Ty(context));
+        });
+    });
+
+    test('Test wrapper class dispatch', () => {
+        const context = new llvm.LLVMContext();
+        const module = new llvm.Module(FileName, context);
+        const builder = new llvm.IRBuilder(context);
+        const sinkType = llvm.FunctionType.get(builder.getVoidTy(), true);
+        const sink = llvm.Function.Create(sinkType, llvm.Function.LinkageTypes.ExternalLinkage, 'sink', module);
+        const funcType = llvm.FunctionType.get(builder.getVoidTy(), [builder.getInt32Ty()], false);
+        const func = llvm.Function.Create(funcType, llvm.Function.LinkageTypes.ExternalLinkage, 'func', module);
+        builder.SetInsertPoint(llvm.BasicBlock.Create(context, 'entry', func));
+        const operands = [
+            func.getArg(0),
+            builder.getInt32(1),
+            sink,
+            builder.CreateAlloca(builder.getInt32Ty()),
+            builder.CreateAdd(func.getArg(0), func.getArg(0)),
+            builder.CreateICmpEQ(func.getArg(0), func.getArg(0)),
+            builder.CreateZExt(func.getArg(0), builder.getInt64Ty())
+        ];
+        const call = builder.CreateCall(sinkType, sink, operands);
+        expect(call.getOperand(0)).toBeInstanceOf(llvm.Argument);
+        expect(call.getOperand(1)).toBeInstanceOf(llvm.ConstantInt);
+        expect(call.getOperand(2)).toBeInstanceOf(llvm.Function);
+        expect(call.getOperand(3)).toBeInstanceOf(llvm.AllocaInst);
+        expect(call.getOperand(4)).toBeInstanceOf(llvm.Instruction);
+        expect(call.getOperand(5)).toBeInstanceOf(llvm.ICmpInst);
+        expect(call.getOperand(6)).toBeInstanceOf(llvm.ZExtInst);
+        expect(call.getType()).toBeInstanceOf(llvm.Type);
+    });
+
+    test('Test bulk traversal', () => {
+        const context = new llvm.LLVMContext();
+        const module = new llvm.Module(FileName, context);
+        const builder = new llvm.IRBuilder(context);
+        const global = new llvm.GlobalVariable(module, builder.getInt32Ty(), false, llvm.Function.LinkageTypes.ExternalLinkage, builder.getInt32(0), 'global');
+        const funcType = llvm.FunctionType.get(builder.getInt32Ty(), [builder.getInt32Ty(), builder.getInt32Ty()], false);
+        const func = llvm.Function.Create(funcType, llvm.Function.LinkageTypes.ExternalLinkage, 'func', module);
+        const decl = llvm.Function.Create(funcType, llvm.Function.LinkageTypes.ExternalLinkage, 'decl', module);
+        const entry = llvm.BasicBlock.Create(context, 'entry', func);
+        const exit = llvm.BasicBlock.Create(context, 'exit', func);
+        builder.SetInsertPoint(entry);
+        const load = builder.CreateLoad(builder.getInt32Ty(), global);
+        const add = builder.CreateAdd(func.getArg(0), load);
+        builder.CreateBr(exit);
+        builder.SetInsertPoint(exit);
+        const ret = builder.CreateRet(builder.CreateMul(add, add));
+
+        // the wrappers have no own enumerable state, so only toBe tells them apart
+        const functions = module.getFunctions();
+        expect(functions.length).toEqual(2);
+        expect(functions[0]).toBe(func);
+        expect(functions[1]).toBe(decl);
+        const globals = module.getGlobalVariables();
+        expect(globals.length).toEqual(1);
+        expect(globals[0]).toBe(global);
+        const args = func.getArguments();
+        expect(args.length).toEqual(2);
+        expect(args[0]).toBe(func.getArg(0));
+        expect(args[1]).toBe(func.getArg(1));
+        const blocks = func.getBasicBlocks();
+        expect(blocks.length).toEqual(2);
+        expect(blocks[0]).toBe(entry);
+        expect(blocks[1]).toBe(exit);
+        expect(decl.getBasicBlocks().length).toEqual(0);
+        expect(entry.getInstructions()[0]).toBe(load);
+        expect(entry.getInstructions()[1]).toBe(add);
+        expect(exit.getInstructions()[1]).toBe(ret);
+        const operands = (add as llvm.Instruction).getOperands();
+        expect(operands.length).toEqual(2);
+        expect(operands[0]).toBe(func.getArg(0));
+        expect(operands[1]).toBe(load);
+        expect(add.getUsers().length).toEqual(2);
+        const users = global.getUsers();
+        expect(users.length).toEqual(1);
+        expect(users[0]).toBe(load);
+    });
+});
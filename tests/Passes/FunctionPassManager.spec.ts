@@ -0,0 +1,81 @@
+import llvm from '../..';
+
+// adds its argument to itself through a stack slot and a branch, which mem2reg, instcombine and simplifycfg fold away
+function createFunction(context: llvm.LLVMContext, module: llvm.Module, name: string): llvm.Function {
+    const builder = new llvm.IRBuilder(context);
+    const funcType = llvm.FunctionType.get(builder.getInt32Ty(), [builder.getInt32Ty()], false);
+    const func = llvm.Function.Create(funcType, llvm.Function.LinkageTypes.ExternalLinkage, name, module);
+    const entry = llvm.BasicBlock.Create(context, 'entry', func);
+    const exit = llvm.BasicBlock.Create(context, 'exit', func);
+    builder.SetInsertPoint(entry);
+    const slot = builder.CreateAlloca(builder.getInt32Ty(), null, 'slot');
+    builder.CreateStore(func.getArg(0), slot);
+    builder.CreateBr(exit);
+    builder.SetInsertPoint(exit);
+    const loaded = builder.CreateLoad(builder.getInt32Ty(), slot, 'loaded');
+    builder.CreateRet(builder.CreateAdd(loaded, loaded));
+    return func;
+}
+
+describe('Test FunctionPassManager', () => {
+    test('Test llvm.FunctionPassManager.run', () => {
+        const context = new llvm.LLVMContext();
+        const module = new llvm.Module('fpm', context);
+        const first = createFunction(context, module, 'first');
+        const second = createFunction(context, module, 'second');
+        const manager = new llvm.FunctionPassManager('mem2reg,instcombine,simplifycfg,gvn', new llvm.PassBuilder());
+        manager.run(first);
+        expect(llvm.verifyModule(module)).toBe(false);
+        const printed = module.print();
+        // only the function which was run is optimized
+        expect(printed.indexOf('alloca')).toBeGreaterThan(printed.indexOf('@second'));
+        manager.run(first);
+        manager.invalidate(second);
+        manager.run(second);
+        expect(module.print()).not.toContain('alloca');
+        manager.clear();
+        manager.dispose();
+        expect(() => manager.run(first)).toThrowError('FunctionPassManager has been disposed');
+    });
+
+    test('Test llvm.FunctionPassManager with a replaced function', () => {
+        const context = new llvm.LLVMContext();
+        const module = new llvm.Module('fpm', context);
+        const manager = new llvm.FunctionPassManager('mem2reg,simplifycfg');
+        for (let i = 0; i < 8; ++i) {
+            const func = createFunction(context, module, 'repl');
+            manager.run(func);
+            expect(llvm.verifyFunction(func)).toBe(false);
+            func.eraseFromParent();
+        }
+    });
+
+    test('Test llvm.FunctionPassManager instrumentation', () => {
+        const context = new llvm.LLVMContext();
+        const module = new llvm.Module('fpm', context);
+        const manager = new llvm.FunctionPassManager('mem2reg,simplifycfg');
+        const report = manager.run(createFunction(context, module, 'instrumented'), { instrument: true });
+        expect(report.passes.map(record => record.passName)).toEqual(['mem2reg', 'simplifycfg']);
+        expect(report.passes.every(record => record.name === 'instrumented')).toBe(true);
+        expect(manager.run(createFunction(context, module, 'plain'))).toBeUndefined();
+    });
+
+    test('Test llvm.FunctionPassManager cancellation', () => {
+        const context = new llvm.LLVMContext();
+        const module = new llvm.Module('fpm', context);
+        const func = createFunction(context, module, 'cancelled');
+        const manager = new llvm.FunctionPassManager('mem2reg,simplifycfg');
+        expect(() => manager.run(func, { timeout: 0 })).toThrowError('The operation timed out');
+        expect(module.print()).toContain('alloca');
+        expect(llvm.verifyFunction(func)).toBe(false);
+        manager.run(func, { timeout: 60000 });
+        expect(module.print()).not.toContain('alloca');
+    });
+
+    test('Test llvm.FunctionPassManager errors', () => {
+        expect(() => new llvm.FunctionPassManager('no-such-pass')).toThrowError('no-such-pass');
+        expect(() => new llvm.FunctionPassManager(1 as unknown as string)).toThrow(TypeError);
+        const manager = new llvm.FunctionPassManager('instcombine');
+        expect(() => manager.run({} as unknown as llvm.Function)).toThrow(TypeError);
+    });
+});
@@ -0,0 +1,127 @@
+import llvm from '../..';
+
+// @sum adds its argument through a stack slot, which mem2reg and instcombine fold away
+function createModule(context: llvm.LLVMContext): llvm.Module {
+    const module = new llvm.Module('passes', context);
+    module.setTargetTriple('x86_64-unknown-linux-gnu');
+    const builder = new llvm.IRBuilder(context);
+    const funcType = llvm.FunctionType.get(builder.getInt32Ty(), [builder.getInt32Ty()], false);
+    const func = llvm.Function.Create(funcType, llvm.Function.LinkageTypes.ExternalLinkage, 'sum', module);
+    builder.SetInsertPoint(llvm.BasicBlock.Create(context, 'entry', func));
+    const slot = builder.CreateAlloca(builder.getInt32Ty(), null, 'slot');
+    builder.CreateStore(func.getArg(0), slot);
+    const loaded = builder.CreateLoad(builder.getInt32Ty(), slot, 'loaded');
+    builder.CreateRet(builder.CreateAdd(loaded, builder.getInt32(0)));
+    return module;
+}
+
+describe('Test PassBuilder', () => {
+    test('Test llvm.PassBuilder.runDefaultPipeline', () => {
+        const context = new llvm.LLVMContext();
+        const module = createModule(context);
+        new llvm.PassBuilder().runDefaultPipeline(module, llvm.OptimizationLevel.O0);
+        expect(module.print()).toContain('alloca');
+        new llvm.PassBuilder(null, { loopUnrolling: false }).runDefaultPipeline(module, llvm.OptimizationLevel.O2);
+        expect(module.print()).not.toContain('alloca');
+        expect(llvm.verifyModule(module)).toBe(false);
+        expect(() => new llvm.PassBuilder().runDefaultPipeline(module, 6)).toThrow(TypeError);
+        expect(() => new llvm.PassBuilder(null, { mergeFunctions: 1 as unknown as boolean })).toThrow(TypeError);
+    });
+
+    test('Test llvm.PassBuilder.runPassPipeline', () => {
+        const context = new llvm.LLVMContext();
+        const module = createModule(context);
+        const builder = new llvm.PassBuilder();
+        builder.runPassPipeline(module, 'function(mem2reg,instcombine)');
+        expect(module.print()).toContain('ret i32 %0');
+        expect(() => builder.runPassPipeline(module, 'no-such-pass')).toThrowError('no-such-pass');
+    });
+
+    test('Test llvm.PassBuilder instrumentation', () => {
+        const context = new llvm.LLVMContext();
+        const module = createModule(context);
+        const builder = new llvm.PassBuilder();
+        expect(builder.runPassPipeline(module, 'verify')).toBeUndefined();
+        const report = builder.runPassPipeline(module, 'function(mem2reg,instcombine)', { instrument: true, statistics: true });
+        const mem2reg = report.passes.find(record => record.passName === 'mem2reg');
+        expect(mem2reg).toBeDefined();
+        if (mem2reg) {
+            expect(mem2reg.unit).toEqual('function');
+            expect(mem2reg.name).toEqual('sum');
+            expect(mem2reg.changed).toBe(true);
+            expect(mem2reg.instructionsAfter).toBeLessThan(mem2reg.instructionsBefore);
+            expect(mem2reg.elapsed).toBeGreaterThanOrEqual(0);
+        }
+        // pass managers and adaptors have no records of their own
+        expect(report.passes.every(record => !record.pass.includes('PassManager'))).toBe(true);
+        expect(typeof report.statistics).toEqual('object');
+        expect(builder.runDefaultPipeline(module, llvm.OptimizationLevel.O1, {}).passes).toEqual([]);
+        expect(() => builder.runDefaultPipeline(module, llvm.OptimizationLevel.O1, { instrument: 1 as unknown as boolean })).toThrow(TypeError);
+    });
+
+    test('Test llvm.PassBuilder cancellation', () => {
+        const context = new llvm.LLVMContext();
+        const module = createModule(context);
+        const builder = new llvm.PassBuilder();
+        expect(() => builder.runDefaultPipeline(module, llvm.OptimizationLevel.O2, { timeout: 0 })).toThrowError('The operation timed out');
+        const controller = new AbortController();
+        controller.abort();
+        let reason: unknown;
+        try {
+            builder.runPassPipeline(module, 'function(mem2reg,instcombine)', { signal: controller.signal });
+        } catch (error) {
+            reason = error;
+        }
+        expect(reason).toBe(controller.signal.reason);
+        // the optional passes were skipped
+        expect(module.print()).toContain('alloca');
+        expect(llvm.verifyModule(module)).toBe(false);
+        expect(() => builder.runPassPipeline(module, 'verify', { timeout: 'soon' as unknown as number })).toThrow(TypeError);
+        builder.runPassPipeline(module, 'function(mem2reg,instcombine)', { timeout: 60000 });
+        expect(module.print()).not.toContain('alloca');
+    });
+
+    test('Test llvm.PassBuilder.runAsync', () => {
+        const context = new llvm.LLVMContext();
+        const module = createModule(context);
+        const builder = new llvm.PassBuilder();
+        expect(() => builder.runAsync(module, 6)).toThrow(TypeError);
+        const running = builder.runAsync(module, llvm.OptimizationLevel.O2);
+        expect(() => module.print()).toThrowError('LLVMContext is locked');
+        return running.then(result => {
+            expect(result).toBeUndefined();
+            expect(module.print()).not.toContain('alloca');
+            return builder.runAsync(createModule(context), 'function(mem2reg,instcombine)', { instrument: true });
+        }).then(report => {
+            expect(report.passes.some(record => record.passName === 'mem2reg')).toBe(true);
+            return builder.runAsync(module, 'no-such-pass');
+        }).then(() => {
+            throw new Error('runAsync should have failed');
+        }, (error: Error) => {
+            expect(error.message).toContain('no-such-pass');
+            return builder.runAsync(createModule(context), llvm.OptimizationLevel.O2, { timeout: 0 });
+        }).then(() => {
+            throw new Error('runAsync should have timed out');
+        }, (error: Error) => {
+            expect(error.name).toEqual('TimeoutError');
+        });
+    });
+
+    test('Test llvm.PassBuilder with a TargetMachine', () => {
+        llvm.InitializeAllTargetInfos();
+        llvm.InitializeAllTargets();
+        llvm.InitializeAllTargetMCs();
+        const target = llvm.TargetRegistry.lookupTarget('x86_64');
+        if (target) {
+            const machine = target.createTargetMachine('x86_64-unknown-linux-gnu', 'generic');
+            const context = new llvm.LLVMContext();
+            const module = createModule(context);
+            module.setDataLayout(machine.createDataLayout());
+            const builder = new llvm.PassBuilder(machine);
+            builder.runDefaultPipeline(module, llvm.OptimizationLevel.O3);
+            expect(module.print()).not.toContain('alloca');
+            machine.dispose();
+            expect(() => builder.runDefaultPipeline(module, llvm.OptimizationLevel.O1)).toThrowError('TargetMachine has been disposed');
+        }
+    });
+});
@@ -0,0 +1,138 @@
+import fs from 'fs';
+import llvm from '../..';
+
+const outputBitcodeFileName = 'pipeline-test.bc';
+const outputObjectFileName = 'pipeline-test.o';
+
+function makeIR(name: string, value: number): string {
+    return `define i32 @${name}() {\nentry:\n  ret i32 ${value}\n}\n`;
+}
+
+describe('Test Pipeline', () => {
+    afterEach(() => {
+        for (const fileName of [outputBitcodeFileName, outputObjectFileName]) {
+            if (fs.existsSync(fileName)) {
+                fs.unlinkSync(fileName);
+            }
+        }
+    });
+
+    test('Test llvm.Pipeline options', () => {
+        const pipeline = new llvm.Pipeline({ concurrency: 2, memoryBudget: 1 << 20 });
+        expect(pipeline.getConcurrency()).toEqual(2);
+        expect(pipeline.getMemoryBudget()).toEqual(1 << 20);
+        expect(new llvm.Pipeline().getConcurrency()).toBeGreaterThan(0);
+        expect(() => new llvm.Pipeline({ concurrency: 0 })).toThrow(TypeError);
+    });
+
+    test('Test llvm.Pipeline.submit', () => {
+        const pipeline = new llvm.Pipeline({ concurrency: 4, memoryBudget: 256 });
+        const jobs: Promise<llvm.PipelineResult>[] = [];
+        for (let i = 0; i < 16; ++i) {
+            jobs.push(pipeline.submit({ name: `job${i}`, ir: makeIR(`f${i}`, i), stages: [{ kind: 'verify' }, { kind: 'print' }] }));
+        }
+        return Promise.all(jobs).then(results => {
+            results.forEach((result, i) => {
+                expect(result.name).toEqual(`job${i}`);
+                expect(result.ir).toContain(`define i32 @f${i}()`);
+            });
+        });
+    });
+
+    test('Test llvm.Pipeline job graph', () => {
+        const pipeline = new llvm.Pipeline();
+        const writer = pipeline.submit({
+            name: 'writer',
+            ir: makeIR('callee', 42),
+            stages: [{ kind: 'verify' }, { kind: 'writeBitcode', file: outputBitcodeFileName }]
+        });
+        const linker = pipeline.submit({
+            name: 'linker',
+            after: ['writer'],
+            ir: 'declare i32 @callee()\ndefine i32 @caller() {\n  %1 = call i32 @callee()\n  ret i32 %1\n}\n',
+            stages: [{ kind: 'link', file: outputBitcodeFileName }, { kind: 'verify' }, { kind: 'print' }]
+        });
+        return Promise.all([writer, linker]).then(([, linked]) => {
+            expect(linked.ir).toContain('define i32 @callee()');
+            expect(linked.ir).toContain('define i32 @caller()');
+        });
+    });
+
+    test('Test llvm.Pipeline failures', () => {
+        const pipeline = new llvm.Pipeline({ concurrency: 2 });
+        expect(() => pipeline.submit({ ir: makeIR('f', 0), after: ['missing'] })).toThrowError('no job named missing');
+        expect(() => pipeline.submit({ ir: makeIR('f', 0), stages: [{ kind: 'unknown' } as unknown as llvm.PipelineStage] })).toThrow(TypeError);
+        const broken = pipeline.submit({ name: 'broken', ir: 'define i32 @f() {\n  ret void\n}\n' });
+        const dependent = pipeline.submit({ ir: makeIR('g', 0), after: ['broken'] });
+        const invalid = pipeline.submit({
+            ir: 'define i32 @f(i32 %a) {\nentry:\n  br label %exit\ndead:\n  %x = add i32 %a, 1\n  br label %exit\nexit:\n  ret i32 %x\n}\n',
+            stages: [{ kind: 'verify' }]
+        });
+        return Promise.all([
+            broken.then(() => Promise.reject(new Error('broken should have failed')), (error: Error) => {
+                expect(error.message).toContain('error');
+            }),
+            dependent.then(() => Promise.reject(new Error('dependent should have failed')), (error: Error) => {
+                expect(error.message).toContain('broken');
+            }),
+            invalid.then(() => Promise.reject(new Error('invalid should have failed')), (error: Error) => {
+                expect(error.message).toContain('Instruction does not dominate all uses');
+            })
+        ]);
+    });
+
+    test('Test llvm.Pipeline cancellation', () => {
+        const pipeline = new llvm.Pipeline({ concurrency: 1 });
+        const controller = new AbortController();
+        controller.abort();
+        const aborted = pipeline.submit({ name: 'aborted', ir: makeIR('f', 0), stages: [{ kind: 'verify' }], signal: controller.signal });
+        const dependent = pipeline.submit({ ir: makeIR('g', 0), after: ['aborted'] });
+        const timedOut = pipeline.submit({ ir: makeIR('h', 0), stages: [{ kind: 'print' }], timeout: 0 });
+        return Promise.all([
+            aborted.then(() => Promise.reject(new Error('aborted should have failed')), (error: Error) => {
+                expect(error).toBe(controller.signal.reason);
+            }),
+            dependent.then(() => Promise.reject(new Error('dependent should have failed')), (error: Error) => {
+                expect(error.message).toContain('aborted');
+            }),
+            timedOut.then(() => Promise.reject(new Error('timedOut should have failed')), (error: Error) => {
+                expect(error.name).toEqual('TimeoutError');
+            })
+        ]);
+    });
+
+    test('Test llvm.Pipeline optimize stage', () => {
+        const pipeline = new llvm.Pipeline();
+        // %slot is folded away by mem2reg, which the default pipeline of O2 and the textual one both run
+        const ir = 'define i32 @f(i32 %a) {\n  %slot = alloca i32\n  store i32 %a, i32* %slot\n' +
+            '  %x = load i32, i32* %slot\n  ret i32 %x\n}\n';
+        expect(() => pipeline.submit({ ir, stages: [{ kind: 'optimize', level: 6 }] })).toThrow(TypeError);
+        return Promise.all([
+            pipeline.submit({ ir, stages: [{ kind: 'optimize' }, { kind: 'verify' }, { kind: 'print' }] }),
+            pipeline.submit({ ir, stages: [{ kind: 'optimize', pipeline: 'function(mem2reg)' }, { kind: 'print' }] }),
+            pipeline.submit({ ir, stages: [{ kind: 'optimize', level: llvm.OptimizationLevel.O0 }, { kind: 'print' }] }),
+            pipeline.submit({ ir, stages: [{ kind: 'optimize', pipeline: 'no-such-pass' }] }).then(() => {
+                throw new Error('no-such-pass should have failed');
+            }, (error: Error) => error.message)
+        ]).then(([optimized, promoted, unoptimized, error]) => {
+            expect(optimized.ir).not.toContain('alloca');
+            expect(promoted.ir).not.toContain('alloca');
+            expect(unoptimized.ir).toContain('alloca');
+            expect(error).toContain('no-such-pass');
+        });
+    });
+
+    test('Test llvm.Pipeline emit stage', () => {
+        llvm.InitializeAllTargetInfos();
+        llvm.InitializeAllTargets();
+        llvm.InitializeAllTargetMCs();
+        llvm.InitializeAllAsmPrinters();
+        const pipeline = new llvm.Pipeline();
+        return pipeline.submit({
+            ir: makeIR('f', 1),
+            stages: [{ kind: 'emit', file: outputObjectFileName, triple: 'x86_64-unknown-linux-gnu' }]
+        }).then(() => {
+            expect(fs.readFileSync(outputObjectFileName).subarray(0, 4).toString('latin1')).toEqual('\x7fELF');
+        });
+    });
+});
@@ -0,0 +1,31 @@
+import llvm from '../..';
+
+describe('Test Host', () => {
+    test('Test llvm.sys', () => {
+        expect(llvm.sys.getHostCPUName().length).toBeGreaterThan(0);
+        expect(llvm.sys.getProcessTriple()).toContain('-');
+        expect(llvm.sys.getDefaultTargetTriple()).toContain('-');
+        const features = llvm.sys.getHostCPUFeatures();
+        if (features.length > 0) {
+            const entries = features.split(',');
+            entries.forEach(entry => expect(entry).toMatch(/^[+-]/));
+            expect(entries).toEqual([...entries].sort());
+        }
+    });
+
+    test('Test llvm.createNativeTargetMachine', () => {
+        const machine = llvm.createNativeTargetMachine({ optLevel: llvm.CodeGenOpt.Less });
+        const context = new llvm.LLVMContext();
+        const module = new llvm.Module('native', context);
+        module.setTargetTriple(llvm.sys.getProcessTriple());
+        module.setDataLayout(machine.createDataLayout());
+        const builder = new llvm.IRBuilder(context);
+        const func = llvm.Function.Create(llvm.FunctionType.get(builder.getVoidTy(), false),
+            llvm.Function.LinkageTypes.ExternalLinkage, 'f', module);
+        builder.SetInsertPoint(llvm.BasicBlock.Create(context, 'entry', func));
+        builder.CreateRetVoid();
+        expect(machine.emitToBuffer(module, 'obj').length).toBeGreaterThan(0);
+        machine.dispose();
+        expect(() => llvm.createNativeTargetMachine({ optLevel: 7 })).toThrow(TypeError);
+    });
+});
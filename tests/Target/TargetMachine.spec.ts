@@ -1,10 +1,31 @@
+import fs from 'fs';
 import llvm from '../..';
 
+const outputObjectFileName = 'target-machine-test.o';
+
+function createModule(context: llvm.LLVMContext): llvm.Module {
+    const module = new llvm.Module('emit', context);
+    module.setTargetTriple('x86_64-unknown-linux-gnu');
+    const builder = new llvm.IRBuilder(context);
+    const funcType = llvm.FunctionType.get(builder.getInt32Ty(), [builder.getInt32Ty()], false);
+    const func = llvm.Function.Create(funcType, llvm.Function.LinkageTypes.ExternalLinkage, 'square', module);
+    builder.SetInsertPoint(llvm.BasicBlock.Create(context, 'entry', func));
+    builder.CreateRet(builder.CreateMul(func.getArg(0), func.getArg(0)));
+    return module;
+}
+
 describe('Test TargetMachine', () => {
     beforeAll(() => {
         llvm.InitializeAllTargetInfos();
         llvm.InitializeAllTargets();
         llvm.InitializeAllTargetMCs();
+        llvm.InitializeAllAsmPrinters();
+    });
+
+    afterEach(() => {
+        if (fs.existsSync(outputObjectFileName)) {
+            fs.unlinkSync(outputObjectFileName);
+        }
     });
 
     test('Test llvm.TargetMachine.createDataLayout', () => {
@@ -16,4 +37,168 @@ describe('Test TargetMachine', () => {
             expect(dataLayout).toBeInstanceOf(llvm.DataLayout);
         }
     });
+
+    test('Test llvm.TargetMachine.dispose', () => {
+        const target = llvm.TargetRegistry.lookupTarget('x86_64');
+        if (target) {
+            const machine = target.createTargetMachine('x86_64-unknown-unknown', 'generic');
+            const dataLayout = machine.createDataLayout();
+            machine.dispose();
+            expect(dataLayout.getStringRepresentation()).not.toEqual('');
+            expect(() => machine.createDataLayout()).toThrowError('TargetMachine has been disposed');
+        }
+    });
+
+    test('Test llvm.TargetMachine.emitToBuffer and llvm.TargetMachine.emitToFile', () => {
+        const target = llvm.TargetRegistry.lookupTarget('x86_64');
+        if (target) {
+            const machine = target.createTargetMachine('x86_64-unknown-linux-gnu', 'generic');
+            const context = new llvm.LLVMContext();
+            const object = machine.emitToBuffer(createModule(context), 'obj');
+            expect(object).toBeInstanceOf(Buffer);
+            expect(object.subarray(0, 4).toString('latin1')).toEqual('\x7fELF');
+            const assembly = machine.emitToBuffer(createModule(context), 'asm').toString();
+            expect(assembly).toContain('square:');
+            machine.emitToFile(createModule(context), outputObjectFileName, 'obj');
+            expect(fs.readFileSync(outputObjectFileName).subarray(0, 4)).toEqual(object.subarray(0, 4));
+            expect(() => machine.emitToBuffer(createModule(context), 'exe' as unknown as 'obj')).toThrow(TypeError);
+        }
+    });
+
+    test('Test llvm.TargetMachine emission of a mismatching module', () => {
+        const target = llvm.TargetRegistry.lookupTarget('x86_64');
+        if (!target) {
+            return;
+        }
+        const machine = target.createTargetMachine('x86_64-unknown-linux-gnu', 'generic');
+        const context = new llvm.LLVMContext();
+        const untargeted = createModule(context);
+        untargeted.setTargetTriple('');
+        machine.emitToBuffer(untargeted, 'obj');
+        expect(untargeted.getTargetTriple()).toEqual('x86_64-unknown-linux-gnu');
+        expect(untargeted.getDataLayoutStr()).toEqual(machine.createDataLayout().getStringRepresentation());
+
+        const vendored = createModule(context);
+        vendored.setTargetTriple('x86_64-pc-linux-gnu');
+        expect(machine.emitToBuffer(vendored, 'obj').subarray(0, 4).toString('latin1')).toEqual('\x7fELF');
+
+        const foreign = createModule(context);
+        foreign.setTargetTriple('aarch64-unknown-linux-gnu');
+        expect(() => machine.emitToBuffer(foreign, 'obj')).toThrowError('TargetMachine doesn\'t target the platform of the module\'s triple');
+        const misaligned = createModule(context);
+        misaligned.setDataLayout('e-p:32:32');
+        expect(() => machine.emitToBuffer(misaligned, 'obj')).toThrowError('TargetMachine doesn\'t match the data layout of the module');
+        return machine.emitToBufferAsync(misaligned, 'obj').then(() => {
+            throw new Error('the data layout mismatch should have been rejected');
+        }, (error: Error) => {
+            expect(error.message).toEqual('TargetMachine doesn\'t match the data layout of the module');
+        });
+    });
+
+    test('Test llvm.TargetMachine.emitToBufferAsync', () => {
+        const target = llvm.TargetRegistry.lookupTarget('x86_64');
+        if (!target) {
+            return;
+        }
+        const machine = target.createTargetMachine('x86_64-unknown-linux-gnu', 'generic');
+        const context = new llvm.LLVMContext();
+        const module = createModule(context);
+        const emitted = machine.emitToBufferAsync(module, 'obj');
+        expect(() => machine.emitToBuffer(createModule(new llvm.LLVMContext()), 'obj')).toThrowError('TargetMachine is used by a pending asynchronous emission');
+        expect(() => machine.dispose()).toThrowError('TargetMachine is used by a pending asynchronous emission');
+        return emitted.then(object => {
+            expect(object.subarray(0, 4).toString('latin1')).toEqual('\x7fELF');
+            return machine.emitToFileAsync(createModule(context), outputObjectFileName, 'obj');
+        }).then(() => {
+            expect(fs.existsSync(outputObjectFileName)).toBe(true);
+            machine.dispose();
+        });
+    });
+
+    test('Test cancellation of llvm.TargetMachine.emitToBufferAsync', () => {
+        const target = llvm.TargetRegistry.lookupTarget('x86_64');
+        if (!target) {
+            return;
+        }
+        const machine = target.createTargetMachine('x86_64-unknown-linux-gnu', 'generic');
+        const context = new llvm.LLVMContext();
+        const module = new llvm.Module('cancel', context);
+        module.setTargetTriple('x86_64-unknown-linux-gnu');
+        const builder = new llvm.IRBuilder(context);
+        const funcType = llvm.FunctionType.get(builder.getInt32Ty(), [builder.getInt32Ty(), builder.getInt32Ty()], false);
+        for (let i = 0; i < 100; i++) {
+            const linkage = i % 2 ? llvm.Function.LinkageTypes.InternalLinkage : llvm.Function.LinkageTypes.ExternalLinkage;
+            const func = llvm.Function.Create(funcType, linkage, `func${i}`, module);
+            builder.SetInsertPoint(llvm.BasicBlock.Create(context, 'entry', func));
+            let value: llvm.Value = func.getArg(0);
+            for (let j = 0; j < 200; j++) {
+                value = builder.CreateMul(builder.CreateAdd(value, func.getArg(1)), value);
+            }
+            builder.CreateRet(value);
+        }
+        let start = Date.now();
+        machine.emitToBuffer(module, 'obj');
+        const complete = Date.now() - start;
+        // instruction selection and register allocation have to be cut short too, not only the optional passes
+        const controller = new AbortController();
+        start = Date.now();
+        const emitted = machine.emitToBufferAsync(module, 'obj', { signal: controller.signal });
+        setTimeout(() => controller.abort(), complete / 10);
+        return emitted.then(() => {
+            throw new Error('emitToBufferAsync should have been aborted');
+        }, (error: Error) => {
+            expect(error).toBe(controller.signal.reason);
+            expect(Date.now() - start).toBeLessThan(complete / 2);
+            // the functions left out get their linkages back
+            expect(module.print()).not.toContain('available_externally');
+        });
+    });
+
+    test('Test llvm.Target.createTargetMachine options', () => {
+        const target = llvm.TargetRegistry.lookupTarget('x86_64');
+        if (target) {
+            const machine = target.createTargetMachine('x86_64-unknown-linux-gnu', 'generic', '', {
+                optLevel: llvm.CodeGenOpt.Aggressive,
+                relocModel: llvm.Reloc.PIC_,
+                codeModel: llvm.CodeModel.Small,
+                functionSections: true,
+                floatABIType: llvm.FloatABI.Hard
+            });
+            const assembly = machine.emitToBuffer(createModule(new llvm.LLVMContext()), 'asm').toString();
+            expect(assembly).toContain('.text.square');
+            expect(() => target.createTargetMachine('x86_64-unknown-linux-gnu', 'generic', '', { optLevel: 7 })).toThrow(TypeError);
+            expect(() => target.createTargetMachine('x86_64-unknown-linux-gnu', 'generic', '', { dataSections: 1 as unknown as boolean })).toThrow(TypeError);
+        }
+    });
+
+    test('Test llvm.TargetMachineCache', () => {
+        llvm.TargetMachineCache.clear();
+        llvm.TargetMachineCache.setCapacity(1);
+        const before = llvm.TargetMachineCache.getStats();
+        const first = llvm.TargetMachineCache.get('x86_64-unknown-linux-gnu', 'generic', '', { optLevel: llvm.CodeGenOpt.Less });
+        // leased machines are never shared
+        const second = llvm.TargetMachineCache.get('x86_64-unknown-linux-gnu', 'generic', '', { optLevel: llvm.CodeGenOpt.Less });
+        expect(second).not.toBe(first);
+        first.dispose();
+        second.dispose();
+        let stats = llvm.TargetMachineCache.getStats();
+        expect(stats.misses - before.misses).toEqual(2);
+        expect(stats.evictions - before.evictions).toEqual(1);
+        expect(stats.size).toEqual(1);
+        expect(stats.capacity).toEqual(1);
+
+        const reused = llvm.TargetMachineCache.get('x86_64-unknown-linux-gnu', 'generic', '', { optLevel: llvm.CodeGenOpt.Less });
+        expect(reused.emitToBuffer(createModule(new llvm.LLVMContext()), 'obj').subarray(0, 4).toString('latin1')).toEqual('\x7fELF');
+        reused.dispose();
+        llvm.TargetMachineCache.get('x86_64-unknown-linux-gnu', 'generic', '', { optLevel: llvm.CodeGenOpt.None }).dispose();
+        stats = llvm.TargetMachineCache.getStats();
+        expect(stats.hits - before.hits).toEqual(1);
+        expect(stats.misses - before.misses).toEqual(3);
+
+        llvm.TargetMachineCache.clear();
+        expect(llvm.TargetMachineCache.getStats().size).toEqual(0);
+        llvm.TargetMachineCache.setCapacity(8);
+        expect(() => llvm.TargetMachineCache.get('no-such-arch-unknown-unknown', 'generic')).toThrow(Error);
+        expect(() => llvm.TargetMachineCache.setCapacity(-1)).toThrow(TypeError);
+    });
 });